@@ -28,5 +28,6 @@ async def to_code(config):
     var = cg.new_Pvariable(config[CONF_ID])
     await cg.register_component(var, config)
     await i2c.register_i2c_device(var, config)
+    cg.add(var.set_i2c_scheduler(await i2c.get_scheduler()))
 
     cg.add(var.set_continuous_mode(config[CONF_CONTINUOUS_MODE]))
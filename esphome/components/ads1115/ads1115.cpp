@@ -1,5 +1,6 @@
 #include "ads1115.h"
 #include "esphome/core/hal.h"
+#include "esphome/core/helpers.h"
 #include "esphome/core/log.h"
 
 namespace esphome {
@@ -13,6 +14,7 @@ static const uint8_t ADS1115_DATA_RATE_860_SPS = 0b111;  // 3300_SPS for ADS1015
 
 void ADS1115Component::setup() {
   ESP_LOGCONFIG(TAG, "Setting up ADS1115...");
+  this->transaction_.set_callback([this](i2c::ErrorCode err) { this->complete_request_(err); });
   uint16_t value;
   if (!this->read_byte_16(ADS1115_REGISTER_CONVERSION, &value)) {
     this->mark_failed();
@@ -76,8 +78,7 @@ void ADS1115Component::dump_config() {
     ESP_LOGE(TAG, "Communication with ADS1115 failed!");
   }
 }
-float ADS1115Component::request_measurement(ADS1115Multiplexer multiplexer, ADS1115Gain gain,
-                                            ADS1115Resolution resolution) {
+uint16_t ADS1115Component::make_config_(ADS1115Multiplexer multiplexer, ADS1115Gain gain) const {
   uint16_t config = this->prev_config_;
   // Multiplexer
   //        0bxBBBxxxxxxxxxxxx
@@ -93,6 +94,12 @@ float ADS1115Component::request_measurement(ADS1115Multiplexer multiplexer, ADS1
     // Start conversion
     config |= 0b1000000000000000;
   }
+  return config;
+}
+
+float ADS1115Component::request_measurement(ADS1115Multiplexer multiplexer, ADS1115Gain gain,
+                                            ADS1115Resolution resolution) {
+  uint16_t config = this->make_config_(multiplexer, gain);
 
   if (!this->continuous_mode_ || this->prev_config_ != config) {
     if (!this->write_byte_16(ADS1115_REGISTER_CONFIG, config)) {
@@ -126,6 +133,70 @@ float ADS1115Component::request_measurement(ADS1115Multiplexer multiplexer, ADS1
     return NAN;
   }
 
+  this->status_clear_warning();
+  return this->convert_(raw_conversion, gain, resolution);
+}
+
+void ADS1115Component::request_measurement(ADS1115Multiplexer multiplexer, ADS1115Gain gain,
+                                           ADS1115Resolution resolution, std::function<void(float)> &&callback) {
+  if (this->scheduler_ == nullptr) {
+    callback(this->request_measurement(multiplexer, gain, resolution));
+    return;
+  }
+  this->requests_.push_back({multiplexer, gain, resolution, std::move(callback)});
+  // the channels share one converter, so only one measurement can run at a time
+  if (this->requests_.size() == 1)
+    this->start_request_();
+}
+
+void ADS1115Component::start_request_() {
+  const auto &request = this->requests_.front();
+  uint16_t config = this->make_config_(request.multiplexer, request.gain);
+  this->request_config_ = config;
+  this->transaction_.clear();
+  if (!this->continuous_mode_ || this->prev_config_ != config) {
+    this->config_command_[0] = ADS1115_REGISTER_CONFIG;
+    this->config_command_[1] = config >> 8;
+    this->config_command_[2] = config & 0xFF;
+    this->prev_config_ = config;
+    // about 1.2 ms with 860 samples per second
+    this->transaction_.write(this->config_command_, 3).delay(2);
+    if (!this->continuous_mode_) {
+      // to check that the conversion is complete
+      this->transaction_.read_register(ADS1115_REGISTER_CONFIG, this->config_data_, 2);
+    }
+  }
+  this->transaction_.read_register(ADS1115_REGISTER_CONVERSION, this->conversion_data_, 2);
+  if (!this->scheduler_->submit(&this->transaction_))
+    this->complete_request_(i2c::ERROR_UNKNOWN);
+}
+
+void ADS1115Component::complete_request_(i2c::ErrorCode err) {
+  Request request = std::move(this->requests_.front());
+  this->requests_.erase(this->requests_.begin());
+
+  float value = NAN;
+  if (err != i2c::ERROR_OK) {
+    this->status_set_warning();
+  } else {
+    uint16_t config = encode_uint16(this->config_data_[0], this->config_data_[1]);
+    // the conversion is only checked in single shot mode, the config was read back before the conversion
+    if (!this->continuous_mode_ && ((config >> 15) == 0 || (config & 0x7E00) != (this->request_config_ & 0x7E00))) {
+      ESP_LOGW(TAG, "Conversion not complete");
+      this->status_set_warning();
+    } else {
+      this->status_clear_warning();
+      value = this->convert_(encode_uint16(this->conversion_data_[0], this->conversion_data_[1]), request.gain,
+                             request.resolution);
+    }
+  }
+
+  if (!this->requests_.empty())
+    this->start_request_();
+  request.callback(value);
+}
+
+float ADS1115Component::convert_(uint16_t raw_conversion, ADS1115Gain gain, ADS1115Resolution resolution) const {
   if (resolution == ADS1015_12_BITS) {
     bool negative = (raw_conversion >> 15) == 1;
 
@@ -169,7 +240,6 @@ float ADS1115Component::request_measurement(ADS1115Multiplexer multiplexer, ADS1
       millivolts = NAN;
   }
 
-  this->status_clear_warning();
   return millivolts / 1e3f;
 }
 
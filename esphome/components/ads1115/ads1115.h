@@ -1,8 +1,10 @@
 #pragma once
 
 #include "esphome/components/i2c/i2c.h"
+#include "esphome/components/i2c/i2c_scheduler.h"
 #include "esphome/core/component.h"
 
+#include <functional>
 #include <vector>
 
 namespace esphome {
@@ -40,13 +42,39 @@ class ADS1115Component : public Component, public i2c::I2CDevice {
   /// HARDWARE_LATE setup priority
   float get_setup_priority() const override { return setup_priority::DATA; }
   void set_continuous_mode(bool continuous_mode) { continuous_mode_ = continuous_mode; }
+  void set_i2c_scheduler(i2c::I2CScheduler *scheduler) { this->scheduler_ = scheduler; }
 
   /// Helper method to request a measurement from a sensor.
   float request_measurement(ADS1115Multiplexer multiplexer, ADS1115Gain gain, ADS1115Resolution resolution);
+  /// Queue a measurement, the callback is called with the voltage or NAN once the conversion is complete.
+  /// Measurements are run one after the other through the I2C scheduler, or right away if there is none.
+  void request_measurement(ADS1115Multiplexer multiplexer, ADS1115Gain gain, ADS1115Resolution resolution,
+                           std::function<void(float)> &&callback);
 
  protected:
+  struct Request {
+    ADS1115Multiplexer multiplexer;
+    ADS1115Gain gain;
+    ADS1115Resolution resolution;
+    std::function<void(float)> callback;
+  };
+
+  uint16_t make_config_(ADS1115Multiplexer multiplexer, ADS1115Gain gain) const;
+  float convert_(uint16_t raw_conversion, ADS1115Gain gain, ADS1115Resolution resolution) const;
+  void start_request_();
+  void complete_request_(i2c::ErrorCode err);
+
   uint16_t prev_config_{0};
   bool continuous_mode_;
+
+  i2c::I2CScheduler *scheduler_{nullptr};
+  i2c::I2CTransaction transaction_{this};
+  /// Queued measurements, the first one is running.
+  std::vector<Request> requests_{};
+  uint16_t request_config_{0};
+  uint8_t config_command_[3];
+  uint8_t config_data_[2];
+  uint8_t conversion_data_[2];
 };
 
 }  // namespace ads1115
@@ -12,11 +12,12 @@ float ADS1115Sensor::sample() {
 }
 
 void ADS1115Sensor::update() {
-  float v = this->sample();
-  if (!std::isnan(v)) {
-    ESP_LOGD(TAG, "'%s': Got Voltage=%fV", this->get_name().c_str(), v);
-    this->publish_state(v);
-  }
+  this->parent_->request_measurement(this->multiplexer_, this->gain_, this->resolution_, [this](float v) {
+    if (!std::isnan(v)) {
+      ESP_LOGD(TAG, "'%s': Got Voltage=%fV", this->get_name().c_str(), v);
+      this->publish_state(v);
+    }
+  });
 }
 
 void ADS1115Sensor::dump_config() {
@@ -49,6 +49,7 @@ SERVICE_ARG_NATIVE_TYPES = {
     "string[]": cg.std_vector.template(cg.std_string),
 }
 CONF_ENCRYPTION = "encryption"
+CONF_CACHE_ENTITY_LIST = "cache_entity_list"
 
 
 def validate_encryption_key(value):
@@ -100,6 +101,15 @@ CONFIG_SCHEMA = cv.All(
                     cv.Required(CONF_KEY): validate_encryption_key,
                 }
             ),
+            cv.SplitDefault(
+                CONF_CACHE_ENTITY_LIST,
+                esp8266=False,
+                esp32=True,
+                rp2040=True,
+                bk72xx=False,
+                rtl87xx=False,
+                host=True,
+            ): cv.boolean,
             cv.Optional(CONF_ON_CLIENT_CONNECTED): automation.validate_automation(
                 single=True
             ),
@@ -159,6 +169,9 @@ async def to_code(config):
     else:
         cg.add_define("USE_API_PLAINTEXT")
 
+    if config.get(CONF_CACHE_ENTITY_LIST):
+        cg.add_define("USE_API_ENTITY_CACHE")
+
     cg.add_define("USE_API")
     cg.add_global(api_ns.using)
 
@@ -27,6 +27,11 @@ namespace api {
 
 static const char *const TAG = "api.connection";
 static const int ESP32_CAMERA_STOP_STREAM = 5000;
+// Initial states are sent in batches of about one TCP segment
+static const size_t INITIAL_STATE_BATCH_SIZE = 1436;
+static const uint16_t INITIAL_STATE_BATCH_MAX_STEPS = 128;
+// How often to ask the client to confirm the states it received, so they don't need to be sent again on resume
+static const uint32_t STATE_ACK_INTERVAL = 10000;
 
 APIConnection::APIConnection(std::unique_ptr<socket::Socket> sock, APIServer *parent)
     : parent_(parent), initial_state_iterator_(this), list_entities_iterator_(this) {
@@ -111,13 +116,17 @@ void APIConnection::loop() {
   } else {
     this->last_traffic_ = millis();
     // read a packet
-    this->read_message(buffer.data_len, buffer.type, &buffer.container[buffer.data_offset]);
+    this->read_message(buffer.data_len, buffer.type, buffer.container.data() + buffer.data_offset);
     if (this->remove_)
       return;
   }
 
+#ifdef USE_API_ENTITY_CACHE
+  this->send_entity_catalog_();
+#else
   this->list_entities_iterator_.advance();
-  this->initial_state_iterator_.advance();
+#endif
+  this->send_initial_states_();
 
   static uint32_t keepalive = 60000;
   static uint8_t max_ping_retries = 60;
@@ -129,10 +138,14 @@ void APIConnection::loop() {
       on_fatal_error();
       ESP_LOGW(TAG, "%s didn't respond to ping request in time. Disconnecting...", this->client_combined_info_.c_str());
     }
+  } else if (this->needs_state_ack_() && now - this->last_state_ack_ >= STATE_ACK_INTERVAL) {
+    // The client answers pings in order, so the response confirms that it received every state sent before.
+    // Failing to send is not fatal here, the next attempt is only delayed.
+    this->last_state_ack_ = now;
+    this->send_ping_request_();
   } else if (now - this->last_traffic_ > keepalive && now > this->next_ping_retry_) {
     ESP_LOGVV(TAG, "Sending keepalive PING...");
-    this->sent_ping_ = this->send_ping_request(PingRequest());
-    if (!this->sent_ping_) {
+    if (!this->send_ping_request_()) {
       this->next_ping_retry_ = now + ping_retry_interval;
       this->ping_retries_++;
       if (this->ping_retries_ >= max_ping_retries) {
@@ -1161,6 +1174,12 @@ BluetoothConnectionsFreeResponse APIConnection::subscribe_bluetooth_connections_
 #endif
 
 #ifdef USE_VOICE_ASSISTANT
+bool APIConnection::send_voice_assistant_audio(const uint8_t *data, size_t len) {
+  // same encoding as VoiceAssistantAudio with only the data field set
+  auto buffer = this->create_buffer();
+  buffer.encode_bytes(1, data, len);
+  return this->send_buffer(buffer, 106);
+}
 void APIConnection::subscribe_voice_assistant(const SubscribeVoiceAssistantRequest &msg) {
   if (voice_assistant::global_voice_assistant != nullptr) {
     voice_assistant::global_voice_assistant->client_subscription(this, msg.subscribe);
@@ -1403,6 +1422,26 @@ void APIConnection::update_command(const UpdateCommandRequest &msg) {
 }
 #endif
 
+#ifdef USE_RUNTIME_STATS
+RuntimeStatsResponse APIConnection::runtime_stats(const RuntimeStatsRequest &msg) {
+  RuntimeStatsResponse resp;
+  auto snapshot = App.runtime_stats.snapshot(msg.reset);
+  for (const auto &entry : snapshot.entries) {
+    ComponentRuntimeStats stats;
+    stats.source = entry.component->get_component_source();
+    stats.kind = static_cast<enums::RuntimeStatsKind>(entry.kind);
+    stats.count = entry.count;
+    stats.min_us = entry.min_us;
+    stats.avg_us = entry.average_us();
+    stats.p99_us = entry.percentile_us(99);
+    stats.max_us = entry.max_us;
+    resp.stats.push_back(std::move(stats));
+  }
+  resp.dropped = snapshot.dropped;
+  return resp;
+}
+#endif
+
 bool APIConnection::send_log_message(int level, const char *tag, const char *line) {
   if (this->log_subscription_ < level)
     return false;
@@ -1513,10 +1552,131 @@ void APIConnection::execute_service(const ExecuteServiceRequest &msg) {
     ESP_LOGV(TAG, "Could not find matching service!");
   }
 }
+void APIConnection::list_entities(const ListEntitiesRequest &msg) {
+#ifdef USE_API_ENTITY_CACHE
+  this->entity_catalog_ = this->parent_->get_entity_catalog();
+  if (this->entity_catalog_ == nullptr) {
+    this->entity_catalog_ = this->build_entity_catalog_();
+    this->parent_->set_entity_catalog(this->entity_catalog_);
+  }
+  this->entity_catalog_at_ = 0;
+#else
+  this->list_entities_iterator_.begin();
+#endif
+}
+#ifdef USE_API_ENTITY_CACHE
+std::shared_ptr<const EntityCatalog> APIConnection::build_entity_catalog_() {
+  auto catalog = std::make_shared<EntityCatalog>();
+  uint32_t start = micros();
+  // encode the list of all entities through the usual send functions, with send_buffer() collecting the messages
+  this->catalog_capture_ = catalog.get();
+  this->list_entities_iterator_.begin();
+  while (!this->list_entities_iterator_.completed())
+    this->list_entities_iterator_.advance();
+  this->catalog_capture_ = nullptr;
+  catalog->finish();
+  ESP_LOGD(TAG, "Encoded entity list: %zu messages, %zu bytes in %" PRIu32 "us", catalog->size(),
+           catalog->get_data_size(), micros() - start);
+  return catalog;
+}
+void APIConnection::send_entity_catalog_() {
+  if (this->entity_catalog_ == nullptr || !this->helper_->can_write_without_blocking())
+    return;
+  // Like the initial states, hand about one TCP segment of messages to the socket at a time
+  const EntityCatalog &catalog = *this->entity_catalog_;
+  this->helper_->begin_batch();
+  APIError err = APIError::OK;
+  while (this->entity_catalog_at_ < catalog.size() && this->helper_->get_batch_size() < INITIAL_STATE_BATCH_SIZE) {
+    const auto &entry = catalog.get_entry(this->entity_catalog_at_++);
+    err = this->helper_->write_packet(entry.message_type, catalog.get_data(entry), entry.length);
+    if (err != APIError::OK)
+      break;
+  }
+  if (err == APIError::OK)
+    err = this->helper_->end_batch();
+  if (err != APIError::OK) {
+    on_fatal_error();
+    ESP_LOGW(TAG, "%s: Socket operation failed: %s errno=%d", this->client_combined_info_.c_str(),
+             api_error_to_str(err), errno);
+    return;
+  }
+  if (this->entity_catalog_at_ == catalog.size())
+    this->entity_catalog_.reset();
+}
+#endif
+void APIConnection::subscribe_states(const SubscribeStatesRequest &msg) {
+  this->state_subscription_ = true;
+  if (msg.resume && this->parent_->take_resume_state(this->client_combined_info_, &this->resume_changed_)) {
+    ESP_LOGD(TAG, "%s: Resuming state subscription", this->client_combined_info_.c_str());
+    this->initial_state_iterator_.set_filter(&this->resume_changed_);
+    // The client still has every other state, only the ones sent now are unconfirmed
+    this->state_unacked_ = this->resume_changed_;
+    this->initial_states_acked_ = true;
+  } else {
+    this->initial_state_iterator_.set_filter(nullptr);
+    this->state_unacked_.clear();
+    this->initial_states_acked_ = false;
+  }
+  this->state_pinged_.clear();
+  this->initial_states_pinged_ = false;
+  this->initial_state_iterator_.begin();
+}
+void APIConnection::mark_state_unacked(EntityBase *entity) {
+  if (this->state_subscription_)
+    this->state_unacked_.mark(entity->get_object_id_hash());
+}
+bool APIConnection::needs_state_ack_() const {
+  if (!this->state_subscription_ || !this->initial_state_iterator_.completed())
+    return false;
+  return !this->initial_states_acked_ || this->state_unacked_.any();
+}
+bool APIConnection::send_ping_request_() {
+  this->sent_ping_ = this->send_ping_request(PingRequest());
+  if (!this->sent_ping_)
+    return false;
+  this->state_pinged_.merge(this->state_unacked_);
+  this->state_unacked_.clear();
+  this->initial_states_pinged_ = this->state_subscription_ && this->initial_state_iterator_.completed();
+  return true;
+}
+void APIConnection::on_ping_response(const PingResponse &value) {
+  // we initiated ping
+  this->ping_retries_ = 0;
+  this->sent_ping_ = false;
+  this->state_pinged_.clear();
+  if (this->initial_states_pinged_)
+    this->initial_states_acked_ = true;
+}
+void APIConnection::send_initial_states_() {
+  if (this->initial_state_iterator_.completed() || !this->helper_->can_write_without_blocking())
+    return;
+  // Encode as many states as fit in about one TCP segment and hand them to the socket in a single write,
+  // instead of one state message per loop iteration. Only start a new batch once the previous one has been
+  // accepted by the socket, so the amount of buffered data stays bounded by the socket send buffer.
+  this->helper_->begin_batch();
+  for (uint16_t i = 0; i < INITIAL_STATE_BATCH_MAX_STEPS && !this->initial_state_iterator_.completed(); i++) {
+    if (this->helper_->get_batch_size() >= INITIAL_STATE_BATCH_SIZE || this->remove_)
+      break;
+    this->initial_state_iterator_.advance();
+  }
+  APIError err = this->helper_->end_batch();
+  if (err != APIError::OK) {
+    on_fatal_error();
+    ESP_LOGW(TAG, "%s: Socket operation failed: %s errno=%d", this->client_combined_info_.c_str(),
+             api_error_to_str(err), errno);
+  }
+}
 void APIConnection::subscribe_home_assistant_states(const SubscribeHomeAssistantStatesRequest &msg) {
   state_subs_at_ = 0;
 }
 bool APIConnection::send_buffer(ProtoWriteBuffer buffer, uint32_t message_type) {
+#ifdef USE_API_ENTITY_CACHE
+  // SubscribeLogsResponse - 29, log messages emitted while the catalog is built are sent as usual
+  if (this->catalog_capture_ != nullptr && message_type != 29) {
+    this->catalog_capture_->add(message_type, buffer.get_buffer()->data(), buffer.get_buffer()->size());
+    return true;
+  }
+#endif
   if (this->remove_)
     return false;
   if (!this->helper_->can_write_without_blocking()) {
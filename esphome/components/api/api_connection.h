@@ -156,6 +156,9 @@ class APIConnection : public APIServerConnection {
   VoiceAssistantConfigurationResponse voice_assistant_get_configuration(
       const VoiceAssistantConfigurationRequest &msg) override;
   void voice_assistant_set_configuration(const VoiceAssistantSetConfiguration &msg) override;
+  using APIServerConnectionBase::send_voice_assistant_audio;
+  /// Send microphone audio straight from the caller's buffer, without building a VoiceAssistantAudio message first.
+  bool send_voice_assistant_audio(const uint8_t *data, size_t len);
 #endif
 
 #ifdef USE_ALARM_CONTROL_PANEL
@@ -175,12 +178,12 @@ class APIConnection : public APIServerConnection {
   void update_command(const UpdateCommandRequest &msg) override;
 #endif
 
+#ifdef USE_RUNTIME_STATS
+  RuntimeStatsResponse runtime_stats(const RuntimeStatsRequest &msg) override;
+#endif
+
   void on_disconnect_response(const DisconnectResponse &value) override;
-  void on_ping_response(const PingResponse &value) override {
-    // we initiated ping
-    this->ping_retries_ = 0;
-    this->sent_ping_ = false;
-  }
+  void on_ping_response(const PingResponse &value) override;
   void on_home_assistant_state_response(const HomeAssistantStateResponse &msg) override;
 #ifdef USE_HOMEASSISTANT_TIME
   void on_get_time_response(const GetTimeResponse &value) override;
@@ -190,11 +193,8 @@ class APIConnection : public APIServerConnection {
   DisconnectResponse disconnect(const DisconnectRequest &msg) override;
   PingResponse ping(const PingRequest &msg) override { return {}; }
   DeviceInfoResponse device_info(const DeviceInfoRequest &msg) override;
-  void list_entities(const ListEntitiesRequest &msg) override { this->list_entities_iterator_.begin(); }
-  void subscribe_states(const SubscribeStatesRequest &msg) override {
-    this->state_subscription_ = true;
-    this->initial_state_iterator_.begin();
-  }
+  void list_entities(const ListEntitiesRequest &msg) override;
+  void subscribe_states(const SubscribeStatesRequest &msg) override;
   void subscribe_logs(const SubscribeLogsRequest &msg) override {
     this->log_subscription_ = msg.level;
     if (msg.dump_config)
@@ -226,10 +226,24 @@ class APIConnection : public APIServerConnection {
 
   std::string get_client_combined_info() const { return this->client_combined_info_; }
 
+  /** Remember that the client has not confirmed receiving the latest state of this entity.
+   *
+   * Call this for every state update, whether it was sent or not: a state that was written to the socket can still be
+   * lost if the connection drops before the client read it.
+   */
+  void mark_state_unacked(EntityBase *entity);
+
  protected:
   friend APIServer;
 
   bool send_(const void *buf, size_t len, bool force);
+  void send_initial_states_();
+  bool needs_state_ack_() const;
+  bool send_ping_request_();
+#ifdef USE_API_ENTITY_CACHE
+  std::shared_ptr<const EntityCatalog> build_entity_catalog_();
+  void send_entity_catalog_();
+#endif
 
   enum class ConnectionState {
     WAITING_FOR_HELLO,
@@ -264,6 +278,23 @@ class APIConnection : public APIServerConnection {
   APIServer *parent_;
   InitialStateIterator initial_state_iterator_;
   ListEntitiesIterator list_entities_iterator_;
+#ifdef USE_API_ENTITY_CACHE
+  // The entity list that is being sent to this client, and the index of the next message
+  std::shared_ptr<const EntityCatalog> entity_catalog_;
+  size_t entity_catalog_at_{0};
+  // Set while the entity list is encoded into a new catalog instead of being sent
+  EntityCatalog *catalog_capture_{nullptr};
+#endif
+  // Entities whose state changed since this client last disconnected, used to resume a state subscription
+  StateChangeBitmap resume_changed_;
+  // Entities whose latest state the client has not confirmed yet, split by whether it was sent before the
+  // outstanding ping. A ping response confirms every state sent before that ping.
+  StateChangeBitmap state_unacked_;
+  StateChangeBitmap state_pinged_;
+  uint32_t last_state_ack_{0};
+  // Whether the client confirmed receiving all states once, so it can resume after a disconnect
+  bool initial_states_acked_{false};
+  bool initial_states_pinged_{false};
   int state_subs_at_ = -1;
 };
 
@@ -72,6 +72,20 @@ const char *api_error_to_str(APIError err) {
   return "UNKNOWN";
 }
 
+APIError APIFrameHelper::end_batch() {
+  this->batching_ = false;
+  if (this->batch_buf_.empty())
+    return APIError::OK;
+  if (this->tx_buf_.empty()) {
+    // take over the batch buffer instead of copying it
+    this->tx_buf_.swap(this->batch_buf_);
+  } else {
+    this->tx_buf_.insert(this->tx_buf_.end(), this->batch_buf_.begin(), this->batch_buf_.end());
+  }
+  this->batch_buf_.clear();
+  return this->try_send_tx_buf_();
+}
+
 #define HELPER_LOG(msg, ...) ESP_LOGVV(TAG, "%s: " msg, info_.c_str(), ##__VA_ARGS__)
 // uncomment to log raw packets
 //#define HELPER_LOG_PACKETS
@@ -550,6 +564,10 @@ APIError APINoiseFrameHelper::try_send_tx_buf_() {
 APIError APINoiseFrameHelper::write_raw_(const struct iovec *iov, int iovcnt) {
   if (iovcnt == 0)
     return APIError::OK;
+  if (batching_) {
+    append_batch_(iov, iovcnt);
+    return APIError::OK;
+  }
   APIError aerr;
 
   size_t total_write_len = 0;
@@ -950,6 +968,10 @@ APIError APIPlaintextFrameHelper::try_send_tx_buf_() {
 APIError APIPlaintextFrameHelper::write_raw_(const struct iovec *iov, int iovcnt) {
   if (iovcnt == 0)
     return APIError::OK;
+  if (batching_) {
+    append_batch_(iov, iovcnt);
+    return APIError::OK;
+  }
   APIError aerr;
 
   size_t total_write_len = 0;
@@ -72,6 +72,27 @@ class APIFrameHelper {
   virtual APIError shutdown(int how) = 0;
   // Give this helper a name for logging
   virtual void set_log_info(std::string info) = 0;
+
+  /// Collect the packets written until end_batch() in memory, so they can be sent with a single socket write.
+  void begin_batch() { this->batching_ = true; }
+  /// Hand all packets collected since begin_batch() to the socket.
+  APIError end_batch();
+  /// Number of bytes collected since begin_batch().
+  size_t get_batch_size() const { return this->batch_buf_.size(); }
+
+ protected:
+  void append_batch_(const struct iovec *iov, int iovcnt) {
+    for (int i = 0; i < iovcnt; i++) {
+      this->batch_buf_.insert(this->batch_buf_.end(), reinterpret_cast<uint8_t *>(iov[i].iov_base),
+                              reinterpret_cast<uint8_t *>(iov[i].iov_base) + iov[i].iov_len);
+    }
+  }
+
+  virtual APIError try_send_tx_buf_() = 0;
+
+  bool batching_{false};
+  std::vector<uint8_t> batch_buf_;
+  std::vector<uint8_t> tx_buf_;
 };
 
 #ifdef USE_API_NOISE
@@ -101,7 +122,7 @@ class APINoiseFrameHelper : public APIFrameHelper {
 
   APIError state_action_();
   APIError try_read_frame_(ParsedFrame *frame);
-  APIError try_send_tx_buf_();
+  APIError try_send_tx_buf_() override;
   APIError write_frame_(const uint8_t *data, size_t len);
   APIError write_raw_(const struct iovec *iov, int iovcnt);
   APIError init_handshake_();
@@ -116,7 +137,6 @@ class APINoiseFrameHelper : public APIFrameHelper {
   std::vector<uint8_t> rx_buf_;
   size_t rx_buf_len_ = 0;
 
-  std::vector<uint8_t> tx_buf_;
   std::vector<uint8_t> prologue_;
 
   std::shared_ptr<APINoiseContext> ctx_;
@@ -163,7 +183,7 @@ class APIPlaintextFrameHelper : public APIFrameHelper {
   };
 
   APIError try_read_frame_(ParsedFrame *frame);
-  APIError try_send_tx_buf_();
+  APIError try_send_tx_buf_() override;
   APIError write_raw_(const struct iovec *iov, int iovcnt);
 
   std::unique_ptr<socket::Socket> socket_;
@@ -177,8 +197,6 @@ class APIPlaintextFrameHelper : public APIFrameHelper {
   std::vector<uint8_t> rx_buf_;
   size_t rx_buf_len_ = 0;
 
-  std::vector<uint8_t> tx_buf_;
-
   enum class State {
     INITIALIZE = 1,
     DATA = 2,
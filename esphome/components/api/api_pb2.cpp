@@ -593,6 +593,20 @@ template<> const char *proto_enum_to_string<enums::UpdateCommand>(enums::UpdateC
   }
 }
 #endif
+#ifdef HAS_PROTO_MESSAGE_DUMP
+template<> const char *proto_enum_to_string<enums::RuntimeStatsKind>(enums::RuntimeStatsKind value) {
+  switch (value) {
+    case enums::RUNTIME_STATS_KIND_LOOP:
+      return "RUNTIME_STATS_KIND_LOOP";
+    case enums::RUNTIME_STATS_KIND_UPDATE:
+      return "RUNTIME_STATS_KIND_UPDATE";
+    case enums::RUNTIME_STATS_KIND_SCHEDULER:
+      return "RUNTIME_STATS_KIND_SCHEDULER";
+    default:
+      return "UNKNOWN";
+  }
+}
+#endif
 bool HelloRequest::decode_varint(uint32_t field_id, ProtoVarInt value) {
   switch (field_id) {
     case 2: {
@@ -948,9 +962,26 @@ void ListEntitiesDoneResponse::encode(ProtoWriteBuffer buffer) const {}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void ListEntitiesDoneResponse::dump_to(std::string &out) const { out.append("ListEntitiesDoneResponse {}"); }
 #endif
-void SubscribeStatesRequest::encode(ProtoWriteBuffer buffer) const {}
+bool SubscribeStatesRequest::decode_varint(uint32_t field_id, ProtoVarInt value) {
+  switch (field_id) {
+    case 1: {
+      this->resume = value.as_bool();
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+void SubscribeStatesRequest::encode(ProtoWriteBuffer buffer) const { buffer.encode_bool(1, this->resume); }
 #ifdef HAS_PROTO_MESSAGE_DUMP
-void SubscribeStatesRequest::dump_to(std::string &out) const { out.append("SubscribeStatesRequest {}"); }
+void SubscribeStatesRequest::dump_to(std::string &out) const {
+  __attribute__((unused)) char buffer[64];
+  out.append("SubscribeStatesRequest {\n");
+  out.append("  resume: ");
+  out.append(YESNO(this->resume));
+  out.append("\n");
+  out.append("}");
+}
 #endif
 bool ListEntitiesBinarySensorResponse::decode_varint(uint32_t field_id, ProtoVarInt value) {
   switch (field_id) {
@@ -8941,6 +8972,158 @@ void UpdateCommandRequest::dump_to(std::string &out) const {
   out.append("}");
 }
 #endif
+bool RuntimeStatsRequest::decode_varint(uint32_t field_id, ProtoVarInt value) {
+  switch (field_id) {
+    case 1: {
+      this->reset = value.as_bool();
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+void RuntimeStatsRequest::encode(ProtoWriteBuffer buffer) const { buffer.encode_bool(1, this->reset); }
+#ifdef HAS_PROTO_MESSAGE_DUMP
+void RuntimeStatsRequest::dump_to(std::string &out) const {
+  __attribute__((unused)) char buffer[64];
+  out.append("RuntimeStatsRequest {\n");
+  out.append("  reset: ");
+  out.append(YESNO(this->reset));
+  out.append("\n");
+  out.append("}");
+}
+#endif
+bool ComponentRuntimeStats::decode_varint(uint32_t field_id, ProtoVarInt value) {
+  switch (field_id) {
+    case 2: {
+      this->kind = value.as_enum<enums::RuntimeStatsKind>();
+      return true;
+    }
+    case 3: {
+      this->count = value.as_uint32();
+      return true;
+    }
+    case 4: {
+      this->min_us = value.as_uint32();
+      return true;
+    }
+    case 5: {
+      this->avg_us = value.as_uint32();
+      return true;
+    }
+    case 6: {
+      this->p99_us = value.as_uint32();
+      return true;
+    }
+    case 7: {
+      this->max_us = value.as_uint32();
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+bool ComponentRuntimeStats::decode_length(uint32_t field_id, ProtoLengthDelimited value) {
+  switch (field_id) {
+    case 1: {
+      this->source = value.as_string();
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+void ComponentRuntimeStats::encode(ProtoWriteBuffer buffer) const {
+  buffer.encode_string(1, this->source);
+  buffer.encode_enum<enums::RuntimeStatsKind>(2, this->kind);
+  buffer.encode_uint32(3, this->count);
+  buffer.encode_uint32(4, this->min_us);
+  buffer.encode_uint32(5, this->avg_us);
+  buffer.encode_uint32(6, this->p99_us);
+  buffer.encode_uint32(7, this->max_us);
+}
+#ifdef HAS_PROTO_MESSAGE_DUMP
+void ComponentRuntimeStats::dump_to(std::string &out) const {
+  __attribute__((unused)) char buffer[64];
+  out.append("ComponentRuntimeStats {\n");
+  out.append("  source: ");
+  out.append("'").append(this->source).append("'");
+  out.append("\n");
+
+  out.append("  kind: ");
+  out.append(proto_enum_to_string<enums::RuntimeStatsKind>(this->kind));
+  out.append("\n");
+
+  out.append("  count: ");
+  sprintf(buffer, "%" PRIu32, this->count);
+  out.append(buffer);
+  out.append("\n");
+
+  out.append("  min_us: ");
+  sprintf(buffer, "%" PRIu32, this->min_us);
+  out.append(buffer);
+  out.append("\n");
+
+  out.append("  avg_us: ");
+  sprintf(buffer, "%" PRIu32, this->avg_us);
+  out.append(buffer);
+  out.append("\n");
+
+  out.append("  p99_us: ");
+  sprintf(buffer, "%" PRIu32, this->p99_us);
+  out.append(buffer);
+  out.append("\n");
+
+  out.append("  max_us: ");
+  sprintf(buffer, "%" PRIu32, this->max_us);
+  out.append(buffer);
+  out.append("\n");
+  out.append("}");
+}
+#endif
+bool RuntimeStatsResponse::decode_varint(uint32_t field_id, ProtoVarInt value) {
+  switch (field_id) {
+    case 2: {
+      this->dropped = value.as_uint32();
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+bool RuntimeStatsResponse::decode_length(uint32_t field_id, ProtoLengthDelimited value) {
+  switch (field_id) {
+    case 1: {
+      this->stats.push_back(value.as_message<ComponentRuntimeStats>());
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+void RuntimeStatsResponse::encode(ProtoWriteBuffer buffer) const {
+  for (auto &it : this->stats) {
+    buffer.encode_message<ComponentRuntimeStats>(1, it, true);
+  }
+  buffer.encode_uint32(2, this->dropped);
+}
+#ifdef HAS_PROTO_MESSAGE_DUMP
+void RuntimeStatsResponse::dump_to(std::string &out) const {
+  __attribute__((unused)) char buffer[64];
+  out.append("RuntimeStatsResponse {\n");
+  for (const auto &it : this->stats) {
+    out.append("  stats: ");
+    it.dump_to(out);
+    out.append("\n");
+  }
+
+  out.append("  dropped: ");
+  sprintf(buffer, "%" PRIu32, this->dropped);
+  out.append(buffer);
+  out.append("\n");
+  out.append("}");
+}
+#endif
 
 }  // namespace api
 }  // namespace esphome
@@ -236,6 +236,11 @@ enum UpdateCommand : uint32_t {
   UPDATE_COMMAND_UPDATE = 1,
   UPDATE_COMMAND_CHECK = 2,
 };
+enum RuntimeStatsKind : uint32_t {
+  RUNTIME_STATS_KIND_LOOP = 0,
+  RUNTIME_STATS_KIND_UPDATE = 1,
+  RUNTIME_STATS_KIND_SCHEDULER = 2,
+};
 
 }  // namespace enums
 
@@ -383,12 +388,14 @@ class ListEntitiesDoneResponse : public ProtoMessage {
 };
 class SubscribeStatesRequest : public ProtoMessage {
  public:
+  bool resume{false};
   void encode(ProtoWriteBuffer buffer) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
 #endif
 
  protected:
+  bool decode_varint(uint32_t field_id, ProtoVarInt value) override;
 };
 class ListEntitiesBinarySensorResponse : public ProtoMessage {
  public:
@@ -2283,6 +2290,48 @@ class UpdateCommandRequest : public ProtoMessage {
   bool decode_32bit(uint32_t field_id, Proto32Bit value) override;
   bool decode_varint(uint32_t field_id, ProtoVarInt value) override;
 };
+class RuntimeStatsRequest : public ProtoMessage {
+ public:
+  bool reset{false};
+  void encode(ProtoWriteBuffer buffer) const override;
+#ifdef HAS_PROTO_MESSAGE_DUMP
+  void dump_to(std::string &out) const override;
+#endif
+
+ protected:
+  bool decode_varint(uint32_t field_id, ProtoVarInt value) override;
+};
+class ComponentRuntimeStats : public ProtoMessage {
+ public:
+  std::string source{};
+  enums::RuntimeStatsKind kind{};
+  uint32_t count{0};
+  uint32_t min_us{0};
+  uint32_t avg_us{0};
+  uint32_t p99_us{0};
+  uint32_t max_us{0};
+  void encode(ProtoWriteBuffer buffer) const override;
+#ifdef HAS_PROTO_MESSAGE_DUMP
+  void dump_to(std::string &out) const override;
+#endif
+
+ protected:
+  bool decode_length(uint32_t field_id, ProtoLengthDelimited value) override;
+  bool decode_varint(uint32_t field_id, ProtoVarInt value) override;
+};
+class RuntimeStatsResponse : public ProtoMessage {
+ public:
+  std::vector<ComponentRuntimeStats> stats{};
+  uint32_t dropped{0};
+  void encode(ProtoWriteBuffer buffer) const override;
+#ifdef HAS_PROTO_MESSAGE_DUMP
+  void dump_to(std::string &out) const override;
+#endif
+
+ protected:
+  bool decode_length(uint32_t field_id, ProtoLengthDelimited value) override;
+  bool decode_varint(uint32_t field_id, ProtoVarInt value) override;
+};
 
 }  // namespace api
 }  // namespace esphome
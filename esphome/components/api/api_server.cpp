@@ -20,6 +20,8 @@ namespace esphome {
 namespace api {
 
 static const char *const TAG = "api";
+// Number of disconnected clients to remember state changes for
+static const size_t MAX_RESUME_STATES = 2;
 
 // APIServer
 void APIServer::setup() {
@@ -113,6 +115,7 @@ void APIServer::loop() {
   // print disconnection messages
   for (auto it = new_end; it != this->clients_.end(); ++it) {
     this->client_disconnected_trigger_->trigger((*it)->client_info_, (*it)->client_peername_);
+    this->save_resume_state_(it->get());
     ESP_LOGV(TAG, "Removing connection to %s", (*it)->client_info_.c_str());
   }
   // resize vector
@@ -175,12 +178,42 @@ bool APIServer::check_password(const std::string &password) const {
   return result == 0;
 }
 void APIServer::handle_disconnect(APIConnection *conn) {}
+void APIServer::save_resume_state_(APIConnection *conn) {
+  auto it = std::find_if(this->resume_states_.begin(), this->resume_states_.end(),
+                         [conn](const ResumeState &state) { return state.client == conn->client_combined_info_; });
+  if (it != this->resume_states_.end())
+    this->resume_states_.erase(it);
+  // The client can only resume if it confirmed receiving every state at least once
+  if (!conn->state_subscription_ || !conn->initial_states_acked_)
+    return;
+  if (this->resume_states_.size() >= MAX_RESUME_STATES)
+    this->resume_states_.erase(this->resume_states_.begin());
+  // Every state the client did not confirm may have been lost with the connection
+  this->resume_states_.push_back({conn->client_combined_info_, conn->state_unacked_});
+  this->resume_states_.back().changed.merge(conn->state_pinged_);
+}
+bool APIServer::take_resume_state(const std::string &client, StateChangeBitmap *changed) {
+  auto it = std::find_if(this->resume_states_.begin(), this->resume_states_.end(),
+                         [&client](const ResumeState &state) { return state.client == client; });
+  if (it == this->resume_states_.end())
+    return false;
+  *changed = it->changed;
+  this->resume_states_.erase(it);
+  return true;
+}
+void APIServer::mark_state_changed_(EntityBase *obj) {
+  for (auto &state : this->resume_states_)
+    state.changed.mark(obj->get_object_id_hash());
+}
 #ifdef USE_BINARY_SENSOR
 void APIServer::on_binary_sensor_update(binary_sensor::BinarySensor *obj, bool state) {
   if (obj->is_internal())
     return;
-  for (auto &c : this->clients_)
+  this->mark_state_changed_(obj);
+  for (auto &c : this->clients_) {
     c->send_binary_sensor_state(obj, state);
+    c->mark_state_unacked(obj);
+  }
 }
 #endif
 
@@ -188,8 +221,11 @@ void APIServer::on_binary_sensor_update(binary_sensor::BinarySensor *obj, bool s
 void APIServer::on_cover_update(cover::Cover *obj) {
   if (obj->is_internal())
     return;
-  for (auto &c : this->clients_)
+  this->mark_state_changed_(obj);
+  for (auto &c : this->clients_) {
     c->send_cover_state(obj);
+    c->mark_state_unacked(obj);
+  }
 }
 #endif
 
@@ -197,8 +233,11 @@ void APIServer::on_cover_update(cover::Cover *obj) {
 void APIServer::on_fan_update(fan::Fan *obj) {
   if (obj->is_internal())
     return;
-  for (auto &c : this->clients_)
+  this->mark_state_changed_(obj);
+  for (auto &c : this->clients_) {
     c->send_fan_state(obj);
+    c->mark_state_unacked(obj);
+  }
 }
 #endif
 
@@ -206,8 +245,11 @@ void APIServer::on_fan_update(fan::Fan *obj) {
 void APIServer::on_light_update(light::LightState *obj) {
   if (obj->is_internal())
     return;
-  for (auto &c : this->clients_)
+  this->mark_state_changed_(obj);
+  for (auto &c : this->clients_) {
     c->send_light_state(obj);
+    c->mark_state_unacked(obj);
+  }
 }
 #endif
 
@@ -215,8 +257,11 @@ void APIServer::on_light_update(light::LightState *obj) {
 void APIServer::on_sensor_update(sensor::Sensor *obj, float state) {
   if (obj->is_internal())
     return;
-  for (auto &c : this->clients_)
+  this->mark_state_changed_(obj);
+  for (auto &c : this->clients_) {
     c->send_sensor_state(obj, state);
+    c->mark_state_unacked(obj);
+  }
 }
 #endif
 
@@ -224,8 +269,11 @@ void APIServer::on_sensor_update(sensor::Sensor *obj, float state) {
 void APIServer::on_switch_update(switch_::Switch *obj, bool state) {
   if (obj->is_internal())
     return;
-  for (auto &c : this->clients_)
+  this->mark_state_changed_(obj);
+  for (auto &c : this->clients_) {
     c->send_switch_state(obj, state);
+    c->mark_state_unacked(obj);
+  }
 }
 #endif
 
@@ -233,8 +281,11 @@ void APIServer::on_switch_update(switch_::Switch *obj, bool state) {
 void APIServer::on_text_sensor_update(text_sensor::TextSensor *obj, const std::string &state) {
   if (obj->is_internal())
     return;
-  for (auto &c : this->clients_)
+  this->mark_state_changed_(obj);
+  for (auto &c : this->clients_) {
     c->send_text_sensor_state(obj, state);
+    c->mark_state_unacked(obj);
+  }
 }
 #endif
 
@@ -242,8 +293,11 @@ void APIServer::on_text_sensor_update(text_sensor::TextSensor *obj, const std::s
 void APIServer::on_climate_update(climate::Climate *obj) {
   if (obj->is_internal())
     return;
-  for (auto &c : this->clients_)
+  this->mark_state_changed_(obj);
+  for (auto &c : this->clients_) {
     c->send_climate_state(obj);
+    c->mark_state_unacked(obj);
+  }
 }
 #endif
 
@@ -251,8 +305,11 @@ void APIServer::on_climate_update(climate::Climate *obj) {
 void APIServer::on_number_update(number::Number *obj, float state) {
   if (obj->is_internal())
     return;
-  for (auto &c : this->clients_)
+  this->mark_state_changed_(obj);
+  for (auto &c : this->clients_) {
     c->send_number_state(obj, state);
+    c->mark_state_unacked(obj);
+  }
 }
 #endif
 
@@ -260,8 +317,11 @@ void APIServer::on_number_update(number::Number *obj, float state) {
 void APIServer::on_date_update(datetime::DateEntity *obj) {
   if (obj->is_internal())
     return;
-  for (auto &c : this->clients_)
+  this->mark_state_changed_(obj);
+  for (auto &c : this->clients_) {
     c->send_date_state(obj);
+    c->mark_state_unacked(obj);
+  }
 }
 #endif
 
@@ -269,8 +329,11 @@ void APIServer::on_date_update(datetime::DateEntity *obj) {
 void APIServer::on_time_update(datetime::TimeEntity *obj) {
   if (obj->is_internal())
     return;
-  for (auto &c : this->clients_)
+  this->mark_state_changed_(obj);
+  for (auto &c : this->clients_) {
     c->send_time_state(obj);
+    c->mark_state_unacked(obj);
+  }
 }
 #endif
 
@@ -278,8 +341,11 @@ void APIServer::on_time_update(datetime::TimeEntity *obj) {
 void APIServer::on_datetime_update(datetime::DateTimeEntity *obj) {
   if (obj->is_internal())
     return;
-  for (auto &c : this->clients_)
+  this->mark_state_changed_(obj);
+  for (auto &c : this->clients_) {
     c->send_datetime_state(obj);
+    c->mark_state_unacked(obj);
+  }
 }
 #endif
 
@@ -287,8 +353,11 @@ void APIServer::on_datetime_update(datetime::DateTimeEntity *obj) {
 void APIServer::on_text_update(text::Text *obj, const std::string &state) {
   if (obj->is_internal())
     return;
-  for (auto &c : this->clients_)
+  this->mark_state_changed_(obj);
+  for (auto &c : this->clients_) {
     c->send_text_state(obj, state);
+    c->mark_state_unacked(obj);
+  }
 }
 #endif
 
@@ -296,8 +365,11 @@ void APIServer::on_text_update(text::Text *obj, const std::string &state) {
 void APIServer::on_select_update(select::Select *obj, const std::string &state, size_t index) {
   if (obj->is_internal())
     return;
-  for (auto &c : this->clients_)
+  this->mark_state_changed_(obj);
+  for (auto &c : this->clients_) {
     c->send_select_state(obj, state);
+    c->mark_state_unacked(obj);
+  }
 }
 #endif
 
@@ -305,8 +377,11 @@ void APIServer::on_select_update(select::Select *obj, const std::string &state,
 void APIServer::on_lock_update(lock::Lock *obj) {
   if (obj->is_internal())
     return;
-  for (auto &c : this->clients_)
+  this->mark_state_changed_(obj);
+  for (auto &c : this->clients_) {
     c->send_lock_state(obj, obj->state);
+    c->mark_state_unacked(obj);
+  }
 }
 #endif
 
@@ -314,8 +389,11 @@ void APIServer::on_lock_update(lock::Lock *obj) {
 void APIServer::on_valve_update(valve::Valve *obj) {
   if (obj->is_internal())
     return;
-  for (auto &c : this->clients_)
+  this->mark_state_changed_(obj);
+  for (auto &c : this->clients_) {
     c->send_valve_state(obj);
+    c->mark_state_unacked(obj);
+  }
 }
 #endif
 
@@ -323,8 +401,11 @@ void APIServer::on_valve_update(valve::Valve *obj) {
 void APIServer::on_media_player_update(media_player::MediaPlayer *obj) {
   if (obj->is_internal())
     return;
-  for (auto &c : this->clients_)
+  this->mark_state_changed_(obj);
+  for (auto &c : this->clients_) {
     c->send_media_player_state(obj);
+    c->mark_state_unacked(obj);
+  }
 }
 #endif
 
@@ -337,8 +418,11 @@ void APIServer::on_event(event::Event *obj, const std::string &event_type) {
 
 #ifdef USE_UPDATE
 void APIServer::on_update(update::UpdateEntity *obj) {
-  for (auto &c : this->clients_)
+  this->mark_state_changed_(obj);
+  for (auto &c : this->clients_) {
     c->send_update_state(obj);
+    c->mark_state_unacked(obj);
+  }
 }
 #endif
 
@@ -397,8 +481,11 @@ void APIServer::on_shutdown() {
 void APIServer::on_alarm_control_panel_update(alarm_control_panel::AlarmControlPanel *obj) {
   if (obj->is_internal())
     return;
-  for (auto &c : this->clients_)
+  this->mark_state_changed_(obj);
+  for (auto &c : this->clients_) {
     c->send_alarm_control_panel_state(obj);
+    c->mark_state_unacked(obj);
+  }
 }
 #endif
 
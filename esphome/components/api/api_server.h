@@ -14,6 +14,7 @@
 #include "subscribe_state.h"
 #include "user_services.h"
 
+#include <memory>
 #include <vector>
 
 namespace esphome {
@@ -40,6 +41,11 @@ class APIServer : public Component, public Controller {
 #endif  // USE_API_NOISE
 
   void handle_disconnect(APIConnection *conn);
+  /** Get the entities whose state changed since the given client last disconnected.
+   *
+   * @return false if there is no record of that client, in which case all states must be sent.
+   */
+  bool take_resume_state(const std::string &client, StateChangeBitmap *changed);
 #ifdef USE_BINARY_SENSOR
   void on_binary_sensor_update(binary_sensor::BinarySensor *obj, bool state) override;
 #endif
@@ -92,7 +98,12 @@ class APIServer : public Component, public Controller {
   void on_media_player_update(media_player::MediaPlayer *obj) override;
 #endif
   void send_homeassistant_service_call(const HomeassistantServiceResponse &call);
-  void register_user_service(UserServiceDescriptor *descriptor) { this->user_services_.push_back(descriptor); }
+  void register_user_service(UserServiceDescriptor *descriptor) {
+    this->user_services_.push_back(descriptor);
+#ifdef USE_API_ENTITY_CACHE
+    this->invalidate_entity_catalog();
+#endif
+  }
 #ifdef USE_HOMEASSISTANT_TIME
   void request_time();
 #endif
@@ -123,12 +134,27 @@ class APIServer : public Component, public Controller {
   const std::vector<HomeAssistantStateSubscription> &get_state_subs() const;
   const std::vector<UserServiceDescriptor *> &get_user_services() const { return this->user_services_; }
 
+#ifdef USE_API_ENTITY_CACHE
+  /// Build the entity list again for the next client that requests it, after entity metadata has been changed.
+  void invalidate_entity_catalog() { this->entity_catalog_.reset(); }
+  const std::shared_ptr<const EntityCatalog> &get_entity_catalog() const { return this->entity_catalog_; }
+  void set_entity_catalog(std::shared_ptr<const EntityCatalog> catalog) { this->entity_catalog_ = std::move(catalog); }
+#endif
+
   Trigger<std::string, std::string> *get_client_connected_trigger() const { return this->client_connected_trigger_; }
   Trigger<std::string, std::string> *get_client_disconnected_trigger() const {
     return this->client_disconnected_trigger_;
   }
 
  protected:
+  struct ResumeState {
+    std::string client;
+    StateChangeBitmap changed;
+  };
+
+  void save_resume_state_(APIConnection *conn);
+  void mark_state_changed_(EntityBase *obj);
+
   std::unique_ptr<socket::Socket> socket_ = nullptr;
   uint16_t port_{6053};
   uint32_t reboot_timeout_{300000};
@@ -137,6 +163,10 @@ class APIServer : public Component, public Controller {
   std::string password_;
   std::vector<HomeAssistantStateSubscription> state_subs_;
   std::vector<UserServiceDescriptor *> user_services_;
+  std::vector<ResumeState> resume_states_;
+#ifdef USE_API_ENTITY_CACHE
+  std::shared_ptr<const EntityCatalog> entity_catalog_;
+#endif
   Trigger<std::string, std::string> *client_connected_trigger_ = new Trigger<std::string, std::string>();
   Trigger<std::string, std::string> *client_disconnected_trigger_ = new Trigger<std::string, std::string>();
 
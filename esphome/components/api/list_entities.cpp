@@ -2,9 +2,12 @@
 #ifdef USE_API
 #include "api_connection.h"
 #include "esphome/core/application.h"
+#include "esphome/core/helpers.h"
 #include "esphome/core/log.h"
 #include "esphome/core/util.h"
 
+#include <algorithm>
+
 namespace esphome {
 namespace api {
 
@@ -44,6 +47,36 @@ bool ListEntitiesIterator::on_valve(valve::Valve *valve) { return this->client_-
 #endif
 
 bool ListEntitiesIterator::on_end() { return this->client_->send_list_info_done(); }
+
+#ifdef USE_API_ENTITY_CACHE
+EntityCatalog::~EntityCatalog() {
+  // the data is only allocated separately if the building buffer has been released
+  if (this->data_ != nullptr && this->building_.empty())
+    RAMAllocator<uint8_t>().deallocate(this->data_, this->data_size_);
+}
+
+void EntityCatalog::add(uint16_t message_type, const uint8_t *data, size_t length) {
+  this->entries_.push_back(Entry{static_cast<uint32_t>(this->building_.size()), static_cast<uint32_t>(length),
+                                 message_type});
+  this->building_.insert(this->building_.end(), data, data + length);
+}
+
+void EntityCatalog::finish() {
+  this->entries_.shrink_to_fit();
+  this->data_ = RAMAllocator<uint8_t>().allocate(this->building_.size());
+  if (this->data_ == nullptr) {
+    // keep the buffer that was used to build the catalog
+    this->building_.shrink_to_fit();
+    this->data_ = this->building_.data();
+    this->data_size_ = this->building_.size();
+    return;
+  }
+  this->data_size_ = this->building_.size();
+  std::copy(this->building_.begin(), this->building_.end(), this->data_);
+  this->building_ = std::vector<uint8_t>();
+}
+#endif
+
 ListEntitiesIterator::ListEntitiesIterator(APIConnection *client) : client_(client) {}
 bool ListEntitiesIterator::on_service(UserServiceDescriptor *service) {
   auto resp = service->encode_list_service_response();
@@ -4,11 +4,52 @@
 #ifdef USE_API
 #include "esphome/core/component.h"
 #include "esphome/core/component_iterator.h"
+
+#include <vector>
+
 namespace esphome {
 namespace api {
 
 class APIConnection;
 
+#ifdef USE_API_ENTITY_CACHE
+/** The encoded ListEntities response messages of all entities, in the order they are sent to a client.
+ *
+ * Entity metadata doesn't change after setup, so the messages are encoded once and streamed to every client that
+ * lists the entities. The data is placed in PSRAM when available. Once finished, a catalog is never modified; a new
+ * one is built after APIServer::invalidate_entity_catalog().
+ */
+class EntityCatalog {
+ public:
+  struct Entry {
+    uint32_t offset;
+    uint32_t length;
+    uint16_t message_type;
+  };
+
+  EntityCatalog() = default;
+  EntityCatalog(const EntityCatalog &) = delete;
+  EntityCatalog &operator=(const EntityCatalog &) = delete;
+  ~EntityCatalog();
+
+  /// Append an encoded message while building.
+  void add(uint16_t message_type, const uint8_t *data, size_t length);
+  /// Move the messages into a buffer of their exact size, after the last one has been added.
+  void finish();
+
+  size_t size() const { return this->entries_.size(); }
+  size_t get_data_size() const { return this->data_size_; }
+  const Entry &get_entry(size_t index) const { return this->entries_[index]; }
+  const uint8_t *get_data(const Entry &entry) const { return this->data_ + entry.offset; }
+
+ protected:
+  std::vector<Entry> entries_;
+  std::vector<uint8_t> building_;
+  uint8_t *data_{nullptr};
+  size_t data_size_{0};
+};
+#endif
+
 class ListEntitiesIterator : public ComponentIterator {
  public:
   ListEntitiesIterator(APIConnection *client);
@@ -8,78 +8,136 @@ namespace api {
 
 #ifdef USE_BINARY_SENSOR
 bool InitialStateIterator::on_binary_sensor(binary_sensor::BinarySensor *binary_sensor) {
+  if (this->is_filtered_(binary_sensor))
+    return true;
   return this->client_->send_binary_sensor_state(binary_sensor, binary_sensor->state);
 }
 #endif
 #ifdef USE_COVER
-bool InitialStateIterator::on_cover(cover::Cover *cover) { return this->client_->send_cover_state(cover); }
+bool InitialStateIterator::on_cover(cover::Cover *cover) {
+  if (this->is_filtered_(cover))
+    return true;
+  return this->client_->send_cover_state(cover);
+}
 #endif
 #ifdef USE_FAN
-bool InitialStateIterator::on_fan(fan::Fan *fan) { return this->client_->send_fan_state(fan); }
+bool InitialStateIterator::on_fan(fan::Fan *fan) {
+  if (this->is_filtered_(fan))
+    return true;
+  return this->client_->send_fan_state(fan);
+}
 #endif
 #ifdef USE_LIGHT
-bool InitialStateIterator::on_light(light::LightState *light) { return this->client_->send_light_state(light); }
+bool InitialStateIterator::on_light(light::LightState *light) {
+  if (this->is_filtered_(light))
+    return true;
+  return this->client_->send_light_state(light);
+}
 #endif
 #ifdef USE_SENSOR
 bool InitialStateIterator::on_sensor(sensor::Sensor *sensor) {
+  if (this->is_filtered_(sensor))
+    return true;
   return this->client_->send_sensor_state(sensor, sensor->state);
 }
 #endif
 #ifdef USE_SWITCH
 bool InitialStateIterator::on_switch(switch_::Switch *a_switch) {
+  if (this->is_filtered_(a_switch))
+    return true;
   return this->client_->send_switch_state(a_switch, a_switch->state);
 }
 #endif
 #ifdef USE_TEXT_SENSOR
 bool InitialStateIterator::on_text_sensor(text_sensor::TextSensor *text_sensor) {
+  if (this->is_filtered_(text_sensor))
+    return true;
   return this->client_->send_text_sensor_state(text_sensor, text_sensor->state);
 }
 #endif
 #ifdef USE_CLIMATE
-bool InitialStateIterator::on_climate(climate::Climate *climate) { return this->client_->send_climate_state(climate); }
+bool InitialStateIterator::on_climate(climate::Climate *climate) {
+  if (this->is_filtered_(climate))
+    return true;
+  return this->client_->send_climate_state(climate);
+}
 #endif
 #ifdef USE_NUMBER
 bool InitialStateIterator::on_number(number::Number *number) {
+  if (this->is_filtered_(number))
+    return true;
   return this->client_->send_number_state(number, number->state);
 }
 #endif
 #ifdef USE_DATETIME_DATE
-bool InitialStateIterator::on_date(datetime::DateEntity *date) { return this->client_->send_date_state(date); }
+bool InitialStateIterator::on_date(datetime::DateEntity *date) {
+  if (this->is_filtered_(date))
+    return true;
+  return this->client_->send_date_state(date);
+}
 #endif
 #ifdef USE_DATETIME_TIME
-bool InitialStateIterator::on_time(datetime::TimeEntity *time) { return this->client_->send_time_state(time); }
+bool InitialStateIterator::on_time(datetime::TimeEntity *time) {
+  if (this->is_filtered_(time))
+    return true;
+  return this->client_->send_time_state(time);
+}
 #endif
 #ifdef USE_DATETIME_DATETIME
 bool InitialStateIterator::on_datetime(datetime::DateTimeEntity *datetime) {
+  if (this->is_filtered_(datetime))
+    return true;
   return this->client_->send_datetime_state(datetime);
 }
 #endif
 #ifdef USE_TEXT
-bool InitialStateIterator::on_text(text::Text *text) { return this->client_->send_text_state(text, text->state); }
+bool InitialStateIterator::on_text(text::Text *text) {
+  if (this->is_filtered_(text))
+    return true;
+  return this->client_->send_text_state(text, text->state);
+}
 #endif
 #ifdef USE_SELECT
 bool InitialStateIterator::on_select(select::Select *select) {
+  if (this->is_filtered_(select))
+    return true;
   return this->client_->send_select_state(select, select->state);
 }
 #endif
 #ifdef USE_LOCK
-bool InitialStateIterator::on_lock(lock::Lock *a_lock) { return this->client_->send_lock_state(a_lock, a_lock->state); }
+bool InitialStateIterator::on_lock(lock::Lock *a_lock) {
+  if (this->is_filtered_(a_lock))
+    return true;
+  return this->client_->send_lock_state(a_lock, a_lock->state);
+}
 #endif
 #ifdef USE_VALVE
-bool InitialStateIterator::on_valve(valve::Valve *valve) { return this->client_->send_valve_state(valve); }
+bool InitialStateIterator::on_valve(valve::Valve *valve) {
+  if (this->is_filtered_(valve))
+    return true;
+  return this->client_->send_valve_state(valve);
+}
 #endif
 #ifdef USE_MEDIA_PLAYER
 bool InitialStateIterator::on_media_player(media_player::MediaPlayer *media_player) {
+  if (this->is_filtered_(media_player))
+    return true;
   return this->client_->send_media_player_state(media_player);
 }
 #endif
 #ifdef USE_ALARM_CONTROL_PANEL
 bool InitialStateIterator::on_alarm_control_panel(alarm_control_panel::AlarmControlPanel *a_alarm_control_panel) {
+  if (this->is_filtered_(a_alarm_control_panel))
+    return true;
   return this->client_->send_alarm_control_panel_state(a_alarm_control_panel);
 }
 #endif
 #ifdef USE_UPDATE
-bool InitialStateIterator::on_update(update::UpdateEntity *update) { return this->client_->send_update_state(update); }
+bool InitialStateIterator::on_update(update::UpdateEntity *update) {
+  if (this->is_filtered_(update))
+    return true;
+  return this->client_->send_update_state(update);
+}
 #endif
 InitialStateIterator::InitialStateIterator(APIConnection *client) : client_(client) {}
 
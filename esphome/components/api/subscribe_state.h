@@ -5,14 +5,47 @@
 #include "esphome/core/component.h"
 #include "esphome/core/component_iterator.h"
 #include "esphome/core/controller.h"
+#include "esphome/core/entity_base.h"
+
+#include <cstring>
+
 namespace esphome {
 namespace api {
 
 class APIConnection;
 
+/** Set of entity keys, stored as a fixed-size bitmap indexed by the key hash.
+ *
+ * Collisions only mean that an unchanged state is sent again, so no per-entity bookkeeping is needed.
+ */
+class StateChangeBitmap {
+ public:
+  static const uint16_t SIZE = 512;
+
+  void mark(uint32_t key) { this->bits_[(key % SIZE) / 32] |= 1u << (key % 32); }
+  bool test(uint32_t key) const { return this->bits_[(key % SIZE) / 32] & (1u << (key % 32)); }
+  void clear() { memset(this->bits_, 0, sizeof(this->bits_)); }
+  void merge(const StateChangeBitmap &other) {
+    for (size_t i = 0; i < SIZE / 32; i++)
+      this->bits_[i] |= other.bits_[i];
+  }
+  bool any() const {
+    for (auto bits : this->bits_) {
+      if (bits != 0)
+        return true;
+    }
+    return false;
+  }
+
+ protected:
+  uint32_t bits_[SIZE / 32]{};
+};
+
 class InitialStateIterator : public ComponentIterator {
  public:
   InitialStateIterator(APIConnection *client);
+  /// Only send the entities marked in `changed`, or all of them if nullptr.
+  void set_filter(const StateChangeBitmap *changed) { this->filter_ = changed; }
 #ifdef USE_BINARY_SENSOR
   bool on_binary_sensor(binary_sensor::BinarySensor *binary_sensor) override;
 #endif
@@ -77,7 +110,12 @@ class InitialStateIterator : public ComponentIterator {
   bool on_update(update::UpdateEntity *update) override;
 #endif
  protected:
+  bool is_filtered_(EntityBase *entity) const {
+    return this->filter_ != nullptr && !this->filter_->test(entity->get_object_id_hash());
+  }
+
   APIConnection *client_;
+  const StateChangeBitmap *filter_{nullptr};
 };
 
 }  // namespace api
@@ -1,7 +1,9 @@
 #pragma once
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 
 namespace esphome {
 namespace audio {
@@ -17,5 +19,95 @@ struct AudioStreamInfo {
   uint32_t sample_rate = 16000;
 };
 
+// Block kernels for PCM samples. The loops are kept free of branches and calls so the compiler can vectorize them.
+// Samples are saturated instead of wrapping around. Unless noted otherwise, output may be the same buffer as an input.
+
+/// Convert a gain in [0, 1] to a Q15 factor.
+inline int16_t gain_to_q15(float gain) {
+  return static_cast<int16_t>(std::min(std::max(gain, 0.0f), 1.0f) * INT16_MAX + 0.5f);
+}
+
+/// Convert a gain in [0, 1] to a Q31 factor.
+inline int32_t gain_to_q31(float gain) {
+  return static_cast<int32_t>(std::min(std::max(gain, 0.0f), 1.0f) * static_cast<double>(INT32_MAX) + 0.5);
+}
+
+/// Multiply 16 bit samples by a Q15 factor.
+inline void scale_q15(const int16_t *input, int16_t *output, size_t samples, int16_t factor) {
+  for (size_t i = 0; i < samples; i++) {
+    int32_t value = (static_cast<int32_t>(input[i]) * factor) >> 15;
+    output[i] = static_cast<int16_t>(std::min<int32_t>(std::max<int32_t>(value, INT16_MIN), INT16_MAX));
+  }
+}
+
+/// Multiply 32 bit samples by a Q31 factor.
+inline void scale_q31(const int32_t *input, int32_t *output, size_t samples, int32_t factor) {
+  for (size_t i = 0; i < samples; i++) {
+    int64_t value = (static_cast<int64_t>(input[i]) * factor) >> 31;
+    output[i] = static_cast<int32_t>(std::min<int64_t>(std::max<int64_t>(value, INT32_MIN), INT32_MAX));
+  }
+}
+
+/// Add two blocks of 16 bit samples.
+inline void mix_s16(const int16_t *a, const int16_t *b, int16_t *output, size_t samples) {
+  for (size_t i = 0; i < samples; i++) {
+    int32_t value = static_cast<int32_t>(a[i]) + b[i];
+    output[i] = static_cast<int16_t>(std::min<int32_t>(std::max<int32_t>(value, INT16_MIN), INT16_MAX));
+  }
+}
+
+/** Add two blocks of 16 bit samples, each multiplied by a Q15 factor.
+ *
+ * The factors may be negative to invert a block. They are limited to [-INT16_MAX, INT16_MAX], an INT16_MIN factor
+ * is raised to -INT16_MAX, so the sum of both products always fits into 32 bits.
+ */
+inline void mix_q15(const int16_t *a, int16_t factor_a, const int16_t *b, int16_t factor_b, int16_t *output,
+                    size_t samples) {
+  factor_a = std::max<int16_t>(factor_a, -INT16_MAX);
+  factor_b = std::max<int16_t>(factor_b, -INT16_MAX);
+  for (size_t i = 0; i < samples; i++) {
+    int32_t value = (static_cast<int32_t>(a[i]) * factor_a + static_cast<int32_t>(b[i]) * factor_b) >> 15;
+    output[i] = static_cast<int16_t>(std::min<int32_t>(std::max<int32_t>(value, INT16_MIN), INT16_MAX));
+  }
+}
+
+/// Combine two mono blocks of `frames` samples into one stereo block. Output must not overlap the inputs.
+inline void interleave_s16(const int16_t *left, const int16_t *right, int16_t *output, size_t frames) {
+  for (size_t i = 0; i < frames; i++) {
+    output[2 * i] = left[i];
+    output[2 * i + 1] = right[i];
+  }
+}
+
+/// Split a stereo block of `frames` frames into two mono blocks. Outputs must not overlap the input.
+inline void deinterleave_s16(const int16_t *input, int16_t *left, int16_t *right, size_t frames) {
+  for (size_t i = 0; i < frames; i++) {
+    left[i] = input[2 * i];
+    right[i] = input[2 * i + 1];
+  }
+}
+
+/// Widen 16 bit samples to 32 bit samples, in the upper bits. Output must not overlap the input.
+inline void convert_s16_to_s32(const int16_t *input, int32_t *output, size_t samples) {
+  for (size_t i = 0; i < samples; i++)
+    output[i] = static_cast<int32_t>(static_cast<uint32_t>(input[i]) << 16);
+}
+
+/** Narrow 32 bit samples to 16 bit samples.
+ *
+ * @param input Samples in native byte order, the buffer does not have to be aligned for 32 bit access. It may be the
+ * same buffer as `output`, for converting in place.
+ * @param shift Number of bits to shift the samples right by, 16 keeps the upper half. Smaller values amplify.
+ */
+inline void convert_s32_to_s16(const void *input, int16_t *output, size_t samples, uint8_t shift = 16) {
+  const uint8_t *bytes = static_cast<const uint8_t *>(input);
+  for (size_t i = 0; i < samples; i++) {
+    int32_t value;
+    std::memcpy(&value, bytes + i * sizeof(int32_t), sizeof(int32_t));
+    value >>= shift;
+    output[i] = static_cast<int16_t>(std::min<int32_t>(std::max<int32_t>(value, INT16_MIN), INT16_MAX));
+  }
+}
+
 }  // namespace audio
 }  // namespace esphome
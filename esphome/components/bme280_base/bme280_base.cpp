@@ -212,43 +212,50 @@ void BME280Component::update() {
   meas_value |= (this->temperature_oversampling_ & 0b111) << 5;
   meas_value |= (this->pressure_oversampling_ & 0b111) << 2;
   meas_value |= BME280_MODE_FORCED;
-  if (!this->write_byte(BME280_REGISTER_CONTROL, meas_value)) {
-    this->status_set_warning();
-    return;
-  }
 
   float meas_time = 1.5f;
   meas_time += 2.3f * oversampling_to_time(this->temperature_oversampling_);
   meas_time += 2.3f * oversampling_to_time(this->pressure_oversampling_) + 0.575f;
   meas_time += 2.3f * oversampling_to_time(this->humidity_oversampling_) + 0.575f;
 
-  this->set_timeout("data", uint32_t(ceilf(meas_time)), [this]() {
+  this->start_measurement_(meas_value, uint32_t(ceilf(meas_time)));
+}
+void BME280Component::start_measurement_(uint8_t meas_value, uint32_t meas_time) {
+  if (!this->write_byte(BME280_REGISTER_CONTROL, meas_value)) {
+    this->status_set_warning();
+    return;
+  }
+
+  this->set_timeout("data", meas_time, [this]() {
     uint8_t data[8];
     if (!this->read_bytes(BME280_REGISTER_MEASUREMENTS, data, 8)) {
       ESP_LOGW(TAG, "Error reading registers.");
       this->status_set_warning();
       return;
     }
-    int32_t t_fine = 0;
-    float const temperature = this->read_temperature_(data, &t_fine);
-    if (std::isnan(temperature)) {
-      ESP_LOGW(TAG, "Invalid temperature, cannot read pressure & humidity values.");
-      this->status_set_warning();
-      return;
-    }
-    float const pressure = this->read_pressure_(data, t_fine);
-    float const humidity = this->read_humidity_(data, t_fine);
-
-    ESP_LOGV(TAG, "Got temperature=%.1f°C pressure=%.1fhPa humidity=%.1f%%", temperature, pressure, humidity);
-    if (this->temperature_sensor_ != nullptr)
-      this->temperature_sensor_->publish_state(temperature);
-    if (this->pressure_sensor_ != nullptr)
-      this->pressure_sensor_->publish_state(pressure);
-    if (this->humidity_sensor_ != nullptr)
-      this->humidity_sensor_->publish_state(humidity);
-    this->status_clear_warning();
+    this->publish_measurement_(data);
   });
 }
+void BME280Component::publish_measurement_(const uint8_t *data) {
+  int32_t t_fine = 0;
+  float const temperature = this->read_temperature_(data, &t_fine);
+  if (std::isnan(temperature)) {
+    ESP_LOGW(TAG, "Invalid temperature, cannot read pressure & humidity values.");
+    this->status_set_warning();
+    return;
+  }
+  float const pressure = this->read_pressure_(data, t_fine);
+  float const humidity = this->read_humidity_(data, t_fine);
+
+  ESP_LOGV(TAG, "Got temperature=%.1f°C pressure=%.1fhPa humidity=%.1f%%", temperature, pressure, humidity);
+  if (this->temperature_sensor_ != nullptr)
+    this->temperature_sensor_->publish_state(temperature);
+  if (this->pressure_sensor_ != nullptr)
+    this->pressure_sensor_->publish_state(pressure);
+  if (this->humidity_sensor_ != nullptr)
+    this->humidity_sensor_->publish_state(humidity);
+  this->status_clear_warning();
+}
 float BME280Component::read_temperature_(const uint8_t *data, int32_t *t_fine) {
   int32_t adc = ((data[3] & 0xFF) << 16) | ((data[4] & 0xFF) << 8) | (data[5] & 0xFF);
   adc >>= 4;
@@ -287,11 +294,12 @@ float BME280Component::read_pressure_(const uint8_t *data, int32_t t_fine) {
   const int64_t p9 = this->calibration_.p9;
 
   int64_t var1, var2, p;
+  // the calibration values can be negative, so they are scaled by multiplication, a left shift of them is undefined
   var1 = int64_t(t_fine) - 128000;
   var2 = var1 * var1 * p6;
-  var2 = var2 + ((var1 * p5) << 17);
-  var2 = var2 + (p4 << 35);
-  var1 = ((var1 * var1 * p3) >> 8) + ((var1 * p2) << 12);
+  var2 = var2 + var1 * p5 * (int64_t(1) << 17);
+  var2 = var2 + p4 * (int64_t(1) << 35);
+  var1 = ((var1 * var1 * p3) >> 8) + var1 * p2 * (int64_t(1) << 12);
   var1 = ((int64_t(1) << 47) + var1) * p1 >> 33;
 
   if (var1 == 0)
@@ -302,7 +310,7 @@ float BME280Component::read_pressure_(const uint8_t *data, int32_t t_fine) {
   var1 = (p9 * (p >> 13) * (p >> 13)) >> 25;
   var2 = (p8 * p) >> 19;
 
-  p = ((p + var1 + var2) >> 8) + (p7 << 4);
+  p = ((p + var1 + var2) >> 8) + p7 * 16;
   return (p / 256.0f) / 100.0f;
 }
 
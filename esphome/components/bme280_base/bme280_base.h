@@ -80,6 +80,10 @@ class BME280Component : public PollingComponent {
   void update() override;
 
  protected:
+  /// Write the forced mode measurement command, and read the data registers once the measurement is complete.
+  virtual void start_measurement_(uint8_t meas_value, uint32_t meas_time);
+  /// Calculate and publish the values from the data registers 0xF7 - 0xFE.
+  void publish_measurement_(const uint8_t *data);
   /// Read the temperature value and store the calculated ambient temperature in t_fine.
   float read_temperature_(const uint8_t *data, int32_t *t_fine);
   /// Read the pressure value in hPa using the provided t_fine value.
@@ -4,10 +4,14 @@
 #include "bme280_i2c.h"
 #include "esphome/components/i2c/i2c.h"
 #include "../bme280_base/bme280_base.h"
+#include "esphome/core/log.h"
 
 namespace esphome {
 namespace bme280_i2c {
 
+static const uint8_t BME280_REGISTER_CONTROL = 0xF4;
+static const uint8_t BME280_REGISTER_MEASUREMENTS = 0xF7;
+
 bool BME280I2CComponent::read_byte(uint8_t a_register, uint8_t *data) {
   return I2CDevice::read_byte(a_register, data);
 };
@@ -21,6 +25,37 @@ bool BME280I2CComponent::read_byte_16(uint8_t a_register, uint16_t *data) {
   return I2CDevice::read_byte_16(a_register, data);
 };
 
+void BME280I2CComponent::setup() {
+  this->measure_transaction_.set_callback([this](i2c::ErrorCode err) {
+    if (err != i2c::ERROR_OK) {
+      ESP_LOGW(TAG, "Error reading registers.");
+      this->status_set_warning();
+      return;
+    }
+    this->publish_measurement_(this->measure_data_);
+  });
+  BME280Component::setup();
+}
+
+void BME280I2CComponent::start_measurement_(uint8_t meas_value, uint32_t meas_time) {
+  if (this->scheduler_ == nullptr) {
+    BME280Component::start_measurement_(meas_value, meas_time);
+    return;
+  }
+  if (this->measure_transaction_.is_pending()) {
+    ESP_LOGW(TAG, "Previous measurement still in progress");
+    return;
+  }
+  // Start the forced measurement, and read all data registers once it is complete
+  this->measure_command_[0] = BME280_REGISTER_CONTROL;
+  this->measure_command_[1] = meas_value;
+  this->measure_transaction_.clear()
+      .write(this->measure_command_, 2)
+      .delay(meas_time)
+      .read_register(BME280_REGISTER_MEASUREMENTS, this->measure_data_, 8);
+  this->scheduler_->submit(&this->measure_transaction_);
+}
+
 void BME280I2CComponent::dump_config() {
   LOG_I2C_DEVICE(this);
   BME280Component::dump_config();
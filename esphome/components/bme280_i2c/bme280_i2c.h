@@ -2,6 +2,7 @@
 
 #include "esphome/components/bme280_base/bme280_base.h"
 #include "esphome/components/i2c/i2c.h"
+#include "esphome/components/i2c/i2c_scheduler.h"
 
 namespace esphome {
 namespace bme280_i2c {
@@ -9,11 +10,22 @@ namespace bme280_i2c {
 static const char *const TAG = "bme280_i2c.sensor";
 
 class BME280I2CComponent : public esphome::bme280_base::BME280Component, public i2c::I2CDevice {
+ public:
+  void set_i2c_scheduler(i2c::I2CScheduler *scheduler) { this->scheduler_ = scheduler; }
+  void setup() override;
+
+ protected:
   bool read_byte(uint8_t a_register, uint8_t *data) override;
   bool write_byte(uint8_t a_register, uint8_t data) override;
   bool read_bytes(uint8_t a_register, uint8_t *data, size_t len) override;
   bool read_byte_16(uint8_t a_register, uint16_t *data) override;
   void dump_config() override;
+  void start_measurement_(uint8_t meas_value, uint32_t meas_time) override;
+
+  i2c::I2CScheduler *scheduler_{nullptr};
+  i2c::I2CTransaction measure_transaction_{this};
+  uint8_t measure_command_[2];
+  uint8_t measure_data_[8];
 };
 
 }  // namespace bme280_i2c
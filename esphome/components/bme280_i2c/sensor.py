@@ -19,3 +19,4 @@ CONFIG_SCHEMA = CONFIG_SCHEMA_BASE.extend(
 async def to_code(config):
     var = await to_code_base(config)
     await i2c.register_i2c_device(var, config)
+    cg.add(var.set_i2c_scheduler(await i2c.get_scheduler()))
@@ -37,7 +37,11 @@ void CaptivePortal::handle_wifisave(AsyncWebServerRequest *request) {
   request->redirect("/?save");
 }
 
-void CaptivePortal::setup() {}
+void CaptivePortal::setup() {
+  // the loop only serves DNS requests while the portal is active
+  if (!this->active_)
+    this->disable_loop();
+}
 void CaptivePortal::start() {
   this->base_->init();
   if (!this->initialized_) {
@@ -64,6 +68,7 @@ void CaptivePortal::start() {
 
   this->initialized_ = true;
   this->active_ = true;
+  this->enable_loop();
 }
 
 void CaptivePortal::handleRequest(AsyncWebServerRequest *req) {
@@ -30,6 +30,7 @@ class CaptivePortal : public AsyncWebHandler, public Component {
   bool is_active() const { return this->active_; }
   void end() {
     this->active_ = false;
+    this->disable_loop();
     this->base_->deinit();
 #ifdef USE_ARDUINO
     this->dns_server_->stop();
@@ -1,6 +1,7 @@
 #include "debug_component.h"
 
 #include <algorithm>
+#include "esphome/core/application.h"
 #include "esphome/core/log.h"
 #include "esphome/core/hal.h"
 #include "esphome/core/helpers.h"
@@ -84,9 +85,36 @@ void DebugComponent::update() {
   }
 
 #endif  // USE_SENSOR
+#ifdef USE_RUNTIME_STATS
+  this->log_runtime_stats_();
+#endif
   update_platform_();
 }
 
+#ifdef USE_RUNTIME_STATS
+void DebugComponent::log_runtime_stats_() {
+  static const size_t MAX_LOGGED = 10;
+  auto snapshot = App.runtime_stats.snapshot();
+  auto &entries = snapshot.entries;
+  size_t logged = std::min(entries.size(), MAX_LOGGED);
+  std::partial_sort(entries.begin(), entries.begin() + logged, entries.end(),
+                    [](const RuntimeStatsEntry &a, const RuntimeStatsEntry &b) { return a.total_us > b.total_us; });
+
+  ESP_LOGD(TAG, "Runtime stats, top %zu by total time:", logged);
+  for (size_t i = 0; i < logged; i++) {
+    const auto &entry = entries[i];
+    ESP_LOGD(TAG,
+             "  %s %s: calls=%" PRIu32 " min=%" PRIu32 "us avg=%" PRIu32 "us p99=%" PRIu32 "us max=%" PRIu32
+             "us total=%" PRIu32 "ms",
+             entry.component->get_component_source(), runtime_stats_kind_to_string(entry.kind), entry.count,
+             entry.min_us, entry.average_us(), entry.percentile_us(99), entry.max_us,
+             (uint32_t) (entry.total_us / 1000));
+  }
+  if (snapshot.dropped != 0)
+    ESP_LOGD(TAG, "  %" PRIu32 " calls not recorded, stats table is full", snapshot.dropped);
+}
+#endif  // USE_RUNTIME_STATS
+
 float DebugComponent::get_setup_priority() const { return setup_priority::LATE; }
 
 }  // namespace debug
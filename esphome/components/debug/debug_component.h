@@ -60,6 +60,10 @@ class DebugComponent : public PollingComponent {
   text_sensor::TextSensor *reset_reason_{nullptr};
 #endif  // USE_TEXT_SENSOR
 
+#ifdef USE_RUNTIME_STATS
+  void log_runtime_stats_();
+#endif
+
   std::string get_reset_reason_();
   uint32_t get_free_heap_();
   void get_device_info_(std::string &device_info);
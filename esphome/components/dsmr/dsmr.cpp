@@ -42,9 +42,7 @@ bool Dsmr::ready_to_request_data_() {
       this->start_requesting_data_();
     }
     if (!this->requesting_data_) {
-      while (this->available()) {
-        this->read();
-      }
+      this->drain_rx_();
     }
   }
   return this->requesting_data_;
@@ -60,6 +58,9 @@ bool Dsmr::request_interval_reached_() {
 bool Dsmr::receive_timeout_reached_() { return millis() - this->last_read_time_ > this->receive_timeout_; }
 
 bool Dsmr::available_within_timeout_() {
+  // Bytes left over from the previous chunk come first.
+  if (this->read_pos_ < this->read_len_)
+    return true;
   // Data are available for reading on the UART bus?
   // Then we can start reading right away.
   if (this->available()) {
@@ -117,13 +118,25 @@ void Dsmr::stop_requesting_data_() {
     } else {
       ESP_LOGV(TAG, "Stop reading data from P1 port");
     }
-    while (this->available()) {
-      this->read();
-    }
+    this->drain_rx_();
     this->requesting_data_ = false;
   }
 }
 
+void Dsmr::drain_rx_() {
+  this->read_pos_ = 0;
+  this->read_len_ = 0;
+  while (this->read_available(this->read_buf_, sizeof(this->read_buf_)) > 0) {
+  }
+}
+
+void Dsmr::fill_read_buf_() {
+  if (this->read_pos_ < this->read_len_)
+    return;
+  this->read_pos_ = 0;
+  this->read_len_ = this->read_available(this->read_buf_, sizeof(this->read_buf_));
+}
+
 void Dsmr::reset_telegram_() {
   this->header_found_ = false;
   this->footer_found_ = false;
@@ -131,124 +144,215 @@ void Dsmr::reset_telegram_() {
   this->crypt_bytes_read_ = 0;
   this->crypt_telegram_len_ = 0;
   this->last_read_time_ = 0;
+  this->data_ = MyData();
+  this->line_start_ = 0;
+  this->crc_end_ = 0;
+  this->footer_pos_ = 0;
+  this->crc_ = 0;
+  this->parse_error_ = false;
 }
 
 void Dsmr::receive_telegram_() {
   while (this->available_within_timeout_()) {
-    const char c = this->read();
-
-    // Find a new telegram header, i.e. forward slash.
-    if (c == '/') {
-      ESP_LOGV(TAG, "Header of telegram found");
-      this->reset_telegram_();
-      this->header_found_ = true;
+    this->fill_read_buf_();
+    while (this->read_pos_ < this->read_len_) {
+      // The rest of the chunk may already belong to the next telegram, keep it for the next call
+      if (this->receive_byte_(this->read_buf_[this->read_pos_++]))
+        return;
     }
-    if (!this->header_found_)
-      continue;
+  }
+}
+
+bool Dsmr::receive_byte_(char c) {
+  // Find a new telegram header, i.e. forward slash.
+  if (c == '/') {
+    ESP_LOGV(TAG, "Header of telegram found");
+    this->reset_telegram_();
+    this->header_found_ = true;
+  }
+  if (!this->header_found_)
+    return false;
+
+  // Check for buffer overflow.
+  if (this->bytes_read_ >= this->max_telegram_len_) {
+    this->reset_telegram_();
+    ESP_LOGE(TAG, "Error: telegram larger than buffer (%d bytes)", this->max_telegram_len_);
+    return true;
+  }
 
-    // Check for buffer overflow.
-    if (this->bytes_read_ >= this->max_telegram_len_) {
+  if (this->footer_found_) {
+    // Store the hex checksum, and check for its end, i.e. a newline.
+    this->telegram_[this->bytes_read_++] = c;
+    if (c == '\n') {
+      this->finish_telegram_();
       this->reset_telegram_();
-      ESP_LOGE(TAG, "Error: telegram larger than buffer (%d bytes)", this->max_telegram_len_);
-      return;
+      return true;
     }
+    return false;
+  }
 
-    // Some v2.2 or v3 meters will send a new value which starts with '('
-    // in a new line, while the value belongs to the previous ObisId. For
-    // proper parsing, remove these new line characters.
-    if (c == '(') {
-      while (true) {
-        auto previous_char = this->telegram_[this->bytes_read_ - 1];
-        if (previous_char == '\n' || previous_char == '\r') {
-          this->bytes_read_--;
-        } else {
-          break;
-        }
+  // Some v2.2 or v3 meters will send a new value which starts with '('
+  // in a new line, while the value belongs to the previous ObisId. For
+  // proper parsing, remove these new line characters.
+  if (c == '(') {
+    while (this->bytes_read_ > this->line_start_) {
+      auto previous_char = this->telegram_[this->bytes_read_ - 1];
+      if (previous_char == '\n' || previous_char == '\r') {
+        this->bytes_read_--;
+      } else {
+        break;
       }
     }
+  }
 
-    // Store the byte in the buffer.
-    this->telegram_[this->bytes_read_] = c;
-    this->bytes_read_++;
+  // The previous line is complete once the next line starts with anything but a value continuation.
+  if (c != '\n' && c != '\r' && c != '(' && this->bytes_read_ > this->line_start_) {
+    auto previous_char = this->telegram_[this->bytes_read_ - 1];
+    if (previous_char == '\n' || previous_char == '\r') {
+      this->parse_line_(this->telegram_ + this->line_start_, this->telegram_ + this->bytes_read_);
+      this->update_crc_(this->bytes_read_);
+      this->line_start_ = this->bytes_read_;
+    }
+  }
 
-    // Check for a footer, i.e. exclamation mark, followed by a hex checksum.
-    if (c == '!') {
-      ESP_LOGV(TAG, "Footer of telegram found");
-      this->footer_found_ = true;
-      continue;
+  // Store the byte in the buffer.
+  this->telegram_[this->bytes_read_++] = c;
+
+  // Check for a footer, i.e. exclamation mark, followed by a hex checksum.
+  if (c == '!') {
+    ESP_LOGV(TAG, "Footer of telegram found");
+    this->footer_found_ = true;
+    this->footer_pos_ = this->bytes_read_ - 1;
+    if (this->line_start_ != this->footer_pos_ && !this->parse_error_) {
+      ESP_LOGE(TAG, "Last data line of telegram not CRLF terminated");
+      this->parse_error_ = true;
     }
-    // Check for the end of the hex checksum, i.e. a newline.
-    if (this->footer_found_ && c == '\n') {
-      // Parse the telegram and publish sensor values.
-      this->parse_telegram();
-      this->reset_telegram_();
+    this->update_crc_(this->bytes_read_);
+  }
+  return false;
+}
+
+void Dsmr::parse_line_(const char *start, const char *end) {
+  if (this->parse_error_)
+    return;
+  while (end > start && (end[-1] == '\n' || end[-1] == '\r'))
+    end--;
+
+  ::dsmr::ParseResult<void> res;
+  if (start == this->telegram_) {
+    // The identification line, offered for processing using the all-ones Obis ID like the P1Parser does
+    start++;  // skip the '/'
+    res = this->data_.parse_line(::dsmr::ObisId(255, 255, 255, 255, 255, 255), start, end);
+  } else {
+    res = ::dsmr::P1Parser::parse_line(&this->data_, start, end, false);
+  }
+  if (res.err) {
+    auto err_str = res.fullError(start, end);
+    ESP_LOGE(TAG, "%s", err_str.c_str());
+    this->parse_error_ = true;
+  }
+}
+
+void Dsmr::update_crc_(size_t end) {
+  if (this->crc_check_) {
+    this->crc_ = crc16(reinterpret_cast<const uint8_t *>(this->telegram_ + this->crc_end_), end - this->crc_end_,
+                       this->crc_, 0xA001);
+  }
+  this->crc_end_ = end;
+}
+
+void Dsmr::finish_telegram_() {
+  this->stop_requesting_data_();
+  if (this->parse_error_)
+    return;
+
+  if (this->crc_check_) {
+    uint8_t crc_bytes[2];
+    if (parse_hex(this->telegram_ + this->footer_pos_ + 1, this->bytes_read_ - this->footer_pos_ - 1, crc_bytes, 2) !=
+        4) {
+      ESP_LOGE(TAG, "Invalid checksum in telegram");
+      return;
+    }
+    if (encode_uint16(crc_bytes[0], crc_bytes[1]) != this->crc_) {
+      ESP_LOGE(TAG, "Checksum mismatch in telegram");
       return;
     }
   }
+
+  this->status_clear_warning();
+  this->publish_sensors(this->data_);
+
+  // publish the telegram, after publishing the sensors so it can also trigger action based on latest values
+  if (this->s_telegram_ != nullptr) {
+    this->s_telegram_->publish_state(std::string(this->telegram_, this->bytes_read_));
+  }
 }
 
 void Dsmr::receive_encrypted_telegram_() {
   while (this->available_within_timeout_()) {
-    const char c = this->read();
-
-    // Find a new telegram start byte.
-    if (!this->header_found_) {
-      if ((uint8_t) c != 0xDB) {
-        continue;
+    this->fill_read_buf_();
+    while (this->read_pos_ < this->read_len_) {
+      const char c = this->read_buf_[this->read_pos_++];
+
+      // Find a new telegram start byte.
+      if (!this->header_found_) {
+        if ((uint8_t) c != 0xDB) {
+          continue;
+        }
+        ESP_LOGV(TAG, "Start byte 0xDB of encrypted telegram found");
+        this->reset_telegram_();
+        this->header_found_ = true;
       }
-      ESP_LOGV(TAG, "Start byte 0xDB of encrypted telegram found");
-      this->reset_telegram_();
-      this->header_found_ = true;
-    }
 
-    // Check for buffer overflow.
-    if (this->crypt_bytes_read_ >= this->max_telegram_len_) {
-      this->reset_telegram_();
-      ESP_LOGE(TAG, "Error: encrypted telegram larger than buffer (%d bytes)", this->max_telegram_len_);
-      return;
-    }
+      // Check for buffer overflow.
+      if (this->crypt_bytes_read_ >= this->max_telegram_len_) {
+        this->reset_telegram_();
+        ESP_LOGE(TAG, "Error: encrypted telegram larger than buffer (%d bytes)", this->max_telegram_len_);
+        return;
+      }
 
-    // Store the byte in the buffer.
-    this->crypt_telegram_[this->crypt_bytes_read_] = c;
-    this->crypt_bytes_read_++;
+      // Store the byte in the buffer.
+      this->crypt_telegram_[this->crypt_bytes_read_] = c;
+      this->crypt_bytes_read_++;
 
-    // Read the length of the incoming encrypted telegram.
-    if (this->crypt_telegram_len_ == 0 && this->crypt_bytes_read_ > 20) {
-      // Complete header + data bytes
-      this->crypt_telegram_len_ = 13 + (this->crypt_telegram_[11] << 8 | this->crypt_telegram_[12]);
-      ESP_LOGV(TAG, "Encrypted telegram length: %d bytes", this->crypt_telegram_len_);
-    }
+      // Read the length of the incoming encrypted telegram.
+      if (this->crypt_telegram_len_ == 0 && this->crypt_bytes_read_ > 20) {
+        // Complete header + data bytes
+        this->crypt_telegram_len_ = 13 + (this->crypt_telegram_[11] << 8 | this->crypt_telegram_[12]);
+        ESP_LOGV(TAG, "Encrypted telegram length: %d bytes", this->crypt_telegram_len_);
+      }
 
-    // Check for the end of the encrypted telegram.
-    if (this->crypt_telegram_len_ == 0 || this->crypt_bytes_read_ != this->crypt_telegram_len_) {
-      continue;
+      // Check for the end of the encrypted telegram.
+      if (this->crypt_telegram_len_ == 0 || this->crypt_bytes_read_ != this->crypt_telegram_len_) {
+        continue;
+      }
+      ESP_LOGV(TAG, "End of encrypted telegram found");
+
+      // Decrypt the encrypted telegram.
+      GCM<AES128> *gcmaes128{new GCM<AES128>()};
+      gcmaes128->setKey(this->decryption_key_.data(), gcmaes128->keySize());
+      // the iv is 8 bytes of the system title + 4 bytes frame counter
+      // system title is at byte 2 and frame counter at byte 15
+      for (int i = 10; i < 14; i++)
+        this->crypt_telegram_[i] = this->crypt_telegram_[i + 4];
+      constexpr uint16_t iv_size{12};
+      gcmaes128->setIV(&this->crypt_telegram_[2], iv_size);
+      gcmaes128->decrypt(reinterpret_cast<uint8_t *>(this->telegram_),
+                         // the ciphertext start at byte 18
+                         &this->crypt_telegram_[18],
+                         // cipher size
+                         this->crypt_bytes_read_ - 17);
+      delete gcmaes128;  // NOLINT(cppcoreguidelines-owning-memory)
+
+      this->bytes_read_ = strnlen(this->telegram_, this->max_telegram_len_);
+      ESP_LOGV(TAG, "Decrypted telegram size: %d bytes", this->bytes_read_);
+      ESP_LOGVV(TAG, "Decrypted telegram: %s", this->telegram_);
+
+      // Parse the decrypted telegram and publish sensor values.
+      this->parse_telegram();
+      this->reset_telegram_();
+      return;
     }
-    ESP_LOGV(TAG, "End of encrypted telegram found");
-
-    // Decrypt the encrypted telegram.
-    GCM<AES128> *gcmaes128{new GCM<AES128>()};
-    gcmaes128->setKey(this->decryption_key_.data(), gcmaes128->keySize());
-    // the iv is 8 bytes of the system title + 4 bytes frame counter
-    // system title is at byte 2 and frame counter at byte 15
-    for (int i = 10; i < 14; i++)
-      this->crypt_telegram_[i] = this->crypt_telegram_[i + 4];
-    constexpr uint16_t iv_size{12};
-    gcmaes128->setIV(&this->crypt_telegram_[2], iv_size);
-    gcmaes128->decrypt(reinterpret_cast<uint8_t *>(this->telegram_),
-                       // the ciphertext start at byte 18
-                       &this->crypt_telegram_[18],
-                       // cipher size
-                       this->crypt_bytes_read_ - 17);
-    delete gcmaes128;  // NOLINT(cppcoreguidelines-owning-memory)
-
-    this->bytes_read_ = strnlen(this->telegram_, this->max_telegram_len_);
-    ESP_LOGV(TAG, "Decrypted telegram size: %d bytes", this->bytes_read_);
-    ESP_LOGVV(TAG, "Decrypted telegram: %s", this->telegram_);
-
-    // Parse the decrypted telegram and publish sensor values.
-    this->parse_telegram();
-    this->reset_telegram_();
-    return;
   }
 }
 
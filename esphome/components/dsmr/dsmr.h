@@ -92,6 +92,19 @@ class Dsmr : public Component, public uart::UARTDevice {
   void receive_telegram_();
   void receive_encrypted_telegram_();
   void reset_telegram_();
+  /// Discard all data in the UART receive buffer.
+  void drain_rx_();
+  /// Read the next chunk from the UART once all bytes of the previous one have been handled.
+  void fill_read_buf_();
+
+  /// Handle one byte of an unencrypted telegram, returns true when the telegram is complete or was dropped.
+  bool receive_byte_(char c);
+  /// Parse a complete line of the telegram into data_ as soon as it has been received.
+  void parse_line_(const char *start, const char *end);
+  /// Include all received bytes up to `end` in the running telegram checksum.
+  void update_crc_(size_t end);
+  /// Validate the checksum of a completely received telegram and publish its values.
+  void finish_telegram_();
 
   /// Wait for UART data to become available within the read timeout.
   ///
@@ -126,6 +139,18 @@ class Dsmr : public Component, public uart::UARTDevice {
   uint32_t last_read_time_{0};
   bool header_found_{false};
   bool footer_found_{false};
+  // Bytes read from the UART at once, kept across calls when a telegram ends within a chunk
+  uint8_t read_buf_[64];
+  uint8_t read_pos_{0};
+  uint8_t read_len_{0};
+
+  // Incremental parsing of unencrypted telegrams
+  MyData data_;
+  size_t line_start_{0};
+  size_t crc_end_{0};
+  size_t footer_pos_{0};
+  uint16_t crc_{0};
+  bool parse_error_{false};
 
   // handled outside dsmr
   text_sensor::TextSensor *s_telegram_{nullptr};
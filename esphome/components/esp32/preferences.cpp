@@ -7,69 +7,79 @@
 #include <cstring>
 #include <cinttypes>
 #include <vector>
-#include <string>
+#include <cstdio>
 
 namespace esphome {
 namespace esp32 {
 
 static const char *const TAG = "esp32.preferences";
 
-struct NVSData {
-  std::string key;
-  std::vector<uint8_t> data;
-};
+static const size_t KEY_BUFFER_SIZE = 11;
+
+class ESP32PreferenceBackend;
 
-static std::vector<NVSData> s_pending_save;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+// Backends with a value that hasn't been written to flash yet.
+static std::vector<ESP32PreferenceBackend *> s_pending_save;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+static ESPPreferencesStats s_stats;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
 
 class ESP32PreferenceBackend : public ESPPreferenceBackend {
  public:
-  std::string key;
+  uint32_t key;
   uint32_t nvs_handle;
+  /// The value waiting to be written, only set while dirty.
+  std::vector<uint8_t> data;
+  /// CRC of the value in flash, only valid if flash_known is set.
+  uint16_t flash_crc{0};
+  bool flash_known{false};
+  bool dirty{false};
+
+  void format_key(char *buffer) { snprintf(buffer, KEY_BUFFER_SIZE, "%" PRIu32, this->key); }
+
   bool save(const uint8_t *data, size_t len) override {
-    // try find in pending saves and update that
-    for (auto &obj : s_pending_save) {
-      if (obj.key == key) {
-        obj.data.assign(data, data + len);
-        return true;
-      }
+    s_stats.saves++;
+    if (this->dirty && this->data.size() == len && memcmp(this->data.data(), data, len) == 0) {
+      s_stats.unchanged++;
+      return true;
+    }
+    this->data.assign(data, data + len);
+    if (!this->dirty) {
+      this->dirty = true;
+      s_pending_save.push_back(this);
     }
-    NVSData save{};
-    save.key = key;
-    save.data.assign(data, data + len);
-    s_pending_save.emplace_back(save);
-    ESP_LOGVV(TAG, "s_pending_save: key: %s, len: %d", key.c_str(), len);
+    ESP_LOGVV(TAG, "s_pending_save: key: %" PRIu32 ", len: %d", this->key, len);
     return true;
   }
   bool load(uint8_t *data, size_t len) override {
-    // try find in pending saves and load from that
-    for (auto &obj : s_pending_save) {
-      if (obj.key == key) {
-        if (obj.data.size() != len) {
-          // size mismatch
-          return false;
-        }
-        memcpy(data, obj.data.data(), len);
-        return true;
+    if (this->dirty) {
+      if (this->data.size() != len) {
+        // size mismatch
+        return false;
       }
+      memcpy(data, this->data.data(), len);
+      return true;
     }
 
+    char key[KEY_BUFFER_SIZE];
+    this->format_key(key);
     size_t actual_len;
-    esp_err_t err = nvs_get_blob(nvs_handle, key.c_str(), nullptr, &actual_len);
+    esp_err_t err = nvs_get_blob(nvs_handle, key, nullptr, &actual_len);
     if (err != 0) {
-      ESP_LOGV(TAG, "nvs_get_blob('%s'): %s - the key might not be set yet", key.c_str(), esp_err_to_name(err));
+      ESP_LOGV(TAG, "nvs_get_blob('%s'): %s - the key might not be set yet", key, esp_err_to_name(err));
       return false;
     }
     if (actual_len != len) {
       ESP_LOGVV(TAG, "NVS length does not match (%u!=%u)", actual_len, len);
       return false;
     }
-    err = nvs_get_blob(nvs_handle, key.c_str(), data, &len);
+    err = nvs_get_blob(nvs_handle, key, data, &len);
     if (err != 0) {
-      ESP_LOGV(TAG, "nvs_get_blob('%s') failed: %s", key.c_str(), esp_err_to_name(err));
+      ESP_LOGV(TAG, "nvs_get_blob('%s') failed: %s", key, esp_err_to_name(err));
       return false;
     } else {
-      ESP_LOGVV(TAG, "nvs_get_blob: key: %s, len: %d", key.c_str(), len);
+      ESP_LOGVV(TAG, "nvs_get_blob: key: %s, len: %d", key, len);
     }
+    this->flash_crc = crc16(data, len);
+    this->flash_known = true;
     return true;
   }
 };
@@ -98,11 +108,15 @@ class ESP32Preferences : public ESPPreferences {
     return make_preference(length, type);
   }
   ESPPreferenceObject make_preference(size_t length, uint32_t type) override {
+    // Share one backend per key so that pending values and the flash state are tracked in one place
+    for (auto *pref : this->prefs_) {
+      if (pref->key == type)
+        return ESPPreferenceObject(pref);
+    }
     auto *pref = new ESP32PreferenceBackend();  // NOLINT(cppcoreguidelines-owning-memory)
     pref->nvs_handle = nvs_handle;
-
-    uint32_t keyval = type;
-    pref->key = str_sprintf("%" PRIu32, keyval);
+    pref->key = type;
+    this->prefs_.push_back(pref);
 
     return ESPPreferenceObject(pref);
   }
@@ -115,36 +129,48 @@ class ESP32Preferences : public ESPPreferences {
     // goal try write all pending saves even if one fails
     int cached = 0, written = 0, failed = 0;
     esp_err_t last_err = ESP_OK;
-    std::string last_key{};
+    uint32_t last_key = 0;
 
     // go through vector from back to front (makes erase easier/more efficient)
     for (ssize_t i = s_pending_save.size() - 1; i >= 0; i--) {
-      const auto &save = s_pending_save[i];
-      ESP_LOGVV(TAG, "Checking if NVS data %s has changed", save.key.c_str());
-      if (is_changed(nvs_handle, save)) {
-        esp_err_t err = nvs_set_blob(nvs_handle, save.key.c_str(), save.data.data(), save.data.size());
-        ESP_LOGV(TAG, "sync: key: %s, len: %d", save.key.c_str(), save.data.size());
+      auto *pref = s_pending_save[i];
+      char key[KEY_BUFFER_SIZE];
+      pref->format_key(key);
+      uint16_t crc = crc16(pref->data.data(), pref->data.size());
+      // A different CRC means the value changed for sure, only read back from flash if we can't tell
+      ESP_LOGVV(TAG, "Checking if NVS data %s has changed", key);
+      if ((pref->flash_known && pref->flash_crc != crc) || is_changed(nvs_handle, key, pref->data)) {
+        esp_err_t err = nvs_set_blob(nvs_handle, key, pref->data.data(), pref->data.size());
+        ESP_LOGV(TAG, "sync: key: %s, len: %d", key, pref->data.size());
         if (err != 0) {
-          ESP_LOGV(TAG, "nvs_set_blob('%s', len=%u) failed: %s", save.key.c_str(), save.data.size(),
-                   esp_err_to_name(err));
+          ESP_LOGV(TAG, "nvs_set_blob('%s', len=%u) failed: %s", key, pref->data.size(), esp_err_to_name(err));
           failed++;
           last_err = err;
-          last_key = save.key;
+          last_key = pref->key;
           continue;
         }
         written++;
+        s_stats.writes++;
+        s_stats.bytes_written += pref->data.size();
       } else {
-        ESP_LOGV(TAG, "NVS data not changed skipping %s  len=%u", save.key.c_str(), save.data.size());
+        ESP_LOGV(TAG, "NVS data not changed skipping %s  len=%u", key, pref->data.size());
+        // Not counted as unchanged: save() already counted the call, this only skips the flash write
         cached++;
       }
+      pref->flash_crc = crc;
+      pref->flash_known = true;
+      pref->dirty = false;
+      pref->data.clear();
       s_pending_save.erase(s_pending_save.begin() + i);
     }
     ESP_LOGD(TAG, "Saving %d preferences to flash: %d cached, %d written, %d failed", cached + written + failed, cached,
              written, failed);
     if (failed > 0) {
-      ESP_LOGE(TAG, "Error saving %d preferences to flash. Last error=%s for key=%s", failed, esp_err_to_name(last_err),
-               last_key.c_str());
+      ESP_LOGE(TAG, "Error saving %d preferences to flash. Last error=%s for key=%" PRIu32, failed,
+               esp_err_to_name(last_err), last_key);
     }
+    if (written > 0)
+      s_stats.commits++;
 
     // note: commit on esp-idf currently is a no-op, nvs_set_blob always writes
     esp_err_t err = nvs_commit(nvs_handle);
@@ -155,26 +181,33 @@ class ESP32Preferences : public ESPPreferences {
 
     return failed == 0;
   }
-  bool is_changed(const uint32_t nvs_handle, const NVSData &to_save) {
-    NVSData stored_data{};
+  bool is_changed(const uint32_t nvs_handle, const char *key, const std::vector<uint8_t> &to_save) {
     size_t actual_len;
-    esp_err_t err = nvs_get_blob(nvs_handle, to_save.key.c_str(), nullptr, &actual_len);
+    esp_err_t err = nvs_get_blob(nvs_handle, key, nullptr, &actual_len);
     if (err != 0) {
-      ESP_LOGV(TAG, "nvs_get_blob('%s'): %s - the key might not be set yet", to_save.key.c_str(), esp_err_to_name(err));
+      ESP_LOGV(TAG, "nvs_get_blob('%s'): %s - the key might not be set yet", key, esp_err_to_name(err));
       return true;
     }
-    stored_data.data.resize(actual_len);
-    err = nvs_get_blob(nvs_handle, to_save.key.c_str(), stored_data.data.data(), &actual_len);
+    if (actual_len != to_save.size())
+      return true;
+    std::vector<uint8_t> stored_data(actual_len);
+    err = nvs_get_blob(nvs_handle, key, stored_data.data(), &actual_len);
     if (err != 0) {
-      ESP_LOGV(TAG, "nvs_get_blob('%s') failed: %s", to_save.key.c_str(), esp_err_to_name(err));
+      ESP_LOGV(TAG, "nvs_get_blob('%s') failed: %s", key, esp_err_to_name(err));
       return true;
     }
-    return to_save.data != stored_data.data;
+    return to_save != stored_data;
   }
 
   bool reset() override {
     ESP_LOGD(TAG, "Cleaning up preferences in flash...");
+    for (auto *pref : s_pending_save) {
+      pref->dirty = false;
+      pref->data.clear();
+    }
     s_pending_save.clear();
+    for (auto *pref : this->prefs_)
+      pref->flash_known = false;
 
     nvs_flash_deinit();
     nvs_flash_erase();
@@ -182,6 +215,11 @@ class ESP32Preferences : public ESPPreferences {
     nvs_handle = 0;
     return true;
   }
+
+  ESPPreferencesStats get_stats() override { return s_stats; }
+
+ protected:
+  std::vector<ESP32PreferenceBackend *> prefs_;
 };
 
 void setup_preferences() {
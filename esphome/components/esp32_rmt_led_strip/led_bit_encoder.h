@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace esphome {
+namespace esp32_rmt_led_strip {
+
+/** Expands LED data into one RMT symbol per bit, most significant bit first, followed by an optional reset symbol.
+ *
+ * The symbols are produced in chunks of any size, so the whole strip never has to be expanded at once. A symbol has
+ * the layout of rmt_item32_t / rmt_symbol_word_t, but nothing here depends on the RMT driver.
+ */
+class LEDBitEncoder {
+ public:
+  void set_symbols(uint32_t bit0, uint32_t bit1, uint32_t reset) {
+    this->bit0_ = bit0;
+    this->bit_diff_ = bit0 ^ bit1;
+    this->reset_ = reset;
+  }
+
+  /** Encode as many complete bytes of `src` as fit into `max_symbols` symbols.
+   *
+   * The reset symbol is added after the last byte, so the final chunk is kept short by one byte if the reset symbol
+   * would not fit. With room for a single byte only, the reset symbol is left out.
+   *
+   * @param num_symbols Set to the number of symbols written to `dest`.
+   * @return The number of bytes of `src` that were encoded.
+   */
+  size_t encode(const uint8_t *src, size_t len, uint32_t *dest, size_t max_symbols, size_t *num_symbols) const {
+    size_t bytes = max_symbols / 8;
+    bool reset = false;
+    if (bytes >= len) {
+      bytes = len;
+      if (this->reset_ != 0) {
+        if (bytes * 8 < max_symbols) {
+          reset = true;
+        } else if (bytes > 1) {
+          bytes--;
+        }
+      }
+    }
+    for (size_t i = 0; i != bytes; i++) {
+      uint8_t b = src[i];
+      // select bit1 or bit0 without a branch
+      for (int bit = 7; bit >= 0; bit--)
+        *dest++ = this->bit0_ ^ (this->bit_diff_ & -static_cast<uint32_t>((b >> bit) & 1));
+    }
+    if (reset)
+      *dest = this->reset_;
+    *num_symbols = bytes * 8 + reset;
+    return bytes;
+  }
+
+ protected:
+  uint32_t bit0_{0};
+  uint32_t bit_diff_{0};
+  uint32_t reset_{0};
+};
+
+}  // namespace esp32_rmt_led_strip
+}  // namespace esphome
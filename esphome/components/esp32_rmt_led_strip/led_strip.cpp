@@ -13,6 +13,110 @@ namespace esp32_rmt_led_strip {
 
 static const char *const TAG = "esp32_rmt_led_strip";
 
+#if ESP_IDF_VERSION_MAJOR >= 5
+/// Encoder for the LED data followed by the reset symbol, the bits are expanded into the channel memory by the bytes
+/// encoder as it is transmitted.
+struct LEDStripEncoder {
+  rmt_encoder_t base;
+  rmt_encoder_handle_t bytes_encoder;
+  rmt_encoder_handle_t copy_encoder;
+  rmt_symbol_word_t reset;
+  int state;
+};
+
+static size_t IRAM_ATTR led_strip_encode(rmt_encoder_t *encoder, rmt_channel_handle_t channel,
+                                         const void *primary_data, size_t data_size, rmt_encode_state_t *ret_state) {
+  auto *led_encoder = __containerof(encoder, LEDStripEncoder, base);
+  rmt_encode_state_t session_state = RMT_ENCODING_RESET;
+  int state = RMT_ENCODING_RESET;
+  size_t encoded_symbols = 0;
+  if (led_encoder->state == 0) {
+    encoded_symbols += led_encoder->bytes_encoder->encode(led_encoder->bytes_encoder, channel, primary_data,
+                                                          data_size, &session_state);
+    if (session_state & RMT_ENCODING_COMPLETE)
+      led_encoder->state = led_encoder->reset.duration0 > 0 || led_encoder->reset.duration1 > 0 ? 1 : 2;
+    if (session_state & RMT_ENCODING_MEM_FULL) {
+      *ret_state = rmt_encode_state_t(state | RMT_ENCODING_MEM_FULL);
+      return encoded_symbols;
+    }
+  }
+  if (led_encoder->state == 1) {
+    encoded_symbols += led_encoder->copy_encoder->encode(led_encoder->copy_encoder, channel, &led_encoder->reset,
+                                                         sizeof(led_encoder->reset), &session_state);
+    if (session_state & RMT_ENCODING_COMPLETE)
+      led_encoder->state = 2;
+    if (session_state & RMT_ENCODING_MEM_FULL)
+      state |= RMT_ENCODING_MEM_FULL;
+  }
+  if (led_encoder->state == 2) {
+    led_encoder->state = 0;
+    state |= RMT_ENCODING_COMPLETE;
+  }
+  *ret_state = rmt_encode_state_t(state);
+  return encoded_symbols;
+}
+
+static esp_err_t led_strip_encoder_reset(rmt_encoder_t *encoder) {
+  auto *led_encoder = __containerof(encoder, LEDStripEncoder, base);
+  rmt_encoder_reset(led_encoder->bytes_encoder);
+  rmt_encoder_reset(led_encoder->copy_encoder);
+  led_encoder->state = 0;
+  return ESP_OK;
+}
+
+static esp_err_t led_strip_encoder_del(rmt_encoder_t *encoder) {
+  auto *led_encoder = __containerof(encoder, LEDStripEncoder, base);
+  rmt_del_encoder(led_encoder->bytes_encoder);
+  rmt_del_encoder(led_encoder->copy_encoder);
+  delete led_encoder;  // NOLINT(cppcoreguidelines-owning-memory)
+  return ESP_OK;
+}
+
+static esp_err_t new_led_strip_encoder(rmt_symbol_word_t bit0, rmt_symbol_word_t bit1, rmt_symbol_word_t reset,
+                                       rmt_encoder_handle_t *ret_encoder) {
+  auto *led_encoder = new LEDStripEncoder();  // NOLINT(cppcoreguidelines-owning-memory)
+  led_encoder->base.encode = led_strip_encode;
+  led_encoder->base.reset = led_strip_encoder_reset;
+  led_encoder->base.del = led_strip_encoder_del;
+  led_encoder->reset = reset;
+
+  rmt_bytes_encoder_config_t bytes_config;
+  memset(&bytes_config, 0, sizeof(bytes_config));
+  bytes_config.bit0 = bit0;
+  bytes_config.bit1 = bit1;
+  bytes_config.flags.msb_first = 1;
+  esp_err_t error = rmt_new_bytes_encoder(&bytes_config, &led_encoder->bytes_encoder);
+  if (error != ESP_OK) {
+    delete led_encoder;  // NOLINT(cppcoreguidelines-owning-memory)
+    return error;
+  }
+  rmt_copy_encoder_config_t copy_config;
+  memset(&copy_config, 0, sizeof(copy_config));
+  error = rmt_new_copy_encoder(&copy_config, &led_encoder->copy_encoder);
+  if (error != ESP_OK) {
+    rmt_del_encoder(led_encoder->bytes_encoder);
+    delete led_encoder;  // NOLINT(cppcoreguidelines-owning-memory)
+    return error;
+  }
+  *ret_encoder = &led_encoder->base;
+  return ESP_OK;
+}
+#else
+void IRAM_ATTR ESP32RMTLEDStripLightOutput::translate_(const void *src, rmt_item32_t *dest, size_t src_size,
+                                                       size_t wanted_num, size_t *translated_size,
+                                                       size_t *item_num) {
+  void *context;
+  if (src == nullptr || dest == nullptr || rmt_translator_get_context(item_num, &context) != ESP_OK) {
+    *translated_size = 0;
+    *item_num = 0;
+    return;
+  }
+  auto *light = static_cast<ESP32RMTLEDStripLightOutput *>(context);
+  *translated_size = light->bit_encoder_.encode(static_cast<const uint8_t *>(src), src_size,
+                                                reinterpret_cast<uint32_t *>(dest), wanted_num, item_num);
+}
+#endif
+
 #ifdef USE_ESP32_VARIANT_ESP32H2
 static const uint32_t RMT_CLK_FREQ = 32000000;
 static const uint8_t RMT_CLK_DIV = 1;
@@ -34,6 +138,14 @@ void ESP32RMTLEDStripLightOutput::setup() {
     return;
   }
 
+  // the symbols are generated while sending, so the data must not change meanwhile
+  this->tx_buf_ = allocator.allocate(buffer_size);
+  if (this->tx_buf_ == nullptr) {
+    ESP_LOGE(TAG, "Cannot allocate LED transmit buffer!");
+    this->mark_failed();
+    return;
+  }
+
   this->effect_data_ = allocator.allocate(this->num_leds_);
   if (this->effect_data_ == nullptr) {
     ESP_LOGE(TAG, "Cannot allocate effect data!");
@@ -42,11 +154,6 @@ void ESP32RMTLEDStripLightOutput::setup() {
   }
 
 #if ESP_IDF_VERSION_MAJOR >= 5
-  RAMAllocator<rmt_symbol_word_t> rmt_allocator(this->use_psram_ ? 0 : RAMAllocator<rmt_symbol_word_t>::ALLOC_INTERNAL);
-
-  // 8 bits per byte, 1 rmt_symbol_word_t per bit + 1 rmt_symbol_word_t for reset
-  this->rmt_buf_ = rmt_allocator.allocate(buffer_size * 8 + 1);
-
   rmt_tx_channel_config_t channel;
   memset(&channel, 0, sizeof(channel));
   channel.clk_src = RMT_CLK_SRC_DEFAULT;
@@ -65,9 +172,7 @@ void ESP32RMTLEDStripLightOutput::setup() {
     return;
   }
 
-  rmt_copy_encoder_config_t encoder;
-  memset(&encoder, 0, sizeof(encoder));
-  if (rmt_new_copy_encoder(&encoder, &this->encoder_) != ESP_OK) {
+  if (new_led_strip_encoder(this->bit0_, this->bit1_, this->reset_, &this->encoder_) != ESP_OK) {
     ESP_LOGE(TAG, "Encoder creation failed");
     this->mark_failed();
     return;
@@ -79,11 +184,6 @@ void ESP32RMTLEDStripLightOutput::setup() {
     return;
   }
 #else
-  RAMAllocator<rmt_item32_t> rmt_allocator(this->use_psram_ ? 0 : RAMAllocator<rmt_item32_t>::ALLOC_INTERNAL);
-
-  // 8 bits per byte, 1 rmt_item32_t per bit + 1 rmt_item32_t for reset
-  this->rmt_buf_ = rmt_allocator.allocate(buffer_size * 8 + 1);
-
   rmt_config_t config;
   memset(&config, 0, sizeof(config));
   config.channel = this->channel_;
@@ -107,6 +207,14 @@ void ESP32RMTLEDStripLightOutput::setup() {
     this->mark_failed();
     return;
   }
+  this->bit_encoder_.set_symbols(this->bit0_.val, this->bit1_.val,
+                                 this->reset_.duration0 > 0 || this->reset_.duration1 > 0 ? this->reset_.val : 0);
+  if (rmt_translator_init(this->channel_, translate_) != ESP_OK ||
+      rmt_translator_set_context(this->channel_, this) != ESP_OK) {
+    ESP_LOGE(TAG, "Cannot install RMT translator!");
+    this->mark_failed();
+    return;
+  }
 #endif
 }
 
@@ -157,40 +265,16 @@ void ESP32RMTLEDStripLightOutput::write_state(light::LightState *state) {
   delayMicroseconds(50);
 
   size_t buffer_size = this->get_buffer_size_();
-
-  size_t size = 0;
-  size_t len = 0;
-  uint8_t *psrc = this->buf_;
-#if ESP_IDF_VERSION_MAJOR >= 5
-  rmt_symbol_word_t *pdest = this->rmt_buf_;
-#else
-  rmt_item32_t *pdest = this->rmt_buf_;
-#endif
-  while (size < buffer_size) {
-    uint8_t b = *psrc;
-    for (int i = 0; i < 8; i++) {
-      pdest->val = b & (1 << (7 - i)) ? this->bit1_.val : this->bit0_.val;
-      pdest++;
-      len++;
-    }
-    size++;
-    psrc++;
-  }
-
-  if (this->reset_.duration0 > 0 || this->reset_.duration1 > 0) {
-    pdest->val = this->reset_.val;
-    pdest++;
-    len++;
-  }
+  memcpy(this->tx_buf_, this->buf_, buffer_size);
 
 #if ESP_IDF_VERSION_MAJOR >= 5
   rmt_transmit_config_t config;
   memset(&config, 0, sizeof(config));
   config.loop_count = 0;
   config.flags.eot_level = 0;
-  error = rmt_transmit(this->channel_, this->encoder_, this->rmt_buf_, len * sizeof(rmt_symbol_word_t), &config);
+  error = rmt_transmit(this->channel_, this->encoder_, this->tx_buf_, buffer_size, &config);
 #else
-  error = rmt_write_items(this->channel_, this->rmt_buf_, len, false);
+  error = rmt_write_sample(this->channel_, this->tx_buf_, buffer_size, false);
 #endif
   if (error != ESP_OK) {
     ESP_LOGE(TAG, "RMT TX error");
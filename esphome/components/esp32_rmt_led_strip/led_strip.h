@@ -2,6 +2,8 @@
 
 #ifdef USE_ESP32
 
+#include "led_bit_encoder.h"
+
 #include "esphome/components/light/addressable_light.h"
 #include "esphome/components/light/light_output.h"
 #include "esphome/core/color.h"
@@ -78,18 +80,25 @@ class ESP32RMTLEDStripLightOutput : public light::AddressableLight {
 
   size_t get_buffer_size_() const { return this->num_leds_ * (this->is_rgbw_ || this->is_wrgb_ ? 4 : 3); }
 
+#if ESP_IDF_VERSION_MAJOR < 5
+  /// RMT translator, expands the LED data into symbols as the driver refills the channel memory.
+  static void translate_(const void *src, rmt_item32_t *dest, size_t src_size, size_t wanted_num,
+                         size_t *translated_size, size_t *item_num);
+#endif
+
   uint8_t *buf_{nullptr};
+  /// Copy of buf_ that is being sent, the symbols are generated from it while transmitting.
+  uint8_t *tx_buf_{nullptr};
   uint8_t *effect_data_{nullptr};
 #if ESP_IDF_VERSION_MAJOR >= 5
   rmt_channel_handle_t channel_{nullptr};
   rmt_encoder_handle_t encoder_{nullptr};
-  rmt_symbol_word_t *rmt_buf_{nullptr};
   rmt_symbol_word_t bit0_, bit1_, reset_;
   uint32_t rmt_symbols_;
 #else
-  rmt_item32_t *rmt_buf_{nullptr};
   rmt_item32_t bit0_, bit1_, reset_;
   rmt_channel_t channel_{RMT_CHANNEL_0};
+  LEDBitEncoder bit_encoder_;
 #endif
 
   uint8_t pin_;
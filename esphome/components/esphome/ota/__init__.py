@@ -5,6 +5,7 @@ from esphome.components.ota import BASE_OTA_SCHEMA, OTAComponent, ota_to_code
 from esphome.config_helpers import merge_config
 import esphome.config_validation as cv
 from esphome.const import (
+    CONF_BUFFER_SIZE,
     CONF_ESPHOME,
     CONF_ID,
     CONF_NUM_ATTEMPTS,
@@ -101,7 +102,18 @@ CONFIG_SCHEMA = (
                 rp2040=2040,
                 bk72xx=8892,
                 rtl87xx=8892,
+                host=3232,
             ): cv.port,
+            # Two buffers of this size are used on ESP32 and the host, so flash writes overlap with receiving
+            cv.SplitDefault(
+                CONF_BUFFER_SIZE,
+                esp8266=1024,
+                esp32=4096,
+                rp2040=1024,
+                bk72xx=1024,
+                rtl87xx=1024,
+                host=4096,
+            ): cv.int_range(min=256, max=65536),
             cv.Optional(CONF_PASSWORD): cv.string,
             cv.Optional(CONF_NUM_ATTEMPTS): cv.invalid(
                 f"'{CONF_SAFE_MODE}' (and its related configuration variables) has moved from 'ota' to its own component. See https://esphome.io/components/safe_mode"
@@ -125,6 +137,7 @@ FINAL_VALIDATE_SCHEMA = ota_esphome_final_validate
 async def to_code(config):
     var = cg.new_Pvariable(config[CONF_ID])
     cg.add(var.set_port(config[CONF_PORT]))
+    cg.add(var.set_buffer_size(config[CONF_BUFFER_SIZE]))
     if CONF_PASSWORD in config:
         cg.add(var.set_auth_password(config[CONF_PASSWORD]))
         cg.add_define("USE_OTA_PASSWORD")
@@ -8,18 +8,25 @@
 #include "esphome/components/ota/ota_backend_arduino_libretiny.h"
 #include "esphome/components/ota/ota_backend_arduino_rp2040.h"
 #include "esphome/components/ota/ota_backend_esp_idf.h"
+#include "esphome/components/ota/ota_backend_host.h"
+#include "esphome/components/ota/ota_delta.h"
+#include "esphome/components/ota/ota_write_pipeline.h"
 #include "esphome/core/application.h"
 #include "esphome/core/hal.h"
 #include "esphome/core/log.h"
 #include "esphome/core/util.h"
 
+#include <algorithm>
 #include <cerrno>
+#include <cinttypes>
 #include <cstdio>
 
 namespace esphome {
 
 static const char *const TAG = "esphome.ota";
 static constexpr u_int16_t OTA_BLOCK_SIZE = 8192;
+/// How often to check for a client while no update is running, instead of on every loop iteration.
+static const uint32_t ACCEPT_INTERVAL = 100;
 
 void ESPHomeOTAComponent::setup() {
 #ifdef USE_OTA_STATE_CALLBACK
@@ -67,12 +74,25 @@ void ESPHomeOTAComponent::setup() {
     this->mark_failed();
     return;
   }
+
+  // The loop only runs while a client is connected
+  this->disable_loop();
+  this->set_interval("accept", ACCEPT_INTERVAL, [this]() {
+    if (this->client_ == nullptr) {
+      struct sockaddr_storage source_addr;
+      socklen_t addr_len = sizeof(source_addr);
+      this->client_ = this->server_->accept((struct sockaddr *) &source_addr, &addr_len);
+    }
+    if (this->client_ != nullptr)
+      this->enable_loop();
+  });
 }
 
 void ESPHomeOTAComponent::dump_config() {
   ESP_LOGCONFIG(TAG, "Over-The-Air updates:");
   ESP_LOGCONFIG(TAG, "  Address: %s:%u", network::get_use_address().c_str(), this->port_);
   ESP_LOGCONFIG(TAG, "  Version: %d", USE_OTA_VERSION);
+  ESP_LOGCONFIG(TAG, "  Buffer Size: %zu", this->buffer_size_);
 #ifdef USE_OTA_PASSWORD
   if (!this->password_.empty()) {
     ESP_LOGCONFIG(TAG, "  Password configured");
@@ -80,23 +100,42 @@ void ESPHomeOTAComponent::dump_config() {
 #endif
 }
 
-void ESPHomeOTAComponent::loop() { this->handle_(); }
+void ESPHomeOTAComponent::loop() {
+  this->handle_();
+  // an update runs to its end within handle_(), so there is nothing left to do until the next client connects
+  if (this->client_ == nullptr)
+    this->disable_loop();
+}
 
 static const uint8_t FEATURE_SUPPORTS_COMPRESSION = 0x01;
+static const uint8_t FEATURE_SUPPORTS_DELTA = 0x02;
+static const uint8_t DELTA_FLAG_SUPPORTS_COMPRESSION = 0x01;
+static const uint8_t UPLOAD_MODE_DELTA = 0x01;
 
 void ESPHomeOTAComponent::handle_() {
   ota::OTAResponseTypes error_code = ota::OTA_RESPONSE_ERROR_UNKNOWN;
   bool update_started = false;
   size_t total = 0;
+  size_t buffered = 0;
   uint32_t last_progress = 0;
-  uint8_t buf[1024];
+  uint32_t receive_start;
+  uint32_t elapsed;
+  // only used for the handshake, the image is received into the buffers of the pipeline
+  uint8_t buf[128];
   char *sbuf = reinterpret_cast<char *>(buf);
   size_t ota_size;
+  size_t image_size;
+  size_t running_image_size = 0;
+  bool delta = false;
   uint8_t ota_features;
   std::unique_ptr<ota::OTABackend> backend;
+  // declared after the backend, so pending writes are finished before the backend is destroyed
+  std::unique_ptr<ota::OTAWritePipeline> pipeline;
+  std::unique_ptr<ota::OTADeltaDecoder> decoder;
   (void) ota_features;
 #if USE_OTA_VERSION == 2
   size_t size_acknowledged = 0;
+  const uint8_t chunk_ok = ota::OTA_RESPONSE_CHUNK_OK;
 #endif
 
   if (client_ == nullptr) {
@@ -149,10 +188,14 @@ void ESPHomeOTAComponent::handle_() {
 
   // Acknowledge header - 1 byte
   buf[0] = ota::OTA_RESPONSE_HEADER_OK;
-  if ((ota_features & FEATURE_SUPPORTS_COMPRESSION) != 0 && backend->supports_compression()) {
+  if ((ota_features & FEATURE_SUPPORTS_DELTA) != 0)
+    running_image_size = backend->get_running_image_size();
+  if (running_image_size != 0) {
+    // the running image is only described to the uploader once it is authenticated
+    buf[0] = ota::OTA_RESPONSE_SUPPORTS_DELTA;
+  } else if ((ota_features & FEATURE_SUPPORTS_COMPRESSION) != 0 && backend->supports_compression()) {
     buf[0] = ota::OTA_RESPONSE_SUPPORTS_COMPRESSION;
   }
-
   this->writeall_(buf, 1);
 
 #ifdef USE_OTA_PASSWORD
@@ -218,6 +261,24 @@ void ESPHomeOTAComponent::handle_() {
   buf[0] = ota::OTA_RESPONSE_AUTH_OK;
   this->writeall_(buf, 1);
 
+  if (running_image_size != 0) {
+    if (!ota::get_running_image_md5(backend.get(), running_image_size, sbuf + 1)) {
+      ESP_LOGW(TAG, "Reading the running image failed");
+      goto error;  // NOLINT(cppcoreguidelines-avoid-goto)
+    }
+    // Send the delta flags and the MD5 of the running image, the uploader may send a delta against it - 33 bytes
+    ESP_LOGV(TAG, "Running image MD5 is %.32s", sbuf + 1);
+    buf[0] = backend->supports_compression() ? DELTA_FLAG_SUPPORTS_COMPRESSION : 0;
+    this->writeall_(buf, 33);
+
+    // Read upload mode - 1 byte
+    if (!this->readall_(buf, 1)) {
+      ESP_LOGW(TAG, "Reading upload mode failed");
+      goto error;  // NOLINT(cppcoreguidelines-avoid-goto)
+    }
+    delta = buf[0] == UPLOAD_MODE_DELTA;
+  }
+
   // Read size, 4 bytes MSB first
   if (!this->readall_(buf, 4)) {
     ESP_LOGW(TAG, "Reading size failed");
@@ -229,8 +290,19 @@ void ESPHomeOTAComponent::handle_() {
     ota_size |= buf[i];
   }
   ESP_LOGV(TAG, "Size is %u bytes", ota_size);
+  image_size = ota_size;
+
+  if (delta) {
+    // Read size of the image that is reconstructed from the patch, 4 bytes MSB first
+    if (!this->readall_(buf, 4)) {
+      ESP_LOGW(TAG, "Reading image size failed");
+      goto error;  // NOLINT(cppcoreguidelines-avoid-goto)
+    }
+    image_size = encode_uint32(buf[0], buf[1], buf[2], buf[3]);
+    ESP_LOGD(TAG, "Receiving a %u byte delta for a %u byte image", ota_size, image_size);
+  }
 
-  error_code = backend->begin(ota_size);
+  error_code = backend->begin(image_size);
   if (error_code != ota::OTA_RESPONSE_OK)
     goto error;  // NOLINT(cppcoreguidelines-avoid-goto)
   update_started = true;
@@ -248,14 +320,24 @@ void ESPHomeOTAComponent::handle_() {
   ESP_LOGV(TAG, "Update: Binary MD5 is %s", sbuf);
   backend->set_update_md5(sbuf);
 
+  pipeline = make_unique<ota::OTAWritePipeline>(backend.get(), this->buffer_size_);
+  if (!pipeline->start())
+    goto error;  // NOLINT(cppcoreguidelines-avoid-goto)
+  if (delta)
+    decoder = make_unique<ota::OTADeltaDecoder>(backend.get(), pipeline.get(), running_image_size, image_size);
+
   // Acknowledge MD5 OK - 1 byte
   buf[0] = ota::OTA_RESPONSE_BIN_MD5_OK;
   this->writeall_(buf, 1);
 
+  receive_start = millis();
   while (total < ota_size) {
     // TODO: timeout check
-    size_t requested = std::min(sizeof(buf), ota_size - total);
-    ssize_t read = this->client_->read(buf, requested);
+    // fill the buffer completely before it is written, the backends are faster with larger writes
+    // a patch is received in small parts instead, the decoder writes the image into the buffers
+    uint8_t *dest = decoder != nullptr ? buf : pipeline->get_buffer() + buffered;
+    size_t space = decoder != nullptr ? sizeof(buf) : pipeline->get_buffer_size() - buffered;
+    ssize_t read = this->client_->read(dest, std::min(space, ota_size - total));
     if (read == -1) {
       if (errno == EAGAIN || errno == EWOULDBLOCK) {
         App.feed_wdt();
@@ -272,25 +354,42 @@ void ESPHomeOTAComponent::handle_() {
       goto error;  // NOLINT(cppcoreguidelines-avoid-goto)
     }
 
-    error_code = backend->write(buf, read);
-    if (error_code != ota::OTA_RESPONSE_OK) {
-      ESP_LOGW(TAG, "Error writing binary data to flash!, error_code: %d", error_code);
-      goto error;  // NOLINT(cppcoreguidelines-avoid-goto)
-    }
     total += read;
 #if USE_OTA_VERSION == 2
+    // blocks are acknowledged once they are received, so the next one is sent while the previous one is written
     while (size_acknowledged + OTA_BLOCK_SIZE <= total || (total == ota_size && size_acknowledged < ota_size)) {
-      buf[0] = ota::OTA_RESPONSE_CHUNK_OK;
-      this->writeall_(buf, 1);
+      this->writeall_(&chunk_ok, 1);
       size_acknowledged += OTA_BLOCK_SIZE;
     }
 #endif
+    if (decoder != nullptr) {
+      error_code = decoder->feed(buf, read);
+      if (error_code == ota::OTA_RESPONSE_OK && total == ota_size)
+        error_code = decoder->finish();
+      if (error_code != ota::OTA_RESPONSE_OK) {
+        ESP_LOGW(TAG, "Error applying delta update, error_code: %d", error_code);
+        goto error;  // NOLINT(cppcoreguidelines-avoid-goto)
+      }
+    } else {
+      buffered += read;
+      if (buffered == pipeline->get_buffer_size() || total == ota_size) {
+        // the buffer is written while the next one is received
+        error_code = pipeline->commit(buffered);
+        buffered = 0;
+        if (error_code != ota::OTA_RESPONSE_OK) {
+          ESP_LOGW(TAG, "Error writing binary data to flash!, error_code: %d", error_code);
+          goto error;  // NOLINT(cppcoreguidelines-avoid-goto)
+        }
+      }
+    }
 
     uint32_t now = millis();
     if (now - last_progress > 1000) {
       last_progress = now;
       float percentage = (total * 100.0f) / ota_size;
-      ESP_LOGD(TAG, "Progress: %0.1f%%", percentage);
+      // bytes per ms are roughly kB/s
+      ESP_LOGD(TAG, "Progress: %0.1f%% (%" PRIu32 " kB/s)", percentage,
+               static_cast<uint32_t>(total / std::max<uint32_t>(now - receive_start, 1)));
 #ifdef USE_OTA_STATE_CALLBACK
       this->state_callback_.call(ota::OTA_IN_PROGRESS, percentage, 0);
 #endif
@@ -300,6 +399,15 @@ void ESPHomeOTAComponent::handle_() {
     }
   }
 
+  error_code = pipeline->flush();
+  if (error_code != ota::OTA_RESPONSE_OK) {
+    ESP_LOGW(TAG, "Error writing binary data to flash!, error_code: %d", error_code);
+    goto error;  // NOLINT(cppcoreguidelines-avoid-goto)
+  }
+  elapsed = std::max<uint32_t>(millis() - receive_start, 1);
+  ESP_LOGD(TAG, "Received %zu bytes in %" PRIu32 "ms (%" PRIu32 " kB/s), waited %" PRIu32 "ms for writes", total,
+           elapsed, static_cast<uint32_t>(total / elapsed), pipeline->get_wait_time());
+
   // Acknowledge receive OK - 1 byte
   buf[0] = ota::OTA_RESPONSE_RECEIVE_OK;
   this->writeall_(buf, 1);
@@ -337,6 +445,8 @@ error:
   this->client_->close();
   this->client_ = nullptr;
 
+  // wait for a write that may still be in progress
+  pipeline = nullptr;
   if (backend != nullptr && update_started) {
     backend->abort();
   }
@@ -409,5 +519,6 @@ bool ESPHomeOTAComponent::writeall_(const uint8_t *buf, size_t len) {
 float ESPHomeOTAComponent::get_setup_priority() const { return setup_priority::AFTER_WIFI; }
 uint16_t ESPHomeOTAComponent::get_port() const { return this->port_; }
 void ESPHomeOTAComponent::set_port(uint16_t port) { this->port_ = port; }
+void ESPHomeOTAComponent::set_buffer_size(size_t buffer_size) { this->buffer_size_ = buffer_size; }
 }  // namespace esphome
 #endif
@@ -18,6 +18,8 @@ class ESPHomeOTAComponent : public ota::OTAComponent {
 
   /// Manually set the port OTA should listen on
   void set_port(uint16_t port);
+  /// Set the size of each of the buffers the image is received into
+  void set_buffer_size(size_t buffer_size);
 
   void setup() override;
   void dump_config() override;
@@ -36,6 +38,7 @@ class ESPHomeOTAComponent : public ota::OTAComponent {
 #endif  // USE_OTA_PASSWORD
 
   uint16_t port_;
+  size_t buffer_size_{1024};
 
   std::unique_ptr<socket::Socket> server_;
   std::unique_ptr<socket::Socket> client_;
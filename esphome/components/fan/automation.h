@@ -98,6 +98,10 @@ template<typename... Ts> class FanIsOnCondition : public Condition<Ts...> {
  public:
   explicit FanIsOnCondition(Fan *state) : state_(state) {}
   bool check(Ts... x) override { return this->state_->state; }
+  bool add_on_dependency_change_callback(const std::function<void()> &callback) override {
+    this->state_->add_on_state_callback([callback]() { callback(); });
+    return true;
+  }
 
  protected:
   Fan *state_;
@@ -106,6 +110,10 @@ template<typename... Ts> class FanIsOffCondition : public Condition<Ts...> {
  public:
   explicit FanIsOffCondition(Fan *state) : state_(state) {}
   bool check(Ts... x) override { return !this->state_->state; }
+  bool add_on_dependency_change_callback(const std::function<void()> &callback) override {
+    this->state_->add_on_state_callback([callback]() { callback(); });
+    return true;
+  }
 
  protected:
   Fan *state_;
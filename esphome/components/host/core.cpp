@@ -5,6 +5,7 @@
 #include "preferences.h"
 
 #include <sched.h>
+#include <signal.h>
 #include <time.h>
 #include <cmath>
 #include <cstdlib>
@@ -46,7 +47,8 @@ void IRAM_ATTR HOT delayMicroseconds(uint32_t us) {
 }
 void arch_restart() { exit(0); }
 void arch_init() {
-  // pass
+  // Writing to a socket that was closed by the peer must fail with EPIPE instead of terminating the process
+  signal(SIGPIPE, SIG_IGN);
 }
 void IRAM_ATTR HOT arch_feed_wdt() {
   // pass
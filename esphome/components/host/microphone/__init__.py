@@ -0,0 +1,23 @@
+import esphome.codegen as cg
+from esphome.components import microphone
+import esphome.config_validation as cv
+from esphome.const import CONF_FILE, CONF_ID
+from esphome.core import CORE
+
+host_ns = cg.esphome_ns.namespace("host")
+HostMicrophone = host_ns.class_("HostMicrophone", microphone.Microphone, cg.Component)
+
+CONFIG_SCHEMA = microphone.MICROPHONE_SCHEMA.extend(
+    {
+        cv.GenerateID(): cv.declare_id(HostMicrophone),
+        cv.Required(CONF_FILE): cv.file_,
+    }
+).extend(cv.COMPONENT_SCHEMA)
+
+
+async def to_code(config):
+    var = cg.new_Pvariable(config[CONF_ID])
+    await cg.register_component(var, config)
+    await microphone.register_microphone(var, config)
+    # the firmware does not run in the directory of the configuration
+    cg.add(var.set_file(CORE.relative_config_path(config[CONF_FILE])))
@@ -0,0 +1,132 @@
+#include "host_microphone.h"
+
+#ifdef USE_HOST
+
+#include "esphome/core/log.h"
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstring>
+#include <vector>
+
+namespace esphome {
+namespace host {
+
+static const char *const TAG = "host.microphone";
+
+// Number of bytes passed to on_data triggers at once
+static const size_t CALLBACK_BUFFER_SIZE = 512;
+
+static uint32_t read_le(const uint8_t *data, size_t len) {
+  uint32_t value = 0;
+  for (size_t i = len; i != 0; i--)
+    value = (value << 8) | data[i - 1];
+  return value;
+}
+
+void HostMicrophone::setup() {
+  ESP_LOGCONFIG(TAG, "Setting up Host Microphone...");
+  if (!this->open_()) {
+    if (this->file_ != nullptr) {
+      fclose(this->file_);
+      this->file_ = nullptr;
+    }
+    this->mark_failed();
+  }
+}
+
+bool HostMicrophone::open_() {
+  this->file_ = fopen(this->file_name_.c_str(), "rb");
+  if (this->file_ == nullptr) {
+    ESP_LOGE(TAG, "Could not open %s", this->file_name_.c_str());
+    return false;
+  }
+  uint8_t header[12];
+  if (fread(header, 1, sizeof(header), this->file_) != sizeof(header) || memcmp(header, "RIFF", 4) != 0 ||
+      memcmp(header + 8, "WAVE", 4) != 0) {
+    ESP_LOGE(TAG, "%s is not a WAV file", this->file_name_.c_str());
+    return false;
+  }
+  bool has_format = false;
+  uint8_t chunk[8];
+  while (fread(chunk, 1, sizeof(chunk), this->file_) == sizeof(chunk)) {
+    uint32_t size = read_le(chunk + 4, 4);
+    if (memcmp(chunk, "fmt ", 4) == 0) {
+      uint8_t format[16];
+      if (size < sizeof(format) || fread(format, 1, sizeof(format), this->file_) != sizeof(format))
+        break;
+      uint32_t audio_format = read_le(format, 2);
+      uint32_t channels = read_le(format + 2, 2);
+      uint32_t bits_per_sample = read_le(format + 14, 2);
+      if (audio_format != 1 || channels != 1 || bits_per_sample != 16) {
+        ESP_LOGE(TAG, "%s must hold 16 bit mono PCM (format %" PRIu32 ", %" PRIu32 " channels, %" PRIu32 " bits)",
+                 this->file_name_.c_str(), audio_format, channels, bits_per_sample);
+        return false;
+      }
+      this->sample_rate_ = read_le(format + 4, 4);
+      has_format = true;
+      size -= sizeof(format);
+    } else if (memcmp(chunk, "data", 4) == 0) {
+      if (!has_format)
+        break;
+      this->data_size_ = size;
+      this->remaining_ = size;
+      return true;
+    }
+    // chunks are padded to an even size
+    if (fseek(this->file_, size + (size & 1), SEEK_CUR) != 0)
+      break;
+  }
+  ESP_LOGE(TAG, "%s has no audio data", this->file_name_.c_str());
+  return false;
+}
+
+void HostMicrophone::start() {
+  if (this->is_failed())
+    return;
+  if (this->remaining_ == 0) {
+    ESP_LOGW(TAG, "End of %s was reached", this->file_name_.c_str());
+    return;
+  }
+  this->state_ = microphone::STATE_RUNNING;
+}
+
+void HostMicrophone::stop() { this->state_ = microphone::STATE_STOPPED; }
+
+size_t HostMicrophone::read(int16_t *buf, size_t len) {
+  if (this->state_ != microphone::STATE_RUNNING)
+    return 0;
+  // whole samples only
+  size_t to_read = std::min<size_t>(len, this->remaining_) & ~size_t(1);
+  size_t bytes_read = fread(buf, 1, to_read, this->file_);
+  this->remaining_ -= bytes_read;
+  if (bytes_read != to_read || this->remaining_ < sizeof(int16_t)) {
+    ESP_LOGI(TAG, "End of %s", this->file_name_.c_str());
+    this->remaining_ = 0;
+    this->state_ = microphone::STATE_STOPPED;
+  }
+  return bytes_read;
+}
+
+void HostMicrophone::loop() {
+  if (this->state_ != microphone::STATE_RUNNING || this->data_callbacks_.size() == 0)
+    return;
+  std::vector<int16_t> samples(CALLBACK_BUFFER_SIZE / sizeof(int16_t));
+  size_t bytes_read = this->read(samples.data(), CALLBACK_BUFFER_SIZE);
+  samples.resize(bytes_read / sizeof(int16_t));
+  this->data_callbacks_.call(samples);
+}
+
+void HostMicrophone::dump_config() {
+  ESP_LOGCONFIG(TAG, "Host Microphone:");
+  ESP_LOGCONFIG(TAG, "  File: %s", this->file_name_.c_str());
+  if (this->sample_rate_ != 0) {
+    ESP_LOGCONFIG(TAG, "  Sample rate: %" PRIu32 " Hz", this->sample_rate_);
+    ESP_LOGCONFIG(TAG, "  Duration: %.2f s", this->data_size_ / (2.0f * this->sample_rate_));
+  }
+}
+
+}  // namespace host
+}  // namespace esphome
+
+#endif  // USE_HOST
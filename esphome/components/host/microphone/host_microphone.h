@@ -0,0 +1,45 @@
+#pragma once
+
+#ifdef USE_HOST
+
+#include "esphome/components/microphone/microphone.h"
+#include "esphome/core/component.h"
+
+#include <cstdio>
+#include <string>
+
+namespace esphome {
+namespace host {
+
+/** A microphone that plays back a WAV file, to run audio components on recorded samples.
+ *
+ * The file must hold 16 bit mono PCM. Samples are returned as fast as they are read, so a file is processed faster
+ * than real time. The microphone stops at the end of the file.
+ */
+class HostMicrophone : public microphone::Microphone, public Component {
+ public:
+  void setup() override;
+  void loop() override;
+  void dump_config() override;
+
+  void start() override;
+  void stop() override;
+  size_t read(int16_t *buf, size_t len) override;
+
+  void set_file(const std::string &file) { this->file_name_ = file; }
+
+ protected:
+  bool open_();
+
+  std::string file_name_;
+  FILE *file_{nullptr};
+  uint32_t sample_rate_{0};
+  /// Number of bytes of sample data that were not read yet.
+  uint32_t remaining_{0};
+  uint32_t data_size_{0};
+};
+
+}  // namespace host
+}  // namespace esphome
+
+#endif  // USE_HOST
@@ -1,15 +1,22 @@
 #ifdef USE_HOST
 
+#include <cerrno>
+#include <cstring>
 #include <filesystem>
 #include <fstream>
 #include "preferences.h"
 #include "esphome/core/application.h"
+#include "esphome/core/log.h"
 
 namespace esphome {
 namespace host {
 namespace fs = std::filesystem;
 
 static const char *const TAG = "host.preferences";
+// Size of a record header: key and length.
+static const size_t RECORD_HEADER_SIZE = sizeof(uint32_t) + sizeof(uint8_t);
+// The log is compacted once it grows past this many times the size of the live records.
+static const size_t COMPACTION_RATIO = 4;
 
 void HostPreferences::setup_() {
   if (this->setup_complete_)
@@ -33,8 +40,10 @@ void HostPreferences::setup_() {
       uint8_t data[len];
       if (fread(data, sizeof(uint8_t), len, fp) != len)
         break;
+      // Records are appended as they change, so later records replace earlier ones
       std::vector vec(data, data + len);
       this->data[key] = vec;
+      this->log_size_ += RECORD_HEADER_SIZE + len;
     }
     fclose(fp);
   }
@@ -43,21 +52,101 @@ void HostPreferences::setup_() {
 
 bool HostPreferences::sync() {
   this->setup_();
-  FILE *fp = fopen(this->filename_.c_str(), "wb");
-  std::map<uint32_t, std::vector<uint8_t>>::iterator it;
-
-  for (it = this->data.begin(); it != this->data.end(); ++it) {
-    fwrite(&it->first, sizeof(uint32_t), 1, fp);
-    uint8_t len = it->second.size();
-    fwrite(&len, sizeof(len), 1, fp);
-    fwrite(it->second.data(), sizeof(uint8_t), it->second.size(), fp);
+  if (this->dirty_.empty() && !this->needs_compaction_)
+    return true;
+
+  size_t live_size = 0;
+  for (auto &it : this->data)
+    live_size += RECORD_HEADER_SIZE + it.second.size();
+
+  bool ok;
+  if (this->needs_compaction_ || this->log_size_ > live_size * COMPACTION_RATIO) {
+    ok = this->compact_();
+  } else {
+    ok = this->append_();
+  }
+  if (ok) {
+    this->dirty_.clear();
+    this->needs_compaction_ = false;
+  }
+  return ok;
+}
+
+static bool write_record(FILE *fp, uint32_t key, const std::vector<uint8_t> &value) {
+  uint8_t len = value.size();
+  return fwrite(&key, sizeof(key), 1, fp) == 1 && fwrite(&len, sizeof(len), 1, fp) == 1 &&
+         fwrite(value.data(), sizeof(uint8_t), len, fp) == len;
+}
+
+bool HostPreferences::append_() {
+  FILE *fp = fopen(this->filename_.c_str(), "ab");
+  if (fp == nullptr) {
+    ESP_LOGW(TAG, "Failed to open %s: %s", this->filename_.c_str(), strerror(errno));
+    return false;
+  }
+  size_t written = 0;
+  bool ok = true;
+  for (uint32_t key : this->dirty_) {
+    auto &vec = this->data[key];
+    if (!write_record(fp, key, vec)) {
+      ok = false;
+      break;
+    }
+    written += RECORD_HEADER_SIZE + vec.size();
+  }
+  // fclose() flushes, so a full disk may only show up here
+  if (fclose(fp) != 0)
+    ok = false;
+  if (!ok) {
+    // The log may now end in a partial record, which would misalign anything appended after it
+    ESP_LOGW(TAG, "Failed to append to %s: %s", this->filename_.c_str(), strerror(errno));
+    this->needs_compaction_ = true;
+    return false;
+  }
+  this->log_size_ += written;
+  this->stats_.writes += this->dirty_.size();
+  this->stats_.bytes_written += written;
+  this->stats_.commits++;
+  ESP_LOGV(TAG, "Appended %zu preferences (%zu bytes)", this->dirty_.size(), written);
+  return true;
+}
+
+bool HostPreferences::compact_() {
+  // Write a new log next to the old one and swap them, so that a failed write keeps the old data
+  std::string tmp_filename = this->filename_ + ".tmp";
+  FILE *fp = fopen(tmp_filename.c_str(), "wb");
+  if (fp == nullptr) {
+    ESP_LOGW(TAG, "Failed to open %s: %s", tmp_filename.c_str(), strerror(errno));
+    return false;
+  }
+  size_t written = 0;
+  bool ok = true;
+  for (auto &it : this->data) {
+    if (!write_record(fp, it.first, it.second)) {
+      ok = false;
+      break;
+    }
+    written += RECORD_HEADER_SIZE + it.second.size();
+  }
+  if (fclose(fp) != 0)
+    ok = false;
+  if (!ok || rename(tmp_filename.c_str(), this->filename_.c_str()) != 0) {
+    ESP_LOGW(TAG, "Failed to write %s: %s", tmp_filename.c_str(), strerror(errno));
+    remove(tmp_filename.c_str());
+    return false;
   }
-  fclose(fp);
+  ESP_LOGV(TAG, "Compacted preferences log from %zu to %zu bytes", this->log_size_, written);
+  this->log_size_ = written;
+  this->stats_.writes += this->data.size();
+  this->stats_.bytes_written += written;
+  this->stats_.commits++;
   return true;
 }
 
 bool HostPreferences::reset() {
   host_preferences->data.clear();
+  host_preferences->dirty_.clear();
+  host_preferences->needs_compaction_ = true;
   return true;
 }
 
@@ -4,6 +4,7 @@
 
 #include "esphome/core/preferences.h"
 #include <map>
+#include <set>
 
 namespace esphome {
 namespace host {
@@ -23,6 +24,7 @@ class HostPreferences : public ESPPreferences {
  public:
   bool sync() override;
   bool reset() override;
+  ESPPreferencesStats get_stats() override { return this->stats_; }
 
   ESPPreferenceObject make_preference(size_t length, uint32_t type, bool in_flash) override;
   ESPPreferenceObject make_preference(size_t length, uint32_t type) override {
@@ -33,8 +35,15 @@ class HostPreferences : public ESPPreferences {
     if (len > 255)
       return false;
     this->setup_();
+    this->stats_.saves++;
+    auto it = this->data.find(key);
+    if (it != this->data.end() && it->second.size() == len && memcmp(it->second.data(), data, len) == 0) {
+      this->stats_.unchanged++;
+      return true;
+    }
     std::vector vec(data, data + len);
     this->data[key] = vec;
+    this->dirty_.insert(key);
     return true;
   }
 
@@ -53,9 +62,20 @@ class HostPreferences : public ESPPreferences {
 
  protected:
   void setup_();
+  /// Append the changed records to the end of the log.
+  bool append_();
+  /// Rewrite the log with only the latest record of each key.
+  bool compact_();
   bool setup_complete_{};
+  /// Rewrite the whole log on the next sync, e.g. after a reset.
+  bool needs_compaction_{};
+  /// Size of the log file, including records that have since been superseded.
+  size_t log_size_{};
   std::string filename_{};
   std::map<uint32_t, std::vector<uint8_t>> data{};
+  /// Keys that have changed since the last sync.
+  std::set<uint32_t> dirty_{};
+  ESPPreferencesStats stats_{};
 };
 void setup_preferences();
 extern HostPreferences *host_preferences;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
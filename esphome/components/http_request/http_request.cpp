@@ -3,6 +3,7 @@
 #include "esphome/core/log.h"
 
 #include <cinttypes>
+#include <cstring>
 
 namespace esphome {
 namespace http_request {
@@ -15,10 +16,102 @@ void HttpRequestComponent::dump_config() {
   ESP_LOGCONFIG(TAG, "  User-Agent: %s", this->useragent_);
   ESP_LOGCONFIG(TAG, "  Follow redirects: %s", YESNO(this->follow_redirects_));
   ESP_LOGCONFIG(TAG, "  Redirect limit: %d", this->redirect_limit_);
+  ESP_LOGCONFIG(TAG, "  Keep alive: %s", YESNO(this->keep_alive_));
   if (this->watchdog_timeout_ > 0) {
     ESP_LOGCONFIG(TAG, "  Watchdog Timeout: %" PRIu32 "ms", this->watchdog_timeout_);
   }
 }
 
+std::string get_url_origin(const std::string &url) {
+  size_t start = url.find("://");
+  if (start == std::string::npos)
+    return {};
+  start += 3;
+  size_t end = url.find_first_of("/?#", start);
+  if (end == std::string::npos)
+    end = url.size();
+  std::string origin = url.substr(0, start);
+  // credentials are sent with each request, they do not belong to the connection
+  size_t at = url.rfind('@', end);
+  if (at != std::string::npos && at >= start)
+    start = at + 1;
+  return origin + url.substr(start, end - start);
+}
+
+HttpStreamResult HttpContainer::stream(const HttpBodyCallback &callback, size_t chunk_size) {
+  HttpStream stream(chunk_size);
+  if (!stream.is_allocated()) {
+    ESP_LOGE(TAG, "Could not allocate %zu bytes for the response body", chunk_size);
+    return HTTP_STREAM_ERROR;
+  }
+  size_t last_read = this->bytes_read_;
+  uint32_t last_data = millis();
+  while (true) {
+    HttpStreamResult result = stream.poll(this, callback);
+    if (result != HTTP_STREAM_PENDING)
+      return result;
+
+    // feed watchdog and give other tasks a chance to run
+    App.feed_wdt();
+    yield();
+
+    uint32_t now = millis();
+    if (this->bytes_read_ != last_read) {
+      last_read = this->bytes_read_;
+      last_data = now;
+    } else if (now - last_data > this->parent_->get_timeout()) {
+      ESP_LOGE(TAG, "Timed out after reading %zu of %zu bytes", this->bytes_read_, this->content_length);
+      return HTTP_STREAM_ERROR;
+    }
+  }
+}
+
+HttpStream::HttpStream(size_t chunk_size) : size_(chunk_size) {
+  if (chunk_size > 0)
+    this->buffer_ = this->allocator_.allocate(chunk_size);
+}
+
+HttpStream::~HttpStream() {
+  if (this->buffer_ != nullptr)
+    this->allocator_.deallocate(this->buffer_, this->size_);
+}
+
+HttpStreamResult HttpStream::poll(HttpContainer *container, const HttpBodyCallback &callback) {
+  if (this->buffer_ == nullptr)
+    return HTTP_STREAM_ERROR;
+
+  bool complete = container->is_read_complete();
+  if (!complete && this->unread_ < this->size_) {
+    int len = container->read(this->buffer_ + this->unread_, this->size_ - this->unread_);
+    if (len < 0) {
+      ESP_LOGE(TAG, "Reading the response body failed after %zu bytes", container->get_bytes_read());
+      return HTTP_STREAM_ERROR;
+    }
+    this->unread_ += len;
+    complete = container->is_read_complete();
+  }
+  if (this->unread_ == 0)
+    return complete ? HTTP_STREAM_DONE : HTTP_STREAM_PENDING;
+
+  int used = callback(this->buffer_, this->unread_);
+  if (used < 0)
+    return HTTP_STREAM_STOPPED;
+  if (used == 0) {
+    // the consumer waits for more data, which only works if there is more and it fits
+    if (complete || this->unread_ == this->size_) {
+      ESP_LOGE(TAG, "Response body consumer is stuck with %zu bytes", this->unread_);
+      return HTTP_STREAM_ERROR;
+    }
+    return HTTP_STREAM_PENDING;
+  }
+  size_t consumed = std::min<size_t>(used, this->unread_);
+  this->unread_ -= consumed;
+  if (this->unread_ > 0) {
+    memmove(this->buffer_, this->buffer_ + consumed, this->unread_);
+    return HTTP_STREAM_PENDING;
+  }
+  return complete ? HTTP_STREAM_DONE : HTTP_STREAM_PENDING;
+}
+
 }  // namespace http_request
 }  // namespace esphome
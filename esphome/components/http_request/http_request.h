@@ -1,8 +1,10 @@
 #pragma once
 
+#include <functional>
 #include <list>
 #include <map>
 #include <memory>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -79,6 +81,49 @@ inline bool is_redirect(int const status) {
  */
 inline bool is_success(int const status) { return status >= HTTP_STATUS_OK && status < HTTP_STATUS_MULTIPLE_CHOICES; }
 
+/**
+ * @brief Checks if sending a request with the given method more than once has the same effect as sending it once.
+ *
+ * Only these requests are sent again when a kept connection turns out to be closed, as the server may have acted on
+ * the first attempt before it closed the connection.
+ *
+ * @param method the HTTP method, in upper case
+ * @return true for GET, HEAD, PUT, DELETE, OPTIONS and TRACE
+ */
+inline bool is_idempotent(const std::string &method) {
+  return method == "GET" || method == "HEAD" || method == "PUT" || method == "DELETE" || method == "OPTIONS" ||
+         method == "TRACE";
+}
+
+/**
+ * @brief Returns the scheme, host and port of an URL, e.g. "http://example.com:8080".
+ *
+ * Requests to the same origin can share a connection.
+ *
+ * @param url the URL to get the origin of
+ * @return the origin, or an empty string if the URL has no scheme
+ */
+std::string get_url_origin(const std::string &url);
+
+/**
+ * @brief Receives a part of a response body.
+ *
+ * The consumer returns the number of bytes it used. Bytes it did not use are passed again with the next call, followed
+ * by newly received data; no new data is received while the buffer is full. A negative value stops the transfer.
+ */
+using HttpBodyCallback = std::function<int(uint8_t *data, size_t len)>;
+
+enum HttpStreamResult : uint8_t {
+  /// More of the body is expected.
+  HTTP_STREAM_PENDING = 0,
+  /// The whole body was received and consumed.
+  HTTP_STREAM_DONE,
+  /// The consumer returned a negative value.
+  HTTP_STREAM_STOPPED,
+  /// Reading failed or timed out, or the consumer did not use any data while it could not get more.
+  HTTP_STREAM_ERROR,
+};
+
 class HttpRequestComponent;
 
 class HttpContainer : public Parented<HttpRequestComponent> {
@@ -91,15 +136,56 @@ class HttpContainer : public Parented<HttpRequestComponent> {
   virtual int read(uint8_t *buf, size_t max_len) = 0;
   virtual void end() = 0;
 
+  /**
+   * @brief Pass the whole body to `callback`, in chunks of up to `chunk_size` bytes.
+   *
+   * Blocks until the body was consumed, the consumer stopped or the connection timed out, while feeding the watchdog.
+   */
+  HttpStreamResult stream(const HttpBodyCallback &callback, size_t chunk_size);
+
   void set_secure(bool secure) { this->secure_ = secure; }
 
   size_t get_bytes_read() const { return this->bytes_read_; }
+  /// Whether the whole body was read from the connection.
+  bool is_read_complete() const { return this->bytes_read_ >= this->content_length; }
 
  protected:
   size_t bytes_read_{0};
   bool secure_{false};
 };
 
+/**
+ * @brief Reads a response body into a buffer of fixed size and hands it to a consumer, e.g. a decoder.
+ *
+ * Data is only read from the connection while there is room in the buffer, so a slow consumer holds back the sender
+ * instead of filling up memory. Call poll() repeatedly, e.g. from loop(), until it returns something other than
+ * HTTP_STREAM_PENDING.
+ */
+class HttpStream {
+ public:
+  explicit HttpStream(size_t chunk_size);
+  ~HttpStream();
+  HttpStream(const HttpStream &) = delete;
+  HttpStream &operator=(const HttpStream &) = delete;
+
+  /// Whether the buffer could be allocated.
+  bool is_allocated() const { return this->buffer_ != nullptr; }
+  size_t get_chunk_size() const { return this->size_; }
+  /// Number of bytes that were received but not used by the consumer yet.
+  size_t get_buffered() const { return this->unread_; }
+
+  /// Read once from the container if there is room, and pass the buffered data to the consumer.
+  HttpStreamResult poll(HttpContainer *container, const HttpBodyCallback &callback);
+  /// Discard the buffered data.
+  void reset() { this->unread_ = 0; }
+
+ protected:
+  ExternalRAMAllocator<uint8_t> allocator_{ExternalRAMAllocator<uint8_t>::ALLOW_FAILURE};
+  uint8_t *buffer_{nullptr};
+  size_t size_;
+  size_t unread_{0};
+};
+
 class HttpRequestResponseTrigger : public Trigger<std::shared_ptr<HttpContainer>, std::string &> {
  public:
   void process(std::shared_ptr<HttpContainer> container, std::string &response_body) {
@@ -118,6 +204,8 @@ class HttpRequestComponent : public Component {
   uint32_t get_watchdog_timeout() const { return this->watchdog_timeout_; }
   void set_follow_redirects(bool follow_redirects) { this->follow_redirects_ = follow_redirects; }
   void set_redirect_limit(uint16_t limit) { this->redirect_limit_ = limit; }
+  void set_keep_alive(bool keep_alive) { this->keep_alive_ = keep_alive; }
+  uint16_t get_timeout() const { return this->timeout_; }
 
   std::shared_ptr<HttpContainer> get(std::string url) { return this->start(std::move(url), "GET", "", {}); }
   std::shared_ptr<HttpContainer> get(std::string url, std::list<Header> headers) {
@@ -136,6 +224,7 @@ class HttpRequestComponent : public Component {
  protected:
   const char *useragent_{nullptr};
   bool follow_redirects_{};
+  bool keep_alive_{false};
   uint16_t redirect_limit_{};
   uint16_t timeout_{4500};
   uint32_t watchdog_timeout_{0};
@@ -197,21 +286,17 @@ template<typename... Ts> class HttpRequestSendAction : public Action<Ts...> {
     size_t max_length = std::min(content_length, this->max_response_buffer_size_);
 
     std::string response_body;
-    if (this->capture_response_.value(x...)) {
-      ExternalRAMAllocator<uint8_t> allocator(ExternalRAMAllocator<uint8_t>::ALLOW_FAILURE);
-      uint8_t *buf = allocator.allocate(max_length);
-      if (buf != nullptr) {
-        size_t read_index = 0;
-        while (container->get_bytes_read() < max_length) {
-          int read = container->read(buf + read_index, std::min<size_t>(max_length - read_index, 512));
-          App.feed_wdt();
-          yield();
-          read_index += read;
-        }
-        response_body.reserve(read_index);
-        response_body.assign((char *) buf, read_index);
-        allocator.deallocate(buf, max_length);
-      }
+    if (this->capture_response_.value(x...) && max_length > 0) {
+      response_body.reserve(max_length);
+      container->stream(
+          [&response_body, max_length](uint8_t *data, size_t len) -> int {
+            if (response_body.size() >= max_length)
+              return -1;
+            size_t used = std::min(len, max_length - response_body.size());
+            response_body.append(reinterpret_cast<const char *>(data), used);
+            return used;
+          },
+          std::min<size_t>(max_length, 512));
     }
 
     if (this->response_triggers_.size() == 1) {
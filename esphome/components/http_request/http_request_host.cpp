@@ -0,0 +1,345 @@
+#include "http_request_host.h"
+
+#ifdef USE_HOST
+
+#include "esphome/core/application.h"
+#include "esphome/core/log.h"
+
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+
+namespace esphome {
+namespace http_request {
+
+static const char *const TAG = "http_request.host";
+
+static const size_t MAX_HEADER_SIZE = 8192;
+static const size_t MAX_IDLE_CONNECTIONS = 4;
+static const uint32_t KEEP_ALIVE_TIMEOUT = 10000;
+
+static bool send_all(int fd, const char *data, size_t len) {
+  while (len > 0) {
+    ssize_t sent = ::send(fd, data, len, 0);
+    if (sent <= 0)
+      return false;
+    data += sent;
+    len -= sent;
+  }
+  return true;
+}
+
+static std::string trim(const std::string &str, size_t begin, size_t end) {
+  while (begin < end && (str[begin] == ' ' || str[begin] == '\t'))
+    begin++;
+  while (end > begin && (str[end - 1] == ' ' || str[end - 1] == '\t'))
+    end--;
+  return str.substr(begin, end - begin);
+}
+
+std::shared_ptr<HttpContainer> HttpRequestHost::start(std::string url, std::string method, std::string body,
+                                                      std::list<Header> headers) {
+  return this->start_(url, method, body, headers, this->follow_redirects_ ? this->redirect_limit_ : 0, millis());
+}
+
+std::shared_ptr<HttpContainer> HttpRequestHost::start_(const std::string &url, const std::string &method,
+                                                       const std::string &body, const std::list<Header> &headers,
+                                                       uint16_t redirects_left, uint32_t start) {
+  size_t authority_start = url.find("://");
+  if (authority_start == std::string::npos || url.compare(0, authority_start, "http") != 0) {
+    this->status_momentary_error("failed", 1000);
+    ESP_LOGE(TAG, "HTTP Request failed; only http:// URLs are supported on the host; URL: %s", url.c_str());
+    return nullptr;
+  }
+  authority_start += 3;
+  size_t path_start = url.find_first_of("/?#", authority_start);
+  if (path_start == std::string::npos)
+    path_start = url.size();
+  std::string authority = url.substr(authority_start, path_start - authority_start);
+  std::string path = url.substr(path_start, url.find('#', path_start) - path_start);
+  if (path.empty() || path[0] != '/')
+    path.insert(0, "/");
+
+  std::string credentials;
+  size_t at = authority.rfind('@');
+  if (at != std::string::npos) {
+    credentials = authority.substr(0, at);
+    authority.erase(0, at + 1);
+  }
+  std::string host = authority;
+  std::string port = "80";
+  size_t host_end = authority[0] == '[' ? authority.find(']') : 0;
+  size_t colon = authority.find(':', host_end == std::string::npos ? 0 : host_end);
+  if (colon != std::string::npos) {
+    host = authority.substr(0, colon);
+    port = authority.substr(colon + 1);
+  }
+  if (host.size() > 1 && host[0] == '[')
+    host = host.substr(1, host.size() - 2);
+
+  std::string origin = get_url_origin(url);
+  // Only idempotent requests use a kept connection, so they can be sent again if the server closed it in the meantime.
+  // Other requests get a new connection, the server may have acted on them before the connection broke.
+  int fd = this->keep_alive_ && is_idempotent(method) ? this->take_idle_connection_(origin) : -1;
+  const bool reused = fd >= 0;
+  if (!reused)
+    fd = this->connect_(host, port);
+  if (fd < 0) {
+    this->status_momentary_error("failed", 1000);
+    return nullptr;
+  }
+
+  std::string request = method + " " + path + " HTTP/1.1\r\nHost: " + authority + "\r\n";
+  if (this->useragent_ != nullptr)
+    request += std::string("User-Agent: ") + this->useragent_ + "\r\n";
+  if (!credentials.empty()) {
+    request += "Authorization: Basic " +
+               base64_encode(reinterpret_cast<const uint8_t *>(credentials.data()), credentials.size()) + "\r\n";
+  }
+  request += this->keep_alive_ ? "Connection: keep-alive\r\n" : "Connection: close\r\n";
+  if (!body.empty() || method == "POST" || method == "PUT" || method == "PATCH")
+    request += "Content-Length: " + std::to_string(body.size()) + "\r\n";
+  for (const auto &header : headers)
+    request += std::string(header.name) + ": " + header.value + "\r\n";
+  request += "\r\n";
+
+  bool ok = send_all(fd, request.data(), request.size()) && send_all(fd, body.data(), body.size());
+
+  std::string head;
+  size_t head_end = std::string::npos;
+  while (ok && (head_end = head.find("\r\n\r\n")) == std::string::npos) {
+    char buf[512];
+    ssize_t len = ::recv(fd, buf, sizeof(buf), 0);
+    if (len <= 0 || head.size() > MAX_HEADER_SIZE) {
+      ok = false;
+      break;
+    }
+    head.append(buf, len);
+    App.feed_wdt();
+  }
+  if (!ok) {
+    ::close(fd);
+    if (reused) {
+      // the server closed the kept connection in the meantime
+      ESP_LOGV(TAG, "Kept connection to %s was closed, reconnecting", origin.c_str());
+      return this->start_(url, method, body, headers, redirects_left, start);
+    }
+    this->status_momentary_error("failed", 1000);
+    ESP_LOGE(TAG, "HTTP Request failed; no response; URL: %s", url.c_str());
+    return nullptr;
+  }
+
+  auto container = std::make_shared<HttpContainerHost>();
+  container->set_parent(this);
+  container->fd_ = fd;
+
+  size_t line_end = head.find("\r\n");
+  size_t status_start = head.find(' ');
+  if (head.compare(0, 5, "HTTP/") != 0 || status_start > line_end) {
+    this->status_momentary_error("failed", 1000);
+    ESP_LOGE(TAG, "HTTP Request failed; invalid response; URL: %s", url.c_str());
+    return nullptr;
+  }
+  container->status_code = atoi(head.c_str() + status_start + 1);
+  bool keep_alive = head.compare(0, 8, "HTTP/1.0") != 0;
+  bool has_length = false;
+  bool chunked = false;
+  std::string location;
+  while (line_end < head_end) {
+    size_t begin = line_end + 2;
+    line_end = head.find("\r\n", begin);
+    size_t colon = head.find(':', begin);
+    if (colon >= line_end)
+      continue;
+    std::string name = str_lower_case(trim(head, begin, colon));
+    std::string value = trim(head, colon + 1, line_end);
+    if (name == "content-length") {
+      container->content_length = strtoull(value.c_str(), nullptr, 10);
+      has_length = true;
+    } else if (name == "transfer-encoding") {
+      chunked = str_lower_case(value).find("chunked") != std::string::npos;
+    } else if (name == "connection") {
+      value = str_lower_case(value);
+      if (value == "close") {
+        keep_alive = false;
+      } else if (value == "keep-alive") {
+        keep_alive = true;
+      }
+    } else if (name == "location") {
+      location = value;
+    }
+  }
+  if (chunked) {
+    this->status_momentary_error("failed", 1000);
+    ESP_LOGE(TAG, "HTTP Request failed; chunked responses are not supported on the host; URL: %s", url.c_str());
+    return nullptr;
+  }
+  if (!has_length) {
+    if (method == "HEAD" || container->status_code == HTTP_STATUS_NO_CONTENT ||
+        container->status_code == HTTP_STATUS_NOT_MODIFIED) {
+      container->content_length = 0;
+    } else {
+      container->content_length = std::numeric_limits<size_t>::max();
+      container->until_close_ = true;
+      keep_alive = false;
+    }
+  }
+  container->pending_ = head.substr(head_end + 4);
+  if (this->keep_alive_ && keep_alive)
+    container->origin_ = origin;
+
+  if (is_redirect(container->status_code) && this->follow_redirects_ && !location.empty()) {
+    if (redirects_left > 0) {
+      if (location.find("://") == std::string::npos) {
+        if (location[0] == '/') {
+          location = origin + location;
+        } else {
+          location = origin + path.substr(0, path.rfind('/', path.find('?')) + 1) + location;
+        }
+      }
+      ESP_LOGV(TAG, "redirecting to url: %s", location.c_str());
+      container->origin_.clear();
+      container->end();
+      if (container->status_code == HTTP_STATUS_SEE_OTHER)
+        return this->start_(location, "GET", "", headers, redirects_left - 1, start);
+      return this->start_(location, method, body, headers, redirects_left - 1, start);
+    }
+    ESP_LOGW(TAG, "Reach redirect limit count=%d", this->redirect_limit_);
+  }
+
+  container->duration_ms = millis() - start;
+  if (!is_success(container->status_code)) {
+    ESP_LOGE(TAG, "HTTP Request failed; URL: %s; Code: %d", url.c_str(), container->status_code);
+    this->status_momentary_error("failed", 1000);
+  }
+  return container;
+}
+
+int HttpRequestHost::connect_(const std::string &host, const std::string &port) {
+  struct addrinfo hints {};
+  hints.ai_family = AF_UNSPEC;
+  hints.ai_socktype = SOCK_STREAM;
+  struct addrinfo *result = nullptr;
+  int err = getaddrinfo(host.c_str(), port.c_str(), &hints, &result);
+  if (err != 0) {
+    ESP_LOGE(TAG, "Could not resolve %s: %s", host.c_str(), gai_strerror(err));
+    return -1;
+  }
+  struct timeval timeout {};
+  timeout.tv_sec = this->timeout_ / 1000;
+  timeout.tv_usec = (this->timeout_ % 1000) * 1000;
+  int fd = -1;
+  for (auto *info = result; info != nullptr; info = info->ai_next) {
+    fd = ::socket(info->ai_family, info->ai_socktype, info->ai_protocol);
+    if (fd < 0) {
+      err = errno;
+      continue;
+    }
+    int enable = 1;
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+    if (::connect(fd, info->ai_addr, info->ai_addrlen) == 0)
+      break;
+    err = errno;
+    ::close(fd);
+    fd = -1;
+  }
+  freeaddrinfo(result);
+  if (fd < 0)
+    ESP_LOGE(TAG, "Could not connect to %s:%s: %s", host.c_str(), port.c_str(), strerror(err));
+  return fd;
+}
+
+int HttpRequestHost::take_idle_connection_(const std::string &origin) {
+  for (auto it = this->idle_connections_.begin(); it != this->idle_connections_.end(); ++it) {
+    if (it->origin != origin)
+      continue;
+    int fd = it->fd;
+    this->idle_connections_.erase(it);
+    ESP_LOGV(TAG, "Reusing connection to %s", origin.c_str());
+    return fd;
+  }
+  return -1;
+}
+
+void HttpRequestHost::keep_idle_connection_(const std::string &origin, int fd) {
+  if (this->idle_connections_.size() >= MAX_IDLE_CONNECTIONS) {
+    ::close(this->idle_connections_.front().fd);
+    this->idle_connections_.erase(this->idle_connections_.begin());
+  }
+  this->idle_connections_.push_back({origin, fd});
+  // set_timeout() of this class sets the request timeout
+  this->Component::set_timeout("keep_alive", KEEP_ALIVE_TIMEOUT, [this]() { this->close_idle_connections_(); });
+}
+
+void HttpRequestHost::close_idle_connections_() {
+  for (auto &idle : this->idle_connections_)
+    ::close(idle.fd);
+  this->idle_connections_.clear();
+}
+
+HttpContainerHost::~HttpContainerHost() {
+  if (this->fd_ >= 0)
+    ::close(this->fd_);
+}
+
+int HttpContainerHost::read(uint8_t *buf, size_t max_len) {
+  const uint32_t start = millis();
+  size_t len = std::min(max_len, this->content_length - this->bytes_read_);
+  if (len == 0 || this->fd_ < 0)
+    return 0;
+
+  ssize_t read_len;
+  if (this->pending_pos_ < this->pending_.size()) {
+    read_len = std::min(len, this->pending_.size() - this->pending_pos_);
+    memcpy(buf, this->pending_.data() + this->pending_pos_, read_len);
+    this->pending_pos_ += read_len;
+  } else {
+    App.feed_wdt();
+    read_len = ::recv(this->fd_, buf, len, 0);
+    if (read_len == 0) {
+      if (!this->until_close_) {
+        ESP_LOGE(TAG, "Connection closed after %zu of %zu bytes", this->bytes_read_, this->content_length);
+        read_len = -1;
+      } else {
+        // the server closed the connection, that was the whole body
+        this->content_length = this->bytes_read_;
+      }
+    } else if (read_len < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+      // timed out, nothing was received yet
+      read_len = 0;
+    }
+  }
+  if (read_len < 0) {
+    this->duration_ms += millis() - start;
+    return -1;
+  }
+  this->bytes_read_ += read_len;
+  this->duration_ms += millis() - start;
+  return read_len;
+}
+
+void HttpContainerHost::end() {
+  if (this->fd_ < 0)
+    return;
+  // the connection can only be used again once the whole response was read from it
+  if (!this->origin_.empty() && this->is_read_complete()) {
+    static_cast<HttpRequestHost *>(this->parent_)->keep_idle_connection_(this->origin_, this->fd_);
+  } else {
+    ::close(this->fd_);
+  }
+  this->fd_ = -1;
+}
+
+}  // namespace http_request
+}  // namespace esphome
+
+#endif  // USE_HOST
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "http_request.h"
+
+#ifdef USE_HOST
+
+#include <string>
+#include <vector>
+
+namespace esphome {
+namespace http_request {
+
+class HttpRequestHost;
+
+class HttpContainerHost : public HttpContainer {
+ public:
+  ~HttpContainerHost() override;
+  int read(uint8_t *buf, size_t max_len) override;
+  void end() override;
+
+ protected:
+  friend class HttpRequestHost;
+  int fd_{-1};
+  /// Origin the connection can be kept open for, empty if it must be closed.
+  std::string origin_{};
+  /// The body ends when the server closes the connection.
+  bool until_close_{false};
+  /// Body bytes that were received together with the response headers.
+  std::string pending_{};
+  size_t pending_pos_{0};
+};
+
+/// Plain HTTP/1.1 client on POSIX sockets, for running and testing configurations on the host.
+class HttpRequestHost : public HttpRequestComponent {
+ public:
+  std::shared_ptr<HttpContainer> start(std::string url, std::string method, std::string body,
+                                       std::list<Header> headers) override;
+
+ protected:
+  friend class HttpContainerHost;
+
+  struct IdleConnection {
+    std::string origin;
+    int fd;
+  };
+
+  std::shared_ptr<HttpContainer> start_(const std::string &url, const std::string &method, const std::string &body,
+                                        const std::list<Header> &headers, uint16_t redirects_left, uint32_t start);
+  int connect_(const std::string &host, const std::string &port);
+  /// Take the open connection to `origin`, or return -1.
+  int take_idle_connection_(const std::string &origin);
+  /// Keep a connection with a completely read response open for the next request to the same origin.
+  void keep_idle_connection_(const std::string &origin, int fd);
+  void close_idle_connections_();
+
+  std::vector<IdleConnection> idle_connections_{};
+};
+
+}  // namespace http_request
+}  // namespace esphome
+
+#endif  // USE_HOST
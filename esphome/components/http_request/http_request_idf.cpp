@@ -17,6 +17,10 @@ namespace http_request {
 
 static const char *const TAG = "http_request.idf";
 
+// Each kept connection holds its buffers and, for HTTPS, a TLS session
+static const size_t MAX_IDLE_CLIENTS = 1;
+static const uint32_t KEEP_ALIVE_TIMEOUT = 10000;
+
 void HttpRequestIDF::dump_config() {
   HttpRequestComponent::dump_config();
   ESP_LOGCONFIG(TAG, "  Buffer Size RX: %u", this->buffer_size_rx_);
@@ -74,28 +78,31 @@ std::shared_ptr<HttpContainer> HttpRequestIDF::start(std::string url, std::strin
   const uint32_t start = millis();
   watchdog::WatchdogManager wdm(this->get_watchdog_timeout());
 
-  esp_http_client_handle_t client = esp_http_client_init(&config);
+  std::string origin = this->keep_alive_ ? get_url_origin(url) : std::string();
+  // Only idempotent requests use a kept connection, so they can be sent again if the server closed it in the meantime.
+  // Other requests get a new connection, the server may have acted on them before the connection broke.
+  esp_http_client_handle_t client = is_idempotent(method) ? this->take_idle_client_(origin, url, method_idf) : nullptr;
+  const bool reused = client != nullptr;
+  if (!reused)
+    client = esp_http_client_init(&config);
 
   std::shared_ptr<HttpContainerIDF> container = std::make_shared<HttpContainerIDF>(client);
   container->set_parent(this);
+  container->origin_ = origin;
 
   container->set_secure(secure);
 
   for (const auto &header : headers) {
     esp_http_client_set_header(client, header.name, header.value);
+    if (!origin.empty())
+      container->header_names_.emplace_back(header.name);
   }
 
   const int body_len = body.length();
 
   esp_err_t err = esp_http_client_open(client, body_len);
-  if (err != ESP_OK) {
-    this->status_momentary_error("failed", 1000);
-    ESP_LOGE(TAG, "HTTP Request failed: %s", esp_err_to_name(err));
-    esp_http_client_cleanup(client);
-    return nullptr;
-  }
 
-  if (body_len > 0) {
+  if (err == ESP_OK && body_len > 0) {
     int write_left = body_len;
     int write_index = 0;
     const char *buf = body.c_str();
@@ -110,6 +117,12 @@ std::shared_ptr<HttpContainer> HttpRequestIDF::start(std::string url, std::strin
     }
   }
 
+  if (err != ESP_OK && reused) {
+    // the server closed the kept connection in the meantime
+    ESP_LOGV(TAG, "Kept connection to %s was closed, reconnecting", origin.c_str());
+    esp_http_client_cleanup(client);
+    return this->start(std::move(url), std::move(method), std::move(body), std::move(headers));
+  }
   if (err != ESP_OK) {
     this->status_momentary_error("failed", 1000);
     ESP_LOGE(TAG, "HTTP Request failed: %s", esp_err_to_name(err));
@@ -118,7 +131,13 @@ std::shared_ptr<HttpContainer> HttpRequestIDF::start(std::string url, std::strin
   }
 
   App.feed_wdt();
-  container->content_length = esp_http_client_fetch_headers(client);
+  const int64_t content_length = esp_http_client_fetch_headers(client);
+  if (content_length < 0 && reused) {
+    ESP_LOGV(TAG, "Kept connection to %s was closed, reconnecting", origin.c_str());
+    esp_http_client_cleanup(client);
+    return this->start(std::move(url), std::move(method), std::move(body), std::move(headers));
+  }
+  container->content_length = content_length;
   App.feed_wdt();
   container->status_code = esp_http_client_get_status_code(client);
   App.feed_wdt();
@@ -130,6 +149,8 @@ std::shared_ptr<HttpContainer> HttpRequestIDF::start(std::string url, std::strin
   if (this->follow_redirects_) {
     auto num_redirects = this->redirect_limit_;
     while (is_redirect(container->status_code) && num_redirects > 0) {
+      // the connection may end up at another origin
+      container->origin_.clear();
       err = esp_http_client_set_redirection(client);
       if (err != ESP_OK) {
         ESP_LOGE(TAG, "esp_http_client_set_redirection failed: %s", esp_err_to_name(err));
@@ -197,10 +218,57 @@ int HttpContainerIDF::read(uint8_t *buf, size_t max_len) {
 void HttpContainerIDF::end() {
   watchdog::WatchdogManager wdm(this->parent_->get_watchdog_timeout());
 
+  // the connection can only be used again once the whole response was read from it
+  if (!this->origin_.empty() && esp_http_client_is_complete_data_received(this->client_)) {
+    static_cast<HttpRequestIDF *>(this->parent_)->keep_idle_client_(this);
+    return;
+  }
   esp_http_client_close(this->client_);
   esp_http_client_cleanup(this->client_);
 }
 
+esp_http_client_handle_t HttpRequestIDF::take_idle_client_(const std::string &origin, const std::string &url,
+                                                           esp_http_client_method_t method) {
+  if (origin.empty())
+    return nullptr;
+  for (auto it = this->idle_clients_.begin(); it != this->idle_clients_.end(); ++it) {
+    if (it->origin != origin)
+      continue;
+    esp_http_client_handle_t client = it->client;
+    for (const auto &name : it->header_names)
+      esp_http_client_delete_header(client, name.c_str());
+    this->idle_clients_.erase(it);
+    if (esp_http_client_set_url(client, url.c_str()) != ESP_OK ||
+        esp_http_client_set_method(client, method) != ESP_OK) {
+      esp_http_client_close(client);
+      esp_http_client_cleanup(client);
+      return nullptr;
+    }
+    ESP_LOGV(TAG, "Reusing connection to %s", origin.c_str());
+    return client;
+  }
+  return nullptr;
+}
+
+void HttpRequestIDF::keep_idle_client_(HttpContainerIDF *container) {
+  if (this->idle_clients_.size() >= MAX_IDLE_CLIENTS) {
+    esp_http_client_close(this->idle_clients_.front().client);
+    esp_http_client_cleanup(this->idle_clients_.front().client);
+    this->idle_clients_.erase(this->idle_clients_.begin());
+  }
+  this->idle_clients_.push_back({container->origin_, container->client_, std::move(container->header_names_)});
+  // set_timeout() of this class sets the request timeout
+  this->Component::set_timeout("keep_alive", KEEP_ALIVE_TIMEOUT, [this]() { this->close_idle_clients_(); });
+}
+
+void HttpRequestIDF::close_idle_clients_() {
+  for (auto &idle : this->idle_clients_) {
+    esp_http_client_close(idle.client);
+    esp_http_client_cleanup(idle.client);
+  }
+  this->idle_clients_.clear();
+}
+
 }  // namespace http_request
 }  // namespace esphome
 
@@ -4,6 +4,9 @@
 
 #ifdef USE_ESP_IDF
 
+#include <string>
+#include <vector>
+
 #include <esp_event.h>
 #include <esp_http_client.h>
 #include <esp_netif.h>
@@ -12,6 +15,8 @@
 namespace esphome {
 namespace http_request {
 
+class HttpRequestIDF;
+
 class HttpContainerIDF : public HttpContainer {
  public:
   HttpContainerIDF(esp_http_client_handle_t client) : client_(client) {}
@@ -19,7 +24,12 @@ class HttpContainerIDF : public HttpContainer {
   void end() override;
 
  protected:
+  friend class HttpRequestIDF;
   esp_http_client_handle_t client_;
+  /// Origin the connection can be kept open for, empty if it must be closed.
+  std::string origin_{};
+  /// Names of the request headers, which have to be removed before the client is used again.
+  std::vector<std::string> header_names_{};
 };
 
 class HttpRequestIDF : public HttpRequestComponent {
@@ -33,9 +43,25 @@ class HttpRequestIDF : public HttpRequestComponent {
   void set_buffer_size_tx(uint16_t buffer_size_tx) { this->buffer_size_tx_ = buffer_size_tx; }
 
  protected:
+  friend class HttpContainerIDF;
+
+  struct IdleClient {
+    std::string origin;
+    esp_http_client_handle_t client;
+    std::vector<std::string> header_names;
+  };
+
+  /// Take the open connection to the origin of `url` and prepare it for the next request, or return nullptr.
+  esp_http_client_handle_t take_idle_client_(const std::string &origin, const std::string &url,
+                                             esp_http_client_method_t method);
+  /// Keep a client with a completely read response open for the next request to the same origin.
+  void keep_idle_client_(HttpContainerIDF *container);
+  void close_idle_clients_();
+
   // if zero ESP-IDF will use DEFAULT_HTTP_BUF_SIZE
   uint16_t buffer_size_rx_{};
   uint16_t buffer_size_tx_{};
+  std::vector<IdleClient> idle_clients_{};
 };
 
 }  // namespace http_request
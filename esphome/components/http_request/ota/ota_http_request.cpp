@@ -85,7 +85,6 @@ void OtaHttpRequestComponent::cleanup_(std::unique_ptr<ota::OTABackend> backend,
 };
 
 uint8_t OtaHttpRequestComponent::do_ota_() {
-  uint8_t buf[OtaHttpRequestComponent::HTTP_RECV_BUFFER + 1];
   uint32_t last_progress = 0;
   uint32_t update_start_time = millis();
   md5::MD5Digest md5_receive;
@@ -123,47 +122,47 @@ uint8_t OtaHttpRequestComponent::do_ota_() {
     return error_code;
   }
 
-  while (container->get_bytes_read() < container->content_length) {
-    // read a maximum of chunk_size bytes into buf. (real read size returned)
-    int bufsize = container->read(buf, OtaHttpRequestComponent::HTTP_RECV_BUFFER);
-    ESP_LOGVV(TAG, "bytes_read_ = %u, body_length_ = %u, bufsize = %i", container->get_bytes_read(),
-              container->content_length, bufsize);
-
-    // feed watchdog and give other tasks a chance to run
-    App.feed_wdt();
-    yield();
-
-    if (bufsize < 0) {
-      ESP_LOGE(TAG, "Stream closed");
-      this->cleanup_(std::move(backend), container);
-      return OTA_CONNECTION_ERROR;
-    } else if (bufsize > 0 && bufsize <= OtaHttpRequestComponent::HTTP_RECV_BUFFER) {
-      // add read bytes to MD5
-      md5_receive.add(buf, bufsize);
-
-      // write bytes to OTA backend
-      this->update_started_ = true;
-      error_code = backend->write(buf, bufsize);
-      if (error_code != ota::OTA_RESPONSE_OK) {
-        // error code explanation available at
-        // https://github.com/esphome/esphome/blob/dev/esphome/components/ota/ota_backend.h
-        ESP_LOGE(TAG, "Error code (%02X) writing binary data to flash at offset %d and size %d", error_code,
-                 container->get_bytes_read() - bufsize, container->content_length);
-        this->cleanup_(std::move(backend), container);
-        return error_code;
-      }
-    }
-
-    uint32_t now = millis();
-    if ((now - last_progress > 1000) or (container->get_bytes_read() == container->content_length)) {
-      last_progress = now;
-      float percentage = container->get_bytes_read() * 100.0f / container->content_length;
-      ESP_LOGD(TAG, "Progress: %0.1f%%", percentage);
+  // the body is handed over in chunks of up to HTTP_RECV_BUFFER bytes; nothing more is read while a chunk is written
+  auto result = container->stream(
+      [&](uint8_t *data, size_t len) -> int {
+        ESP_LOGVV(TAG, "bytes_read_ = %u, body_length_ = %u, len = %u", container->get_bytes_read(),
+                  container->content_length, len);
+        // add read bytes to MD5
+        md5_receive.add(data, len);
+
+        // write bytes to OTA backend
+        this->update_started_ = true;
+        error_code = backend->write(data, len);
+        if (error_code != ota::OTA_RESPONSE_OK) {
+          // error code explanation available at
+          // https://github.com/esphome/esphome/blob/dev/esphome/components/ota/ota_backend.h
+          ESP_LOGE(TAG, "Error code (%02X) writing binary data to flash at offset %d and size %d", error_code,
+                   container->get_bytes_read() - len, container->content_length);
+          return -1;
+        }
+
+        uint32_t now = millis();
+        if ((now - last_progress > 1000) or (container->get_bytes_read() == container->content_length)) {
+          last_progress = now;
+          float percentage = container->get_bytes_read() * 100.0f / container->content_length;
+          ESP_LOGD(TAG, "Progress: %0.1f%%", percentage);
 #ifdef USE_OTA_STATE_CALLBACK
-      this->state_callback_.call(ota::OTA_IN_PROGRESS, percentage, 0);
+          this->state_callback_.call(ota::OTA_IN_PROGRESS, percentage, 0);
 #endif
-    }
-  }  // while
+        }
+        return len;
+      },
+      OtaHttpRequestComponent::HTTP_RECV_BUFFER);
+
+  if (result == HTTP_STREAM_STOPPED) {
+    this->cleanup_(std::move(backend), container);
+    return error_code;
+  }
+  if (result != HTTP_STREAM_DONE) {
+    ESP_LOGE(TAG, "Stream closed");
+    this->cleanup_(std::move(backend), container);
+    return OTA_CONNECTION_ERROR;
+  }
 
   ESP_LOGI(TAG, "Done in %.0f seconds", float(millis() - update_start_time) / 1000);
 
@@ -244,17 +243,20 @@ bool OtaHttpRequestComponent::http_get_md5_() {
     return false;
   }
 
-  this->md5_expected_.resize(MD5_SIZE);
-  int read_len = 0;
-  while (container->get_bytes_read() < MD5_SIZE) {
-    read_len = container->read((uint8_t *) this->md5_expected_.data(), MD5_SIZE);
-    App.feed_wdt();
-    yield();
-  }
+  this->md5_expected_.clear();
+  this->md5_expected_.reserve(MD5_SIZE);
+  container->stream(
+      [this](uint8_t *data, size_t len) -> int {
+        size_t used = std::min<size_t>(len, MD5_SIZE - this->md5_expected_.size());
+        this->md5_expected_.append(reinterpret_cast<const char *>(data), used);
+        // anything after the hash is not needed
+        return this->md5_expected_.size() < MD5_SIZE ? used : -1;
+      },
+      MD5_SIZE);
   container->end();
 
-  ESP_LOGV(TAG, "Read len: %u, MD5 expected: %u", read_len, MD5_SIZE);
-  return read_len == MD5_SIZE;
+  ESP_LOGV(TAG, "Read len: %u, MD5 expected: %u", this->md5_expected_.size(), MD5_SIZE);
+  return this->md5_expected_.size() == MD5_SIZE;
 }
 
 bool OtaHttpRequestComponent::validate_url_(const std::string &url) {
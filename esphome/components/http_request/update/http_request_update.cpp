@@ -37,30 +37,21 @@ void HttpRequestUpdate::update() {
     return;
   }
 
-  ExternalRAMAllocator<uint8_t> allocator(ExternalRAMAllocator<uint8_t>::ALLOW_FAILURE);
-  uint8_t *data = allocator.allocate(container->content_length);
-  if (data == nullptr) {
-    std::string msg = str_sprintf("Failed to allocate %d bytes for manifest", container->content_length);
+  std::string response;
+  auto result = container->stream(
+      [&response](uint8_t *data, size_t len) -> int {
+        response.append(reinterpret_cast<const char *>(data), len);
+        return len;
+      },
+      MAX_READ_SIZE);
+  container->end();
+
+  if (result != HTTP_STREAM_DONE) {
+    std::string msg = str_sprintf("Failed to read manifest from %s", this->source_url_.c_str());
     this->status_set_error(msg.c_str());
-    container->end();
     return;
   }
 
-  size_t read_index = 0;
-  while (container->get_bytes_read() < container->content_length) {
-    int read_bytes = container->read(data + read_index, MAX_READ_SIZE);
-
-    App.feed_wdt();
-    yield();
-
-    read_index += read_bytes;
-  }
-
-  std::string response((char *) data, read_index);
-  allocator.deallocate(data, container->content_length);
-
-  container->end();
-
   bool valid = json::parse_json(response, [this](JsonObject root) -> bool {
     if (!root.containsKey("name") || !root.containsKey("version") || !root.containsKey("builds")) {
       ESP_LOGE(TAG, "Manifest does not contain required fields");
@@ -17,7 +17,7 @@ from esphome.const import (
     PLATFORM_ESP8266,
     PLATFORM_RP2040,
 )
-from esphome.core import coroutine_with_priority, CORE
+from esphome.core import coroutine_with_priority, CORE, ID
 
 CODEOWNERS = ["@esphome/core"]
 i2c_ns = cg.esphome_ns.namespace("i2c")
@@ -25,8 +25,11 @@ I2CBus = i2c_ns.class_("I2CBus")
 ArduinoI2CBus = i2c_ns.class_("ArduinoI2CBus", I2CBus, cg.Component)
 IDFI2CBus = i2c_ns.class_("IDFI2CBus", I2CBus, cg.Component)
 I2CDevice = i2c_ns.class_("I2CDevice")
+I2CScheduler = i2c_ns.class_("I2CScheduler", cg.Component)
 
 
+KEY_I2C_SCHEDULER = "i2c_scheduler"
+
 CONF_SDA_PULLUP_ENABLED = "sda_pullup_enabled"
 CONF_SCL_PULLUP_ENABLED = "scl_pullup_enabled"
 MULTI_CONF = True
@@ -122,6 +125,20 @@ async def register_i2c_device(var, config):
     cg.add(var.set_i2c_address(config[CONF_ADDRESS]))
 
 
+async def get_scheduler():
+    """Get the scheduler that runs queued i2c transactions of all devices, it is created on first use.
+
+    This is a coroutine, you need to await it with a 'await' expression!
+    """
+    if KEY_I2C_SCHEDULER not in CORE.data:
+        var = cg.new_Pvariable(
+            ID(KEY_I2C_SCHEDULER, is_declaration=True, type=I2CScheduler)
+        )
+        await cg.register_component(var, {})
+        CORE.data[KEY_I2C_SCHEDULER] = var
+    return CORE.data[KEY_I2C_SCHEDULER]
+
+
 def final_validate_device_schema(
     name: str,
     *,
@@ -139,6 +139,10 @@ class I2CDevice {
   /// @param address of the device
   void set_i2c_address(uint8_t address) { address_ = address; }
 
+  /// @brief returns the address of the device on the bus
+  /// @return address of the device
+  uint8_t get_i2c_address() const { return address_; }
+
   /// @brief we store the pointer to the I2CBus to use
   /// @param bus pointer to the I2CBus object
   void set_i2c_bus(I2CBus *bus) { bus_ = bus; }
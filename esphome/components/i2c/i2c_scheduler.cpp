@@ -0,0 +1,163 @@
+#include "i2c_scheduler.h"
+#include "esphome/core/hal.h"
+#include "esphome/core/log.h"
+
+#include <algorithm>
+#include <cinttypes>
+
+namespace esphome {
+namespace i2c {
+
+static const char *const TAG = "i2c.scheduler";
+
+// A waiting transaction is resumed together with another one that is due at most this much later.
+static const uint32_t ALIGN_WINDOW_MS = 4;
+
+I2CTransaction &I2CTransaction::add_step_(const Step &step) {
+  if (this->step_count_ == MAX_STEPS) {
+    ESP_LOGE(TAG, "Too many steps in transaction for 0x%02X", this->device_->get_i2c_address());
+    return *this;
+  }
+  this->steps_[this->step_count_++] = step;
+  return *this;
+}
+
+I2CTransaction &I2CTransaction::write(const uint8_t *data, size_t len, bool stop) {
+  // the data is only read, the pointer is not const to share the step struct with reads
+  return this->add_step_({STEP_WRITE, stop, 0, const_cast<uint8_t *>(data), static_cast<uint32_t>(len)});
+}
+
+I2CTransaction &I2CTransaction::read(uint8_t *data, size_t len) {
+  return this->add_step_({STEP_READ, true, 0, data, static_cast<uint32_t>(len)});
+}
+
+I2CTransaction &I2CTransaction::read_register(uint8_t a_register, uint8_t *data, size_t len, bool stop) {
+  return this->add_step_({STEP_READ_REGISTER, stop, a_register, data, static_cast<uint32_t>(len)});
+}
+
+I2CTransaction &I2CTransaction::delay(uint32_t ms) { return this->add_step_({STEP_DELAY, true, 0, nullptr, ms}); }
+
+I2CTransaction &I2CTransaction::clear() {
+  if (!this->pending_)
+    this->step_count_ = 0;
+  return *this;
+}
+
+bool I2CScheduler::submit(I2CTransaction *transaction) {
+  if (transaction->pending_ || transaction->step_count_ == 0)
+    return false;
+  if (std::find(this->transactions_.begin(), this->transactions_.end(), transaction) == this->transactions_.end())
+    this->transactions_.push_back(transaction);
+
+  transaction->pending_ = true;
+  transaction->next_step_ = 0;
+  transaction->bus_time_us_ = 0;
+  transaction->resume_at_ = millis();
+  transaction->due_at_ = transaction->resume_at_;
+  this->pending_.push_back(transaction);
+  // run on the next loop iteration, together with all other transactions submitted until then
+  this->schedule_run_(0);
+  return true;
+}
+
+void I2CScheduler::schedule_run_(uint32_t delay) {
+  this->set_timeout("run", delay, [this]() { this->run_(); });
+}
+
+void I2CScheduler::run_() {
+  // transactions submitted by callbacks during this pass are left for the next one
+  size_t count = this->pending_.size();
+  for (size_t i = 0; i < count;) {
+    I2CTransaction *transaction = this->pending_[i];
+    if (static_cast<int32_t>(transaction->resume_at_ - millis()) > 0) {
+      i++;
+      continue;
+    }
+
+    ErrorCode err = ERROR_OK;
+    bool waiting = false;
+    while (transaction->next_step_ != transaction->step_count_) {
+      const auto &step = transaction->steps_[transaction->next_step_++];
+      if (step.type == I2CTransaction::STEP_DELAY) {
+        uint32_t due_at = millis() + step.len;
+        uint32_t resume_at = due_at;
+        // share the wake up with another waiting transaction that is due shortly after
+        for (auto *other : this->pending_) {
+          uint32_t diff = other->resume_at_ - due_at;
+          if (other != transaction && other->next_step_ != 0 && diff <= ALIGN_WINDOW_MS) {
+            resume_at = other->resume_at_;
+            break;
+          }
+        }
+        // and let those that are due shortly before wait for this one, as long as they are not delayed by more than
+        // the window in total
+        for (auto *other : this->pending_) {
+          if (other != transaction && other->next_step_ != 0 &&
+              static_cast<int32_t>(resume_at - other->resume_at_) > 0 && resume_at - other->due_at_ <= ALIGN_WINDOW_MS)
+            other->resume_at_ = resume_at;
+        }
+        transaction->due_at_ = due_at;
+        transaction->resume_at_ = resume_at;
+        waiting = true;
+        break;
+      }
+
+      uint32_t start = micros();
+      if (step.type == I2CTransaction::STEP_READ) {
+        err = transaction->device_->read(step.data, step.len);
+      } else if (step.type == I2CTransaction::STEP_READ_REGISTER) {
+        err = transaction->device_->read_register(step.a_register, step.data, step.len, step.stop);
+      } else {
+        err = transaction->device_->write(step.data, step.len, step.stop);
+      }
+      transaction->bus_time_us_ += micros() - start;
+      if (err != ERROR_OK)
+        break;
+    }
+    if (waiting) {
+      i++;
+      continue;
+    }
+
+    // the transaction is complete
+    auto &stats = transaction->stats_;
+    stats.transactions++;
+    stats.bus_time_us += transaction->bus_time_us_;
+    stats.max_bus_time_us = std::max(stats.max_bus_time_us, transaction->bus_time_us_);
+    if (err != ERROR_OK) {
+      stats.errors++;
+      ESP_LOGV(TAG, "Transaction for 0x%02X failed at step %u: error %d", transaction->device_->get_i2c_address(),
+               transaction->next_step_ - 1, err);
+    }
+    this->pending_.erase(this->pending_.begin() + i);
+    count--;
+    transaction->pending_ = false;
+    if (transaction->callback_)
+      transaction->callback_(err);
+  }
+
+  if (this->pending_.empty())
+    return;
+  uint32_t now = millis();
+  uint32_t delay = UINT32_MAX;
+  for (auto *transaction : this->pending_) {
+    int32_t remaining = static_cast<int32_t>(transaction->resume_at_ - now);
+    delay = std::min(delay, remaining > 0 ? static_cast<uint32_t>(remaining) : 0u);
+  }
+  this->schedule_run_(delay);
+}
+
+void I2CScheduler::dump_config() {
+  ESP_LOGCONFIG(TAG, "I2C Scheduler:");
+  for (auto *transaction : this->transactions_) {
+    const auto &stats = transaction->stats_;
+    ESP_LOGCONFIG(TAG,
+                  "  0x%02X: %" PRIu32 " transactions, %" PRIu32 " errors, bus time total %" PRIu64
+                  "us, max %" PRIu32 "us",
+                  transaction->device_->get_i2c_address(), stats.transactions, stats.errors, stats.bus_time_us,
+                  stats.max_bus_time_us);
+  }
+}
+
+}  // namespace i2c
+}  // namespace esphome
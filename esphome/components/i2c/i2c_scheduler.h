@@ -0,0 +1,111 @@
+#pragma once
+
+#include "esphome/core/component.h"
+#include "i2c.h"
+
+#include <functional>
+#include <vector>
+
+namespace esphome {
+namespace i2c {
+
+/// @brief Statistics of the transactions that were run for one device.
+struct I2CTransactionStats {
+  uint32_t transactions{0};     ///< number of completed transactions
+  uint32_t errors{0};           ///< number of transactions that failed
+  uint64_t bus_time_us{0};      ///< total time spent in bus transfers
+  uint32_t max_bus_time_us{0};  ///< longest time spent in the bus transfers of a single transaction
+};
+
+/// @brief A chain of writes, reads and delays that is run for an I2CDevice by the I2CScheduler.
+/// @details The transaction is described once, usually in setup(), and can then be submitted again for every
+/// measurement. All buffers must remain valid while the transaction is pending.
+/// @n typical usage:
+/// @code
+/// // setup()
+/// this->transaction_.write(CMD, 1).delay(10).read(this->data_, 6).set_callback([this](i2c::ErrorCode err) {
+///   ...
+/// });
+/// // update()
+/// this->scheduler_->submit(&this->transaction_);
+/// @endcode
+class I2CTransaction {
+ public:
+  static const uint8_t MAX_STEPS = 8;
+
+  explicit I2CTransaction(I2CDevice *device) : device_(device) {}
+
+  /// @brief Add a write of a buffer to the device.
+  /// @param stop True will send a stop message, False will send a restart for a following read.
+  I2CTransaction &write(const uint8_t *data, size_t len, bool stop = true);
+  /// @brief Add a read of a buffer from the device.
+  I2CTransaction &read(uint8_t *data, size_t len);
+  /// @brief Add a read of a register: the register address is written, followed by a read of the buffer.
+  /// @param stop True will send a stop message after the register address, False will send a restart.
+  I2CTransaction &read_register(uint8_t a_register, uint8_t *data, size_t len, bool stop = true);
+  /// @brief Add a wait, e.g. for a conversion to complete. The bus is released for other devices meanwhile.
+  I2CTransaction &delay(uint32_t ms);
+  /// @brief Remove all steps, to describe a different transaction.
+  I2CTransaction &clear();
+
+  /// @brief Set the function that is called with the result of the transaction. It may submit the transaction again.
+  void set_callback(std::function<void(ErrorCode)> &&callback) { this->callback_ = std::move(callback); }
+
+  bool is_pending() const { return this->pending_; }
+  const I2CTransactionStats &get_stats() const { return this->stats_; }
+  I2CDevice *get_device() const { return this->device_; }
+
+ protected:
+  friend class I2CScheduler;
+
+  enum StepType : uint8_t { STEP_WRITE, STEP_READ, STEP_READ_REGISTER, STEP_DELAY };
+  struct Step {
+    StepType type;
+    bool stop;
+    uint8_t a_register;
+    uint8_t *data;
+    uint32_t len;  ///< number of bytes, or the delay in ms
+  };
+
+  I2CTransaction &add_step_(const Step &step);
+
+  I2CDevice *device_;
+  Step steps_[MAX_STEPS];
+  uint8_t step_count_{0};
+  uint8_t next_step_{0};
+  bool pending_{false};
+  uint32_t resume_at_{0};
+  uint32_t due_at_{0};  ///< when the current delay ends, resume_at_ may be later to share the wake up
+  uint32_t bus_time_us_{0};
+  I2CTransactionStats stats_{};
+  std::function<void(ErrorCode)> callback_{};
+};
+
+/// @brief Runs queued I2CTransactions of all devices that use it.
+/// @details Transactions that are submitted in the same loop iteration are started back-to-back, so their delays
+/// run concurrently. A transaction that has to wait is resumed together with other waiting transactions if they are
+/// due shortly before or after it, so devices that are polled at the same interval are read in a single pass. A single
+/// timer is used for all transactions instead of one per device.
+class I2CScheduler : public Component {
+ public:
+  void dump_config() override;
+  float get_setup_priority() const override { return setup_priority::BUS; }
+
+  /// @brief Queue a transaction to be run.
+  /// @return false if the transaction is still pending from an earlier submission or has no steps.
+  bool submit(I2CTransaction *transaction);
+
+  const std::vector<I2CTransaction *> &get_transactions() const { return this->transactions_; }
+
+ protected:
+  void run_();
+  void schedule_run_(uint32_t delay);
+
+  /// All transactions that were ever submitted, for the statistics.
+  std::vector<I2CTransaction *> transactions_{};
+  /// Transactions that have not completed yet, in submission order.
+  std::vector<I2CTransaction *> pending_{};
+};
+
+}  // namespace i2c
+}  // namespace esphome
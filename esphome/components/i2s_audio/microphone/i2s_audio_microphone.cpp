@@ -4,6 +4,7 @@
 
 #include <driver/i2s.h>
 
+#include "esphome/components/audio/audio.h"
 #include "esphome/core/hal.h"
 #include "esphome/core/log.h"
 
@@ -176,10 +177,8 @@ size_t I2SAudioMicrophone::read(int16_t *buf, size_t len) {
     case I2S_BITS_PER_SAMPLE_24BIT:
     case I2S_BITS_PER_SAMPLE_32BIT: {
       size_t samples_read = bytes_read / sizeof(int32_t);
-      for (size_t i = 0; i < samples_read; i++) {
-        int32_t temp = reinterpret_cast<int32_t *>(buf)[i] >> 14;
-        buf[i] = clamp<int16_t>(temp, INT16_MIN, INT16_MAX);
-      }
+      // buf is only guaranteed to be aligned for 16 bit samples, e.g. when reading into an audio ring
+      audio::convert_s32_to_s16(buf, buf, samples_read, 14);
       return samples_read * sizeof(int16_t);
     }
     default:
@@ -249,7 +249,9 @@ void ILI9XXXDisplay::display_() {
     this->write_array(this->buffer_ + this->y_low_ * this->width_ * 2, h * this->width_ * 2);
   } else {
     ESP_LOGV(TAG, "Doing multiple write");
-    uint8_t transfer_buffer[ILI9XXX_TRANSFER_BUFFER_SIZE];
+    // one buffer is converted while the other one is being sent
+    alignas(4) uint8_t transfer_buffers[2][ILI9XXX_TRANSFER_BUFFER_SIZE];
+    uint8_t *transfer_buffer = transfer_buffers[0];
     size_t rem = h * w;  // remaining number of pixels to write
     set_addr_window_(this->x_low_, this->y_low_, this->x_high_, this->y_high_);
     size_t idx = 0;    // index into transfer_buffer
@@ -278,8 +280,9 @@ void ILI9XXXDisplay::display_() {
         put16_be(transfer_buffer + idx, color_val);
         idx += 2;
       }
-      if (idx == sizeof(transfer_buffer)) {
-        this->write_array(transfer_buffer, idx);
+      if (idx == ILI9XXX_TRANSFER_BUFFER_SIZE) {
+        this->queue_write_array(transfer_buffer, idx);
+        transfer_buffer = transfer_buffer == transfer_buffers[0] ? transfer_buffers[1] : transfer_buffers[0];
         idx = 0;
         App.feed_wdt();
       }
@@ -291,7 +294,7 @@ void ILI9XXXDisplay::display_() {
     }
     // flush any balance.
     if (idx != 0) {
-      this->write_array(transfer_buffer, idx);
+      this->queue_write_array(transfer_buffer, idx);
     }
   }
   this->end_data_();
@@ -330,8 +333,10 @@ void ILI9XXXDisplay::draw_pixels_at(int x_start, int y_start, int w, int h, cons
       }
     }
   } else {
-    // 18 bit mode
-    uint8_t transfer_buffer[ILI9XXX_TRANSFER_BUFFER_SIZE * 4];
+    // 18 bit mode, one buffer is converted while the other one is being sent. Both halves together take the same
+    // 504 bytes of stack as the single buffer did, this can be called from deep within the LVGL renderer.
+    alignas(4) uint8_t transfer_buffers[2][ILI9XXX_TRANSFER_BUFFER_SIZE * 2];
+    uint8_t *transfer_buffer = transfer_buffers[0];
     ESP_LOGV(TAG, "Doing multiple write");
     size_t rem = h * w;  // remaining number of pixels to write
     size_t idx = 0;      // index into transfer_buffer
@@ -343,8 +348,9 @@ void ILI9XXXDisplay::draw_pixels_at(int x_start, int y_start, int w, int h, cons
       transfer_buffer[idx++] = hi_byte & 0xF8;                     // Blue
       transfer_buffer[idx++] = ((hi_byte << 5) | (lo_byte) >> 5);  // Green
       transfer_buffer[idx++] = lo_byte << 3;                       // Red
-      if (idx == sizeof(transfer_buffer)) {
-        this->write_array(transfer_buffer, idx);
+      if (idx == ILI9XXX_TRANSFER_BUFFER_SIZE * 2) {
+        this->queue_write_array(transfer_buffer, idx);
+        transfer_buffer = transfer_buffer == transfer_buffers[0] ? transfer_buffers[1] : transfer_buffers[0];
         idx = 0;
         App.feed_wdt();
       }
@@ -356,7 +362,7 @@ void ILI9XXXDisplay::draw_pixels_at(int x_start, int y_start, int w, int h, cons
     }
     // flush any balance.
     if (idx != 0) {
-      this->write_array(transfer_buffer, idx);
+      this->queue_write_array(transfer_buffer, idx);
     }
   }
   this->end_data_();
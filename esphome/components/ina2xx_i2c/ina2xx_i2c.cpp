@@ -1,6 +1,8 @@
 #include "ina2xx_i2c.h"
 #include "esphome/core/log.h"
 
+#include <cstring>
+
 namespace esphome {
 namespace ina2xx_i2c {
 
@@ -12,15 +14,77 @@ void INA2XXI2C::setup() {
     this->mark_failed();
     return;
   }
+  this->read_transaction_.set_callback([this](i2c::ErrorCode err) {
+    if (err != i2c::ERROR_OK) {
+      ESP_LOGE(TAG, "Reading registers failed. Err=%d", err);
+      this->status_set_warning();
+      return;
+    }
+    this->state_ = State::DATA_COLLECTION_1;
+  });
   INA2XX::setup();
 }
 
+void INA2XXI2C::update() {
+  if (this->scheduler_ == nullptr) {
+    INA2XX::update();
+    return;
+  }
+  if (!this->is_ready() || this->state_ != State::IDLE || this->read_transaction_.is_pending())
+    return;
+
+  // The same registers the data collection steps read
+  bool is_22x = this->ina_model_ == ina2xx_base::INA_228 || this->ina_model_ == ina2xx_base::INA_229;
+  bool energy = this->energy_sensor_j_ != nullptr || this->energy_sensor_wh_ != nullptr;
+  bool charge = this->charge_sensor_c_ != nullptr || this->charge_sensor_ah_ != nullptr;
+  this->prefetch_count_ = 0;
+  this->read_transaction_.clear();
+  if (this->shunt_voltage_sensor_ != nullptr)
+    this->add_prefetch_(ina2xx_base::REG_VSHUNT, is_22x ? 3 : 2);
+  if (this->bus_voltage_sensor_ != nullptr)
+    this->add_prefetch_(ina2xx_base::REG_VBUS, is_22x ? 3 : 2);
+  if (this->die_temperature_sensor_ != nullptr)
+    this->add_prefetch_(ina2xx_base::REG_DIETEMP, 2);
+  if (this->current_sensor_ != nullptr)
+    this->add_prefetch_(ina2xx_base::REG_CURRENT, is_22x ? 3 : 2);
+  if (this->power_sensor_ != nullptr)
+    this->add_prefetch_(ina2xx_base::REG_POWER, 3);
+  if (is_22x && (energy || charge))
+    this->add_prefetch_(ina2xx_base::REG_DIAG_ALRT, 2);
+  if (is_22x && energy)
+    this->add_prefetch_(ina2xx_base::REG_ENERGY, 5);
+  if (is_22x && charge)
+    this->add_prefetch_(ina2xx_base::REG_CHARGE, 5);
+
+  if (this->prefetch_count_ == 0) {
+    this->state_ = State::DATA_COLLECTION_1;
+    return;
+  }
+  this->scheduler_->submit(&this->read_transaction_);
+}
+
+void INA2XXI2C::add_prefetch_(uint8_t reg, uint8_t len) {
+  auto &prefetch = this->prefetch_[this->prefetch_count_++];
+  prefetch.reg = reg;
+  prefetch.len = len;
+  this->read_transaction_.read_register(reg, prefetch.data, len, false);
+}
+
 void INA2XXI2C::dump_config() {
   INA2XX::dump_config();
   LOG_I2C_DEVICE(this);
 }
 
 bool INA2XXI2C::read_ina_register(uint8_t reg, uint8_t *data, size_t len) {
+  if (this->state_ != State::IDLE) {
+    for (uint8_t i = 0; i < this->prefetch_count_; i++) {
+      const auto &prefetch = this->prefetch_[i];
+      if (prefetch.reg == reg && prefetch.len == len) {
+        memcpy(data, prefetch.data, len);
+        return true;
+      }
+    }
+  }
   auto ret = this->read_register(reg, data, len, false);
   if (ret != i2c::ERROR_OK) {
     ESP_LOGE(TAG, "read_ina_register_ failed. Reg=0x%02X Err=%d", reg, ret);
@@ -3,6 +3,7 @@
 #include "esphome/core/component.h"
 #include "esphome/components/ina2xx_base/ina2xx_base.h"
 #include "esphome/components/i2c/i2c.h"
+#include "esphome/components/i2c/i2c_scheduler.h"
 
 namespace esphome {
 namespace ina2xx_i2c {
@@ -10,11 +11,26 @@ namespace ina2xx_i2c {
 class INA2XXI2C : public ina2xx_base::INA2XX, public i2c::I2CDevice {
  public:
   void setup() override;
+  void update() override;
   void dump_config() override;
 
+  void set_i2c_scheduler(i2c::I2CScheduler *scheduler) { this->scheduler_ = scheduler; }
+
  protected:
   bool read_ina_register(uint8_t reg, uint8_t *data, size_t len) override;
   bool write_ina_register(uint8_t reg, const uint8_t *data, size_t len) override;
+
+  void add_prefetch_(uint8_t reg, uint8_t len);
+
+  i2c::I2CScheduler *scheduler_{nullptr};
+  /// Reads all registers of a data collection in one go, the collection steps then use the prefetched values.
+  i2c::I2CTransaction read_transaction_{this};
+  struct Prefetch {
+    uint8_t reg;
+    uint8_t len;
+    uint8_t data[5];
+  } prefetch_[i2c::I2CTransaction::MAX_STEPS];
+  uint8_t prefetch_count_{0};
 };
 
 }  // namespace ina2xx_i2c
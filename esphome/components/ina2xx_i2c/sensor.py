@@ -32,3 +32,4 @@ async def to_code(config):
     var = cg.new_Pvariable(config[CONF_ID])
     await ina2xx_base.setup_ina2xx(var, config)
     await i2c.register_i2c_device(var, config)
+    cg.add(var.set_i2c_scheduler(await i2c.get_scheduler()))
@@ -32,7 +32,7 @@ from esphome.const import (
     CONF_WEB_SERVER,
     CONF_WHITE,
 )
-from esphome.core import coroutine_with_priority
+from esphome.core import CORE, ID, coroutine_with_priority
 from esphome.cpp_helpers import setup_entity
 
 from .automation import LIGHT_STATE_SCHEMA
@@ -52,6 +52,7 @@ from .types import (  # noqa
     LightState,
     LightStateRTCState,
     LightStateTrigger,
+    LightTransitionEngine,
     LightTurnOffTrigger,
     LightTurnOnTrigger,
     light_ns,
@@ -60,6 +61,9 @@ from .types import (  # noqa
 CODEOWNERS = ["@esphome/core"]
 IS_PLATFORM_COMPONENT = True
 
+CONF_TRANSITION_FRAME_RATE = "transition_frame_rate"
+KEY_LIGHT_TRANSITION_ENGINE = "light_transition_engine"
+
 LightRestoreMode = light_ns.enum("LightRestoreMode")
 RESTORE_MODES = {
     "RESTORE_DEFAULT_OFF": LightRestoreMode.LIGHT_RESTORE_DEFAULT_OFF,
@@ -119,6 +123,7 @@ BRIGHTNESS_ONLY_LIGHT_SCHEMA = LIGHT_SCHEMA.extend(
         cv.Optional(
             CONF_FLASH_TRANSITION_LENGTH, default="0s"
         ): cv.positive_time_period_milliseconds,
+        cv.Optional(CONF_TRANSITION_FRAME_RATE): cv.int_range(min=1, max=1000),
         cv.Optional(CONF_EFFECTS): validate_effects(MONOCHROMATIC_EFFECTS),
     }
 )
@@ -184,6 +189,8 @@ async def setup_light_core_(light_var, output_var, config):
         flash_transition_length := config.get(CONF_FLASH_TRANSITION_LENGTH)
     ) is not None:
         cg.add(light_var.set_flash_transition_length(flash_transition_length))
+    if (frame_rate := config.get(CONF_TRANSITION_FRAME_RATE)) is not None:
+        cg.add(light_var.set_transition_frame_interval(1000 // frame_rate))
     if (gamma_correct := config.get(CONF_GAMMA_CORRECT)) is not None:
         cg.add(light_var.set_gamma_correct(gamma_correct))
     effects = await cg.build_registry_list(
@@ -216,10 +223,27 @@ async def setup_light_core_(light_var, output_var, config):
         await web_server.add_entity_config(light_var, web_server_config)
 
 
+async def get_transition_engine():
+    """Get the engine that runs the loop of busy lights, it is created on first use."""
+    if KEY_LIGHT_TRANSITION_ENGINE not in CORE.data:
+        var = cg.new_Pvariable(
+            ID(
+                KEY_LIGHT_TRANSITION_ENGINE,
+                is_declaration=True,
+                type=LightTransitionEngine,
+            )
+        )
+        await cg.register_component(var, {})
+        CORE.data[KEY_LIGHT_TRANSITION_ENGINE] = var
+    return CORE.data[KEY_LIGHT_TRANSITION_ENGINE]
+
+
 async def register_light(output_var, config):
     light_var = cg.new_Pvariable(config[CONF_ID], output_var)
     cg.add(cg.App.register_light(light_var))
     await cg.register_component(light_var, config)
+    engine = await get_transition_engine()
+    cg.add(light_var.set_transition_engine(engine))
     await setup_light_core_(light_var, output_var, config)
 
 
@@ -101,10 +101,11 @@ optional<LightColorValues> AddressableLightTransformer::apply() {
 
     for (auto led : this->light_)
       led.set(add + led.get() * inv_alpha8);
+    // nothing changed if the alpha rounds to zero, so the show can be skipped
+    this->light_.schedule_show();
   }
 
   this->last_transition_progress_ = smoothed_progress;
-  this->light_.schedule_show();
 
   return {};
 }
@@ -2,8 +2,11 @@
 
 #include "light_output.h"
 #include "light_state.h"
+#include "light_transition_engine.h"
 #include "transformers.h"
 
+#include <cmath>
+
 namespace esphome {
 namespace light {
 
@@ -107,16 +110,21 @@ void LightState::loop() {
   }
 
   // Apply transformer (if any)
-  if (this->transformer_ != nullptr) {
+  const uint32_t now = millis();
+  if (this->transformer_ != nullptr && this->is_transition_frame_due_(now)) {
+    this->last_transition_frame_ = now;
+
     auto values = this->transformer_->apply();
     this->is_transformer_active_ = true;
-    if (values.has_value()) {
+    const bool finished = this->transformer_->is_finished();
+    // frames of slow transitions often round to the same output, which doesn't need to be written again
+    if (values.has_value() && (finished || !this->is_same_output_(*values))) {
       this->current_values = *values;
       this->output_->update_state(this);
       this->next_write_ = true;
     }
 
-    if (this->transformer_->is_finished()) {
+    if (finished) {
       // if the transition has written directly to the output, current_values is outdated, so update it
       this->current_values = this->transformer_->get_target_values();
 
@@ -134,6 +142,28 @@ void LightState::loop() {
   }
 }
 
+bool LightState::is_transition_frame_due_(uint32_t now) {
+  if (this->transition_frame_interval_ == 0 || now - this->last_transition_frame_ >= this->transition_frame_interval_)
+    return true;
+  // don't delay the end of the transition to the next frame
+  return static_cast<int32_t>(now - this->transformer_->get_end_time()) >= 0;
+}
+
+bool LightState::is_same_output_(const LightColorValues &values) const {
+  const auto &current = this->current_values;
+  if (values.get_color_mode() != current.get_color_mode())
+    return false;
+  auto same = [](float a, float b) { return lroundf(a * 65535.0f) == lroundf(b * 65535.0f); };
+  // the color temperature is in mireds, compare it at a resolution that is finer than 16 bit of its usual range
+  return same(values.get_state(), current.get_state()) && same(values.get_brightness(), current.get_brightness()) &&
+         same(values.get_color_brightness(), current.get_color_brightness()) &&
+         same(values.get_red(), current.get_red()) && same(values.get_green(), current.get_green()) &&
+         same(values.get_blue(), current.get_blue()) && same(values.get_white(), current.get_white()) &&
+         same(values.get_color_temperature() / 100.0f, current.get_color_temperature() / 100.0f) &&
+         same(values.get_cold_white(), current.get_cold_white()) &&
+         same(values.get_warm_white(), current.get_warm_white());
+}
+
 float LightState::get_setup_priority() const { return setup_priority::HARDWARE - 1.0f; }
 
 void LightState::publish_state() { this->remote_values_callback_.call(); }
@@ -162,6 +192,10 @@ void LightState::set_flash_transition_length(uint32_t flash_transition_length) {
   this->flash_transition_length_ = flash_transition_length;
 }
 uint32_t LightState::get_flash_transition_length() const { return this->flash_transition_length_; }
+void LightState::set_transition_engine(LightTransitionEngine *engine) {
+  this->engine_ = engine;
+  engine->add_light(this);
+}
 void LightState::set_gamma_correct(float gamma_correct) { this->gamma_correct_ = gamma_correct; }
 void LightState::set_restore_mode(LightRestoreMode restore_mode) { this->restore_mode_ = restore_mode; }
 void LightState::set_initial_state(const LightStateRTCState &initial_state) { this->initial_state_ = initial_state; }
@@ -216,6 +250,7 @@ void LightState::start_effect_(uint32_t effect_index) {
   this->active_effect_index_ = effect_index;
   auto *effect = this->get_active_effect_();
   effect->start_internal();
+  this->wake_();
 }
 LightEffect *LightState::get_active_effect_() {
   if (this->active_effect_index_ == 0) {
@@ -235,6 +270,7 @@ void LightState::stop_effect_() {
 void LightState::start_transition_(const LightColorValues &target, uint32_t length, bool set_remote_values) {
   this->transformer_ = this->output_->create_default_transition();
   this->transformer_->setup(this->current_values, target, length);
+  this->wake_();
 
   if (set_remote_values) {
     this->remote_values = target;
@@ -250,6 +286,7 @@ void LightState::start_flash_(const LightColorValues &target, uint32_t length, b
 
   this->transformer_ = make_unique<LightFlashTransformer>(*this);
   this->transformer_->setup(end_colors, target, length);
+  this->wake_();
 
   if (set_remote_values) {
     this->remote_values = target;
@@ -264,7 +301,21 @@ void LightState::set_immediately_(const LightColorValues &target, bool set_remot
     this->remote_values = target;
   }
   this->output_->update_state(this);
+  this->schedule_write_();
+}
+
+void LightState::schedule_write_() {
   this->next_write_ = true;
+  this->wake_();
+}
+
+void LightState::wake_() {
+  if (this->engine_ != nullptr)
+    this->engine_->wake(this);
+}
+
+bool LightState::is_idle_() {
+  return this->transformer_ == nullptr && this->get_active_effect_() == nullptr && !this->next_write_;
 }
 
 void LightState::save_remote_values_() {
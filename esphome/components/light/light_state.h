@@ -16,6 +16,7 @@ namespace esphome {
 namespace light {
 
 class LightOutput;
+class LightTransitionEngine;
 
 enum LightRestoreMode {
   LIGHT_RESTORE_DEFAULT_OFF,
@@ -138,6 +139,17 @@ class LightState : public EntityBase, public Component {
   void set_flash_transition_length(uint32_t flash_transition_length);
   uint32_t get_flash_transition_length() const;
 
+  /** Limit transitions to one frame every `transition_frame_interval` ms, 0 updates the light on every loop iteration.
+   *
+   * The last frame of a transition is always applied when it ends, so the length of transitions is not affected.
+   */
+  void set_transition_frame_interval(uint32_t transition_frame_interval) {
+    this->transition_frame_interval_ = transition_frame_interval;
+  }
+
+  /// Let the engine run the loop of this light while it is busy, instead of the main loop.
+  void set_transition_engine(LightTransitionEngine *engine);
+
   /// Set the gamma correction factor
   void set_gamma_correct(float gamma_correct);
   float get_gamma_correct() const { return this->gamma_correct_; }
@@ -191,6 +203,7 @@ class LightState : public EntityBase, public Component {
   friend LightOutput;
   friend LightCall;
   friend class AddressableLight;
+  friend class LightTransitionEngine;
 
   /// Internal method to start an effect with the given index
   void start_effect_(uint32_t effect_index);
@@ -210,6 +223,17 @@ class LightState : public EntityBase, public Component {
   /// Internal method to save the current remote_values to the preferences
   void save_remote_values_();
 
+  /// Internal method to write the light in the next cycle.
+  void schedule_write_();
+  /// Internal method to make sure loop() is called, required after starting a transition or effect.
+  void wake_();
+  /// Whether the light has no transition, effect or write left to run in loop().
+  bool is_idle_();
+  /// Whether the transformer should be applied in this loop iteration, see set_transition_frame_interval().
+  bool is_transition_frame_due_(uint32_t now);
+  /// Whether writing the values would not change the output at 16 bit resolution.
+  bool is_same_output_(const LightColorValues &values) const;
+
   /// Store the output to allow effects to have more access.
   LightOutput *output_;
   /// Value for storing the index of the currently active effect. 0 if no effect is active
@@ -218,6 +242,12 @@ class LightState : public EntityBase, public Component {
   std::unique_ptr<LightTransformer> transformer_{nullptr};
   /// Whether the light value should be written in the next cycle.
   bool next_write_{true};
+  /// The engine that runs loop() while the light is busy, nullptr if the light is part of the main loop.
+  LightTransitionEngine *engine_{nullptr};
+  /// Minimum time between two frames of a transition in ms, 0 for every loop iteration.
+  uint32_t transition_frame_interval_{0};
+  /// Time the transformer was last applied.
+  uint32_t last_transition_frame_{0};
 
   /// Object used to store the persisted values of the light.
   ESPPreferenceObject rtc_;
@@ -37,6 +37,9 @@ class LightTransformer {
 
   const LightColorValues &get_target_values() const { return this->target_values_; }
 
+  /// The time at which the transformation reaches the target values.
+  uint32_t get_end_time() const { return this->start_time_ + this->length_; }
+
  protected:
   /// The progress of this transition, on a scale of 0 to 1.
   float get_progress_() {
@@ -0,0 +1,50 @@
+#include "light_transition_engine.h"
+#include "light_state.h"
+#include "esphome/core/application.h"
+#include "esphome/core/log.h"
+
+#include <algorithm>
+
+namespace esphome {
+namespace light {
+
+static const char *const TAG = "light.engine";
+
+void LightTransitionEngine::add_light(LightState *state) {
+  this->lights_.push_back(state);
+  App.exclude_from_main_loop(state);
+}
+
+void LightTransitionEngine::setup() {
+  if (this->active_.empty())
+    this->disable_loop();
+}
+
+void LightTransitionEngine::wake(LightState *state) {
+  if (std::find(this->active_.begin(), this->active_.end(), state) == this->active_.end())
+    this->active_.push_back(state);
+  this->enable_loop();
+}
+
+void LightTransitionEngine::loop() {
+  // lights woken by callbacks of other lights are appended and run in the same pass
+  for (size_t i = 0; i < this->active_.size();) {
+    LightState *state = this->active_[i];
+    state->call();
+    if (state->is_idle_()) {
+      this->active_.erase(this->active_.begin() + i);
+    } else {
+      i++;
+    }
+  }
+  if (this->active_.empty())
+    this->disable_loop();
+}
+
+void LightTransitionEngine::dump_config() {
+  ESP_LOGCONFIG(TAG, "Light Transition Engine:");
+  ESP_LOGCONFIG(TAG, "  Lights: %u", static_cast<unsigned>(this->lights_.size()));
+}
+
+}  // namespace light
+}  // namespace esphome
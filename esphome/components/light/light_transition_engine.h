@@ -0,0 +1,40 @@
+#pragma once
+
+#include "esphome/core/component.h"
+
+#include <vector>
+
+namespace esphome {
+namespace light {
+
+class LightState;
+
+/** Runs the loop of the lights that have an active transition, effect or pending write.
+ *
+ * Lights that use the engine are not called from the main loop, so idle lights cost nothing per loop iteration. A
+ * light wakes the engine whenever it starts a transition or effect, or has new values to write, and is dropped again
+ * once it has nothing left to do. The loop of the engine itself is disabled while no light is busy.
+ */
+class LightTransitionEngine : public Component {
+ public:
+  void setup() override;
+  void loop() override;
+  void dump_config() override;
+  float get_setup_priority() const override { return setup_priority::HARDWARE - 1.0f; }
+
+  /// Let the engine run the light from the next loop iteration on, until it is idle again.
+  void wake(LightState *state);
+  /// Stop running the light from the main loop, call before setup() finishes.
+  void add_light(LightState *state);
+
+  const std::vector<LightState *> &get_active_lights() const { return this->active_; }
+
+ protected:
+  /// All lights that use this engine.
+  std::vector<LightState *> lights_{};
+  /// Lights that have work to do, in the order they were woken.
+  std::vector<LightState *> active_{};
+};
+
+}  // namespace light
+}  // namespace esphome
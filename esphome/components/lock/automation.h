@@ -44,6 +44,10 @@ template<typename... Ts> class LockCondition : public Condition<Ts...> {
     auto check_state = this->state_ ? LockState::LOCK_STATE_LOCKED : LockState::LOCK_STATE_UNLOCKED;
     return this->parent_->state == check_state;
   }
+  bool add_on_dependency_change_callback(const std::function<void()> &callback) override {
+    this->parent_->add_on_state_callback([callback]() { callback(); });
+    return true;
+  }
 
  protected:
   Lock *parent_;
@@ -28,9 +28,24 @@
 #define MD5_CTX_TYPE LT_MD5_CTX_T
 #endif
 
+#ifdef USE_HOST
+#include <cstddef>
+#include <cstdint>
+#define MD5_CTX_TYPE HostMD5Context
+#endif
+
 namespace esphome {
 namespace md5 {
 
+#ifdef USE_HOST
+/// State of the portable MD5 implementation that is used on the host platform.
+struct HostMD5Context {
+  uint32_t state[4];
+  uint64_t count;  ///< number of bytes added so far
+  uint8_t buffer[64];
+};
+#endif
+
 class MD5Digest {
  public:
   MD5Digest() = default;
@@ -347,7 +347,8 @@ CONFIG_SCHEMA = cv.All(
             ),
         }
     ).extend(cv.COMPONENT_SCHEMA),
-    cv.only_with_esp_idf,
+    # the host platform runs the same feature generation and inference, e.g. to evaluate models on WAV files
+    cv.only_with_framework(["esp-idf", "host"]),
 )
 
 
@@ -414,22 +415,38 @@ async def to_code(config):
     mic = await cg.get_variable(config[CONF_MICROPHONE])
     cg.add(var.set_microphone(mic))
 
-    esp32.add_idf_component(
-        name="esp-tflite-micro",
-        repo="https://github.com/espressif/esp-tflite-micro",
-        ref="v1.3.1",
-    )
-    # add esp-nn dependency for tflite-micro to work around https://github.com/espressif/esp-nn/issues/17
-    # ...remove after switching to IDF 5.1.4+
-    esp32.add_idf_component(
-        name="esp-nn",
-        repo="https://github.com/espressif/esp-nn",
-        ref="v1.1.0",
-    )
+    if CORE.is_esp32:
+        esp32.add_idf_component(
+            name="esp-tflite-micro",
+            repo="https://github.com/espressif/esp-tflite-micro",
+            ref="v1.3.1",
+        )
+        # add esp-nn dependency for tflite-micro to work around https://github.com/espressif/esp-nn/issues/17
+        # ...remove after switching to IDF 5.1.4+
+        esp32.add_idf_component(
+            name="esp-nn",
+            repo="https://github.com/espressif/esp-nn",
+            ref="v1.1.0",
+        )
+        cg.add_build_flag("-DESP_NN")
+    else:
+        # TFLite Micro with the reference kernels. In a checkout of https://github.com/tensorflow/tflite-micro,
+        #   make -f tensorflow/lite/micro/tools/make/Makefile microlite
+        # builds gen/linux_x86_64_default/lib/libtensorflow-microlite.a and downloads flatbuffers and kissfft to
+        # tensorflow/lite/micro/tools/make/downloads. The audio frontend is not part of that library, it is built with
+        #   cd tensorflow/lite/experimental/microfrontend/lib
+        #   cc -c -O2 -I../../../../.. *.c
+        #   c++ -c -O2 -I../../../../.. -I../../../micro/tools/make/downloads/kissfft fft.cc fft_util.cc \
+        #     kiss_fft_int16.cc
+        #   ar rcs libmicrofrontend.a *.o
+        # The sources include the frontend headers by their path in the checkout. Add the checkout, the flatbuffers
+        # headers and the directories of both libraries to `esphome: platformio_options: build_flags:`, i.e.
+        # -I<checkout> -I<checkout>/tensorflow/lite/micro/tools/make/downloads/flatbuffers/include -L<...>
+        cg.add_build_flag("-ltensorflow-microlite")
+        cg.add_build_flag("-lmicrofrontend")
 
     cg.add_build_flag("-DTF_LITE_STATIC_MEMORY")
     cg.add_build_flag("-DTF_LITE_DISABLE_X86_NEON")
-    cg.add_build_flag("-DESP_NN")
 
     if on_wake_word_detection_config := config.get(CONF_ON_WAKE_WORD_DETECTED):
         await automation.build_automation(
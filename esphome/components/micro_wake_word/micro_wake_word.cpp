@@ -1,19 +1,21 @@
 #include "micro_wake_word.h"
 #include "streaming_model.h"
 
-#ifdef USE_ESP_IDF
+#if defined(USE_ESP_IDF) || defined(USE_HOST)
 
 #include "esphome/core/hal.h"
 #include "esphome/core/helpers.h"
 #include "esphome/core/log.h"
 
-#include <frontend.h>
-#include <frontend_util.h>
+#include <tensorflow/lite/experimental/microfrontend/lib/frontend.h>
+#include <tensorflow/lite/experimental/microfrontend/lib/frontend_util.h>
 
 #include <tensorflow/lite/core/c/common.h>
 #include <tensorflow/lite/micro/micro_interpreter.h>
 #include <tensorflow/lite/micro/micro_mutable_op_resolver.h>
 
+#include <algorithm>
+#include <cinttypes>
 #include <cmath>
 
 namespace esphome {
@@ -115,8 +117,15 @@ void MicroWakeWord::loop() {
       }
       break;
     case State::DETECTING_WAKE_WORD:
+      if (this->microphone_->is_stopped()) {
+        ESP_LOGW(TAG, "Microphone stopped");
+        this->set_state_(State::STOP_MICROPHONE);
+        break;
+      }
       while (!this->has_enough_samples_()) {
-        this->read_microphone_();
+        // try again in the next loop iteration when the microphone has no data
+        if (this->read_microphone_() == 0)
+          return;
       }
       this->update_model_probabilities_();
       if (this->detect_wake_words_()) {
@@ -130,6 +139,7 @@ void MicroWakeWord::loop() {
       this->microphone_->stop();
       this->set_state_(State::STOPPING_MICROPHONE);
       this->high_freq_.stop();
+      this->log_inference_stats_();
       this->unload_models_();
       this->deallocate_buffers_();
       break;
@@ -197,62 +207,29 @@ void MicroWakeWord::set_state_(State state) {
 }
 
 size_t MicroWakeWord::read_microphone_() {
-  size_t bytes_read = this->microphone_->read(this->input_buffer_, INPUT_BUFFER_SIZE * sizeof(int16_t));
-  if (bytes_read == 0) {
-    return 0;
-  }
-
-  size_t bytes_free = this->ring_buffer_->free();
-
-  if (bytes_free < bytes_read) {
+  uint32_t dropped = this->audio_reader_.get_dropped();
+  size_t bytes_read = this->microphone_->read_to_audio_ring(INPUT_BUFFER_SIZE * sizeof(int16_t));
+  if (this->audio_reader_.get_dropped() != dropped) {
     ESP_LOGW(TAG,
-             "Not enough free bytes in ring buffer to store incoming audio data (free bytes=%d, incoming bytes=%d). "
-             "Resetting the ring buffer. Wake word detection accuracy will be reduced.",
-             bytes_free, bytes_read);
-
-    this->ring_buffer_->reset();
+             "Not enough free bytes in ring buffer to store incoming audio data (dropped bytes=%u). "
+             "Wake word detection accuracy will be reduced.",
+             (unsigned) (this->audio_reader_.get_dropped() - dropped));
   }
-
-  return this->ring_buffer_->write((void *) this->input_buffer_, bytes_read);
+  return bytes_read;
 }
 
 bool MicroWakeWord::allocate_buffers_() {
-  ExternalRAMAllocator<int16_t> audio_samples_allocator(ExternalRAMAllocator<int16_t>::ALLOW_FAILURE);
-
-  if (this->input_buffer_ == nullptr) {
-    this->input_buffer_ = audio_samples_allocator.allocate(INPUT_BUFFER_SIZE * sizeof(int16_t));
-    if (this->input_buffer_ == nullptr) {
-      ESP_LOGE(TAG, "Could not allocate input buffer");
-      return false;
-    }
-  }
-
-  if (this->preprocessor_audio_buffer_ == nullptr) {
-    this->preprocessor_audio_buffer_ = audio_samples_allocator.allocate(this->new_samples_to_get_());
-    if (this->preprocessor_audio_buffer_ == nullptr) {
-      ESP_LOGE(TAG, "Could not allocate the audio preprocessor's buffer.");
-      return false;
-    }
-  }
-
-  if (this->ring_buffer_ == nullptr) {
-    this->ring_buffer_ = RingBuffer::create(BUFFER_SIZE * sizeof(int16_t));
-    if (this->ring_buffer_ == nullptr) {
-      ESP_LOGE(TAG, "Could not allocate ring buffer");
-      return false;
-    }
+  // the frontend reads its samples straight from the ring, so views must hold a full step
+  size_t max_view = std::max<size_t>(INPUT_BUFFER_SIZE, this->new_samples_to_get_()) * sizeof(int16_t);
+  if (!this->microphone_->get_audio_ring().add_reader(&this->audio_reader_, BUFFER_SIZE * sizeof(int16_t), max_view)) {
+    ESP_LOGE(TAG, "Could not allocate ring buffer");
+    return false;
   }
 
   return true;
 }
 
-void MicroWakeWord::deallocate_buffers_() {
-  ExternalRAMAllocator<int16_t> audio_samples_allocator(ExternalRAMAllocator<int16_t>::ALLOW_FAILURE);
-  audio_samples_allocator.deallocate(this->input_buffer_, INPUT_BUFFER_SIZE * sizeof(int16_t));
-  this->input_buffer_ = nullptr;
-  audio_samples_allocator.deallocate(this->preprocessor_audio_buffer_, this->new_samples_to_get_());
-  this->preprocessor_audio_buffer_ = nullptr;
-}
+void MicroWakeWord::deallocate_buffers_() { this->microphone_->get_audio_ring().remove_reader(&this->audio_reader_); }
 
 bool MicroWakeWord::load_models_() {
   // Setup preprocesor feature generator
@@ -290,12 +267,54 @@ void MicroWakeWord::unload_models_() {
 #endif
 }
 
+void MicroWakeWord::log_inference_stats_() {
+  uint32_t average = this->feature_windows_ == 0 ? 0 : this->feature_time_us_ / this->feature_windows_;
+  ESP_LOGD(TAG, "Features: %" PRIu32 " windows, average %" PRIu32 "us, max %" PRIu32 "us", this->feature_windows_,
+           average, this->max_feature_time_us_);
+  for (auto &model : this->wake_word_models_) {
+    model.log_inference_stats(model.get_wake_word().c_str());
+  }
+#ifdef USE_MICRO_WAKE_WORD_VAD
+  this->vad_model_->log_inference_stats("VAD");
+#endif
+  if (this->feature_windows_ == 0)
+    return;
+  // To keep up with the audio, a window has to be processed before the next one is due
+  uint32_t budget_us = this->features_step_size_ * 1000;
+  uint32_t late = 0;
+  for (uint8_t i = 0; i < WINDOW_LATENCY_BUCKETS; i++) {
+    if (i * WINDOW_LATENCY_BUCKET_US >= budget_us)
+      late += this->window_latency_histogram_[i];
+  }
+  ESP_LOGD(TAG, "Windows: p50 %" PRIu32 "us, p90 %" PRIu32 "us, p99 %" PRIu32 "us, max %" PRIu32 "us, %" PRIu32
+           " of %" PRIu32 " took the whole %" PRIu32 "ms step or longer",
+           this->window_latency_percentile_(50), this->window_latency_percentile_(90),
+           this->window_latency_percentile_(99), this->max_window_time_us_, late, this->feature_windows_,
+           budget_us / 1000);
+}
+
+uint32_t MicroWakeWord::window_latency_percentile_(uint8_t percentile) {
+  uint32_t rank = (this->feature_windows_ * percentile + 99) / 100;
+  uint32_t count = 0;
+  for (uint8_t i = 0; i < WINDOW_LATENCY_BUCKETS - 1; i++) {
+    count += this->window_latency_histogram_[i];
+    if (count >= rank)
+      return std::min((i + 1) * WINDOW_LATENCY_BUCKET_US, this->max_window_time_us_);
+  }
+  return this->max_window_time_us_;
+}
+
 void MicroWakeWord::update_model_probabilities_() {
   int8_t audio_features[PREPROCESSOR_FEATURE_SIZE];
 
+  uint32_t start = micros();
   if (!this->generate_features_for_window_(audio_features)) {
     return;
   }
+  uint32_t duration = micros() - start;
+  this->feature_windows_++;
+  this->feature_time_us_ += duration;
+  this->max_feature_time_us_ = std::max(this->max_feature_time_us_, duration);
 
   // Increase the counter since the last positive detection
   this->ignore_windows_ = std::min(this->ignore_windows_ + 1, 0);
@@ -307,6 +326,13 @@ void MicroWakeWord::update_model_probabilities_() {
 #ifdef USE_MICRO_WAKE_WORD_VAD
   this->vad_model_->perform_streaming_inference(audio_features);
 #endif
+
+  uint32_t window_duration = micros() - start;
+  ESP_LOGV(TAG, "Window %" PRIu32 ": features %" PRIu32 "us, total %" PRIu32 "us", this->feature_windows_, duration,
+           window_duration);
+  this->window_latency_histogram_[std::min<uint32_t>(window_duration / WINDOW_LATENCY_BUCKET_US,
+                                                     WINDOW_LATENCY_BUCKETS - 1)]++;
+  this->max_window_time_us_ = std::max(this->max_window_time_us_, window_duration);
 }
 
 bool MicroWakeWord::detect_wake_words_() {
@@ -338,7 +364,7 @@ bool MicroWakeWord::detect_wake_words_() {
 }
 
 bool MicroWakeWord::has_enough_samples_() {
-  return this->ring_buffer_->available() >=
+  return this->audio_reader_.available() >=
          (this->features_step_size_ * (AUDIO_SAMPLE_FREQUENCY / 1000)) * sizeof(int16_t);
 }
 
@@ -348,21 +374,18 @@ bool MicroWakeWord::generate_features_for_window_(int8_t features[PREPROCESSOR_F
     return false;
   }
 
-  size_t bytes_read = this->ring_buffer_->read((void *) (this->preprocessor_audio_buffer_),
-                                               this->new_samples_to_get_() * sizeof(int16_t), pdMS_TO_TICKS(200));
-
-  if (bytes_read == 0) {
+  // the frontend reads the samples in place from the audio ring
+  size_t step_bytes = this->new_samples_to_get_() * sizeof(int16_t);
+  const int16_t *samples = reinterpret_cast<const int16_t *>(this->audio_reader_.peek(step_bytes));
+  if (samples == nullptr) {
     ESP_LOGE(TAG, "Could not read data from Ring Buffer");
-  } else if (bytes_read < this->new_samples_to_get_() * sizeof(int16_t)) {
-    ESP_LOGD(TAG, "Partial Read of Data by Model");
-    ESP_LOGD(TAG, "Could only read %d bytes when required %d bytes ", bytes_read,
-             (int) (this->new_samples_to_get_() * sizeof(int16_t)));
     return false;
   }
 
   size_t num_samples_read;
-  struct FrontendOutput frontend_output = FrontendProcessSamples(
-      &this->frontend_state_, this->preprocessor_audio_buffer_, this->new_samples_to_get_(), &num_samples_read);
+  struct FrontendOutput frontend_output =
+      FrontendProcessSamples(&this->frontend_state_, samples, this->new_samples_to_get_(), &num_samples_read);
+  this->audio_reader_.consume(step_bytes);
 
   for (size_t i = 0; i < frontend_output.size; ++i) {
     // These scaling values are set to match the TFLite audio frontend int8 output.
@@ -397,7 +420,12 @@ bool MicroWakeWord::generate_features_for_window_(int8_t features[PREPROCESSOR_F
 
 void MicroWakeWord::reset_states_() {
   ESP_LOGD(TAG, "Resetting buffers and probabilities");
-  this->ring_buffer_->reset();
+  this->audio_reader_.consume_all();
+  this->feature_windows_ = 0;
+  this->feature_time_us_ = 0;
+  this->max_feature_time_us_ = 0;
+  this->window_latency_histogram_.fill(0);
+  this->max_window_time_us_ = 0;
   this->ignore_windows_ = -MIN_SLICES_BEFORE_DETECTION;
   for (auto &model : this->wake_word_models_) {
     model.reset_probabilities();
@@ -455,4 +483,4 @@ bool MicroWakeWord::register_streaming_ops_(tflite::MicroMutableOpResolver<20> &
 }  // namespace micro_wake_word
 }  // namespace esphome
 
-#endif  // USE_ESP_IDF
+#endif  // USE_ESP_IDF || USE_HOST
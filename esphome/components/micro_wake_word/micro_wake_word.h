@@ -1,22 +1,23 @@
 #pragma once
 
-#ifdef USE_ESP_IDF
+#if defined(USE_ESP_IDF) || defined(USE_HOST)
 
 #include "preprocessor_settings.h"
 #include "streaming_model.h"
 
 #include "esphome/core/automation.h"
 #include "esphome/core/component.h"
-#include "esphome/core/ring_buffer.h"
 
 #include "esphome/components/microphone/microphone.h"
 
-#include <frontend_util.h>
+#include <tensorflow/lite/experimental/microfrontend/lib/frontend_util.h>
 
 #include <tensorflow/lite/core/c/common.h>
 #include <tensorflow/lite/micro/micro_interpreter.h>
 #include <tensorflow/lite/micro/micro_mutable_op_resolver.h>
 
+#include <array>
+
 namespace esphome {
 namespace micro_wake_word {
 
@@ -32,6 +33,10 @@ enum State {
 // The number of audio slices to process before accepting a positive detection
 static const uint8_t MIN_SLICES_BEFORE_DETECTION = 74;
 
+// The time to process a window is counted in buckets of this size, the last bucket holds all longer windows
+static const uint32_t WINDOW_LATENCY_BUCKET_US = 250;
+static const uint8_t WINDOW_LATENCY_BUCKETS = 80;
+
 class MicroWakeWord : public Component {
  public:
   void setup() override;
@@ -64,7 +69,8 @@ class MicroWakeWord : public Component {
   State state_{State::IDLE};
   HighFrequencyLoopRequester high_freq_;
 
-  std::unique_ptr<RingBuffer> ring_buffer_;
+  // Reads audio from the ring that is shared with other users of the microphone
+  microphone::AudioRingReader audio_reader_;
 
   std::vector<WakeWordModel> wake_word_models_;
 
@@ -84,10 +90,13 @@ class MicroWakeWord : public Component {
 
   uint8_t features_step_size_;
 
-  // Stores audio read from the microphone before being added to the ring buffer.
-  int16_t *input_buffer_{nullptr};
-  // Stores audio to be fed into the audio frontend for generating features.
-  int16_t *preprocessor_audio_buffer_{nullptr};
+  // Time spent generating features since detection was started
+  uint32_t feature_windows_{0};
+  uint64_t feature_time_us_{0};
+  uint32_t max_feature_time_us_{0};
+  // Time to process each window, feature generation and inference of all models together
+  std::array<uint32_t, WINDOW_LATENCY_BUCKETS> window_latency_histogram_{};
+  uint32_t max_window_time_us_{0};
 
   bool detected_{false};
   std::string detected_wake_word_{""};
@@ -100,18 +109,17 @@ class MicroWakeWord : public Component {
 
   /** Reads audio from microphone into the ring buffer
    *
-   * Audio data (16000 kHz with int16 samples) is read into the input_buffer_.
-   * Verifies the ring buffer has enough space for all audio data. If not, it logs
-   * a warning and resets the ring buffer entirely.
+   * Audio data (16000 kHz with int16 samples) is read directly into the audio ring of the microphone. If the ring
+   * overwrote samples that were not processed yet, it logs a warning.
    * @return Number of bytes written to the ring buffer
    */
   size_t read_microphone_();
 
-  /// @brief Allocates memory for input_buffer_, preprocessor_audio_buffer_, and ring_buffer_
+  /// @brief Adds audio_reader_ to the audio ring of the microphone, which allocates the ring if needed
   /// @return True if successful, false otherwise
   bool allocate_buffers_();
 
-  /// @brief Frees memory allocated for input_buffer_ and preprocessor_audio_buffer_
+  /// @brief Removes audio_reader_ from the audio ring, which frees the ring if no other reader uses it
   void deallocate_buffers_();
 
   /// @brief Loads streaming models and prepares the feature generation frontend
@@ -146,6 +154,13 @@ class MicroWakeWord : public Component {
    */
   bool generate_features_for_window_(int8_t features[PREPROCESSOR_FEATURE_SIZE]);
 
+  /// @brief Logs the time spent generating features and running each model, the models' tensor arena usage, and the
+  /// distribution of the time to process a window
+  void log_inference_stats_();
+
+  /// @brief Returns an upper bound of the given percentile of the time to process a window, in microseconds
+  uint32_t window_latency_percentile_(uint8_t percentile);
+
   /// @brief Resets the ring buffer, ignore_windows_, and sliding window probabilities
   void reset_states_();
 
@@ -173,4 +188,4 @@ template<typename... Ts> class IsRunningCondition : public Condition<Ts...>, pub
 }  // namespace micro_wake_word
 }  // namespace esphome
 
-#endif  // USE_ESP_IDF
+#endif  // USE_ESP_IDF || USE_HOST
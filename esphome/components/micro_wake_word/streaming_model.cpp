@@ -1,4 +1,4 @@
-#ifdef USE_ESP_IDF
+#if defined(USE_ESP_IDF) || defined(USE_HOST)
 
 #include "streaming_model.h"
 
@@ -6,6 +6,9 @@
 #include "esphome/core/helpers.h"
 #include "esphome/core/log.h"
 
+#include <algorithm>
+#include <cinttypes>
+
 static const char *const TAG = "micro_wake_word";
 
 namespace esphome {
@@ -14,13 +17,13 @@ namespace micro_wake_word {
 void WakeWordModel::log_model_config() {
   ESP_LOGCONFIG(TAG, "    - Wake Word: %s", this->wake_word_.c_str());
   ESP_LOGCONFIG(TAG, "      Probability cutoff: %.3f", this->probability_cutoff_);
-  ESP_LOGCONFIG(TAG, "      Sliding window size: %d", this->sliding_window_size_);
+  ESP_LOGCONFIG(TAG, "      Sliding window size: %zu", this->sliding_window_size_);
 }
 
 void VADModel::log_model_config() {
   ESP_LOGCONFIG(TAG, "    - VAD Model");
   ESP_LOGCONFIG(TAG, "      Probability cutoff: %.3f", this->probability_cutoff_);
-  ESP_LOGCONFIG(TAG, "      Sliding window size: %d", this->sliding_window_size_);
+  ESP_LOGCONFIG(TAG, "      Sliding window size: %zu", this->sliding_window_size_);
 }
 
 bool StreamingModel::load_model(tflite::MicroMutableOpResolver<20> &op_resolver) {
@@ -57,6 +60,9 @@ bool StreamingModel::load_model(tflite::MicroMutableOpResolver<20> &op_resolver)
       ESP_LOGE(TAG, "Failed to allocate tensors for the streaming model");
       return false;
     }
+    this->invocations_ = 0;
+    this->invoke_time_us_ = 0;
+    this->max_invoke_time_us_ = 0;
 
     // Verify input tensor matches expected values
     // Dimension 3 will represent the first layer stride, so skip it may vary
@@ -112,7 +118,12 @@ bool StreamingModel::perform_streaming_inference(const int8_t features[PREPROCES
     if (this->current_stride_step_ >= stride) {
       this->current_stride_step_ = 0;
 
+      uint32_t start = micros();
       TfLiteStatus invoke_status = this->interpreter_->Invoke();
+      uint32_t duration = micros() - start;
+      this->invocations_++;
+      this->invoke_time_us_ += duration;
+      this->max_invoke_time_us_ = std::max(this->max_invoke_time_us_, duration);
       if (invoke_status != kTfLiteOk) {
         ESP_LOGW(TAG, "Streaming interpreter invoke failed");
         return false;
@@ -131,6 +142,15 @@ bool StreamingModel::perform_streaming_inference(const int8_t features[PREPROCES
   return false;
 }
 
+void StreamingModel::log_inference_stats(const char *name) {
+  if (this->interpreter_ == nullptr)
+    return;
+  uint32_t average = this->invocations_ == 0 ? 0 : this->invoke_time_us_ / this->invocations_;
+  ESP_LOGD(TAG, "'%s' model: %" PRIu32 " inferences, average %" PRIu32 "us, max %" PRIu32 "us, arena used %zu of %zu",
+           name, this->invocations_, average, this->max_invoke_time_us_, this->interpreter_->arena_used_bytes(),
+           this->tensor_arena_size_);
+}
+
 void StreamingModel::reset_probabilities() {
   for (auto &prob : this->recent_streaming_probabilities_) {
     prob = 0;
@@ -1,6 +1,6 @@
 #pragma once
 
-#ifdef USE_ESP_IDF
+#if defined(USE_ESP_IDF) || defined(USE_HOST)
 
 #include "preprocessor_settings.h"
 
@@ -8,6 +8,10 @@
 #include <tensorflow/lite/micro/micro_interpreter.h>
 #include <tensorflow/lite/micro/micro_mutable_op_resolver.h>
 
+#include <memory>
+#include <string>
+#include <vector>
+
 namespace esphome {
 namespace micro_wake_word {
 
@@ -31,9 +35,17 @@ class StreamingModel {
   /// @brief Destroys the TFLite interpreter and frees the tensor and variable arenas' memory
   void unload_model();
 
+  /// @brief Logs the time spent per inference and the tensor arena usage since the model was loaded
+  /// @param name Name of the model to show in the log
+  void log_inference_stats(const char *name);
+
  protected:
   uint8_t current_stride_step_{0};
 
+  uint32_t invocations_{0};
+  uint64_t invoke_time_us_{0};
+  uint32_t max_invoke_time_us_{0};
+
   float probability_cutoff_;
   size_t sliding_window_size_;
   size_t last_n_index_{0};
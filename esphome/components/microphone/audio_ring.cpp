@@ -0,0 +1,140 @@
+#include "audio_ring.h"
+#include "esphome/core/helpers.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace esphome {
+namespace microphone {
+
+const uint8_t *AudioRingReader::peek(size_t len) const {
+  if (this->ring_ == nullptr || len > this->available_ || len > this->ring_->max_view_)
+    return nullptr;
+  return this->ring_->buffer_ + this->read_pos_;
+}
+
+void AudioRingReader::consume(size_t len) {
+  if (this->ring_ == nullptr)
+    return;
+  len = std::min(len, this->available_);
+  this->available_ -= len;
+  this->read_pos_ += len;
+  if (this->read_pos_ >= this->ring_->size_)
+    this->read_pos_ -= this->ring_->size_;
+}
+
+bool AudioRing::add_reader(AudioRingReader *reader, size_t size, size_t max_view) {
+  if (reader->ring_ == this)
+    return true;
+  if (this->buffer_ == nullptr || size > this->size_ || max_view > this->max_view_) {
+    size = std::max(size, this->size_);
+    max_view = std::max(max_view, this->max_view_);
+    this->deallocate_();
+    if (!this->allocate_(size, max_view))
+      return false;
+    // the data of the other readers was lost with the old buffer
+    for (auto *other : this->readers_) {
+      other->read_pos_ = 0;
+      other->available_ = 0;
+    }
+  }
+  reader->ring_ = this;
+  reader->read_pos_ = this->write_pos_;
+  reader->available_ = 0;
+  this->readers_.push_back(reader);
+  return true;
+}
+
+void AudioRing::remove_reader(AudioRingReader *reader) {
+  auto it = std::find(this->readers_.begin(), this->readers_.end(), reader);
+  if (it == this->readers_.end())
+    return;
+  this->readers_.erase(it);
+  reader->ring_ = nullptr;
+  reader->available_ = 0;
+  if (this->readers_.empty())
+    this->deallocate_();
+}
+
+bool AudioRing::allocate_(size_t size, size_t max_view) {
+  // views that cross the end must not reach into the data they mirror, keep samples of up to 32 bits aligned
+  size = (std::max(size, 2 * max_view) + 3) & ~size_t(3);
+  ExternalRAMAllocator<uint8_t> allocator(ExternalRAMAllocator<uint8_t>::ALLOW_FAILURE);
+  this->buffer_ = allocator.allocate(size + max_view);
+  if (this->buffer_ == nullptr)
+    return false;
+  this->size_ = size;
+  this->max_view_ = max_view;
+  this->write_pos_ = 0;
+  return true;
+}
+
+void AudioRing::deallocate_() {
+  if (this->buffer_ != nullptr) {
+    ExternalRAMAllocator<uint8_t> allocator(ExternalRAMAllocator<uint8_t>::ALLOW_FAILURE);
+    allocator.deallocate(this->buffer_, this->size_ + this->max_view_);
+  }
+  this->buffer_ = nullptr;
+  this->size_ = 0;
+  this->max_view_ = 0;
+  this->write_pos_ = 0;
+}
+
+uint8_t *AudioRing::prepare_write(size_t len) {
+  if (this->buffer_ == nullptr || len > this->max_view_)
+    return nullptr;
+  // the space after write_pos_ holds the oldest data, drop it for the readers that did not consume it yet
+  size_t max_available = this->size_ - len;
+  for (auto *reader : this->readers_) {
+    if (reader->available_ > max_available) {
+      size_t excess = reader->available_ - max_available;
+      reader->available_ = max_available;
+      reader->dropped_ += excess;
+      reader->read_pos_ += excess;
+      if (reader->read_pos_ >= this->size_)
+        reader->read_pos_ -= this->size_;
+    }
+  }
+  return this->buffer_ + this->write_pos_;
+}
+
+void AudioRing::commit_write(size_t len) {
+  if (this->buffer_ == nullptr || len == 0)
+    return;
+  len = std::min(len, this->max_view_);
+  size_t start = this->write_pos_;
+  size_t end = start + len;
+  if (start < this->max_view_) {
+    // keep the mirror behind the end in sync with the start of the ring
+    size_t count = std::min(end, this->max_view_) - start;
+    memcpy(this->buffer_ + this->size_ + start, this->buffer_ + start, count);
+    this->mirrored_ += count;
+  }
+  if (end > this->size_) {
+    // the data was written into the mirror, copy it to the start of the ring
+    size_t count = end - this->size_;
+    memcpy(this->buffer_, this->buffer_ + this->size_, count);
+    this->mirrored_ += count;
+    end = count;
+  }
+  this->write_pos_ = end == this->size_ ? 0 : end;
+  for (auto *reader : this->readers_)
+    reader->available_ += len;
+}
+
+size_t AudioRing::write(const uint8_t *data, size_t len) {
+  size_t written = 0;
+  while (written < len) {
+    size_t chunk = std::min(len - written, this->max_view_);
+    uint8_t *dest = this->prepare_write(chunk);
+    if (dest == nullptr || chunk == 0)
+      break;
+    memcpy(dest, data + written, chunk);
+    this->commit_write(chunk);
+    written += chunk;
+  }
+  return written;
+}
+
+}  // namespace microphone
+}  // namespace esphome
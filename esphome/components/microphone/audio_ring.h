@@ -0,0 +1,98 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace esphome {
+namespace microphone {
+
+class AudioRing;
+
+/** The read position of one consumer of an AudioRing.
+ *
+ * Every reader sees all data that is written to the ring after it was added, independent of the other readers. Data is
+ * read in place through peek() and released with consume(), so it is never copied out of the ring.
+ */
+class AudioRingReader {
+ public:
+  /// Whether the reader was added to a ring.
+  bool is_attached() const { return this->ring_ != nullptr; }
+  /// Number of bytes that were written but not consumed yet.
+  size_t available() const { return this->available_; }
+
+  /** Get a contiguous view of the next `len` bytes without consuming them.
+   *
+   * The view stays valid until the next write to the ring.
+   * @return nullptr if fewer than `len` bytes are available or `len` is larger than the maximum view size of the ring.
+   */
+  const uint8_t *peek(size_t len) const;
+  /// Release the first `len` bytes of the available data.
+  void consume(size_t len);
+  /// Release all available data.
+  void consume_all() { this->consume(this->available_); }
+
+  /// Number of bytes that were overwritten before this reader consumed them.
+  uint32_t get_dropped() const { return this->dropped_; }
+
+ protected:
+  friend class AudioRing;
+
+  AudioRing *ring_{nullptr};
+  size_t read_pos_{0};
+  size_t available_{0};
+  uint32_t dropped_{0};
+};
+
+/** A ring buffer for audio that is shared by several readers, e.g. wake word detection and the voice assistant.
+ *
+ * The writer gets a pointer into the ring to read the microphone into, and readers get pointers to read from, so audio
+ * samples are only copied when the microphone fills the ring. The first bytes of the ring are mirrored behind its end
+ * to keep views that cross the end contiguous. A writer that is faster than a reader overwrites the oldest data of that
+ * reader. The ring is meant to be used from the main loop only.
+ */
+class AudioRing {
+ public:
+  /** Register a reader that needs a ring of at least `size` bytes and views of up to `max_view` bytes.
+   *
+   * The buffer is allocated for the first reader, and reallocated if a reader needs more space than is available. All
+   * data is discarded in that case. The reader starts empty.
+   * @return false if the buffer could not be allocated.
+   */
+  bool add_reader(AudioRingReader *reader, size_t size, size_t max_view);
+  /// Unregister a reader. The buffer is freed when the last reader is removed.
+  void remove_reader(AudioRingReader *reader);
+
+  /** Get contiguous space to write up to `len` bytes to.
+   *
+   * Readers that would be overwritten lose their oldest data. Call commit_write() with the number of bytes that were
+   * actually written.
+   * @return nullptr if there are no readers, or `len` is larger than the maximum view size.
+   */
+  uint8_t *prepare_write(size_t len);
+  /// Make `len` bytes that were written to the space returned by prepare_write() available to all readers.
+  void commit_write(size_t len);
+  /// Copy data into the ring, in chunks of at most the maximum view size.
+  size_t write(const uint8_t *data, size_t len);
+
+  size_t get_size() const { return this->size_; }
+  size_t get_max_view() const { return this->max_view_; }
+  /// Number of bytes that were copied to keep the mirrored part of the ring in sync.
+  uint32_t get_mirrored() const { return this->mirrored_; }
+
+ protected:
+  friend class AudioRingReader;
+
+  bool allocate_(size_t size, size_t max_view);
+  void deallocate_();
+
+  uint8_t *buffer_{nullptr};
+  size_t size_{0};
+  size_t max_view_{0};
+  size_t write_pos_{0};
+  uint32_t mirrored_{0};
+  std::vector<AudioRingReader *> readers_{};
+};
+
+}  // namespace microphone
+}  // namespace esphome
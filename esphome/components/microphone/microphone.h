@@ -5,6 +5,7 @@
 #include <functional>
 #include <vector>
 #include "esphome/core/helpers.h"
+#include "audio_ring.h"
 
 namespace esphome {
 namespace microphone {
@@ -28,8 +29,24 @@ class Microphone {
   bool is_running() const { return this->state_ == STATE_RUNNING; }
   bool is_stopped() const { return this->state_ == STATE_STOPPED; }
 
+  /// The ring that components which process the audio of this microphone share, so each sample is read only once.
+  AudioRing &get_audio_ring() { return this->audio_ring_; }
+  /** Read up to `len` bytes from the microphone directly into the shared audio ring.
+   *
+   * @return The number of bytes that were made available to all readers of the ring.
+   */
+  size_t read_to_audio_ring(size_t len) {
+    uint8_t *dest = this->audio_ring_.prepare_write(len);
+    if (dest == nullptr)
+      return 0;
+    size_t bytes_read = this->read(reinterpret_cast<int16_t *>(dest), len);
+    this->audio_ring_.commit_write(bytes_read);
+    return bytes_read;
+  }
+
  protected:
   State state_{STATE_STOPPED};
+  AudioRing audio_ring_{};
 
   CallbackManager<void(const std::vector<int16_t> &)> data_callbacks_{};
 };
@@ -2,6 +2,7 @@
 #include "esphome/core/util.h"
 #include "esphome/core/log.h"
 #include "esphome/core/application.h"
+#include <algorithm>
 #include <cinttypes>
 
 namespace esphome {
@@ -9,6 +10,9 @@ namespace nextion {
 
 static const char *const TAG = "nextion";
 
+// Number of released NO_RESULT queue entries that are kept for reuse
+static const size_t QUEUE_POOL_SIZE = 8;
+
 void Nextion::setup() {
   this->is_setup_ = false;
   this->ignore_is_setup_ = true;
@@ -130,7 +134,12 @@ void Nextion::reset_(bool reset_nextion) {
   while (this->available()) {  // Clear receive buffer
     this->read_byte(&d);
   };
+  this->pending_sets_.clear();
+  for (auto *entry : this->nextion_queue_)
+    this->release_queue_entry_(entry);
   this->nextion_queue_.clear();
+  for (auto *entry : this->waveform_queue_)
+    this->release_queue_entry_(entry);
   this->waveform_queue_.clear();
 }
 
@@ -158,6 +167,13 @@ void Nextion::dump_config() {
   if (this->start_up_page_ != -1) {
     ESP_LOGCONFIG(TAG, "  Start Up Page:    %" PRId16, this->start_up_page_);
   }
+
+  const auto &stats = this->queue_stats_;
+  ESP_LOGCONFIG(TAG,
+                "  Queue:            %" PRIu32 " acknowledged, %" PRIu32 " coalesced, max depth %" PRIu32
+                ", latency avg %" PRIu32 "ms, max %" PRIu32 "ms",
+                stats.acknowledged, stats.coalesced, stats.max_depth,
+                stats.acknowledged == 0 ? 0 : stats.total_latency_ms / stats.acknowledged, stats.max_latency_ms);
 }
 
 float Nextion::get_setup_priority() const { return setup_priority::DATA; }
@@ -314,14 +330,18 @@ bool Nextion::remove_from_q_(bool report_empty) {
 
   ESP_LOGN(TAG, "Removing %s from the queue", component->get_variable_name().c_str());
 
+  uint32_t latency = millis() - nb->queue_time;
+  this->queue_stats_.acknowledged++;
+  this->queue_stats_.total_latency_ms += latency;
+  this->queue_stats_.max_latency_ms = std::max(this->queue_stats_.max_latency_ms, latency);
+
   if (component->get_queue_type() == NextionQueueType::NO_RESULT) {
     if (component->get_variable_name() == "sleep_wake") {
       this->is_sleeping_ = false;
     }
-    delete component;  // NOLINT(cppcoreguidelines-owning-memory)
   }
-  delete nb;  // NOLINT(cppcoreguidelines-owning-memory)
   this->nextion_queue_.pop_front();
+  this->release_queue_entry_(nb);
   return true;
 }
 
@@ -533,8 +553,8 @@ void Nextion::process_nextion_commands_() {
           component->set_state_from_string(to_process, true, false);
         }
 
-        delete nb;  // NOLINT(cppcoreguidelines-owning-memory)
         this->nextion_queue_.pop_front();
+        this->release_queue_entry_(nb);
 
         break;
       }
@@ -576,8 +596,8 @@ void Nextion::process_nextion_commands_() {
           component->set_state_from_int(value, true, false);
         }
 
-        delete nb;  // NOLINT(cppcoreguidelines-owning-memory)
         this->nextion_queue_.pop_front();
+        this->release_queue_entry_(nb);
 
         break;
       }
@@ -794,13 +814,12 @@ void Nextion::process_nextion_commands_() {
           if (component->get_variable_name() == "sleep_wake") {
             this->is_sleeping_ = false;
           }
-          delete component;  // NOLINT(cppcoreguidelines-owning-memory)
         }
 
-        delete this->nextion_queue_[i];  // NOLINT(cppcoreguidelines-owning-memory)
-
+        NextionQueue *nb = this->nextion_queue_[i];
         this->nextion_queue_.erase(this->nextion_queue_.begin() + i);
         i--;
+        this->release_queue_entry_(nb);
 
       } else {
         break;
@@ -963,16 +982,12 @@ uint16_t Nextion::recv_ret_string_(std::string &response, uint32_t timeout, bool
  * @param variable_name Name for the queue
  */
 void Nextion::add_no_result_to_queue_(const std::string &variable_name) {
-  // NOLINTNEXTLINE(cppcoreguidelines-owning-memory)
-  nextion::NextionQueue *nextion_queue = new nextion::NextionQueue;
-
-  // NOLINTNEXTLINE(cppcoreguidelines-owning-memory)
-  nextion_queue->component = new nextion::NextionComponentBase;
+  nextion::NextionQueue *nextion_queue = this->acquire_no_result_entry_();
   nextion_queue->component->set_variable_name(variable_name);
 
   nextion_queue->queue_time = millis();
 
-  this->nextion_queue_.push_back(nextion_queue);
+  this->push_to_queue_(nextion_queue);
 
   ESP_LOGN(TAG, "Add to queue type: NORESULT component %s", nextion_queue->component->get_variable_name().c_str());
 }
@@ -1061,8 +1076,9 @@ void Nextion::add_no_result_to_queue_with_set_internal_(const std::string &varia
   if ((!this->is_setup() && !this->ignore_is_setup_) || (!is_sleep_safe && this->is_sleeping()))
     return;
 
-  this->add_no_result_to_queue_with_ignore_sleep_printf_(variable_name, "%s=%" PRId32, variable_name_to_send.c_str(),
-                                                         state_value);
+  this->add_no_result_set_command_(variable_name,
+                                   str_sprintf("%s=%" PRId32, variable_name_to_send.c_str(), state_value),
+                                   is_sleep_safe);
 }
 
 /**
@@ -1089,8 +1105,101 @@ void Nextion::add_no_result_to_queue_with_set_internal_(const std::string &varia
   if ((!this->is_setup() && !this->ignore_is_setup_) || (!is_sleep_safe && this->is_sleeping()))
     return;
 
-  this->add_no_result_to_queue_with_printf_(variable_name, "%s=\"%s\"", variable_name_to_send.c_str(),
-                                            state_value.c_str());
+  this->add_no_result_set_command_(variable_name,
+                                   str_sprintf("%s=\"%s\"", variable_name_to_send.c_str(), state_value.c_str()),
+                                   is_sleep_safe);
+}
+
+/**
+ * @brief Sends a variable set, or keeps it to be sent once the previous set of the variable has been acknowledged.
+ *
+ * Only the latest value of a variable is sent while an earlier set is in flight, so fast changing sensors don't fill
+ * the link with values that are overwritten right away.
+ *
+ * @param variable_name Variable name for the queue
+ * @param command The set command
+ * @param is_sleep_safe The command is safe to send when the Nextion is sleeping
+ */
+void Nextion::add_no_result_set_command_(const std::string &variable_name, const std::string &command,
+                                         bool is_sleep_safe) {
+  uint32_t now = millis();
+  for (auto *entry : this->nextion_queue_) {
+    NextionComponentBase *component = entry->component;
+    if (component->get_queue_type() != NextionQueueType::NO_RESULT || component->get_variable_name() != variable_name)
+      continue;
+    // a set that has not been acknowledged in time is likely lost and doesn't hold back newer values
+    if (now - entry->queue_time > this->max_q_age_ms_)
+      continue;
+
+    for (auto &pending : this->pending_sets_) {
+      if (pending.variable_name == variable_name) {
+        ESP_LOGN(TAG, "Replacing pending set of %s", variable_name.c_str());
+        pending.command = command;
+        pending.is_sleep_safe = is_sleep_safe;
+        this->queue_stats_.coalesced++;
+        return;
+      }
+    }
+    this->pending_sets_.push_back(PendingSet{variable_name, command, is_sleep_safe});
+    return;
+  }
+
+  // an older pending value of the variable is superseded by this one
+  for (auto it = this->pending_sets_.begin(); it != this->pending_sets_.end(); ++it) {
+    if (it->variable_name == variable_name) {
+      this->pending_sets_.erase(it);
+      this->queue_stats_.coalesced++;
+      break;
+    }
+  }
+  this->add_no_result_to_queue_with_command_(variable_name, command);
+}
+
+void Nextion::send_pending_set_(const std::string &variable_name) {
+  for (auto it = this->pending_sets_.begin(); it != this->pending_sets_.end(); ++it) {
+    if (it->variable_name != variable_name)
+      continue;
+
+    PendingSet pending = std::move(*it);
+    this->pending_sets_.erase(it);
+    // all states are sent again when the Nextion wakes up
+    if (pending.is_sleep_safe || !this->is_sleeping())
+      this->add_no_result_to_queue_with_command_(pending.variable_name, pending.command);
+    return;
+  }
+}
+
+NextionQueue *Nextion::acquire_no_result_entry_() {
+  if (!this->queue_pool_.empty()) {
+    NextionQueue *entry = this->queue_pool_.back();
+    this->queue_pool_.pop_back();
+    return entry;
+  }
+
+  // NOLINTNEXTLINE(cppcoreguidelines-owning-memory)
+  nextion::NextionQueue *entry = new nextion::NextionQueue;
+  // NOLINTNEXTLINE(cppcoreguidelines-owning-memory)
+  entry->component = new nextion::NextionComponentBase;
+  return entry;
+}
+
+void Nextion::release_queue_entry_(NextionQueue *entry) {
+  // only NO_RESULT entries own their component, the others point to the sensor they belong to
+  if (entry->component->get_queue_type() == NextionQueueType::NO_RESULT) {
+    if (!this->pending_sets_.empty())
+      this->send_pending_set_(entry->component->get_variable_name());
+    if (this->queue_pool_.size() < QUEUE_POOL_SIZE) {
+      this->queue_pool_.push_back(entry);
+      return;
+    }
+    delete entry->component;  // NOLINT(cppcoreguidelines-owning-memory)
+  }
+  delete entry;  // NOLINT(cppcoreguidelines-owning-memory)
+}
+
+void Nextion::push_to_queue_(NextionQueue *entry) {
+  this->nextion_queue_.push_back(entry);
+  this->queue_stats_.max_depth = std::max<uint32_t>(this->queue_stats_.max_depth, this->nextion_queue_.size());
 }
 
 void Nextion::add_to_get_queue(NextionComponentBase *component) {
@@ -1109,7 +1218,7 @@ void Nextion::add_to_get_queue(NextionComponentBase *component) {
   std::string command = "get " + component->get_variable_name_to_send();
 
   if (this->send_command_(command)) {
-    this->nextion_queue_.push_back(nextion_queue);
+    this->push_to_queue_(nextion_queue);
   }
 }
 
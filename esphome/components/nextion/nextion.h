@@ -33,6 +33,15 @@ class NextionComponentBase;
 
 using nextion_writer_t = std::function<void(Nextion &)>;
 
+/// Statistics of the command queue, to judge whether the UART link keeps up with the writes.
+struct NextionQueueStats {
+  uint32_t acknowledged{0};      ///< number of queued commands the Nextion has responded to
+  uint32_t coalesced{0};         ///< number of variable sets that replaced a set of the same variable not sent yet
+  uint32_t max_depth{0};         ///< largest number of commands that were waiting for a response at once
+  uint32_t max_latency_ms{0};    ///< longest time between sending a command and receiving its response
+  uint32_t total_latency_ms{0};  ///< sum of the response times of all acknowledged commands
+};
+
 static const std::string COMMAND_DELIMITER{static_cast<char>(255), static_cast<char>(255), static_cast<char>(255)};
 
 class Nextion : public NextionBase, public PollingComponent, public uart::UARTDevice {
@@ -1187,6 +1196,14 @@ class Nextion : public NextionBase, public PollingComponent, public uart::UARTDe
    */
   size_t queue_size() { return this->nextion_queue_.size(); }
 
+  /**
+   * @brief Get the statistics of the command queue.
+   *
+   * The response times and the largest queue depth show whether the UART link keeps up with the commands sent to the
+   * display, and the number of coalesced sets how many redundant writes were saved.
+   */
+  const NextionQueueStats &get_queue_stats() const { return this->queue_stats_; }
+
   /**
    * @brief Check if the TFT update process is currently running.
    *
@@ -1229,6 +1246,24 @@ class Nextion : public NextionBase, public PollingComponent, public uart::UARTDe
  protected:
   std::deque<NextionQueue *> nextion_queue_;
   std::deque<NextionQueue *> waveform_queue_;
+  NextionQueueStats queue_stats_{};
+
+  /// A variable set that waits for the response to the previous set of the same variable before it is sent.
+  struct PendingSet {
+    std::string variable_name;
+    std::string command;
+    bool is_sleep_safe;
+  };
+  std::vector<PendingSet> pending_sets_;
+  /// Released NO_RESULT queue entries, kept with their component to be reused for the next commands.
+  std::vector<NextionQueue *> queue_pool_;
+
+  NextionQueue *acquire_no_result_entry_();
+  /// Free an entry that was removed from a queue, and send the set that waited for it if there is one.
+  void release_queue_entry_(NextionQueue *entry);
+  void push_to_queue_(NextionQueue *entry);
+  void add_no_result_set_command_(const std::string &variable_name, const std::string &command, bool is_sleep_safe);
+  void send_pending_set_(const std::string &variable_name);
   uint16_t recv_ret_string_(std::string &response, uint32_t timeout, bool recv_flag);
   void all_components_send_state_(bool force_update = false);
   uint64_t comok_sent_ = 0;
@@ -84,6 +84,10 @@ template<typename... Ts> class NumberInRangeCondition : public Condition<Ts...>
       return this->min_ <= state && state <= this->max_;
     }
   }
+  bool add_on_dependency_change_callback(const std::function<void()> &callback) override {
+    this->parent_->add_on_state_callback([callback](float) { callback(); });
+    return true;
+  }
 
  protected:
   Number *parent_;
@@ -28,7 +28,7 @@ OnlineImage::OnlineImage(const std::string &url, int width, int height, ImageFor
                          uint32_t download_buffer_size)
     : Image(nullptr, 0, 0, type),
       buffer_(nullptr),
-      download_buffer_(download_buffer_size),
+      download_stream_(download_buffer_size),
       format_(format),
       fixed_width_(width),
       fixed_height_(height) {
@@ -154,20 +154,17 @@ void OnlineImage::loop() {
     ESP_LOGE(TAG, "Downloader not instantiated; cannot download");
     return;
   }
-  size_t available = this->download_buffer_.free_capacity();
-  if (available) {
-    auto len = this->downloader_->read(this->download_buffer_.append(), available);
-    if (len > 0) {
-      this->download_buffer_.write(len);
-      auto fed = this->decoder_->decode(this->download_buffer_.data(), this->download_buffer_.unread());
-      if (fed < 0) {
-        ESP_LOGE(TAG, "Error when decoding image.");
-        this->end_connection_();
-        this->download_error_callback_.call();
-        return;
-      }
-      this->download_buffer_.read(fed);
+  // nothing more is downloaded while the buffer is full with data the decoder cannot use yet
+  auto result = this->download_stream_.poll(
+      this->downloader_.get(), [this](uint8_t *data, size_t len) { return this->decoder_->decode(data, len); });
+  if (result == http_request::HTTP_STREAM_STOPPED || result == http_request::HTTP_STREAM_ERROR) {
+    if (result == http_request::HTTP_STREAM_STOPPED) {
+      ESP_LOGE(TAG, "Error when decoding image.");
+    } else {
+      ESP_LOGE(TAG, "Error when downloading image.");
     }
+    this->end_connection_();
+    this->download_error_callback_.call();
   }
 }
 
@@ -246,7 +243,7 @@ void OnlineImage::end_connection_() {
     this->downloader_ = nullptr;
   }
   this->decoder_.reset();
-  this->download_buffer_.reset();
+  this->download_stream_.reset();
 }
 
 bool OnlineImage::validate_url_(const std::string &url) {
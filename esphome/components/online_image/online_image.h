@@ -116,7 +116,7 @@ class OnlineImage : public PollingComponent,
   std::unique_ptr<ImageDecoder> decoder_{nullptr};
 
   uint8_t *buffer_;
-  DownloadBuffer download_buffer_;
+  http_request::HttpStream download_stream_;
 
   const ImageFormat format_;
   image::Image *placeholder_{nullptr};
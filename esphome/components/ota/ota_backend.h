@@ -23,6 +23,7 @@ enum OTAResponseTypes {
   OTA_RESPONSE_UPDATE_END_OK = 0x45,
   OTA_RESPONSE_SUPPORTS_COMPRESSION = 0x46,
   OTA_RESPONSE_CHUNK_OK = 0x47,
+  OTA_RESPONSE_SUPPORTS_DELTA = 0x48,
 
   OTA_RESPONSE_ERROR_MAGIC = 0x80,
   OTA_RESPONSE_ERROR_UPDATE_PREPARE = 0x81,
@@ -37,6 +38,7 @@ enum OTAResponseTypes {
   OTA_RESPONSE_ERROR_NO_UPDATE_PARTITION = 0x8A,
   OTA_RESPONSE_ERROR_MD5_MISMATCH = 0x8B,
   OTA_RESPONSE_ERROR_RP2040_NOT_ENOUGH_SPACE = 0x8C,
+  OTA_RESPONSE_ERROR_INVALID_DELTA = 0x8D,
   OTA_RESPONSE_ERROR_UNKNOWN = 0xFF,
 };
 
@@ -57,6 +59,12 @@ class OTABackend {
   virtual OTAResponseTypes end() = 0;
   virtual void abort() = 0;
   virtual bool supports_compression() = 0;
+
+  /// @brief Size of the image that is currently running, or 0 if it can not be read back.
+  /// @details Backends that can read the running image support delta updates, which are reconstructed from it.
+  virtual size_t get_running_image_size() { return 0; }
+  /// @brief Read a part of the image that is currently running.
+  virtual bool read_running_image(size_t offset, uint8_t *data, size_t len) { return false; }
 };
 
 class OTAComponent : public Component {
@@ -4,6 +4,7 @@
 #include "esphome/components/md5/md5.h"
 #include "esphome/core/defines.h"
 
+#include <esp_image_format.h>
 #include <esp_ota_ops.h>
 #include <esp_task_wdt.h>
 
@@ -111,6 +112,28 @@ void IDFOTABackend::abort() {
   this->update_handle_ = 0;
 }
 
+size_t IDFOTABackend::get_running_image_size() {
+  if (this->running_partition_ != nullptr)
+    return this->running_image_size_;
+  const esp_partition_t *partition = esp_ota_get_running_partition();
+  if (partition == nullptr)
+    return 0;
+  // the partition is larger than the image, the length of the image is taken from its segment headers
+  const esp_partition_pos_t pos = {.offset = partition->address, .size = partition->size};
+  esp_image_metadata_t metadata{};
+  if (esp_image_verify(ESP_IMAGE_VERIFY_SILENT, &pos, &metadata) != ESP_OK)
+    return 0;
+  this->running_partition_ = partition;
+  this->running_image_size_ = metadata.image_len;
+  return this->running_image_size_;
+}
+
+bool IDFOTABackend::read_running_image(size_t offset, uint8_t *data, size_t len) {
+  if (this->running_partition_ == nullptr)
+    return false;
+  return esp_partition_read(this->running_partition_, offset, data, len) == ESP_OK;
+}
+
 }  // namespace ota
 }  // namespace esphome
 #endif
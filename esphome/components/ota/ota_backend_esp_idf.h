@@ -18,8 +18,12 @@ class IDFOTABackend : public OTABackend {
   OTAResponseTypes end() override;
   void abort() override;
   bool supports_compression() override { return false; }
+  size_t get_running_image_size() override;
+  bool read_running_image(size_t offset, uint8_t *data, size_t len) override;
 
  private:
+  const esp_partition_t *running_partition_{nullptr};
+  size_t running_image_size_{0};
   esp_ota_handle_t update_handle_{0};
   const esp_partition_t *partition_;
   md5::MD5Digest md5_{};
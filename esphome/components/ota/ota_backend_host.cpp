@@ -0,0 +1,98 @@
+#ifdef USE_HOST
+#include "ota_backend_host.h"
+
+#include "esphome/core/application.h"
+#include "esphome/core/log.h"
+
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+
+namespace esphome {
+namespace ota {
+namespace fs = std::filesystem;
+
+static const char *const TAG = "ota.host";
+
+std::unique_ptr<ota::OTABackend> make_ota_backend() { return make_unique<ota::HostOTABackend>(); }
+
+std::string HostOTABackend::get_filename_() const {
+  return (fs::path(getenv("HOME")) / ".esphome" / "ota" / (App.get_name() + ".bin")).string();
+}
+
+OTAResponseTypes HostOTABackend::begin(size_t image_size) {
+  this->filename_ = this->get_filename_();
+  std::error_code ec;
+  fs::create_directories(fs::path(this->filename_).parent_path(), ec);
+  // the image is received into a temporary file, so an aborted update leaves the previous image in place
+  this->file_ = fopen((this->filename_ + ".part").c_str(), "wb");
+  if (this->file_ == nullptr) {
+    ESP_LOGW(TAG, "Could not open %s.part: errno %d", this->filename_.c_str(), errno);
+    return OTA_RESPONSE_ERROR_UPDATE_PREPARE;
+  }
+  ESP_LOGD(TAG, "Writing %zu bytes to %s", image_size, this->filename_.c_str());
+  this->md5_.init();
+  return OTA_RESPONSE_OK;
+}
+
+void HostOTABackend::set_update_md5(const char *expected_md5) { memcpy(this->expected_bin_md5_, expected_md5, 32); }
+
+OTAResponseTypes HostOTABackend::write(uint8_t *data, size_t len) {
+  this->md5_.add(data, len);
+  if (fwrite(data, 1, len, this->file_) != len)
+    return OTA_RESPONSE_ERROR_WRITING_FLASH;
+  return OTA_RESPONSE_OK;
+}
+
+OTAResponseTypes HostOTABackend::end() {
+  this->md5_.calculate();
+  if (!this->md5_.equals_hex(this->expected_bin_md5_)) {
+    this->abort();
+    return OTA_RESPONSE_ERROR_MD5_MISMATCH;
+  }
+  int err = fclose(this->file_);
+  this->file_ = nullptr;
+  this->close_running_image_();
+  std::error_code ec;
+  if (err == 0)
+    fs::rename(this->filename_ + ".part", this->filename_, ec);
+  if (err != 0 || ec)
+    return OTA_RESPONSE_ERROR_UPDATE_END;
+  return OTA_RESPONSE_OK;
+}
+
+void HostOTABackend::abort() {
+  this->close_running_image_();
+  if (this->file_ == nullptr)
+    return;
+  fclose(this->file_);
+  this->file_ = nullptr;
+  std::error_code ec;
+  fs::remove(this->filename_ + ".part", ec);
+}
+
+size_t HostOTABackend::get_running_image_size() {
+  std::error_code ec;
+  auto size = fs::file_size(this->get_filename_(), ec);
+  return ec ? 0 : size;
+}
+
+bool HostOTABackend::read_running_image(size_t offset, uint8_t *data, size_t len) {
+  if (this->running_image_ == nullptr) {
+    this->running_image_ = fopen(this->get_filename_().c_str(), "rb");
+    if (this->running_image_ == nullptr)
+      return false;
+  }
+  return fseek(this->running_image_, offset, SEEK_SET) == 0 && fread(data, 1, len, this->running_image_) == len;
+}
+
+void HostOTABackend::close_running_image_() {
+  if (this->running_image_ == nullptr)
+    return;
+  fclose(this->running_image_);
+  this->running_image_ = nullptr;
+}
+
+}  // namespace ota
+}  // namespace esphome
+#endif
@@ -0,0 +1,41 @@
+#pragma once
+#ifdef USE_HOST
+#include "ota_backend.h"
+
+#include "esphome/components/md5/md5.h"
+#include "esphome/core/defines.h"
+
+#include <cstdio>
+#include <string>
+
+namespace esphome {
+namespace ota {
+
+/// Stores the received image in a file below ~/.esphome/ota, named after the application.
+class HostOTABackend : public OTABackend {
+ public:
+  ~HostOTABackend() override { this->abort(); }
+  OTAResponseTypes begin(size_t image_size) override;
+  void set_update_md5(const char *md5) override;
+  OTAResponseTypes write(uint8_t *data, size_t len) override;
+  OTAResponseTypes end() override;
+  void abort() override;
+  bool supports_compression() override { return false; }
+  /// The last installed image is treated as the running one.
+  size_t get_running_image_size() override;
+  bool read_running_image(size_t offset, uint8_t *data, size_t len) override;
+
+ private:
+  std::string get_filename_() const;
+  void close_running_image_();
+
+  std::string filename_;
+  FILE *file_{nullptr};
+  FILE *running_image_{nullptr};
+  md5::MD5Digest md5_{};
+  char expected_bin_md5_[32];
+};
+
+}  // namespace ota
+}  // namespace esphome
+#endif
@@ -0,0 +1,156 @@
+#include "ota_delta.h"
+#include "esphome/components/md5/md5.h"
+#include "esphome/core/application.h"
+#include "esphome/core/log.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace esphome {
+namespace ota {
+
+static const char *const TAG = "ota.delta";
+
+static const uint8_t DELTA_MAGIC[] = {'E', 'S', 'P', 'D', 0x01};
+static const uint8_t DELTA_OP_COPY = 0x01;
+static const uint8_t DELTA_OP_DATA = 0x02;
+
+OTAResponseTypes OTADeltaDecoder::feed(const uint8_t *data, size_t len) {
+  const uint8_t *end = data + len;
+  while (data != end) {
+    if (this->state_ == STATE_DATA) {
+      // insert as much of the data as fits into the current buffer
+      size_t n = std::min<size_t>({this->remaining_, static_cast<size_t>(end - data),
+                                   this->pipeline_->get_buffer_size() - this->fill_});
+      memcpy(this->pipeline_->get_buffer() + this->fill_, data, n);
+      data += n;
+      this->fill_ += n;
+      this->remaining_ -= n;
+      if (this->remaining_ == 0)
+        this->state_ = STATE_OPCODE;
+      OTAResponseTypes error = this->commit_if_full_();
+      if (error != OTA_RESPONSE_OK)
+        return error;
+      continue;
+    }
+
+    uint8_t byte = *data++;
+    switch (this->state_) {
+      case STATE_MAGIC:
+        if (byte != DELTA_MAGIC[this->magic_pos_++]) {
+          ESP_LOGW(TAG, "Invalid patch header");
+          return OTA_RESPONSE_ERROR_INVALID_DELTA;
+        }
+        if (this->magic_pos_ == sizeof(DELTA_MAGIC))
+          this->state_ = STATE_OPCODE;
+        break;
+      case STATE_OPCODE:
+        if (byte != DELTA_OP_COPY && byte != DELTA_OP_DATA) {
+          ESP_LOGW(TAG, "Invalid patch operation 0x%02X", byte);
+          return OTA_RESPONSE_ERROR_INVALID_DELTA;
+        }
+        this->opcode_ = byte;
+        this->varint_ = 0;
+        this->varint_shift_ = 0;
+        this->state_ = byte == DELTA_OP_COPY ? STATE_OFFSET : STATE_LENGTH;
+        break;
+      default: {
+        // STATE_OFFSET and STATE_LENGTH read a varint, the 5th byte holds the top 4 bits and has to be the last
+        if (this->varint_shift_ == 28 && byte > 0x0F) {
+          ESP_LOGW(TAG, "Invalid number in patch");
+          return OTA_RESPONSE_ERROR_INVALID_DELTA;
+        }
+        this->varint_ |= static_cast<uint32_t>(byte & 0x7F) << this->varint_shift_;
+        this->varint_shift_ += 7;
+        if (byte & 0x80)
+          break;
+        if (this->state_ == STATE_OFFSET) {
+          this->offset_ = this->varint_;
+          this->varint_ = 0;
+          this->varint_shift_ = 0;
+          this->state_ = STATE_LENGTH;
+          break;
+        }
+        if (this->written_ + this->fill_ + this->varint_ > this->image_size_) {
+          ESP_LOGW(TAG, "Patch is larger than the image");
+          return OTA_RESPONSE_ERROR_INVALID_DELTA;
+        }
+        if (this->opcode_ == DELTA_OP_DATA) {
+          this->remaining_ = this->varint_;
+          this->state_ = this->remaining_ != 0 ? STATE_DATA : STATE_OPCODE;
+          break;
+        }
+        this->state_ = STATE_OPCODE;
+        OTAResponseTypes error = this->copy_(this->offset_, this->varint_);
+        if (error != OTA_RESPONSE_OK)
+          return error;
+        break;
+      }
+    }
+  }
+  return OTA_RESPONSE_OK;
+}
+
+OTAResponseTypes OTADeltaDecoder::copy_(uint32_t offset, uint32_t len) {
+  if (offset > this->source_size_ || len > this->source_size_ - offset) {
+    ESP_LOGW(TAG, "Patch copies beyond the running image");
+    return OTA_RESPONSE_ERROR_INVALID_DELTA;
+  }
+  // read the running image straight into the buffers of the pipeline
+  while (len != 0) {
+    size_t n = std::min<size_t>(len, this->pipeline_->get_buffer_size() - this->fill_);
+    if (!this->backend_->read_running_image(offset, this->pipeline_->get_buffer() + this->fill_, n)) {
+      ESP_LOGW(TAG, "Reading the running image failed");
+      return OTA_RESPONSE_ERROR_UNKNOWN;
+    }
+    offset += n;
+    len -= n;
+    this->fill_ += n;
+    App.feed_wdt();
+    OTAResponseTypes error = this->commit_if_full_();
+    if (error != OTA_RESPONSE_OK)
+      return error;
+  }
+  return OTA_RESPONSE_OK;
+}
+
+OTAResponseTypes OTADeltaDecoder::commit_if_full_() {
+  if (this->fill_ != this->pipeline_->get_buffer_size())
+    return OTA_RESPONSE_OK;
+  this->written_ += this->fill_;
+  this->fill_ = 0;
+  return this->pipeline_->commit(this->pipeline_->get_buffer_size());
+}
+
+OTAResponseTypes OTADeltaDecoder::finish() {
+  if (this->state_ != STATE_OPCODE || this->written_ + this->fill_ != this->image_size_) {
+    ESP_LOGW(TAG, "Patch ended after %zu of %zu bytes", this->written_ + this->fill_, this->image_size_);
+    return OTA_RESPONSE_ERROR_INVALID_DELTA;
+  }
+  if (this->fill_ == 0)
+    return OTA_RESPONSE_OK;
+  this->written_ += this->fill_;
+  size_t len = this->fill_;
+  this->fill_ = 0;
+  return this->pipeline_->commit(len);
+}
+
+bool get_running_image_md5(OTABackend *backend, size_t size, char *output) {
+  md5::MD5Digest md5{};
+  md5.init();
+  uint8_t buf[256];
+  for (size_t offset = 0; offset < size; offset += sizeof(buf)) {
+    size_t n = std::min(sizeof(buf), size - offset);
+    if (!backend->read_running_image(offset, buf, n))
+      return false;
+    md5.add(buf, n);
+    if ((offset & 0xFFFF) == 0)
+      App.feed_wdt();
+  }
+  md5.calculate();
+  md5.get_hex(output);
+  return true;
+}
+
+}  // namespace ota
+}  // namespace esphome
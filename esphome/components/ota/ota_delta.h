@@ -0,0 +1,55 @@
+#pragma once
+
+#include "ota_backend.h"
+#include "ota_write_pipeline.h"
+
+namespace esphome {
+namespace ota {
+
+/// @brief Reconstructs an image from a delta patch against the running image, and writes it through a pipeline.
+/// @details The patch is decoded as it is received, so it is never stored. It starts with the magic bytes "ESPD"
+/// and a version byte, followed by operations. All numbers are unsigned LEB128 varints.
+/// - `0x01 offset length`: copy `length` bytes of the running image, starting at `offset`.
+/// - `0x02 length data`: insert the `length` bytes of `data` that follow.
+///
+/// The reconstructed image is verified by the backend against the MD5 of the new image, like a full upload.
+class OTADeltaDecoder {
+ public:
+  OTADeltaDecoder(OTABackend *backend, OTAWritePipeline *pipeline, size_t source_size, size_t image_size)
+      : backend_(backend), pipeline_(pipeline), source_size_(source_size), image_size_(image_size) {}
+
+  /// @brief Decode the next part of the patch.
+  OTAResponseTypes feed(const uint8_t *data, size_t len);
+  /// @brief Write the remaining output, after the whole patch was fed.
+  OTAResponseTypes finish();
+
+ protected:
+  enum State : uint8_t { STATE_MAGIC, STATE_OPCODE, STATE_OFFSET, STATE_LENGTH, STATE_DATA };
+
+  OTAResponseTypes copy_(uint32_t offset, uint32_t len);
+  OTAResponseTypes commit_if_full_();
+
+  OTABackend *backend_;
+  OTAWritePipeline *pipeline_;
+  size_t source_size_;
+  size_t image_size_;
+  /// number of bytes of the image that were written to the pipeline
+  size_t written_{0};
+  /// number of bytes in the current buffer of the pipeline
+  size_t fill_{0};
+
+  State state_{STATE_MAGIC};
+  uint8_t magic_pos_{0};
+  uint8_t opcode_{0};
+  uint8_t varint_shift_{0};
+  uint32_t varint_{0};
+  uint32_t offset_{0};
+  /// bytes left of a data operation
+  uint32_t remaining_{0};
+};
+
+/// @brief Compute the MD5 of the running image as 32 hex characters, which identifies the source of delta updates.
+bool get_running_image_md5(OTABackend *backend, size_t size, char *output);
+
+}  // namespace ota
+}  // namespace esphome
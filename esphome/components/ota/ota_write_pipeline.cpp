@@ -0,0 +1,166 @@
+#include "ota_write_pipeline.h"
+#include "esphome/core/application.h"
+#include "esphome/core/hal.h"
+#include "esphome/core/helpers.h"
+#include "esphome/core/log.h"
+
+namespace esphome {
+namespace ota {
+
+static const char *const TAG = "ota.pipeline";
+
+#ifdef USE_ESP32
+static const uint32_t WRITER_TASK_STACK_SIZE = 6144;
+// Wait for the writer in steps, so the watchdog can be fed while a slow flash operation is in progress.
+static const TickType_t WAIT_STEP_TICKS = pdMS_TO_TICKS(100);
+#endif
+
+OTAWritePipeline::~OTAWritePipeline() {
+  if (this->threaded_) {
+    this->wait_idle_();
+#ifdef USE_ESP32
+    // the task is blocked waiting for work
+    vTaskDelete(this->task_handle_);
+    vSemaphoreDelete(this->work_semaphore_);
+    vSemaphoreDelete(this->idle_semaphore_);
+#endif
+#ifdef USE_HOST
+    {
+      std::lock_guard<std::mutex> guard(this->lock_);
+      this->stop_ = true;
+    }
+    this->cond_.notify_all();
+    this->thread_.join();
+#endif
+  }
+  RAMAllocator<uint8_t> allocator;
+  for (auto *buffer : this->buffers_) {
+    if (buffer != nullptr)
+      allocator.deallocate(buffer, this->buffer_size_);
+  }
+}
+
+bool OTAWritePipeline::start() {
+  // internal memory is preferred, it is faster to write to flash from it
+  RAMAllocator<uint8_t> allocator(RAMAllocator<uint8_t>::ALLOC_INTERNAL);
+  this->buffers_[0] = allocator.allocate(this->buffer_size_);
+  if (this->buffers_[0] == nullptr) {
+    ESP_LOGW(TAG, "Could not allocate %zu bytes for the receive buffer", this->buffer_size_);
+    return false;
+  }
+#if defined(USE_ESP32) || defined(USE_HOST)
+  // writes overlap with receiving only when a second buffer and the writer task are available
+  this->buffers_[1] = allocator.allocate(this->buffer_size_);
+  if (this->buffers_[1] == nullptr) {
+    ESP_LOGD(TAG, "Not enough memory for a second buffer, writing synchronously");
+    return true;
+  }
+#ifdef USE_ESP32
+  this->work_semaphore_ = xSemaphoreCreateBinary();
+  this->idle_semaphore_ = xSemaphoreCreateBinary();
+  if (this->work_semaphore_ != nullptr && this->idle_semaphore_ != nullptr) {
+    xSemaphoreGive(this->idle_semaphore_);
+    this->threaded_ = xTaskCreate(OTAWritePipeline::writer_task_, "ota_writer", WRITER_TASK_STACK_SIZE, this,
+                                  uxTaskPriorityGet(nullptr), &this->task_handle_) == pdPASS;
+  }
+  if (!this->threaded_) {
+    ESP_LOGD(TAG, "Could not create the writer task, writing synchronously");
+    if (this->work_semaphore_ != nullptr)
+      vSemaphoreDelete(this->work_semaphore_);
+    if (this->idle_semaphore_ != nullptr)
+      vSemaphoreDelete(this->idle_semaphore_);
+  }
+#endif
+#ifdef USE_HOST
+  this->thread_ = std::thread(OTAWritePipeline::writer_task_, this);
+  this->threaded_ = true;
+#endif
+#endif
+  return true;
+}
+
+void OTAWritePipeline::write_pending_() {
+  if (this->error_ != OTA_RESPONSE_OK)
+    return;
+  this->error_ = this->backend_->write(this->buffers_[this->pending_], this->pending_len_);
+}
+
+OTAResponseTypes OTAWritePipeline::commit(size_t len) {
+  if (!this->threaded_) {
+    uint32_t start = millis();
+    this->pending_ = this->current_;
+    this->pending_len_ = len;
+    this->write_pending_();
+    this->wait_time_ += millis() - start;
+    return this->error_;
+  }
+
+  // the other buffer can only be handed over once the previous write is done
+  this->wait_idle_();
+  OTAResponseTypes error = this->error_;
+  this->pending_ = this->current_;
+  this->pending_len_ = len;
+#ifdef USE_ESP32
+  xSemaphoreGive(this->work_semaphore_);
+#endif
+#ifdef USE_HOST
+  {
+    std::lock_guard<std::mutex> guard(this->lock_);
+    this->busy_ = true;
+  }
+  this->cond_.notify_all();
+#endif
+  this->current_ ^= 1;
+  return error;
+}
+
+OTAResponseTypes OTAWritePipeline::flush() {
+  if (this->threaded_) {
+    this->wait_idle_();
+#ifdef USE_ESP32
+    // leave the writer idle for the next commit
+    xSemaphoreGive(this->idle_semaphore_);
+#endif
+  }
+  return this->error_;
+}
+
+void OTAWritePipeline::wait_idle_() {
+  uint32_t start = millis();
+#ifdef USE_ESP32
+  while (xSemaphoreTake(this->idle_semaphore_, WAIT_STEP_TICKS) != pdTRUE)
+    App.feed_wdt();
+#endif
+#ifdef USE_HOST
+  std::unique_lock<std::mutex> guard(this->lock_);
+  this->cond_.wait(guard, [this]() { return !this->busy_; });
+#endif
+  this->wait_time_ += millis() - start;
+}
+
+void OTAWritePipeline::writer_task_(void *arg) {
+  auto *pipeline = static_cast<OTAWritePipeline *>(arg);
+#ifdef USE_ESP32
+  while (true) {
+    xSemaphoreTake(pipeline->work_semaphore_, portMAX_DELAY);
+    pipeline->write_pending_();
+    xSemaphoreGive(pipeline->idle_semaphore_);
+  }
+#endif
+#ifdef USE_HOST
+  std::unique_lock<std::mutex> guard(pipeline->lock_);
+  while (true) {
+    pipeline->cond_.wait(guard, [pipeline]() { return pipeline->busy_ || pipeline->stop_; });
+    if (pipeline->stop_)
+      return;
+    guard.unlock();
+    pipeline->write_pending_();
+    guard.lock();
+    pipeline->busy_ = false;
+    pipeline->cond_.notify_all();
+  }
+#endif
+}
+
+}  // namespace ota
+}  // namespace esphome
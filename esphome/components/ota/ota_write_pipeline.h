@@ -0,0 +1,93 @@
+#pragma once
+
+#include "ota_backend.h"
+#include "esphome/core/defines.h"
+
+#ifdef USE_ESP32
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+#endif
+
+#ifdef USE_HOST
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#endif
+
+namespace esphome {
+namespace ota {
+
+/// @brief Writes the received image to an OTABackend through two buffers.
+/// @details While one buffer is written by the backend, the next part of the image can be received into the other
+/// one. On ESP32 and the host the writes are done by a separate task, on other platforms a single buffer is used and
+/// it is written when it is committed.
+/// @n typical usage:
+/// @code
+/// OTAWritePipeline pipeline(backend, 4096);
+/// if (!pipeline.start())
+///   ...
+/// while (...) {
+///   uint8_t *buf = pipeline.get_buffer();  // fill up to get_buffer_size() bytes
+///   error = pipeline.commit(len);
+/// }
+/// error = pipeline.flush();
+/// @endcode
+class OTAWritePipeline {
+ public:
+  OTAWritePipeline(OTABackend *backend, size_t buffer_size) : backend_(backend), buffer_size_(buffer_size) {}
+  ~OTAWritePipeline();
+
+  /// @brief Allocate the buffers and start the writer task.
+  /// @return false if the buffers could not be allocated.
+  bool start();
+
+  /// @brief The buffer that the next part of the image should be received into.
+  uint8_t *get_buffer() { return this->buffers_[this->current_]; }
+  size_t get_buffer_size() const { return this->buffer_size_; }
+
+  /// @brief Pass the first `len` bytes of the current buffer to the backend, and switch to the other buffer.
+  /// @details Waits until the other buffer has been written.
+  /// @return The error of the first write that failed, or OTA_RESPONSE_OK.
+  OTAResponseTypes commit(size_t len);
+
+  /// @brief Wait until all committed data has been written.
+  /// @return The error of the first write that failed, or OTA_RESPONSE_OK.
+  OTAResponseTypes flush();
+
+  /// @brief Total time spent waiting for the backend to finish a write, in ms.
+  uint32_t get_wait_time() const { return this->wait_time_; }
+
+ protected:
+  void write_pending_();
+  void wait_idle_();
+  static void writer_task_(void *arg);
+
+  OTABackend *backend_;
+  size_t buffer_size_;
+  uint8_t *buffers_[2]{nullptr, nullptr};
+  uint8_t current_{0};
+  /// index and length of the buffer that is handed to the writer task
+  uint8_t pending_{0};
+  size_t pending_len_{0};
+  /// only accessed by the writer task while a write is in progress
+  OTAResponseTypes error_{OTA_RESPONSE_OK};
+  uint32_t wait_time_{0};
+  bool threaded_{false};
+
+#ifdef USE_ESP32
+  TaskHandle_t task_handle_{nullptr};
+  SemaphoreHandle_t work_semaphore_{nullptr};
+  SemaphoreHandle_t idle_semaphore_{nullptr};
+#endif
+#ifdef USE_HOST
+  std::thread thread_;
+  std::mutex lock_;
+  std::condition_variable cond_;
+  bool busy_{false};
+  bool stop_{false};
+#endif
+};
+
+}  // namespace ota
+}  // namespace esphome
@@ -0,0 +1,76 @@
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome.const import (
+    CONF_COMPONENTS,
+    CONF_ID,
+    CONF_PRIORITY,
+    PLATFORM_ESP32,
+    PLATFORM_HOST,
+)
+from esphome.core import CORE
+from esphome.cpp_generator import MockObjClass
+import esphome.final_validate as fv
+
+CODEOWNERS = ["@esphome/core"]
+
+priority_loop_ns = cg.esphome_ns.namespace("priority_loop")
+PriorityLoop = priority_loop_ns.class_("PriorityLoop", cg.Component)
+
+CONF_LOOP_INTERVAL = "loop_interval"
+CONF_STACK_SIZE = "stack_size"
+
+CONFIG_SCHEMA = cv.All(
+    cv.Schema(
+        {
+            cv.GenerateID(): cv.declare_id(PriorityLoop),
+            cv.Required(CONF_COMPONENTS): cv.ensure_list(cv.use_id(cg.Component)),
+            cv.Optional(CONF_LOOP_INTERVAL, default="1ms"): cv.All(
+                cv.positive_time_period_milliseconds,
+                cv.Range(min=cv.TimePeriod(milliseconds=1)),
+            ),
+            cv.SplitDefault(CONF_PRIORITY, esp32=5): cv.All(
+                cv.only_on_esp32, cv.int_range(min=1, max=24)
+            ),
+            cv.SplitDefault(CONF_STACK_SIZE, esp32=4096): cv.All(
+                cv.only_on_esp32, cv.int_range(min=2048, max=32768)
+            ),
+        }
+    ).extend(cv.COMPONENT_SCHEMA),
+    cv.only_on([PLATFORM_ESP32, PLATFORM_HOST]),
+)
+
+
+def _final_validate(config):
+    # Entities publish their state from loop() or update(), which would then run concurrently with the main loop
+    declared_types = {
+        str(declared_id): declared_id.type
+        for declared_id, _ in fv.full_config.get().declare_ids
+    }
+    for index, component_id in enumerate(config[CONF_COMPONENTS]):
+        declared_type = declared_types.get(str(component_id))
+        if isinstance(declared_type, MockObjClass) and declared_type.inherits_from(
+            cg.EntityBase
+        ):
+            raise cv.Invalid(
+                f"'{component_id}' is an entity and can't be pinned to the priority loop. Pin the component "
+                "that talks to the hardware and publish from it with PriorityLoop::publish_state().",
+                path=[CONF_COMPONENTS, index],
+            )
+    return config
+
+
+FINAL_VALIDATE_SCHEMA = _final_validate
+
+
+async def to_code(config):
+    var = cg.new_Pvariable(config[CONF_ID])
+    await cg.register_component(var, config)
+
+    for component_id in config[CONF_COMPONENTS]:
+        component = await cg.get_variable(component_id)
+        cg.add(var.add_component(component))
+
+    cg.add(var.set_loop_interval(config[CONF_LOOP_INTERVAL]))
+    if CORE.is_esp32:
+        cg.add(var.set_task_priority(config[CONF_PRIORITY]))
+        cg.add(var.set_task_stack_size(config[CONF_STACK_SIZE]))
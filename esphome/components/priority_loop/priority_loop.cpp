@@ -0,0 +1,187 @@
+#include "priority_loop.h"
+#include "esphome/core/application.h"
+#include "esphome/core/hal.h"
+#include "esphome/core/log.h"
+
+#include <algorithm>
+#include <cinttypes>
+
+#ifdef USE_HOST
+#include <chrono>
+#endif
+
+namespace esphome {
+namespace priority_loop {
+
+static const char *const TAG = "priority_loop";
+
+#ifdef USE_ESP32
+// How long shutdown waits for the task to finish its current iteration.
+static const uint32_t STOP_TIMEOUT_MS = 1000;
+#endif
+
+void PriorityLoop::add_component(Component *component) {
+  this->components_.push_back(component);
+  App.move_to_task(component, &this->scheduler_);
+}
+
+void PriorityLoop::loop() {
+  if (!this->task_started_ && App.is_setup_complete())
+    this->start_task_();
+  if (this->run_in_main_loop_) {
+    this->run_components_();
+    this->scheduler_.call();
+  }
+
+  this->publish_queued_states_();
+
+  {
+    LockGuard guard(this->lock_);
+    if (this->deferred_.empty())
+      return;
+    this->running_.swap(this->deferred_);
+  }
+  for (auto &callback : this->running_)
+    callback();
+  this->running_.clear();
+}
+
+void PriorityLoop::defer(std::function<void()> &&callback) {
+  LockGuard guard(this->lock_);
+  this->deferred_.push_back(std::move(callback));
+}
+
+#ifdef USE_BINARY_SENSOR
+void PriorityLoop::publish_state(binary_sensor::BinarySensor *binary_sensor, bool state) {
+  this->queue_state_(
+      [](void *entity, float state) { static_cast<binary_sensor::BinarySensor *>(entity)->publish_state(state != 0); },
+      binary_sensor, state ? 1.0f : 0.0f);
+}
+#endif
+
+#ifdef USE_SENSOR
+void PriorityLoop::publish_state(sensor::Sensor *sensor, float state) {
+  this->queue_state_([](void *entity, float state) { static_cast<sensor::Sensor *>(entity)->publish_state(state); },
+                     sensor, state);
+}
+#endif
+
+void PriorityLoop::queue_state_(void (*publish)(void *entity, float state), void *entity, float state) {
+  LockGuard guard(this->lock_);
+  if (this->states_count_ == STATE_QUEUE_SIZE) {
+    // Logged from the main loop
+    this->states_dropped_++;
+    return;
+  }
+  this->states_[(this->states_head_ + this->states_count_) % STATE_QUEUE_SIZE] = {publish, entity, state};
+  this->states_count_++;
+}
+
+void PriorityLoop::publish_queued_states_() {
+  PendingState states[STATE_QUEUE_SIZE];
+  size_t count;
+  uint32_t dropped;
+  {
+    LockGuard guard(this->lock_);
+    count = this->states_count_;
+    for (size_t i = 0; i < count; i++)
+      states[i] = this->states_[(this->states_head_ + i) % STATE_QUEUE_SIZE];
+    this->states_head_ = (this->states_head_ + count) % STATE_QUEUE_SIZE;
+    this->states_count_ = 0;
+    dropped = this->states_dropped_;
+    this->states_dropped_ = 0;
+  }
+  for (size_t i = 0; i < count; i++)
+    states[i].publish(states[i].entity, states[i].state);
+  if (dropped != 0)
+    ESP_LOGW(TAG, "State queue full, dropped %" PRIu32 " states", dropped);
+}
+
+void PriorityLoop::start_task_() {
+  this->task_started_ = true;
+#ifdef USE_ESP32
+  BaseType_t res = xTaskCreate(PriorityLoop::task_func_, "priority_loop", this->task_stack_size_, this,
+                               this->task_priority_, &this->task_handle_);
+  if (res != pdPASS) {
+    ESP_LOGE(TAG, "Failed to create task, running components from the main loop");
+    this->task_handle_ = nullptr;
+    this->run_in_main_loop_ = true;
+  }
+#endif
+#ifdef USE_HOST
+  this->thread_ = std::thread(PriorityLoop::task_func_, this);
+#endif
+}
+
+void PriorityLoop::stop_task_() {
+#ifdef USE_ESP32
+  if (this->task_handle_ == nullptr)
+    return;
+  this->stop_waiter_ = xTaskGetCurrentTaskHandle();
+  this->stop_requested_ = true;
+  if (ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(STOP_TIMEOUT_MS)) == 0)
+    ESP_LOGW(TAG, "Task did not stop within %" PRIu32 "ms", STOP_TIMEOUT_MS);
+#endif
+#ifdef USE_HOST
+  this->stop_requested_ = true;
+  if (this->thread_.joinable())
+    this->thread_.join();
+#endif
+}
+
+void PriorityLoop::run_components_() {
+  for (auto *component : this->components_) {
+    if (!component->is_loop_enabled())
+      continue;
+    WarnIfComponentBlockingGuard guard{component};
+    component->call();
+  }
+}
+
+void PriorityLoop::task_func_(void *arg) {
+  auto *self = static_cast<PriorityLoop *>(arg);
+#ifdef USE_ESP32
+  const TickType_t interval = std::max<TickType_t>(pdMS_TO_TICKS(self->loop_interval_), 1);
+  TickType_t last_wake = xTaskGetTickCount();
+  while (!self->stop_requested_) {
+    self->run_components_();
+    self->scheduler_.call();
+    vTaskDelayUntil(&last_wake, interval);
+  }
+  TaskHandle_t waiter = self->stop_waiter_;
+  self->task_handle_ = nullptr;
+  xTaskNotifyGive(waiter);
+  vTaskDelete(nullptr);
+#endif
+#ifdef USE_HOST
+  const auto interval = std::chrono::milliseconds(self->loop_interval_);
+  auto next_wake = std::chrono::steady_clock::now();
+  while (!self->stop_requested_) {
+    self->run_components_();
+    self->scheduler_.call();
+    next_wake += interval;
+    auto now = std::chrono::steady_clock::now();
+    // Don't try to catch up on missed iterations, that would only make a stall worse.
+    if (next_wake < now)
+      next_wake = now;
+    std::this_thread::sleep_until(next_wake);
+  }
+#endif
+}
+
+// Stop the task before any component shuts down, so that pinned components are no longer called while they do.
+void PriorityLoop::on_safe_shutdown() { this->stop_task_(); }
+void PriorityLoop::on_shutdown() { this->stop_task_(); }
+
+void PriorityLoop::dump_config() {
+  ESP_LOGCONFIG(TAG, "Priority Loop:");
+  ESP_LOGCONFIG(TAG, "  Components: %zu", this->components_.size());
+  ESP_LOGCONFIG(TAG, "  Loop Interval: %" PRIu32 "ms", this->loop_interval_);
+#ifdef USE_ESP32
+  ESP_LOGCONFIG(TAG, "  Task Priority: %u", this->task_priority_);
+  ESP_LOGCONFIG(TAG, "  Task Stack Size: %" PRIu32, this->task_stack_size_);
+#endif
+}
+
+}  // namespace priority_loop
+}  // namespace esphome
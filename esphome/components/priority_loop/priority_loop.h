@@ -0,0 +1,120 @@
+#pragma once
+
+#include "esphome/core/component.h"
+#include "esphome/core/defines.h"
+#include "esphome/core/helpers.h"
+#include "esphome/core/scheduler.h"
+
+#ifdef USE_BINARY_SENSOR
+#include "esphome/components/binary_sensor/binary_sensor.h"
+#endif
+#ifdef USE_SENSOR
+#include "esphome/components/sensor/sensor.h"
+#endif
+
+#include <array>
+#include <functional>
+#include <vector>
+
+#ifdef USE_ESP32
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#endif
+#ifdef USE_HOST
+#include <atomic>
+#include <thread>
+#endif
+
+namespace esphome {
+namespace priority_loop {
+
+/** Runs the loop() of a fixed set of components on a dedicated high-priority task.
+ *
+ * The pinned components are removed from the main loop and called every `loop_interval` ms from their own
+ * task/thread, so a slow display redraw or network write in the main loop can no longer delay them. Their timers
+ * (set_timeout()/set_interval(), and update() of polling components) run from a separate scheduler on the same task.
+ * The task is only started once setup of all components is complete, so setup() and the first loop() never run
+ * concurrently.
+ *
+ * Pinned components run concurrently with the main loop, so they must not publish entity state directly. States go
+ * through publish_state(), which queues them for the main loop, other work through defer(). Entities themselves can't
+ * be pinned, this is checked when validating the configuration.
+ */
+class PriorityLoop : public Component {
+ public:
+  void add_component(Component *component);
+  void set_loop_interval(uint32_t loop_interval) { this->loop_interval_ = loop_interval; }
+#ifdef USE_ESP32
+  void set_task_priority(uint8_t task_priority) { this->task_priority_ = task_priority; }
+  void set_task_stack_size(uint32_t task_stack_size) { this->task_stack_size_ = task_stack_size; }
+#endif
+
+  void loop() override;
+  void dump_config() override;
+  void on_safe_shutdown() override;
+  void on_shutdown() override;
+  /// Set up late so that the task is stopped before the pinned components shut down.
+  float get_setup_priority() const override { return setup_priority::LATE; }
+
+  /// Queue a callback to be executed from the main loop. Safe to call from the priority task.
+  void defer(std::function<void()> &&callback);
+
+#ifdef USE_BINARY_SENSOR
+  /// Publish a state from the main loop. Safe to call from the priority task, states are published in order.
+  void publish_state(binary_sensor::BinarySensor *binary_sensor, bool state);
+#endif
+#ifdef USE_SENSOR
+  /// Publish a state from the main loop. Safe to call from the priority task, states are published in order.
+  void publish_state(sensor::Sensor *sensor, float state);
+#endif
+
+ protected:
+  /// A state published from the priority task, waiting for the main loop.
+  struct PendingState {
+    void (*publish)(void *entity, float state);
+    void *entity;
+    float state;
+  };
+  static const size_t STATE_QUEUE_SIZE = 32;
+
+  void start_task_();
+  void stop_task_();
+  void run_components_();
+  void queue_state_(void (*publish)(void *entity, float state), void *entity, float state);
+  void publish_queued_states_();
+  static void task_func_(void *arg);
+
+  std::vector<Component *> components_;
+  Scheduler scheduler_;
+  uint32_t loop_interval_{1};
+  bool task_started_{false};
+  /// Set when the task could not be created, so the components are not left without a loop.
+  bool run_in_main_loop_{false};
+
+  /// Guards the queued states and deferred callbacks.
+  Mutex lock_;
+  std::vector<std::function<void()>> deferred_;
+  /// Swapped with deferred_ under the lock so callbacks run without holding it.
+  std::vector<std::function<void()>> running_;
+  /// Ring buffer of states waiting to be published, without allocations on the priority task.
+  std::array<PendingState, STATE_QUEUE_SIZE> states_{};
+  size_t states_head_{0};
+  size_t states_count_{0};
+  uint32_t states_dropped_{0};
+
+#ifdef USE_ESP32
+  uint8_t task_priority_{5};
+  uint32_t task_stack_size_{4096};
+  TaskHandle_t task_handle_{nullptr};
+  /// The task waiting in stop_task_(), notified once the priority task has finished.
+  TaskHandle_t volatile stop_waiter_{nullptr};
+  volatile bool stop_requested_{false};
+#endif
+#ifdef USE_HOST
+  std::thread thread_;
+  std::atomic<bool> stop_requested_{false};
+#endif
+};
+
+}  // namespace priority_loop
+}  // namespace esphome
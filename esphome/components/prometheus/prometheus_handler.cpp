@@ -1,65 +1,230 @@
 #include "prometheus_handler.h"
 #ifdef USE_NETWORK
 #include "esphome/core/application.h"
+#include "esphome/core/hal.h"
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
 
 namespace esphome {
 namespace prometheus {
 
-void PrometheusHandler::handleRequest(AsyncWebServerRequest *req) {
-  AsyncResponseStream *stream = req->beginResponseStream("text/plain; version=0.0.4; charset=utf-8");
+void PrometheusHandler::setup() {
   std::string area = App.get_area();
   std::string node = App.get_name();
   std::string friendly_name = App.get_friendly_name();
+  std::string device_labels;
+  if (!area.empty())
+    device_labels += "\",area=\"" + area;
+  if (!node.empty())
+    device_labels += "\",node=\"" + node;
+  if (!friendly_name.empty())
+    device_labels += "\",friendly_name=\"" + friendly_name;
 
+  // The labels of an entity are the same for every scrape, so they are all built once here.
+  auto add = [&](EntityBase *obj, EntityType type) {
+    if (obj->is_internal() && !this->include_internal_)
+      return;
+    size_t offset = this->label_arena_.size();
+    this->label_arena_ += "id=\"";
+    this->label_arena_ += this->relabel_id_(obj);
+    this->label_arena_ += device_labels;
+    this->label_arena_ += "\",name=\"";
+    this->label_arena_ += this->relabel_name_(obj);
+    this->label_arena_ += '"';
+    this->entities_.push_back({obj, static_cast<uint32_t>(offset),
+                               static_cast<uint16_t>(this->label_arena_.size() - offset), type});
+  };
 #ifdef USE_SENSOR
-  this->sensor_type_(stream);
   for (auto *obj : App.get_sensors())
-    this->sensor_row_(stream, obj, area, node, friendly_name);
+    add(obj, TYPE_SENSOR);
 #endif
-
 #ifdef USE_BINARY_SENSOR
-  this->binary_sensor_type_(stream);
   for (auto *obj : App.get_binary_sensors())
-    this->binary_sensor_row_(stream, obj, area, node, friendly_name);
+    add(obj, TYPE_BINARY_SENSOR);
 #endif
-
 #ifdef USE_FAN
-  this->fan_type_(stream);
   for (auto *obj : App.get_fans())
-    this->fan_row_(stream, obj, area, node, friendly_name);
+    add(obj, TYPE_FAN);
 #endif
-
 #ifdef USE_LIGHT
-  this->light_type_(stream);
   for (auto *obj : App.get_lights())
-    this->light_row_(stream, obj, area, node, friendly_name);
+    add(obj, TYPE_LIGHT);
 #endif
-
 #ifdef USE_COVER
-  this->cover_type_(stream);
   for (auto *obj : App.get_covers())
-    this->cover_row_(stream, obj, area, node, friendly_name);
+    add(obj, TYPE_COVER);
 #endif
-
 #ifdef USE_SWITCH
-  this->switch_type_(stream);
   for (auto *obj : App.get_switches())
-    this->switch_row_(stream, obj, area, node, friendly_name);
+    add(obj, TYPE_SWITCH);
 #endif
-
 #ifdef USE_LOCK
-  this->lock_type_(stream);
   for (auto *obj : App.get_locks())
-    this->lock_row_(stream, obj, area, node, friendly_name);
+    add(obj, TYPE_LOCK);
 #endif
-
 #ifdef USE_TEXT_SENSOR
-  this->text_sensor_type_(stream);
   for (auto *obj : App.get_text_sensors())
-    this->text_sensor_row_(stream, obj, area, node, friendly_name);
+    add(obj, TYPE_TEXT_SENSOR);
+#endif
+  this->label_arena_.shrink_to_fit();
+  this->entities_.shrink_to_fit();
+  // the relabel maps are only needed to build the labels
+  this->relabel_map_id_.clear();
+  this->relabel_map_name_.clear();
+
+  this->base_->init();
+  this->base_->add_handler(this);
+}
+
+void PrometheusHandler::handleRequest(AsyncWebServerRequest *req) {
+  // Stream the exposition in chunks as the connection accepts them, instead of building all of it in memory first.
+  // It is not compressed: the deflate encoder in the ESP32 ROM (miniz tdefl) needs about 300 kB for its state with
+  // the 32 kB window that gzip uses, more than the free heap of most devices.
+  auto scrape = std::make_shared<Scrape>();
+  AsyncWebServerResponse *response = req->beginChunkedResponse(
+      "text/plain; version=0.0.4; charset=utf-8",
+      [this, scrape](uint8_t *buffer, size_t max_len, size_t index) -> size_t {
+        return this->fill_chunk_(*scrape, buffer, max_len);
+      });
+  req->send(response);
+}
+
+size_t PrometheusHandler::fill_chunk_(Scrape &scrape, uint8_t *buffer, size_t max_len) {
+  uint32_t start = micros();
+  size_t len = 0;
+  while (len < max_len) {
+    if (scrape.pending_pos == scrape.pending.size()) {
+      if (scrape.done)
+        break;
+      // generate the text of the next entity
+      scrape.pending.clear();
+      scrape.pending_pos = 0;
+      if (scrape.next_entity == this->entities_.size()) {
+        // declare the types without any entities, too
+        while (scrape.next_type != TYPE_COUNT)
+          this->write_types_(scrape.pending, static_cast<EntityType>(scrape.next_type++));
+        scrape.pending += "#TYPE esphome_prometheus_scrape_duration_seconds gauge\n"
+                          "esphome_prometheus_scrape_duration_seconds ";
+        scrape.pending += value_accuracy_to_string(this->last_scrape_duration_us_ / 1e6f, 6);
+        scrape.pending += '\n';
+        scrape.done = true;
+      } else {
+        const auto &entity = this->entities_[scrape.next_entity++];
+        while (scrape.next_type <= entity.type)
+          this->write_types_(scrape.pending, static_cast<EntityType>(scrape.next_type++));
+        this->write_entity_(scrape.pending, entity);
+      }
+      continue;
+    }
+    size_t count = std::min(scrape.pending.size() - scrape.pending_pos, max_len - len);
+    memcpy(buffer + len, scrape.pending.data() + scrape.pending_pos, count);
+    scrape.pending_pos += count;
+    len += count;
+  }
+  scrape.duration_us += micros() - start;
+  if (len == 0) {
+    this->last_scrape_duration_us_ = scrape.duration_us;
+    scrape.pending.clear();
+    scrape.pending.shrink_to_fit();
+  }
+  return len;
+}
+
+void PrometheusHandler::write_types_(std::string &out, EntityType type) {
+  switch (type) {
+#ifdef USE_SENSOR
+    case TYPE_SENSOR:
+      this->sensor_type_(out);
+      break;
+#endif
+#ifdef USE_BINARY_SENSOR
+    case TYPE_BINARY_SENSOR:
+      this->binary_sensor_type_(out);
+      break;
+#endif
+#ifdef USE_FAN
+    case TYPE_FAN:
+      this->fan_type_(out);
+      break;
+#endif
+#ifdef USE_LIGHT
+    case TYPE_LIGHT:
+      this->light_type_(out);
+      break;
+#endif
+#ifdef USE_COVER
+    case TYPE_COVER:
+      this->cover_type_(out);
+      break;
+#endif
+#ifdef USE_SWITCH
+    case TYPE_SWITCH:
+      this->switch_type_(out);
+      break;
+#endif
+#ifdef USE_LOCK
+    case TYPE_LOCK:
+      this->lock_type_(out);
+      break;
+#endif
+#ifdef USE_TEXT_SENSOR
+    case TYPE_TEXT_SENSOR:
+      this->text_sensor_type_(out);
+      break;
 #endif
+    default:
+      break;
+  }
+}
 
-  req->send(stream);
+void PrometheusHandler::write_entity_(std::string &out, const ExportedEntity &entity) {
+  StringRef labels(this->label_arena_.data() + entity.labels_offset, entity.labels_length);
+  switch (entity.type) {
+#ifdef USE_SENSOR
+    case TYPE_SENSOR:
+      this->sensor_row_(out, static_cast<sensor::Sensor *>(entity.obj), labels);
+      break;
+#endif
+#ifdef USE_BINARY_SENSOR
+    case TYPE_BINARY_SENSOR:
+      this->binary_sensor_row_(out, static_cast<binary_sensor::BinarySensor *>(entity.obj), labels);
+      break;
+#endif
+#ifdef USE_FAN
+    case TYPE_FAN:
+      this->fan_row_(out, static_cast<fan::Fan *>(entity.obj), labels);
+      break;
+#endif
+#ifdef USE_LIGHT
+    case TYPE_LIGHT:
+      this->light_row_(out, static_cast<light::LightState *>(entity.obj), labels);
+      break;
+#endif
+#ifdef USE_COVER
+    case TYPE_COVER:
+      this->cover_row_(out, static_cast<cover::Cover *>(entity.obj), labels);
+      break;
+#endif
+#ifdef USE_SWITCH
+    case TYPE_SWITCH:
+      this->switch_row_(out, static_cast<switch_::Switch *>(entity.obj), labels);
+      break;
+#endif
+#ifdef USE_LOCK
+    case TYPE_LOCK:
+      this->lock_row_(out, static_cast<lock::Lock *>(entity.obj), labels);
+      break;
+#endif
+#ifdef USE_TEXT_SENSOR
+    case TYPE_TEXT_SENSOR:
+      this->text_sensor_row_(out, static_cast<text_sensor::TextSensor *>(entity.obj), labels);
+      break;
+#endif
+    default:
+      break;
+  }
 }
 
 std::string PrometheusHandler::relabel_id_(EntityBase *obj) {
@@ -72,441 +237,210 @@ std::string PrometheusHandler::relabel_name_(EntityBase *obj) {
   return item == relabel_map_name_.end() ? obj->get_name() : item->second;
 }
 
-void PrometheusHandler::add_area_label_(AsyncResponseStream *stream, std::string &area) {
-  if (!area.empty()) {
-    stream->print(F("\",area=\""));
-    stream->print(area.c_str());
-  }
+/// Start a data point: the metric name and the constant labels of the entity, without the closing brace.
+static void add_row(std::string &out, const char *metric, const StringRef &labels) {
+  out += metric;
+  out += '{';
+  out.append(labels.c_str(), labels.size());
 }
 
-void PrometheusHandler::add_node_label_(AsyncResponseStream *stream, std::string &node) {
-  if (!node.empty()) {
-    stream->print(F("\",node=\""));
-    stream->print(node.c_str());
-  }
-}
-
-void PrometheusHandler::add_friendly_name_label_(AsyncResponseStream *stream, std::string &friendly_name) {
-  if (!friendly_name.empty()) {
-    stream->print(F("\",friendly_name=\""));
-    stream->print(friendly_name.c_str());
-  }
-}
+/// Format a value the way Print::print(float) does, with two decimals.
+static std::string float_value(float value) { return value_accuracy_to_string(value, 2); }
 
 // Type-specific implementation
 #ifdef USE_SENSOR
-void PrometheusHandler::sensor_type_(AsyncResponseStream *stream) {
-  stream->print(F("#TYPE esphome_sensor_value gauge\n"));
-  stream->print(F("#TYPE esphome_sensor_failed gauge\n"));
+void PrometheusHandler::sensor_type_(std::string &out) {
+  out += "#TYPE esphome_sensor_value gauge\n"
+         "#TYPE esphome_sensor_failed gauge\n";
 }
-void PrometheusHandler::sensor_row_(AsyncResponseStream *stream, sensor::Sensor *obj, std::string &area,
-                                    std::string &node, std::string &friendly_name) {
-  if (obj->is_internal() && !this->include_internal_)
-    return;
+void PrometheusHandler::sensor_row_(std::string &out, sensor::Sensor *obj, const StringRef &labels) {
   if (!std::isnan(obj->state)) {
     // We have a valid value, output this value
-    stream->print(F("esphome_sensor_failed{id=\""));
-    stream->print(relabel_id_(obj).c_str());
-    add_area_label_(stream, area);
-    add_node_label_(stream, node);
-    add_friendly_name_label_(stream, friendly_name);
-    stream->print(F("\",name=\""));
-    stream->print(relabel_name_(obj).c_str());
-    stream->print(F("\"} 0\n"));
+    add_row(out, "esphome_sensor_failed", labels);
+    out += "} 0\n";
     // Data itself
-    stream->print(F("esphome_sensor_value{id=\""));
-    stream->print(relabel_id_(obj).c_str());
-    add_area_label_(stream, area);
-    add_node_label_(stream, node);
-    add_friendly_name_label_(stream, friendly_name);
-    stream->print(F("\",name=\""));
-    stream->print(relabel_name_(obj).c_str());
-    stream->print(F("\",unit=\""));
-    stream->print(obj->get_unit_of_measurement().c_str());
-    stream->print(F("\"} "));
-    stream->print(value_accuracy_to_string(obj->state, obj->get_accuracy_decimals()).c_str());
-    stream->print(F("\n"));
+    add_row(out, "esphome_sensor_value", labels);
+    out += ",unit=\"";
+    out += obj->get_unit_of_measurement();
+    out += "\"} ";
+    out += value_accuracy_to_string(obj->state, obj->get_accuracy_decimals());
+    out += '\n';
   } else {
     // Invalid state
-    stream->print(F("esphome_sensor_failed{id=\""));
-    stream->print(relabel_id_(obj).c_str());
-    add_area_label_(stream, area);
-    add_node_label_(stream, node);
-    add_friendly_name_label_(stream, friendly_name);
-    stream->print(F("\",name=\""));
-    stream->print(relabel_name_(obj).c_str());
-    stream->print(F("\"} 1\n"));
+    add_row(out, "esphome_sensor_failed", labels);
+    out += "} 1\n";
   }
 }
 #endif
 
 // Type-specific implementation
 #ifdef USE_BINARY_SENSOR
-void PrometheusHandler::binary_sensor_type_(AsyncResponseStream *stream) {
-  stream->print(F("#TYPE esphome_binary_sensor_value gauge\n"));
-  stream->print(F("#TYPE esphome_binary_sensor_failed gauge\n"));
+void PrometheusHandler::binary_sensor_type_(std::string &out) {
+  out += "#TYPE esphome_binary_sensor_value gauge\n"
+         "#TYPE esphome_binary_sensor_failed gauge\n";
 }
-void PrometheusHandler::binary_sensor_row_(AsyncResponseStream *stream, binary_sensor::BinarySensor *obj,
-                                           std::string &area, std::string &node, std::string &friendly_name) {
-  if (obj->is_internal() && !this->include_internal_)
-    return;
+void PrometheusHandler::binary_sensor_row_(std::string &out, binary_sensor::BinarySensor *obj,
+                                           const StringRef &labels) {
   if (obj->has_state()) {
     // We have a valid value, output this value
-    stream->print(F("esphome_binary_sensor_failed{id=\""));
-    stream->print(relabel_id_(obj).c_str());
-    add_area_label_(stream, area);
-    add_node_label_(stream, node);
-    add_friendly_name_label_(stream, friendly_name);
-    stream->print(F("\",name=\""));
-    stream->print(relabel_name_(obj).c_str());
-    stream->print(F("\"} 0\n"));
+    add_row(out, "esphome_binary_sensor_failed", labels);
+    out += "} 0\n";
     // Data itself
-    stream->print(F("esphome_binary_sensor_value{id=\""));
-    stream->print(relabel_id_(obj).c_str());
-    add_area_label_(stream, area);
-    add_node_label_(stream, node);
-    add_friendly_name_label_(stream, friendly_name);
-    stream->print(F("\",name=\""));
-    stream->print(relabel_name_(obj).c_str());
-    stream->print(F("\"} "));
-    stream->print(obj->state);
-    stream->print(F("\n"));
+    add_row(out, "esphome_binary_sensor_value", labels);
+    out += obj->state ? "} 1\n" : "} 0\n";
   } else {
     // Invalid state
-    stream->print(F("esphome_binary_sensor_failed{id=\""));
-    stream->print(relabel_id_(obj).c_str());
-    add_area_label_(stream, area);
-    add_node_label_(stream, node);
-    add_friendly_name_label_(stream, friendly_name);
-    stream->print(F("\",name=\""));
-    stream->print(relabel_name_(obj).c_str());
-    stream->print(F("\"} 1\n"));
+    add_row(out, "esphome_binary_sensor_failed", labels);
+    out += "} 1\n";
   }
 }
 #endif
 
 #ifdef USE_FAN
-void PrometheusHandler::fan_type_(AsyncResponseStream *stream) {
-  stream->print(F("#TYPE esphome_fan_value gauge\n"));
-  stream->print(F("#TYPE esphome_fan_failed gauge\n"));
-  stream->print(F("#TYPE esphome_fan_speed gauge\n"));
-  stream->print(F("#TYPE esphome_fan_oscillation gauge\n"));
+void PrometheusHandler::fan_type_(std::string &out) {
+  out += "#TYPE esphome_fan_value gauge\n"
+         "#TYPE esphome_fan_failed gauge\n"
+         "#TYPE esphome_fan_speed gauge\n"
+         "#TYPE esphome_fan_oscillation gauge\n";
 }
-void PrometheusHandler::fan_row_(AsyncResponseStream *stream, fan::Fan *obj, std::string &area, std::string &node,
-                                 std::string &friendly_name) {
-  if (obj->is_internal() && !this->include_internal_)
-    return;
-  stream->print(F("esphome_fan_failed{id=\""));
-  stream->print(relabel_id_(obj).c_str());
-  add_area_label_(stream, area);
-  add_node_label_(stream, node);
-  add_friendly_name_label_(stream, friendly_name);
-  stream->print(F("\",name=\""));
-  stream->print(relabel_name_(obj).c_str());
-  stream->print(F("\"} 0\n"));
+void PrometheusHandler::fan_row_(std::string &out, fan::Fan *obj, const StringRef &labels) {
+  add_row(out, "esphome_fan_failed", labels);
+  out += "} 0\n";
   // Data itself
-  stream->print(F("esphome_fan_value{id=\""));
-  stream->print(relabel_id_(obj).c_str());
-  add_area_label_(stream, area);
-  add_node_label_(stream, node);
-  add_friendly_name_label_(stream, friendly_name);
-  stream->print(F("\",name=\""));
-  stream->print(relabel_name_(obj).c_str());
-  stream->print(F("\"} "));
-  stream->print(obj->state);
-  stream->print(F("\n"));
+  add_row(out, "esphome_fan_value", labels);
+  out += obj->state ? "} 1\n" : "} 0\n";
   // Speed if available
   if (obj->get_traits().supports_speed()) {
-    stream->print(F("esphome_fan_speed{id=\""));
-    stream->print(relabel_id_(obj).c_str());
-    add_area_label_(stream, area);
-    add_node_label_(stream, node);
-    add_friendly_name_label_(stream, friendly_name);
-    stream->print(F("\",name=\""));
-    stream->print(relabel_name_(obj).c_str());
-    stream->print(F("\"} "));
-    stream->print(obj->speed);
-    stream->print(F("\n"));
+    add_row(out, "esphome_fan_speed", labels);
+    out += "} ";
+    out += to_string(obj->speed);
+    out += '\n';
   }
   // Oscillation if available
   if (obj->get_traits().supports_oscillation()) {
-    stream->print(F("esphome_fan_oscillation{id=\""));
-    stream->print(relabel_id_(obj).c_str());
-    add_area_label_(stream, area);
-    add_node_label_(stream, node);
-    add_friendly_name_label_(stream, friendly_name);
-    stream->print(F("\",name=\""));
-    stream->print(relabel_name_(obj).c_str());
-    stream->print(F("\"} "));
-    stream->print(obj->oscillating);
-    stream->print(F("\n"));
+    add_row(out, "esphome_fan_oscillation", labels);
+    out += obj->oscillating ? "} 1\n" : "} 0\n";
   }
 }
 #endif
 
 #ifdef USE_LIGHT
-void PrometheusHandler::light_type_(AsyncResponseStream *stream) {
-  stream->print(F("#TYPE esphome_light_state gauge\n"));
-  stream->print(F("#TYPE esphome_light_color gauge\n"));
-  stream->print(F("#TYPE esphome_light_effect_active gauge\n"));
+void PrometheusHandler::light_type_(std::string &out) {
+  out += "#TYPE esphome_light_state gauge\n"
+         "#TYPE esphome_light_color gauge\n"
+         "#TYPE esphome_light_effect_active gauge\n";
 }
-void PrometheusHandler::light_row_(AsyncResponseStream *stream, light::LightState *obj, std::string &area,
-                                   std::string &node, std::string &friendly_name) {
-  if (obj->is_internal() && !this->include_internal_)
-    return;
+void PrometheusHandler::light_row_(std::string &out, light::LightState *obj, const StringRef &labels) {
   // State
-  stream->print(F("esphome_light_state{id=\""));
-  stream->print(relabel_id_(obj).c_str());
-  add_area_label_(stream, area);
-  add_node_label_(stream, node);
-  add_friendly_name_label_(stream, friendly_name);
-  stream->print(F("\",name=\""));
-  stream->print(relabel_name_(obj).c_str());
-  stream->print(F("\"} "));
-  stream->print(obj->remote_values.is_on());
-  stream->print(F("\n"));
+  add_row(out, "esphome_light_state", labels);
+  out += obj->remote_values.is_on() ? "} 1\n" : "} 0\n";
   // Brightness and RGBW
   light::LightColorValues color = obj->current_values;
   float brightness, r, g, b, w;
   color.as_brightness(&brightness);
   color.as_rgbw(&r, &g, &b, &w);
-  stream->print(F("esphome_light_color{id=\""));
-  stream->print(relabel_id_(obj).c_str());
-  add_area_label_(stream, area);
-  add_node_label_(stream, node);
-  add_friendly_name_label_(stream, friendly_name);
-  stream->print(F("\",name=\""));
-  stream->print(relabel_name_(obj).c_str());
-  stream->print(F("\",channel=\"brightness\"} "));
-  stream->print(brightness);
-  stream->print(F("\n"));
-  stream->print(F("esphome_light_color{id=\""));
-  stream->print(relabel_id_(obj).c_str());
-  add_area_label_(stream, area);
-  add_node_label_(stream, node);
-  add_friendly_name_label_(stream, friendly_name);
-  stream->print(F("\",name=\""));
-  stream->print(relabel_name_(obj).c_str());
-  stream->print(F("\",channel=\"r\"} "));
-  stream->print(r);
-  stream->print(F("\n"));
-  stream->print(F("esphome_light_color{id=\""));
-  stream->print(relabel_id_(obj).c_str());
-  add_area_label_(stream, area);
-  add_node_label_(stream, node);
-  add_friendly_name_label_(stream, friendly_name);
-  stream->print(F("\",name=\""));
-  stream->print(relabel_name_(obj).c_str());
-  stream->print(F("\",channel=\"g\"} "));
-  stream->print(g);
-  stream->print(F("\n"));
-  stream->print(F("esphome_light_color{id=\""));
-  stream->print(relabel_id_(obj).c_str());
-  add_area_label_(stream, area);
-  add_node_label_(stream, node);
-  add_friendly_name_label_(stream, friendly_name);
-  stream->print(F("\",name=\""));
-  stream->print(relabel_name_(obj).c_str());
-  stream->print(F("\",channel=\"b\"} "));
-  stream->print(b);
-  stream->print(F("\n"));
-  stream->print(F("esphome_light_color{id=\""));
-  stream->print(relabel_id_(obj).c_str());
-  add_area_label_(stream, area);
-  add_node_label_(stream, node);
-  add_friendly_name_label_(stream, friendly_name);
-  stream->print(F("\",name=\""));
-  stream->print(relabel_name_(obj).c_str());
-  stream->print(F("\",channel=\"w\"} "));
-  stream->print(w);
-  stream->print(F("\n"));
+  const char *const channels[] = {"brightness", "r", "g", "b", "w"};
+  const float values[] = {brightness, r, g, b, w};
+  for (size_t i = 0; i < 5; i++) {
+    add_row(out, "esphome_light_color", labels);
+    out += ",channel=\"";
+    out += channels[i];
+    out += "\"} ";
+    out += float_value(values[i]);
+    out += '\n';
+  }
   // Effect
   std::string effect = obj->get_effect_name();
+  add_row(out, "esphome_light_effect_active", labels);
   if (effect == "None") {
-    stream->print(F("esphome_light_effect_active{id=\""));
-    stream->print(relabel_id_(obj).c_str());
-    add_area_label_(stream, area);
-    add_node_label_(stream, node);
-    add_friendly_name_label_(stream, friendly_name);
-    stream->print(F("\",name=\""));
-    stream->print(relabel_name_(obj).c_str());
-    stream->print(F("\",effect=\"None\"} 0\n"));
+    out += ",effect=\"None\"} 0\n";
   } else {
-    stream->print(F("esphome_light_effect_active{id=\""));
-    stream->print(relabel_id_(obj).c_str());
-    add_area_label_(stream, area);
-    add_node_label_(stream, node);
-    add_friendly_name_label_(stream, friendly_name);
-    stream->print(F("\",name=\""));
-    stream->print(relabel_name_(obj).c_str());
-    stream->print(F("\",effect=\""));
-    stream->print(effect.c_str());
-    stream->print(F("\"} 1\n"));
+    out += ",effect=\"";
+    out += effect;
+    out += "\"} 1\n";
   }
 }
 #endif
 
 #ifdef USE_COVER
-void PrometheusHandler::cover_type_(AsyncResponseStream *stream) {
-  stream->print(F("#TYPE esphome_cover_value gauge\n"));
-  stream->print(F("#TYPE esphome_cover_failed gauge\n"));
+void PrometheusHandler::cover_type_(std::string &out) {
+  out += "#TYPE esphome_cover_value gauge\n"
+         "#TYPE esphome_cover_failed gauge\n";
 }
-void PrometheusHandler::cover_row_(AsyncResponseStream *stream, cover::Cover *obj, std::string &area, std::string &node,
-                                   std::string &friendly_name) {
-  if (obj->is_internal() && !this->include_internal_)
-    return;
+void PrometheusHandler::cover_row_(std::string &out, cover::Cover *obj, const StringRef &labels) {
   if (!std::isnan(obj->position)) {
     // We have a valid value, output this value
-    stream->print(F("esphome_cover_failed{id=\""));
-    stream->print(relabel_id_(obj).c_str());
-    add_area_label_(stream, area);
-    add_node_label_(stream, node);
-    add_friendly_name_label_(stream, friendly_name);
-    stream->print(F("\",name=\""));
-    stream->print(relabel_name_(obj).c_str());
-    stream->print(F("\"} 0\n"));
+    add_row(out, "esphome_cover_failed", labels);
+    out += "} 0\n";
     // Data itself
-    stream->print(F("esphome_cover_value{id=\""));
-    stream->print(relabel_id_(obj).c_str());
-    add_area_label_(stream, area);
-    add_node_label_(stream, node);
-    add_friendly_name_label_(stream, friendly_name);
-    stream->print(F("\",name=\""));
-    stream->print(relabel_name_(obj).c_str());
-    stream->print(F("\"} "));
-    stream->print(obj->position);
-    stream->print(F("\n"));
+    add_row(out, "esphome_cover_value", labels);
+    out += "} ";
+    out += float_value(obj->position);
+    out += '\n';
     if (obj->get_traits().get_supports_tilt()) {
-      stream->print(F("esphome_cover_tilt{id=\""));
-      stream->print(relabel_id_(obj).c_str());
-      add_area_label_(stream, area);
-      add_node_label_(stream, node);
-      add_friendly_name_label_(stream, friendly_name);
-      stream->print(F("\",name=\""));
-      stream->print(relabel_name_(obj).c_str());
-      stream->print(F("\"} "));
-      stream->print(obj->tilt);
-      stream->print(F("\n"));
+      add_row(out, "esphome_cover_tilt", labels);
+      out += "} ";
+      out += float_value(obj->tilt);
+      out += '\n';
     }
   } else {
     // Invalid state
-    stream->print(F("esphome_cover_failed{id=\""));
-    stream->print(relabel_id_(obj).c_str());
-    add_area_label_(stream, area);
-    add_node_label_(stream, node);
-    add_friendly_name_label_(stream, friendly_name);
-    stream->print(F("\",name=\""));
-    stream->print(relabel_name_(obj).c_str());
-    stream->print(F("\"} 1\n"));
+    add_row(out, "esphome_cover_failed", labels);
+    out += "} 1\n";
   }
 }
 #endif
 
 #ifdef USE_SWITCH
-void PrometheusHandler::switch_type_(AsyncResponseStream *stream) {
-  stream->print(F("#TYPE esphome_switch_value gauge\n"));
-  stream->print(F("#TYPE esphome_switch_failed gauge\n"));
+void PrometheusHandler::switch_type_(std::string &out) {
+  out += "#TYPE esphome_switch_value gauge\n"
+         "#TYPE esphome_switch_failed gauge\n";
 }
-void PrometheusHandler::switch_row_(AsyncResponseStream *stream, switch_::Switch *obj, std::string &area,
-                                    std::string &node, std::string &friendly_name) {
-  if (obj->is_internal() && !this->include_internal_)
-    return;
-  stream->print(F("esphome_switch_failed{id=\""));
-  stream->print(relabel_id_(obj).c_str());
-  add_area_label_(stream, area);
-  add_node_label_(stream, node);
-  add_friendly_name_label_(stream, friendly_name);
-  stream->print(F("\",name=\""));
-  stream->print(relabel_name_(obj).c_str());
-  stream->print(F("\"} 0\n"));
+void PrometheusHandler::switch_row_(std::string &out, switch_::Switch *obj, const StringRef &labels) {
+  add_row(out, "esphome_switch_failed", labels);
+  out += "} 0\n";
   // Data itself
-  stream->print(F("esphome_switch_value{id=\""));
-  stream->print(relabel_id_(obj).c_str());
-  add_area_label_(stream, area);
-  add_node_label_(stream, node);
-  add_friendly_name_label_(stream, friendly_name);
-  stream->print(F("\",name=\""));
-  stream->print(relabel_name_(obj).c_str());
-  stream->print(F("\"} "));
-  stream->print(obj->state);
-  stream->print(F("\n"));
+  add_row(out, "esphome_switch_value", labels);
+  out += obj->state ? "} 1\n" : "} 0\n";
 }
 #endif
 
 #ifdef USE_LOCK
-void PrometheusHandler::lock_type_(AsyncResponseStream *stream) {
-  stream->print(F("#TYPE esphome_lock_value gauge\n"));
-  stream->print(F("#TYPE esphome_lock_failed gauge\n"));
+void PrometheusHandler::lock_type_(std::string &out) {
+  out += "#TYPE esphome_lock_value gauge\n"
+         "#TYPE esphome_lock_failed gauge\n";
 }
-void PrometheusHandler::lock_row_(AsyncResponseStream *stream, lock::Lock *obj, std::string &area, std::string &node,
-                                  std::string &friendly_name) {
-  if (obj->is_internal() && !this->include_internal_)
-    return;
-  stream->print(F("esphome_lock_failed{id=\""));
-  stream->print(relabel_id_(obj).c_str());
-  add_area_label_(stream, area);
-  add_node_label_(stream, node);
-  add_friendly_name_label_(stream, friendly_name);
-  stream->print(F("\",name=\""));
-  stream->print(relabel_name_(obj).c_str());
-  stream->print(F("\"} 0\n"));
+void PrometheusHandler::lock_row_(std::string &out, lock::Lock *obj, const StringRef &labels) {
+  add_row(out, "esphome_lock_failed", labels);
+  out += "} 0\n";
   // Data itself
-  stream->print(F("esphome_lock_value{id=\""));
-  stream->print(relabel_id_(obj).c_str());
-  add_area_label_(stream, area);
-  add_node_label_(stream, node);
-  add_friendly_name_label_(stream, friendly_name);
-  stream->print(F("\",name=\""));
-  stream->print(relabel_name_(obj).c_str());
-  stream->print(F("\"} "));
-  stream->print(obj->state);
-  stream->print(F("\n"));
+  add_row(out, "esphome_lock_value", labels);
+  out += "} ";
+  out += to_string(static_cast<int>(obj->state));
+  out += '\n';
 }
 #endif
 
 // Type-specific implementation
 #ifdef USE_TEXT_SENSOR
-void PrometheusHandler::text_sensor_type_(AsyncResponseStream *stream) {
-  stream->print(F("#TYPE esphome_text_sensor_value gauge\n"));
-  stream->print(F("#TYPE esphome_text_sensor_failed gauge\n"));
+void PrometheusHandler::text_sensor_type_(std::string &out) {
+  out += "#TYPE esphome_text_sensor_value gauge\n"
+         "#TYPE esphome_text_sensor_failed gauge\n";
 }
-void PrometheusHandler::text_sensor_row_(AsyncResponseStream *stream, text_sensor::TextSensor *obj, std::string &area,
-                                         std::string &node, std::string &friendly_name) {
-  if (obj->is_internal() && !this->include_internal_)
-    return;
+void PrometheusHandler::text_sensor_row_(std::string &out, text_sensor::TextSensor *obj, const StringRef &labels) {
   if (obj->has_state()) {
     // We have a valid value, output this value
-    stream->print(F("esphome_text_sensor_failed{id=\""));
-    stream->print(relabel_id_(obj).c_str());
-    add_area_label_(stream, area);
-    add_node_label_(stream, node);
-    add_friendly_name_label_(stream, friendly_name);
-    stream->print(F("\",name=\""));
-    stream->print(relabel_name_(obj).c_str());
-    stream->print(F("\"} 0\n"));
+    add_row(out, "esphome_text_sensor_failed", labels);
+    out += "} 0\n";
     // Data itself
-    stream->print(F("esphome_text_sensor_value{id=\""));
-    stream->print(relabel_id_(obj).c_str());
-    add_area_label_(stream, area);
-    add_node_label_(stream, node);
-    add_friendly_name_label_(stream, friendly_name);
-    stream->print(F("\",name=\""));
-    stream->print(relabel_name_(obj).c_str());
-    stream->print(F("\",value=\""));
-    stream->print(obj->state.c_str());
-    stream->print(F("\"} "));
-    stream->print(F("1.0"));
-    stream->print(F("\n"));
+    add_row(out, "esphome_text_sensor_value", labels);
+    out += ",value=\"";
+    out += obj->state;
+    out += "\"} 1.0\n";
   } else {
     // Invalid state
-    stream->print(F("esphome_text_sensor_failed{id=\""));
-    stream->print(relabel_id_(obj).c_str());
-    add_area_label_(stream, area);
-    add_node_label_(stream, node);
-    add_friendly_name_label_(stream, friendly_name);
-    stream->print(F("\",name=\""));
-    stream->print(relabel_name_(obj).c_str());
-    stream->print(F("\"} 1\n"));
+    add_row(out, "esphome_text_sensor_failed", labels);
+    out += "} 1\n";
   }
 }
 #endif
@@ -2,12 +2,15 @@
 #include "esphome/core/defines.h"
 #ifdef USE_NETWORK
 #include <map>
+#include <string>
 #include <utility>
+#include <vector>
 
 #include "esphome/components/web_server_base/web_server_base.h"
 #include "esphome/core/component.h"
 #include "esphome/core/controller.h"
 #include "esphome/core/entity_base.h"
+#include "esphome/core/string_ref.h"
 
 namespace esphome {
 namespace prometheus {
@@ -48,90 +51,118 @@ class PrometheusHandler : public AsyncWebHandler, public Component {
 
   void handleRequest(AsyncWebServerRequest *req) override;
 
-  void setup() override {
-    this->base_->init();
-    this->base_->add_handler(this);
-  }
+  void setup() override;
   float get_setup_priority() const override {
     // After WiFi
     return setup_priority::WIFI - 1.0f;
   }
 
  protected:
+  /// The entity types in the order they are exported, each one is preceded by its type declarations.
+  enum EntityType : uint8_t {
+    TYPE_SENSOR,
+    TYPE_BINARY_SENSOR,
+    TYPE_FAN,
+    TYPE_LIGHT,
+    TYPE_COVER,
+    TYPE_SWITCH,
+    TYPE_LOCK,
+    TYPE_TEXT_SENSOR,
+    TYPE_COUNT,
+  };
+
+  /// An exported entity, with its constant labels (`id="...",...,name="..."`) in the label arena.
+  struct ExportedEntity {
+    EntityBase *obj;
+    uint32_t labels_offset;
+    uint16_t labels_length;
+    EntityType type;
+  };
+
+  /// Progress of a scrape that is being sent.
+  struct Scrape {
+    size_t next_entity{0};
+    uint8_t next_type{0};
+    bool done{false};
+    /// Text that did not fit into the previous chunk
+    std::string pending;
+    size_t pending_pos{0};
+    uint32_t duration_us{0};
+  };
+
   std::string relabel_id_(EntityBase *obj);
   std::string relabel_name_(EntityBase *obj);
-  void add_area_label_(AsyncResponseStream *stream, std::string &area);
-  void add_node_label_(AsyncResponseStream *stream, std::string &node);
-  void add_friendly_name_label_(AsyncResponseStream *stream, std::string &friendly_name);
+  /// Fill the next chunk of the response, returns 0 once the scrape is complete.
+  size_t fill_chunk_(Scrape &scrape, uint8_t *buffer, size_t max_len);
+  void write_types_(std::string &out, EntityType type);
+  void write_entity_(std::string &out, const ExportedEntity &entity);
 
 #ifdef USE_SENSOR
   /// Return the type for prometheus
-  void sensor_type_(AsyncResponseStream *stream);
+  void sensor_type_(std::string &out);
   /// Return the sensor state as prometheus data point
-  void sensor_row_(AsyncResponseStream *stream, sensor::Sensor *obj, std::string &area, std::string &node,
-                   std::string &friendly_name);
+  void sensor_row_(std::string &out, sensor::Sensor *obj, const StringRef &labels);
 #endif
 
 #ifdef USE_BINARY_SENSOR
   /// Return the type for prometheus
-  void binary_sensor_type_(AsyncResponseStream *stream);
+  void binary_sensor_type_(std::string &out);
   /// Return the sensor state as prometheus data point
-  void binary_sensor_row_(AsyncResponseStream *stream, binary_sensor::BinarySensor *obj, std::string &area,
-                          std::string &node, std::string &friendly_name);
+  void binary_sensor_row_(std::string &out, binary_sensor::BinarySensor *obj, const StringRef &labels);
 #endif
 
 #ifdef USE_FAN
   /// Return the type for prometheus
-  void fan_type_(AsyncResponseStream *stream);
+  void fan_type_(std::string &out);
   /// Return the sensor state as prometheus data point
-  void fan_row_(AsyncResponseStream *stream, fan::Fan *obj, std::string &area, std::string &node,
-                std::string &friendly_name);
+  void fan_row_(std::string &out, fan::Fan *obj, const StringRef &labels);
 #endif
 
 #ifdef USE_LIGHT
   /// Return the type for prometheus
-  void light_type_(AsyncResponseStream *stream);
+  void light_type_(std::string &out);
   /// Return the Light Values state as prometheus data point
-  void light_row_(AsyncResponseStream *stream, light::LightState *obj, std::string &area, std::string &node,
-                  std::string &friendly_name);
+  void light_row_(std::string &out, light::LightState *obj, const StringRef &labels);
 #endif
 
 #ifdef USE_COVER
   /// Return the type for prometheus
-  void cover_type_(AsyncResponseStream *stream);
+  void cover_type_(std::string &out);
   /// Return the switch Values state as prometheus data point
-  void cover_row_(AsyncResponseStream *stream, cover::Cover *obj, std::string &area, std::string &node,
-                  std::string &friendly_name);
+  void cover_row_(std::string &out, cover::Cover *obj, const StringRef &labels);
 #endif
 
 #ifdef USE_SWITCH
   /// Return the type for prometheus
-  void switch_type_(AsyncResponseStream *stream);
+  void switch_type_(std::string &out);
   /// Return the switch Values state as prometheus data point
-  void switch_row_(AsyncResponseStream *stream, switch_::Switch *obj, std::string &area, std::string &node,
-                   std::string &friendly_name);
+  void switch_row_(std::string &out, switch_::Switch *obj, const StringRef &labels);
 #endif
 
 #ifdef USE_LOCK
   /// Return the type for prometheus
-  void lock_type_(AsyncResponseStream *stream);
+  void lock_type_(std::string &out);
   /// Return the lock Values state as prometheus data point
-  void lock_row_(AsyncResponseStream *stream, lock::Lock *obj, std::string &area, std::string &node,
-                 std::string &friendly_name);
+  void lock_row_(std::string &out, lock::Lock *obj, const StringRef &labels);
 #endif
 
 #ifdef USE_TEXT_SENSOR
   /// Return the type for prometheus
-  void text_sensor_type_(AsyncResponseStream *stream);
+  void text_sensor_type_(std::string &out);
   /// Return the lock Values state as prometheus data point
-  void text_sensor_row_(AsyncResponseStream *stream, text_sensor::TextSensor *obj, std::string &area, std::string &node,
-                        std::string &friendly_name);
+  void text_sensor_row_(std::string &out, text_sensor::TextSensor *obj, const StringRef &labels);
 #endif
 
   web_server_base::WebServerBase *base_;
   bool include_internal_{false};
   std::map<EntityBase *, std::string> relabel_map_id_;
   std::map<EntityBase *, std::string> relabel_map_name_;
+  /// Exported entities, sorted by type
+  std::vector<ExportedEntity> entities_;
+  /// The labels of all exported entities, built once in setup()
+  std::string label_arena_;
+  /// Time spent generating the last complete scrape
+  uint32_t last_scrape_duration_us_{0};
 };
 
 }  // namespace prometheus
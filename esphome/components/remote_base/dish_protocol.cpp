@@ -6,8 +6,8 @@ namespace remote_base {
 
 static const char *const TAG = "remote.dish";
 
-static const uint32_t HEADER_HIGH_US = 400;
-static const uint32_t HEADER_LOW_US = 6100;
+static const uint32_t HEADER_HIGH_US = DishProtocol::HEADER_MARK_US;
+static const uint32_t HEADER_LOW_US = DishProtocol::HEADER_SPACE_US;
 static const uint32_t BIT_HIGH_US = 400;
 static const uint32_t BIT_ONE_LOW_US = 1700;
 static const uint32_t BIT_ZERO_LOW_US = 2800;
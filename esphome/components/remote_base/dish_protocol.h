@@ -14,6 +14,9 @@ struct DishData {
 
 class DishProtocol : public RemoteProtocol<DishData> {
  public:
+  static constexpr uint32_t HEADER_MARK_US = 400;
+  static constexpr uint32_t HEADER_SPACE_US = 6100;
+  static uint64_t dispatch_key(const DishData &data) { return (uint32_t(data.address) << 16) | data.command; }
   void encode(RemoteTransmitData *dst, const DishData &data) override;
   optional<DishData> decode(RemoteReceiveData src) override;
   void dump(const DishData &data) override;
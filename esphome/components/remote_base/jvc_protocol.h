@@ -15,6 +15,9 @@ struct JVCData {
 
 class JVCProtocol : public RemoteProtocol<JVCData> {
  public:
+  static constexpr uint32_t HEADER_MARK_US = 8400;
+  static constexpr uint32_t HEADER_SPACE_US = 4200;
+  static uint64_t dispatch_key(const JVCData &data) { return data.data; }
   void encode(RemoteTransmitData *dst, const JVCData &data) override;
   optional<JVCData> decode(RemoteReceiveData src) override;
   void dump(const JVCData &data) override;
@@ -6,8 +6,8 @@ namespace remote_base {
 
 static const char *const TAG = "remote.lg";
 
-static const uint32_t HEADER_HIGH_US = 8000;
-static const uint32_t HEADER_LOW_US = 4000;
+static const uint32_t HEADER_HIGH_US = LGProtocol::HEADER_MARK_US;
+static const uint32_t HEADER_LOW_US = LGProtocol::HEADER_SPACE_US;
 static const uint32_t BIT_HIGH_US = 600;
 static const uint32_t BIT_ONE_LOW_US = 1600;
 static const uint32_t BIT_ZERO_LOW_US = 550;
@@ -17,6 +17,9 @@ struct LGData {
 
 class LGProtocol : public RemoteProtocol<LGData> {
  public:
+  static constexpr uint32_t HEADER_MARK_US = 8000;
+  static constexpr uint32_t HEADER_SPACE_US = 4000;
+  static uint64_t dispatch_key(const LGData &data) { return (uint64_t(data.nbits) << 32) | data.data; }
   void encode(RemoteTransmitData *dst, const LGData &data) override;
   optional<LGData> decode(RemoteReceiveData src) override;
   void dump(const LGData &data) override;
@@ -15,6 +15,9 @@ struct NECData {
 
 class NECProtocol : public RemoteProtocol<NECData> {
  public:
+  static constexpr uint32_t HEADER_MARK_US = 9000;
+  static constexpr uint32_t HEADER_SPACE_US = 4500;
+  static uint64_t dispatch_key(const NECData &data) { return (uint32_t(data.address) << 16) | data.command; }
   void encode(RemoteTransmitData *dst, const NECData &data) override;
   optional<NECData> decode(RemoteReceiveData src) override;
   void dump(const NECData &data) override;
@@ -6,8 +6,8 @@ namespace remote_base {
 
 static const char *const TAG = "remote.panasonic";
 
-static const uint32_t HEADER_HIGH_US = 3502;
-static const uint32_t HEADER_LOW_US = 1750;
+static const uint32_t HEADER_HIGH_US = PanasonicProtocol::HEADER_MARK_US;
+static const uint32_t HEADER_LOW_US = PanasonicProtocol::HEADER_SPACE_US;
 static const uint32_t BIT_HIGH_US = 502;
 static const uint32_t BIT_ZERO_LOW_US = 400;
 static const uint32_t BIT_ONE_LOW_US = 1244;
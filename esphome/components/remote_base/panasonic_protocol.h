@@ -17,6 +17,9 @@ struct PanasonicData {
 
 class PanasonicProtocol : public RemoteProtocol<PanasonicData> {
  public:
+  static constexpr uint32_t HEADER_MARK_US = 3502;
+  static constexpr uint32_t HEADER_SPACE_US = 1750;
+  static uint64_t dispatch_key(const PanasonicData &data) { return (uint64_t(data.address) << 32) | data.command; }
   void encode(RemoteTransmitData *dst, const PanasonicData &data) override;
   optional<PanasonicData> decode(RemoteReceiveData src) override;
   void dump(const PanasonicData &data) override;
@@ -6,8 +6,8 @@ namespace remote_base {
 
 static const char *const TAG = "remote.pioneer";
 
-static const uint32_t HEADER_HIGH_US = 9000;
-static const uint32_t HEADER_LOW_US = 4500;
+static const uint32_t HEADER_HIGH_US = PioneerProtocol::HEADER_MARK_US;
+static const uint32_t HEADER_LOW_US = PioneerProtocol::HEADER_SPACE_US;
 static const uint32_t BIT_HIGH_US = 560;
 static const uint32_t BIT_ONE_LOW_US = 1690;
 static const uint32_t BIT_ZERO_LOW_US = 560;
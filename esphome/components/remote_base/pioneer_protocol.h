@@ -14,6 +14,9 @@ struct PioneerData {
 
 class PioneerProtocol : public RemoteProtocol<PioneerData> {
  public:
+  static constexpr uint32_t HEADER_MARK_US = 9000;
+  static constexpr uint32_t HEADER_SPACE_US = 4500;
+  static uint64_t dispatch_key(const PioneerData &data) { return (uint32_t(data.rc_code_1) << 16) | data.rc_code_2; }
   void encode(RemoteTransmitData *dst, const PioneerData &data) override;
   optional<PioneerData> decode(RemoteReceiveData src) override;
   void dump(const PioneerData &data) override;
@@ -15,6 +15,7 @@ struct RC5Data {
 
 class RC5Protocol : public RemoteProtocol<RC5Data> {
  public:
+  static uint64_t dispatch_key(const RC5Data &data) { return (uint32_t(data.address) << 16) | data.command; }
   void encode(RemoteTransmitData *dst, const RC5Data &data) override;
   optional<RC5Data> decode(RemoteReceiveData src) override;
   void dump(const RC5Data &data) override;
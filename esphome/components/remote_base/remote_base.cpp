@@ -107,19 +107,21 @@ void RemoteReceiverBase::register_dumper(RemoteReceiverDumperBase *dumper) {
 }
 
 void RemoteReceiverBase::call_listeners_() {
+  RemoteReceiveData src(this->temp_, this->tolerance_, this->tolerance_mode_, &this->decode_cache_);
   for (auto *listener : this->listeners_)
-    listener->on_receive(RemoteReceiveData(this->temp_, this->tolerance_, this->tolerance_mode_));
+    listener->on_receive(src);
 }
 
 void RemoteReceiverBase::call_dumpers_() {
+  RemoteReceiveData src(this->temp_, this->tolerance_, this->tolerance_mode_, &this->decode_cache_);
   bool success = false;
   for (auto *dumper : this->dumpers_) {
-    if (dumper->dump(RemoteReceiveData(this->temp_, this->tolerance_, this->tolerance_mode_)))
+    if (dumper->dump(src))
       success = true;
   }
   if (!success) {
     for (auto *dumper : this->secondary_dumpers_)
-      dumper->dump(RemoteReceiveData(this->temp_, this->tolerance_, this->tolerance_mode_));
+      dumper->dump(src);
   }
 }
 
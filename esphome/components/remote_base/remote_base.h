@@ -1,3 +1,5 @@
+#include <memory>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -45,10 +47,13 @@ class RemoteTransmitData {
   uint32_t carrier_frequency_{0};
 };
 
+class RemoteDecodeCache;
+
 class RemoteReceiveData {
  public:
-  explicit RemoteReceiveData(const RawTimings &data, uint32_t tolerance, ToleranceMode tolerance_mode)
-      : data_(data), index_(0), tolerance_(tolerance), tolerance_mode_(tolerance_mode) {}
+  explicit RemoteReceiveData(const RawTimings &data, uint32_t tolerance, ToleranceMode tolerance_mode,
+                             RemoteDecodeCache *cache = nullptr)
+      : data_(data), index_(0), tolerance_(tolerance), tolerance_mode_(tolerance_mode), cache_(cache) {}
 
   const RawTimings &get_raw_data() const { return this->data_; }
   uint32_t get_index() const { return index_; }
@@ -76,6 +81,8 @@ class RemoteReceiveData {
   }
   uint32_t get_tolerance() { return tolerance_; }
   ToleranceMode get_tolerance_mode() { return this->tolerance_mode_; }
+  /// The decode results of the frame that is being dispatched, if any.
+  RemoteDecodeCache *get_cache() const { return this->cache_; }
 
  protected:
   int32_t lower_bound_(uint32_t length) const {
@@ -99,8 +106,81 @@ class RemoteReceiveData {
   uint32_t index_;
   uint32_t tolerance_;
   ToleranceMode tolerance_mode_;
+  RemoteDecodeCache *cache_;
 };
 
+/// A unique address for every protocol type.
+template<typename Protocol> const void *protocol_tag() {
+  static const char TAG = 0;
+  return &TAG;
+}
+
+/// Decode a frame with Protocol. Frames that do not start with the header of the protocol are rejected without
+/// calling the decoder.
+template<typename Protocol> optional<typename Protocol::ProtocolData> decode_frame(const RemoteReceiveData &src) {
+  if (Protocol::HEADER_MARK_US != 0 && !src.peek_item(Protocol::HEADER_MARK_US, Protocol::HEADER_SPACE_US))
+    return {};
+  return Protocol().decode(src);
+}
+
+/** Results of the protocol decoders for the frame that is dispatched to the listeners and dumpers.
+ *
+ * Every protocol decodes a frame at most once, no matter how many binary sensors, triggers and dumpers use it.
+ * The results are kept between frames, so only the first frame that a protocol decodes allocates anything.
+ */
+class RemoteDecodeCache {
+ public:
+  /// Start a new frame, all results of the previous one become invalid.
+  void new_frame() { this->frame_++; }
+
+  /// Get the result of Protocol::decode() for the current frame, decoding it if this is the first request.
+  template<typename Protocol>
+  const optional<typename Protocol::ProtocolData> &decode(const RemoteReceiveData &src) {
+    auto *result = this->get_result_<Protocol>();
+    if (result->frame != this->frame_) {
+      result->value = decode_frame<Protocol>(src);
+      result->frame = this->frame_;
+    }
+    return result->value;
+  }
+
+ protected:
+  struct ResultBase {
+    virtual ~ResultBase() = default;
+    uint32_t frame{0};
+  };
+  template<typename T> struct Result : ResultBase {
+    optional<T> value;
+  };
+  struct Entry {
+    const void *tag;
+    std::unique_ptr<ResultBase> result;
+  };
+
+  template<typename Protocol> Result<typename Protocol::ProtocolData> *get_result_() {
+    const void *tag = protocol_tag<Protocol>();
+    for (auto &entry : this->entries_) {
+      if (entry.tag == tag)
+        return static_cast<Result<typename Protocol::ProtocolData> *>(entry.result.get());
+    }
+    auto *result = new Result<typename Protocol::ProtocolData>();  // NOLINT(cppcoreguidelines-owning-memory)
+    this->entries_.push_back({tag, std::unique_ptr<ResultBase>(result)});
+    return result;
+  }
+
+  // starts at 1, so the initial frame of a result never matches
+  uint32_t frame_{1};
+  std::vector<Entry> entries_;
+};
+
+/// Decode a frame with Protocol, sharing the result with the other listeners and dumpers of the receiver.
+template<typename Protocol> optional<typename Protocol::ProtocolData> decode_once(const RemoteReceiveData &src) {
+  auto *cache = src.get_cache();
+  if (cache == nullptr)
+    return decode_frame<Protocol>(src);
+  return cache->decode<Protocol>(src);
+}
+
 class RemoteComponentBase {
  public:
   explicit RemoteComponentBase(InternalGPIOPin *pin) : pin_(pin){};
@@ -191,11 +271,19 @@ class RemoteTransmitterBase : public RemoteComponentBase {
   RemoteTransmitData temp_;
 };
 
+class RemoteReceiverBase;
+
 class RemoteReceiverListener {
  public:
+  virtual ~RemoteReceiverListener() = default;
   virtual bool on_receive(RemoteReceiveData data) = 0;
+  /// Called on registration. Returns true if the listener joined a listener that the receiver shares between
+  /// several of them, and is not called directly.
+  virtual bool join_shared_listener(RemoteReceiverBase *receiver) { return false; }
 };
 
+template<typename T> class RemoteReceiverBinarySensorDispatcher;
+
 class RemoteReceiverDumperBase {
  public:
   virtual bool dump(RemoteReceiveData src) = 0;
@@ -205,8 +293,13 @@ class RemoteReceiverDumperBase {
 class RemoteReceiverBase : public RemoteComponentBase {
  public:
   RemoteReceiverBase(InternalGPIOPin *pin) : RemoteComponentBase(pin) {}
-  void register_listener(RemoteReceiverListener *listener) { this->listeners_.push_back(listener); }
+  void register_listener(RemoteReceiverListener *listener) {
+    if (!listener->join_shared_listener(this))
+      this->listeners_.push_back(listener);
+  }
   void register_dumper(RemoteReceiverDumperBase *dumper);
+  /// The listener that matches all binary sensors of Protocol, created and registered on first use.
+  template<typename Protocol> RemoteReceiverBinarySensorDispatcher<Protocol> *get_binary_sensor_dispatcher();
   void set_tolerance(uint32_t tolerance, ToleranceMode tolerance_mode) {
     this->tolerance_ = tolerance;
     this->tolerance_mode_ = tolerance_mode;
@@ -216,14 +309,18 @@ class RemoteReceiverBase : public RemoteComponentBase {
   void call_listeners_();
   void call_dumpers_();
   void call_listeners_dumpers_() {
+    this->decode_cache_.new_frame();
     this->call_listeners_();
     this->call_dumpers_();
   }
 
   std::vector<RemoteReceiverListener *> listeners_;
+  /// Owns the binary sensor dispatchers in listeners_, by protocol tag.
+  std::vector<std::pair<const void *, std::unique_ptr<RemoteReceiverListener>>> dispatchers_;
   std::vector<RemoteReceiverDumperBase *> dumpers_;
   std::vector<RemoteReceiverDumperBase *> secondary_dumpers_;
   RawTimings temp_;
+  RemoteDecodeCache decode_cache_;
   uint32_t tolerance_{25};
   ToleranceMode tolerance_mode_{TOLERANCE_MODE_PERCENTAGE};
 };
@@ -243,6 +340,13 @@ class RemoteReceiverBinarySensorBase : public binary_sensor::BinarySensorInitial
 template<typename T> class RemoteProtocol {
  public:
   using ProtocolData = T;
+  /// The item that every frame starts with. Protocols that have one declare it, so that frames of other protocols
+  /// are rejected before decode() is called.
+  static constexpr uint32_t HEADER_MARK_US = 0;
+  static constexpr uint32_t HEADER_SPACE_US = 0;
+  /// Binary sensors are looked up in a hash table by this key. Values that compare equal must have the same key,
+  /// protocols without a simple operator== keep the default and compare every binary sensor.
+  static uint64_t dispatch_key(const ProtocolData &data) { return 0; }
   virtual void encode(RemoteTransmitData *dst, const ProtocolData &data) = 0;
   virtual optional<ProtocolData> decode(RemoteReceiveData src) = 0;
   virtual void dump(const ProtocolData &data) = 0;
@@ -252,26 +356,75 @@ template<typename T> class RemoteReceiverBinarySensor : public RemoteReceiverBin
  public:
   RemoteReceiverBinarySensor() : RemoteReceiverBinarySensorBase() {}
 
+  bool join_shared_listener(RemoteReceiverBase *receiver) override {
+    receiver->get_binary_sensor_dispatcher<T>()->add(this);
+    return true;
+  }
+
  protected:
   bool matches(RemoteReceiveData src) override {
-    auto proto = T();
-    auto res = proto.decode(src);
+    auto res = decode_once<T>(src);
     return res.has_value() && *res == this->data_;
   }
 
  public:
   void set_data(typename T::ProtocolData data) { data_ = data; }
+  const typename T::ProtocolData &get_data() const { return this->data_; }
 
  protected:
   typename T::ProtocolData data_;
 };
 
+/** Matches the frames of a protocol against all its binary sensors on a receiver.
+ *
+ * The frame is decoded once, and only the binary sensors with the dispatch key of the decoded value are compared.
+ * The data of the binary sensors is set after registration, so the table is built on the first frame.
+ */
+template<typename T> class RemoteReceiverBinarySensorDispatcher : public RemoteReceiverListener {
+ public:
+  void add(RemoteReceiverBinarySensor<T> *sensor) {
+    this->sensors_.push_back(sensor);
+    this->table_.clear();
+  }
+
+  bool on_receive(RemoteReceiveData src) override {
+    auto res = decode_once<T>(src);
+    if (!res.has_value())
+      return false;
+    if (this->table_.empty()) {
+      for (auto *sensor : this->sensors_)
+        this->table_.emplace(T::dispatch_key(sensor->get_data()), sensor);
+    }
+    bool matched = false;
+    auto range = this->table_.equal_range(T::dispatch_key(*res));
+    for (auto it = range.first; it != range.second; ++it)
+      matched |= it->second->on_receive(src);
+    return matched;
+  }
+
+ protected:
+  std::vector<RemoteReceiverBinarySensor<T> *> sensors_;
+  std::unordered_multimap<uint64_t, RemoteReceiverBinarySensor<T> *> table_;
+};
+
+template<typename Protocol>
+RemoteReceiverBinarySensorDispatcher<Protocol> *RemoteReceiverBase::get_binary_sensor_dispatcher() {
+  const void *tag = protocol_tag<Protocol>();
+  for (auto &dispatcher : this->dispatchers_) {
+    if (dispatcher.first == tag)
+      return static_cast<RemoteReceiverBinarySensorDispatcher<Protocol> *>(dispatcher.second.get());
+  }
+  auto *dispatcher = new RemoteReceiverBinarySensorDispatcher<Protocol>();  // NOLINT(cppcoreguidelines-owning-memory)
+  this->dispatchers_.emplace_back(tag, std::unique_ptr<RemoteReceiverListener>(dispatcher));
+  this->listeners_.push_back(dispatcher);
+  return dispatcher;
+}
+
 template<typename T>
 class RemoteReceiverTrigger : public Trigger<typename T::ProtocolData>, public RemoteReceiverListener {
  protected:
   bool on_receive(RemoteReceiveData src) override {
-    auto proto = T();
-    auto res = proto.decode(src);
+    auto res = decode_once<T>(src);
     if (res.has_value()) {
       this->trigger(*res);
       return true;
@@ -312,11 +465,10 @@ template<typename... Ts> class RemoteTransmitterActionBase : public RemoteTransm
 template<typename T> class RemoteReceiverDumper : public RemoteReceiverDumperBase {
  public:
   bool dump(RemoteReceiveData src) override {
-    auto proto = T();
-    auto decoded = proto.decode(src);
+    auto decoded = decode_once<T>(src);
     if (!decoded.has_value())
       return false;
-    proto.dump(*decoded);
+    T().dump(*decoded);
     return true;
   }
 };
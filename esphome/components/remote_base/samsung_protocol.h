@@ -15,6 +15,9 @@ struct SamsungData {
 
 class SamsungProtocol : public RemoteProtocol<SamsungData> {
  public:
+  static constexpr uint32_t HEADER_MARK_US = 4500;
+  static constexpr uint32_t HEADER_SPACE_US = 4500;
+  static uint64_t dispatch_key(const SamsungData &data) { return data.data ^ (uint64_t(data.nbits) << 56); }
   void encode(RemoteTransmitData *dst, const SamsungData &data) override;
   optional<SamsungData> decode(RemoteReceiveData src) override;
   void dump(const SamsungData &data) override;
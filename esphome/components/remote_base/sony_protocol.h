@@ -17,6 +17,9 @@ struct SonyData {
 
 class SonyProtocol : public RemoteProtocol<SonyData> {
  public:
+  static constexpr uint32_t HEADER_MARK_US = 2400;
+  static constexpr uint32_t HEADER_SPACE_US = 600;
+  static uint64_t dispatch_key(const SonyData &data) { return (uint64_t(data.nbits) << 32) | data.data; }
   void encode(RemoteTransmitData *dst, const SonyData &data) override;
   optional<SonyData> decode(RemoteReceiveData src) override;
   void dump(const SonyData &data) override;
@@ -88,6 +88,12 @@ template<typename... Ts> class RestartScript : public Script<Ts...> {
  */
 template<typename... Ts> class QueueingScript : public Script<Ts...>, public Component {
  public:
+  void setup() override {
+    // the loop only runs queued instances
+    if (this->num_runs_ == 0)
+      this->disable_loop();
+  }
+
   void execute(Ts... x) override {
     if (this->is_action_running() || this->num_runs_ > 0) {
       // num_runs_ is the number of *queued* instances, so total number of instances is
@@ -100,6 +106,7 @@ template<typename... Ts> class QueueingScript : public Script<Ts...>, public Com
       this->esp_logd_(__LINE__, "Script '%s' queueing new instance (mode: queued)", this->name_.c_str());
       this->num_runs_++;
       this->var_queue_.push(std::make_tuple(x...));
+      this->enable_loop();
       return;
     }
 
@@ -114,7 +121,11 @@ template<typename... Ts> class QueueingScript : public Script<Ts...>, public Com
   }
 
   void loop() override {
-    if (this->num_runs_ != 0 && !this->is_action_running()) {
+    if (this->num_runs_ == 0) {
+      this->disable_loop();
+      return;
+    }
+    if (!this->is_action_running()) {
       this->num_runs_--;
       auto &vars = this->var_queue_.front();
       this->var_queue_.pop();
@@ -218,6 +229,11 @@ template<class C, typename... Ts> class ScriptWaitAction : public Action<Ts...>,
  public:
   ScriptWaitAction(C *script) : script_(script) {}
 
+  void setup() override {
+    if (this->num_running_ == 0)
+      this->disable_loop();
+  }
+
   void play_complex(Ts... x) override {
     this->num_running_++;
     // Check if we can continue immediately.
@@ -226,12 +242,15 @@ template<class C, typename... Ts> class ScriptWaitAction : public Action<Ts...>,
       return;
     }
     this->var_ = std::make_tuple(x...);
+    this->enable_loop();
     this->loop();
   }
 
   void loop() override {
-    if (this->num_running_ == 0)
+    if (this->num_running_ == 0) {
+      this->disable_loop();
       return;
+    }
 
     if (this->script_->is_running())
       return;
@@ -148,6 +148,14 @@ class SensirionI2CDevice : public i2c::I2CDevice {
    */
   uint8_t sht_crc_(uint8_t data1, uint8_t data2) { return sht_crc_(encode_uint16(data1, data2)); }
 
+  /** Check the crc of data words that were read from the device, and store them.
+   * @param buf received bytes, each data word followed by its crc
+   * @param data pointer to raw result
+   * @param len number of words
+   * @return true if all crcs are valid
+   */
+  bool decode_data_(const uint8_t *buf, uint16_t *data, uint8_t len);
+
   /** last error code from i2c operation
    */
   i2c::ErrorCode last_error_;
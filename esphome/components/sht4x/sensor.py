@@ -91,6 +91,7 @@ async def to_code(config):
     var = cg.new_Pvariable(config[CONF_ID])
     await cg.register_component(var, config)
     await i2c.register_i2c_device(var, config)
+    cg.add(var.set_i2c_scheduler(await i2c.get_scheduler()))
 
     cg.add(var.set_precision_value(config[CONF_PRECISION]))
     cg.add(var.set_heater_power_value(config[CONF_HEATER_POWER]))
@@ -18,6 +18,10 @@ void SHT4XComponent::start_heater_() {
 void SHT4XComponent::setup() {
   ESP_LOGCONFIG(TAG, "Setting up sht4x...");
 
+  // Send the measure command, and read both result words with their crc once the measurement is complete
+  this->measure_transaction_.write(&MEASURECOMMANDS[this->precision_], 1).delay(10).read(this->measure_buffer_, 6);
+  this->measure_transaction_.set_callback([this](i2c::ErrorCode err) { this->publish_measurement_(err); });
+
   if (this->duty_cycle_ > 0.0) {
     uint32_t heater_interval = (uint32_t) (this->heater_time_ / this->duty_cycle_);
     ESP_LOGD(TAG, "Heater interval: %" PRIu32, heater_interval);
@@ -50,36 +54,35 @@ void SHT4XComponent::setup() {
 void SHT4XComponent::dump_config() { LOG_I2C_DEVICE(this); }
 
 void SHT4XComponent::update() {
-  // Send command
-  this->write_command(MEASURECOMMANDS[this->precision_]);
+  if (!this->scheduler_->submit(&this->measure_transaction_))
+    ESP_LOGW(TAG, "Previous measurement still in progress");
+}
 
-  this->set_timeout(10, [this]() {
-    uint16_t buffer[2];
+void SHT4XComponent::publish_measurement_(i2c::ErrorCode err) {
+  uint16_t buffer[2];
 
-    // Read measurement
-    bool read_status = this->read_data(buffer, 2);
+  bool read_status = err == i2c::ERROR_OK && this->decode_data_(this->measure_buffer_, buffer, 2);
 
-    if (read_status) {
-      // Evaluate and publish measurements
-      if (this->temp_sensor_ != nullptr) {
-        // Temp is contained in the first result word
-        float sensor_value_temp = buffer[0];
-        float temp = -45 + 175 * sensor_value_temp / 65535;
+  if (read_status) {
+    // Evaluate and publish measurements
+    if (this->temp_sensor_ != nullptr) {
+      // Temp is contained in the first result word
+      float sensor_value_temp = buffer[0];
+      float temp = -45 + 175 * sensor_value_temp / 65535;
 
-        this->temp_sensor_->publish_state(temp);
-      }
+      this->temp_sensor_->publish_state(temp);
+    }
 
-      if (this->humidity_sensor_ != nullptr) {
-        // Relative humidity is in the second result word
-        float sensor_value_rh = buffer[1];
-        float rh = -6 + 125 * sensor_value_rh / 65535;
+    if (this->humidity_sensor_ != nullptr) {
+      // Relative humidity is in the second result word
+      float sensor_value_rh = buffer[1];
+      float rh = -6 + 125 * sensor_value_rh / 65535;
 
-        this->humidity_sensor_->publish_state(rh);
-      }
-    } else {
-      ESP_LOGD(TAG, "Sensor read failed");
+      this->humidity_sensor_->publish_state(rh);
     }
-  });
+  } else {
+    ESP_LOGD(TAG, "Sensor read failed");
+  }
 }
 
 }  // namespace sht4x
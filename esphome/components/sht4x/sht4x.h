@@ -3,6 +3,7 @@
 #include "esphome/core/component.h"
 #include "esphome/components/sensor/sensor.h"
 #include "esphome/components/sensirion_common/i2c_sensirion.h"
+#include "esphome/components/i2c/i2c_scheduler.h"
 
 #include <cinttypes>
 
@@ -27,6 +28,8 @@ class SHT4XComponent : public PollingComponent, public sensirion_common::Sensiri
   void set_heater_time_value(SHT4XHEATERTIME heater_time) { this->heater_time_ = heater_time; };
   void set_heater_duty_value(float duty_cycle) { this->duty_cycle_ = duty_cycle; };
 
+  void set_i2c_scheduler(i2c::I2CScheduler *scheduler) { this->scheduler_ = scheduler; }
+
   void set_temp_sensor(sensor::Sensor *temp_sensor) { this->temp_sensor_ = temp_sensor; }
   void set_humidity_sensor(sensor::Sensor *humidity_sensor) { this->humidity_sensor_ = humidity_sensor; }
 
@@ -37,8 +40,13 @@ class SHT4XComponent : public PollingComponent, public sensirion_common::Sensiri
   float duty_cycle_;
 
   void start_heater_();
+  void publish_measurement_(i2c::ErrorCode err);
   uint8_t heater_command_;
 
+  i2c::I2CScheduler *scheduler_{nullptr};
+  i2c::I2CTransaction measure_transaction_{this};
+  uint8_t measure_buffer_[6];
+
   sensor::Sensor *temp_sensor_{nullptr};
   sensor::Sensor *humidity_sensor_{nullptr};
 };
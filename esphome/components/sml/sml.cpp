@@ -3,6 +3,9 @@
 #include "esphome/core/helpers.h"
 #include "sml_parser.h"
 
+#include <algorithm>
+#include <cstdio>
+
 namespace esphome {
 namespace sml {
 
@@ -12,7 +15,29 @@ const char START_BYTES_DETECTED = 1;
 const char END_BYTES_DETECTED = 2;
 
 SmlListener::SmlListener(std::string server_id, std::string obis_code)
-    : server_id(std::move(server_id)), obis_code(std::move(obis_code)) {}
+    : server_id(std::move(server_id)), obis_code(std::move(obis_code)) {
+  unsigned a, b, c, d, e;
+  if (sscanf(this->obis_code.c_str(), "%u-%u:%u.%u.%u", &a, &b, &c, &d, &e) == 5 && a <= 255 && b <= 255 &&
+      c <= 255 && d <= 255 && e <= 255)
+    this->obis_code_key_ = pack_obis_code(a, b, c, d, e);
+
+  if (!this->server_id.empty()) {
+    size_t length = this->server_id.size() / 2;
+    this->server_id_bytes_.resize(length);
+    this->server_id_valid_ = this->server_id.size() % 2 == 0 &&
+                             parse_hex(this->server_id, this->server_id_bytes_.data(), length);
+  }
+}
+
+bool SmlListener::matches_server_id(const BytesView &server_id) const {
+  if (this->server_id.empty())
+    return true;
+  return this->server_id_valid_ && BytesView(this->server_id_bytes_) == server_id;
+}
+
+static bool compare_obis_code_key(const SmlListener *listener, uint64_t key) {
+  return listener->get_obis_code_key() < key;
+}
 
 char Sml::check_start_end_bytes_(uint8_t byte) {
   this->incoming_mask_ = (this->incoming_mask_ << 2) | get_code(byte);
@@ -51,53 +76,46 @@ void Sml::loop() {
           if (!valid)
             break;
 
-          // remove start/end sequence
-          this->sml_data_.erase(this->sml_data_.begin(), this->sml_data_.begin() + START_SEQ.size());
-          this->sml_data_.resize(this->sml_data_.size() - 8);
-          this->process_sml_file_(this->sml_data_);
+          // skip start/end sequence
+          this->process_sml_file_(BytesView(this->sml_data_).subview(START_SEQ.size(), this->sml_data_.size() - 16));
         }
         break;
       };
     };
   }
+  // Meters send a file every second or so, there is nothing to do in between
+  if (this->wake_on_rx_)
+    this->disable_loop();
 }
 
 void Sml::add_on_data_callback(std::function<void(std::vector<uint8_t>, bool)> &&callback) {
   this->data_callbacks_.add(std::move(callback));
 }
 
-void Sml::process_sml_file_(const bytes &sml_data) {
-  SmlFile sml_file = SmlFile(sml_data);
-  std::vector<ObisInfo> obis_info = sml_file.get_obis_info();
-  this->publish_obis_info_(obis_info);
-
-  this->log_obis_info_(obis_info);
-}
-
-void Sml::log_obis_info_(const std::vector<ObisInfo> &obis_info_vec) {
+void Sml::process_sml_file_(const BytesView &sml_data) {
   ESP_LOGD(TAG, "OBIS info:");
-  for (auto const &obis_info : obis_info_vec) {
-    std::string info;
-    info += "  (" + bytes_repr(obis_info.server_id) + ") ";
-    info += obis_info.code_repr();
-    info += " [0x" + bytes_repr(obis_info.value) + "]";
-    ESP_LOGD(TAG, "%s", info.c_str());
-  }
+  SmlFile sml_file(sml_data);
+  sml_file.for_each_obis_info([this](const ObisInfo &obis_info) {
+    this->publish_value_(obis_info);
+    this->log_obis_info_(obis_info);
+  });
 }
 
-void Sml::publish_obis_info_(const std::vector<ObisInfo> &obis_info_vec) {
-  for (auto const &obis_info : obis_info_vec) {
-    this->publish_value_(obis_info);
-  }
+void Sml::log_obis_info_(const ObisInfo &obis_info) {
+  ESP_LOGD(TAG, "  (%s) %s [0x%s]", bytes_repr(obis_info.server_id).c_str(), obis_info.code_repr().c_str(),
+           bytes_repr(obis_info.value).c_str());
 }
 
 void Sml::publish_value_(const ObisInfo &obis_info) {
-  for (auto const &sml_listener : sml_listeners_) {
-    if ((!sml_listener->server_id.empty()) && (bytes_repr(obis_info.server_id) != sml_listener->server_id))
-      continue;
-    if (obis_info.code_repr() != sml_listener->obis_code)
-      continue;
-    sml_listener->publish_val(obis_info);
+  const BytesView &code = obis_info.code;
+  if (code.size() < 5)
+    return;
+  uint64_t key = pack_obis_code(code[0], code[1], code[2], code[3], code[4]);
+
+  auto it = std::lower_bound(this->listener_table_.begin(), this->listener_table_.end(), key, compare_obis_code_key);
+  for (; it != this->listener_table_.end() && (*it)->get_obis_code_key() == key; ++it) {
+    if ((*it)->matches_server_id(obis_info.server_id))
+      (*it)->publish_val(obis_info);
   }
 }
 
@@ -105,6 +123,15 @@ void Sml::dump_config() { ESP_LOGCONFIG(TAG, "SML:"); }
 
 void Sml::register_sml_listener(SmlListener *listener) { sml_listeners_.emplace_back(listener); }
 
+void Sml::setup() {
+  this->listener_table_ = this->sml_listeners_;
+  std::stable_sort(this->listener_table_.begin(), this->listener_table_.end(),
+                   [](const SmlListener *a, const SmlListener *b) {
+                     return a->get_obis_code_key() < b->get_obis_code_key();
+                   });
+  this->wake_on_rx_ = this->parent_->wake_loop_on_rx(this);
+}
+
 bool check_sml_data(const bytes &buffer) {
   if (buffer.size() < 2) {
     ESP_LOGW(TAG, "Checksum error in received SML data.");
@@ -16,27 +16,42 @@ class SmlListener {
   std::string obis_code;
   SmlListener(std::string server_id, std::string obis_code);
   virtual void publish_val(const ObisInfo &obis_info){};
+
+  /// The OBIS code packed with pack_obis_code(), parsed once from obis_code.
+  uint64_t get_obis_code_key() const { return this->obis_code_key_; }
+  bool matches_server_id(const BytesView &server_id) const;
+
+ protected:
+  // Never matches a packed code, used if obis_code is not a valid OBIS code
+  uint64_t obis_code_key_{UINT64_MAX};
+  bytes server_id_bytes_;
+  bool server_id_valid_{true};
 };
 
 class Sml : public Component, public uart::UARTDevice {
  public:
   void register_sml_listener(SmlListener *listener);
+  void setup() override;
   void loop() override;
   void dump_config() override;
   std::vector<SmlListener *> sml_listeners_{};
   void add_on_data_callback(std::function<void(std::vector<uint8_t>, bool)> &&callback);
 
  protected:
-  void process_sml_file_(const bytes &sml_data);
-  void log_obis_info_(const std::vector<ObisInfo> &obis_info_vec);
-  void publish_obis_info_(const std::vector<ObisInfo> &obis_info_vec);
+  void process_sml_file_(const BytesView &sml_data);
+  void log_obis_info_(const ObisInfo &obis_info);
   char check_start_end_bytes_(uint8_t byte);
   void publish_value_(const ObisInfo &obis_info);
 
+  // Listeners sorted by their OBIS code key, so the listeners of a value can be found with a binary search
+  std::vector<SmlListener *> listener_table_;
+
   // Serial parser
   bool record_ = false;
   uint16_t incoming_mask_ = 0;
   bytes sml_data_;
+  /// The UART wakes the loop when data arrives, so it is disabled while there is nothing to read.
+  bool wake_on_rx_{false};
 
   CallbackManager<void(const std::vector<uint8_t> &, bool)> data_callbacks_{};
 };
@@ -2,116 +2,197 @@
 #include "constants.h"
 #include "sml_parser.h"
 
+#include <algorithm>
+
 namespace esphome {
 namespace sml {
 
-SmlFile::SmlFile(bytes buffer) : buffer_(std::move(buffer)) {
-  // extract messages
+// Maximum number of TL bytes of a single element, and nesting depth of lists that are skipped
+static const uint8_t MAX_TL_BYTES = 4;
+static const uint8_t MAX_SKIP_DEPTH = 16;
+
+SmlFile::SmlFile(const BytesView &buffer) : buffer_(buffer) {}
+
+bool SmlFile::for_each_obis_info(const std::function<void(const ObisInfo &)> &callback) {
   this->pos_ = 0;
   while (this->pos_ < this->buffer_.size()) {
     if (this->buffer_[this->pos_] == 0x00)
       break;  // EndOfSmlMsg
 
-    SmlNode message = SmlNode();
-    if (!this->setup_node(&message))
-      break;
-    this->messages.emplace_back(message);
+    if (!this->parse_message_(callback))
+      return false;
   }
+  return true;
 }
 
-bool SmlFile::setup_node(SmlNode *node) {
+bool SmlFile::read_tl_(uint8_t *type, size_t *length) {
+  if (this->pos_ >= this->buffer_.size())
+    return false;
+
   // If the TL field is 0x00, this is the end of the message
   // (see 6.3.1 of SML protocol definition)
   if (this->buffer_[this->pos_] == 0x00) {
-    // Increment past this byte and signal that the message is done
     this->pos_ += 1;
+    *type = SML_OCTET;
+    *length = 0;
     return true;
   }
 
   // Extract data from initial TL field
-  uint8_t type = (this->buffer_[this->pos_] >> 4) & 0x07;     // type without overlength info
-  bool overlength = (this->buffer_[this->pos_] >> 4) & 0x08;  // overlength information
-  uint8_t length = this->buffer_[this->pos_] & 0x0f;          // length (including TL bytes)
-
-  // Check if we need additional length bytes
-  if (overlength) {
-    // Shift the current length to the higher nibble
-    // and add the lower nibble of the next byte to the length
-    length = (length << 4) + (this->buffer_[this->pos_ + 1] & 0x0f);
-    // We are basically done with the first TL field now,
-    // so increment past that, we now point to the second TL field
+  uint8_t tl = this->buffer_[this->pos_];
+  *type = (tl >> 4) & 0x07;  // type without overlength info
+  size_t len = tl & 0x0f;    // length (including TL bytes)
+  uint8_t tl_bytes = 1;
+
+  // Each TL byte with the overlength bit set is followed by another one holding the next nibble of the length
+  while (tl & 0x80) {
+    if (tl_bytes == MAX_TL_BYTES || this->pos_ + 1 >= this->buffer_.size())
+      return false;
     this->pos_ += 1;
-    // Decrement the length for value fields (not lists),
-    // since the byte we just handled is counted as part of the field
-    // in case of values but not for lists
-    if (type != SML_LIST)
-      length -= 1;
-
-    // Technically, this is not enough, the standard allows for more than two length fields.
-    // However I don't think it is very common to have more than 255 entries in a list
+    tl = this->buffer_[this->pos_];
+    len = (len << 4) | (tl & 0x0f);
+    tl_bytes++;
   }
-
-  // We are done with the last TL field(s), so advance the position
   this->pos_ += 1;
-  // and decrement the length for non-list fields
-  if (type != SML_LIST)
-    length -= 1;
 
-  // Check if the buffer length is long enough
-  if (this->pos_ + length > this->buffer_.size())
+  // The length of lists is the number of entries, for values it includes the TL bytes
+  if (*type != SML_LIST) {
+    if (len < tl_bytes)
+      return false;
+    len -= tl_bytes;
+    // Check if the buffer length is long enough
+    if (this->pos_ + len > this->buffer_.size())
+      return false;
+  }
+  *length = len;
+  return true;
+}
+
+bool SmlFile::read_list_(size_t *length) {
+  uint8_t type;
+  if (!this->read_tl_(&type, length))
+    return false;
+  return type == SML_LIST;
+}
+
+bool SmlFile::read_value_(BytesView *value, uint8_t *type) {
+  uint8_t node_type;
+  size_t length;
+  if (!this->read_tl_(&node_type, &length))
+    return false;
+  if (type != nullptr)
+    *type = node_type;
+
+  if (node_type == SML_LIST) {
+    // A list where a value was expected has no value bytes
+    *value = BytesView();
+    return this->skip_nodes_(length);
+  }
+  *value = this->buffer_.subview(this->pos_, length);
+  this->pos_ += length;
+  return true;
+}
+
+bool SmlFile::skip_node_(uint8_t depth) {
+  uint8_t type;
+  size_t length;
+  if (depth == MAX_SKIP_DEPTH || !this->read_tl_(&type, &length))
     return false;
 
-  node->type = type;
-  node->nodes.clear();
-  node->value_bytes.clear();
-
-  if (type == SML_LIST) {
-    node->nodes.reserve(length);
-    for (size_t i = 0; i != length; i++) {
-      SmlNode child_node = SmlNode();
-      if (!this->setup_node(&child_node))
-        return false;
-      node->nodes.emplace_back(child_node);
-    }
-  } else {
-    // Value starts at the current position
-    // Value ends "length" bytes later,
-    // (since the TL field is counted but already subtracted from length)
-    node->value_bytes = bytes(this->buffer_.begin() + this->pos_, this->buffer_.begin() + this->pos_ + length);
-    // Increment the pointer past all consumed bytes
+  if (type != SML_LIST) {
     this->pos_ += length;
+    return true;
+  }
+  for (size_t i = 0; i != length; i++) {
+    if (!this->skip_node_(depth + 1))
+      return false;
   }
   return true;
 }
 
-std::vector<ObisInfo> SmlFile::get_obis_info() {
-  std::vector<ObisInfo> obis_info;
-  for (auto const &message : messages) {
-    SmlNode message_body = message.nodes[3];
-    uint16_t message_type = bytes_to_uint(message_body.nodes[0].value_bytes);
-    if (message_type != SML_GET_LIST_RES)
-      continue;
-
-    SmlNode get_list_response = message_body.nodes[1];
-    bytes server_id = get_list_response.nodes[1].value_bytes;
-    SmlNode val_list = get_list_response.nodes[4];
-
-    for (auto const &val_list_entry : val_list.nodes) {
-      obis_info.emplace_back(server_id, val_list_entry);
-    }
+bool SmlFile::skip_nodes_(size_t count) {
+  for (size_t i = 0; i != count; i++) {
+    if (!this->skip_node_())
+      return false;
   }
-  return obis_info;
+  return true;
 }
 
-std::string bytes_repr(const bytes &buffer) {
-  std::string repr;
-  for (auto const value : buffer) {
-    repr += str_sprintf("%02x", value & 0xff);
+bool SmlFile::parse_message_(const std::function<void(const ObisInfo &)> &callback) {
+  // SML_Message: transactionId, groupNo, abortOnError, messageBody, crc16, endOfSmlMsg
+  size_t length;
+  if (!this->read_list_(&length) || length < 4)
+    return false;
+  if (!this->skip_nodes_(3))
+    return false;
+
+  // SML_MessageBody: choice tag and the message itself
+  size_t body_length;
+  if (!this->read_list_(&body_length) || body_length != 2)
+    return false;
+  BytesView message_type;
+  if (!this->read_value_(&message_type))
+    return false;
+  if (bytes_to_uint(message_type) == SML_GET_LIST_RES) {
+    if (!this->parse_get_list_response_(callback))
+      return false;
+  } else if (!this->skip_node_()) {
+    return false;
   }
-  return repr;
+
+  return this->skip_nodes_(length - 4);
+}
+
+bool SmlFile::parse_get_list_response_(const std::function<void(const ObisInfo &)> &callback) {
+  // SML_GetList.Res: clientId, serverId, listName, actSensorTime, valList, listSignature, actGatewayTime
+  size_t length;
+  if (!this->read_list_(&length) || length < 5)
+    return false;
+  BytesView server_id;
+  if (!this->skip_node_() || !this->read_value_(&server_id) || !this->skip_nodes_(2))
+    return false;
+
+  size_t entries;
+  if (!this->read_list_(&entries))
+    return false;
+  for (size_t i = 0; i != entries; i++) {
+    if (!this->parse_list_entry_(server_id, callback))
+      return false;
+  }
+
+  return this->skip_nodes_(length - 5);
 }
 
-uint64_t bytes_to_uint(const bytes &buffer) {
+bool SmlFile::parse_list_entry_(const BytesView &server_id, const std::function<void(const ObisInfo &)> &callback) {
+  // SML_ListEntry: objName, status, valTime, unit, scaler, value, valueSignature
+  size_t length;
+  if (!this->read_list_(&length) || length < 6)
+    return false;
+
+  ObisInfo info;
+  info.server_id = server_id;
+  BytesView unit, scaler;
+  uint8_t value_type;
+  if (!this->read_value_(&info.code) || !this->read_value_(&info.status) || !this->skip_node_() ||
+      !this->read_value_(&unit) || !this->read_value_(&scaler) || !this->read_value_(&info.value, &value_type))
+    return false;
+  info.unit = bytes_to_uint(unit);
+  info.scaler = bytes_to_int(scaler);
+  info.value_type = value_type;
+
+  if (!this->skip_nodes_(length - 6))
+    return false;
+  callback(info);
+  return true;
+}
+
+bool operator==(const BytesView &lhs, const BytesView &rhs) {
+  return lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+std::string bytes_repr(const BytesView &buffer) { return format_hex(buffer.begin(), buffer.size()); }
+
+uint64_t bytes_to_uint(const BytesView &buffer) {
   uint64_t val = 0;
   for (auto const value : buffer) {
     val = (val << 8) + value;
@@ -119,13 +200,13 @@ uint64_t bytes_to_uint(const bytes &buffer) {
   return val;
 }
 
-int64_t bytes_to_int(const bytes &buffer) {
+int64_t bytes_to_int(const BytesView &buffer) {
   uint64_t tmp = bytes_to_uint(buffer);
   int64_t val;
 
   // sign extension for abbreviations of leading ones (e.g. 3 byte transmissions, see 6.2.2 of SML protocol definition)
   // see https://stackoverflow.com/questions/42534749/signed-extension-from-24-bit-to-32-bit-in-c
-  if (buffer.size() < 8) {
+  if (!buffer.empty() && buffer.size() < 8) {
     const int bits = buffer.size() * 8;
     const uint64_t m = 1ull << (bits - 1);
     tmp = (tmp ^ m) - m;
@@ -135,19 +216,11 @@ int64_t bytes_to_int(const bytes &buffer) {
   return val;
 }
 
-std::string bytes_to_string(const bytes &buffer) { return std::string(buffer.begin(), buffer.end()); }
-
-ObisInfo::ObisInfo(bytes server_id, SmlNode val_list_entry) : server_id(std::move(server_id)) {
-  this->code = val_list_entry.nodes[0].value_bytes;
-  this->status = val_list_entry.nodes[1].value_bytes;
-  this->unit = bytes_to_uint(val_list_entry.nodes[3].value_bytes);
-  this->scaler = bytes_to_int(val_list_entry.nodes[4].value_bytes);
-  SmlNode value_node = val_list_entry.nodes[5];
-  this->value = value_node.value_bytes;
-  this->value_type = value_node.type;
-}
+std::string bytes_to_string(const BytesView &buffer) { return std::string(buffer.begin(), buffer.end()); }
 
 std::string ObisInfo::code_repr() const {
+  if (this->code.size() < 5)
+    return "";
   return str_sprintf("%d-%d:%d.%d.%d", this->code[0], this->code[1], this->code[2], this->code[3], this->code[4]);
 }
 
@@ -2,6 +2,7 @@
 
 #include <cstdint>
 #include <cstdio>
+#include <functional>
 #include <string>
 #include <vector>
 #include "constants.h"
@@ -11,44 +12,75 @@ namespace sml {
 
 using bytes = std::vector<uint8_t>;
 
-class SmlNode {
+/// Non-owning view into a range of bytes of an SML file.
+class BytesView {
  public:
-  uint8_t type;
-  bytes value_bytes;
-  std::vector<SmlNode> nodes;
+  BytesView() = default;
+  BytesView(const uint8_t *first, size_t count) : first_(first), count_(count) {}
+  explicit BytesView(const bytes &buffer) : first_(buffer.data()), count_(buffer.size()) {}
+
+  size_t size() const { return this->count_; }
+  bool empty() const { return this->count_ == 0; }
+  uint8_t operator[](size_t index) const { return this->first_[index]; }
+  const uint8_t *begin() const { return this->first_; }
+  const uint8_t *end() const { return this->first_ + this->count_; }
+  BytesView subview(size_t offset, size_t count) const { return {this->first_ + offset, count}; }
+
+ protected:
+  const uint8_t *first_{nullptr};
+  size_t count_{0};
 };
 
+bool operator==(const BytesView &lhs, const BytesView &rhs);
+
 class ObisInfo {
  public:
-  ObisInfo(bytes server_id, SmlNode val_list_entry);
-  bytes server_id;
-  bytes code;
-  bytes status;
+  BytesView server_id;
+  BytesView code;
+  BytesView status;
   char unit;
   char scaler;
-  bytes value;
+  BytesView value;
   uint16_t value_type;
   std::string code_repr() const;
 };
 
+/** Decoder for the messages of an SML file.
+ *
+ * The buffer is decoded in a single pass without building a node tree, and all values of the reported
+ * ObisInfo entries point into the buffer, so it must outlive them.
+ */
 class SmlFile {
  public:
-  SmlFile(bytes buffer);
-  bool setup_node(SmlNode *node);
-  std::vector<SmlNode> messages;
-  std::vector<ObisInfo> get_obis_info();
+  SmlFile(const BytesView &buffer);
+  /// Call `callback` for every value list entry of every GetListResponse message in the file.
+  bool for_each_obis_info(const std::function<void(const ObisInfo &)> &callback);
 
  protected:
-  const bytes buffer_;
-  size_t pos_;
+  bool read_tl_(uint8_t *type, size_t *length);
+  bool read_list_(size_t *length);
+  bool read_value_(BytesView *value, uint8_t *type = nullptr);
+  bool skip_node_(uint8_t depth = 0);
+  bool skip_nodes_(size_t count);
+  bool parse_message_(const std::function<void(const ObisInfo &)> &callback);
+  bool parse_get_list_response_(const std::function<void(const ObisInfo &)> &callback);
+  bool parse_list_entry_(const BytesView &server_id, const std::function<void(const ObisInfo &)> &callback);
+
+  const BytesView buffer_;
+  size_t pos_{0};
 };
 
-std::string bytes_repr(const bytes &buffer);
+std::string bytes_repr(const BytesView &buffer);
+
+uint64_t bytes_to_uint(const BytesView &buffer);
 
-uint64_t bytes_to_uint(const bytes &buffer);
+int64_t bytes_to_int(const BytesView &buffer);
 
-int64_t bytes_to_int(const bytes &buffer);
+std::string bytes_to_string(const BytesView &buffer);
 
-std::string bytes_to_string(const bytes &buffer);
+/// Pack the first five groups (A-B:C.D.E) of an OBIS code into an integer, for use as a lookup key.
+inline uint64_t pack_obis_code(uint8_t a, uint8_t b, uint8_t c, uint8_t d, uint8_t e) {
+  return (uint64_t(a) << 32) | (uint32_t(b) << 24) | (uint32_t(c) << 16) | (uint32_t(d) << 8) | e;
+}
 }  // namespace sml
 }  // namespace esphome
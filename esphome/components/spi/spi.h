@@ -234,6 +234,17 @@ class SPIDelegate {
       this->transfer(ptr[i]);
   }
 
+  /**
+   * Queue a write of the contents of a buffer and return without waiting for it to complete, if the platform
+   * supports it. When this returns, all previously queued writes have completed, so a caller can fill one buffer
+   * while another one is being sent. The buffer must not be changed until the next call of queue_write_array()
+   * or wait_queued_writes() has returned. The default implementation writes synchronously.
+   */
+  virtual void queue_write_array(const uint8_t *ptr, size_t length) { this->write_array(ptr, length); }
+
+  // wait until all queued writes have completed.
+  virtual void wait_queued_writes() {}
+
   // read into a buffer, write nulls
   virtual void read_array(uint8_t *ptr, size_t length) {
     for (size_t i = 0; i != length; i++)
@@ -468,6 +479,18 @@ class SPIDevice : public SPIClient {
 
   template<size_t N> void write_array(const std::array<uint8_t, N> &data) { this->write_array(data.data(), N); }
 
+  /**
+   * Queue a write of the array data, and return while it is being sent where the platform supports it.
+   * All previously queued writes have completed when this returns. The data must not be changed until the next
+   * call of queue_write_array() or wait_queued_writes() has returned, or the device is disabled.
+   * @param data
+   * @param length
+   */
+  void queue_write_array(const uint8_t *data, size_t length) { this->delegate_->queue_write_array(data, length); }
+
+  /// Wait until all queued writes have completed.
+  void wait_queued_writes() { this->delegate_->wait_queued_writes(); }
+
   void write_array(const std::vector<uint8_t> &data) { this->write_array(data.data(), data.size()); }
 
   template<size_t N> void transfer_array(std::array<uint8_t, N> &data) { this->transfer_array(data.data(), N); }
@@ -7,6 +7,7 @@ namespace spi {
 #ifdef USE_ESP_IDF
 static const char *const TAG = "spi-esp-idf";
 static const size_t MAX_TRANSFER_SIZE = 4092;  // dictated by ESP-IDF API.
+static const uint8_t QUEUE_SIZE = 2;           // number of interrupt transfers that can be queued at once.
 
 class SPIDelegateHw : public SPIDelegate {
  public:
@@ -18,7 +19,7 @@ class SPIDelegateHw : public SPIDelegate {
     config.clock_speed_hz = static_cast<int>(data_rate);
     config.spics_io_num = -1;
     config.flags = 0;
-    config.queue_size = 1;
+    config.queue_size = QUEUE_SIZE;
     config.pre_cb = nullptr;
     config.post_cb = nullptr;
     if (bit_order == BIT_ORDER_LSB_FIRST)
@@ -44,12 +45,14 @@ class SPIDelegateHw : public SPIDelegate {
 
   void end_transaction() override {
     if (this->is_ready()) {
+      this->wait_queued_writes();
       SPIDelegate::end_transaction();
       spi_device_release_bus(this->handle_);
     }
   }
 
   ~SPIDelegateHw() override {
+    this->wait_queued_writes();
     esp_err_t const err = spi_bus_remove_device(this->handle_);
     if (err != ESP_OK)
       ESP_LOGE(TAG, "Remove device failed - err %X", err);
@@ -57,13 +60,13 @@ class SPIDelegateHw : public SPIDelegate {
 
   // do a transfer. either txbuf or rxbuf (but not both) may be null.
   // transfers above the maximum size will be split.
-  // TODO - make use of the queue for interrupt transfers to provide a (short) pipeline of blocks
-  // when splitting is required.
   void transfer(const uint8_t *txbuf, uint8_t *rxbuf, size_t length) override {
     if (rxbuf != nullptr && this->write_only_) {
       ESP_LOGE(TAG, "Attempted read from write-only channel");
       return;
     }
+    // polling transfers can't be started while queued transfers are pending.
+    this->wait_queued_writes();
     spi_transaction_t desc = {};
     desc.flags = 0;
     while (length != 0) {
@@ -90,6 +93,7 @@ class SPIDelegateHw : public SPIDelegate {
   }
 
   void write(uint16_t data, size_t num_bits) override {
+    this->wait_queued_writes();
     spi_transaction_ext_t desc = {};
     desc.command_bits = num_bits;
     desc.base.flags = SPI_TRANS_VARIABLE_CMD;
@@ -121,6 +125,7 @@ class SPIDelegateHw : public SPIDelegate {
       esph_log_w(TAG, "Nothing to transfer");
       return;
     }
+    this->wait_queued_writes();
     desc.base.flags = SPI_TRANS_VARIABLE_ADDR | SPI_TRANS_VARIABLE_CMD | SPI_TRANS_VARIABLE_DUMMY;
     if (bus_width == 4) {
       desc.base.flags |= SPI_TRANS_MODE_QIO;
@@ -188,10 +193,61 @@ class SPIDelegateHw : public SPIDelegate {
 
   void read_array(uint8_t *ptr, size_t length) override { this->transfer(nullptr, ptr, length); }
 
+  // queue interrupt transfers, so the data is sent by DMA while the caller prepares the next buffer.
+  void queue_write_array(const uint8_t *ptr, size_t length) override {
+    while (length != 0) {
+      // make room in the queue for another transfer.
+      if (this->queued_ == QUEUE_SIZE && !this->wait_queued_write_())
+        return;
+      size_t const partial = std::min(length, MAX_TRANSFER_SIZE);
+      spi_transaction_t *desc = &this->queue_descs_[this->queue_next_];
+      *desc = {};
+      desc->length = partial * 8;
+      desc->tx_buffer = ptr;
+      esp_err_t const err = spi_device_queue_trans(this->handle_, desc, portMAX_DELAY);
+      if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Queue transmit failed - err %X", err);
+        return;
+      }
+      this->queued_++;
+      this->queue_next_ = (this->queue_next_ + 1) % QUEUE_SIZE;
+      length -= partial;
+      ptr += partial;
+    }
+    // all writes before the last one are complete once this returns, so their buffers can be reused.
+    while (this->queued_ > 1) {
+      if (!this->wait_queued_write_())
+        return;
+    }
+  }
+
+  void wait_queued_writes() override {
+    while (this->queued_ != 0) {
+      if (!this->wait_queued_write_())
+        return;
+    }
+  }
+
  protected:
+  // wait for the oldest queued transfer to complete.
+  bool wait_queued_write_() {
+    spi_transaction_t *desc;
+    esp_err_t const err = spi_device_get_trans_result(this->handle_, &desc, portMAX_DELAY);
+    if (err != ESP_OK) {
+      ESP_LOGE(TAG, "Queued transmit failed - err %X", err);
+      this->queued_ = 0;
+      return false;
+    }
+    this->queued_--;
+    return true;
+  }
+
   SPIInterface channel_{};
   spi_device_handle_t handle_{};
   bool write_only_{false};
+  spi_transaction_t queue_descs_[QUEUE_SIZE]{};
+  uint8_t queue_next_{0};
+  uint8_t queued_{0};
 };
 
 class SPIBusHw : public SPIBus {
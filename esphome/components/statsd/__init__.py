@@ -15,6 +15,8 @@ DEPENDENCIES = ["network"]
 
 CONF_HOST = "host"
 CONF_PREFIX = "prefix"
+CONF_MAX_PACKET_SIZE = "max_packet_size"
+CONF_ONLY_CHANGES = "only_changes"
 
 statsd_component_ns = cg.esphome_ns.namespace("statsd")
 StatsdComponent = statsd_component_ns.class_("StatsdComponent", cg.PollingComponent)
@@ -39,6 +41,11 @@ CONFIG_SCHEMA = cv.Schema(
         cv.Required(CONF_HOST): cv.string_strict,
         cv.Optional(CONF_PORT, default=8125): cv.port,
         cv.Optional(CONF_PREFIX, default=""): cv.string_strict,
+        # 1500 byte Ethernet MTU minus IP and UDP headers, with some room for tunnels
+        cv.Optional(CONF_MAX_PACKET_SIZE, default=1432): cv.int_range(
+            min=64, max=65507
+        ),
+        cv.Optional(CONF_ONLY_CHANGES, default=False): cv.boolean,
         cv.Optional(CONF_SENSORS): cv.ensure_list(CONFIG_SENSORS_SCHEMA),
         cv.Optional(CONF_BINARY_SENSORS): cv.ensure_list(CONFIG_BINARY_SENSORS_SCHEMA),
     }
@@ -55,6 +62,8 @@ async def to_code(config):
             config.get(CONF_PREFIX),
         )
     )
+    cg.add(var.set_max_packet_size(config[CONF_MAX_PACKET_SIZE]))
+    cg.add(var.set_only_changes(config[CONF_ONLY_CHANGES]))
 
     for sensor_cfg in config.get(CONF_SENSORS, []):
         s = await cg.get_variable(sensor_cfg[CONF_ID])
@@ -1,18 +1,80 @@
+#include "esphome/core/helpers.h"
 #include "esphome/core/log.h"
 
 #include "statsd.h"
 
+#include <cinttypes>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
 #ifdef USE_NETWORK
 namespace esphome {
 namespace statsd {
 
-// send UDP packet if we reach 1Kb packed size
-// this is needed since statsD does not support fragmented UDP packets
-static const uint16_t SEND_THRESHOLD = 1024;
-
 static const char *const TAG = "statsD";
 
+// Large enough for any value formatted by format_value()
+static const size_t VALUE_BUFFER_SIZE = 32;
+
+/// Format a value like value_accuracy_to_string(), without going through printf for the common cases.
+static size_t format_value(char *buf, float value, int8_t accuracy_decimals) {
+  static const uint32_t POW10[] = {1, 10, 100, 1000, 10000, 100000, 1000000};
+  if (accuracy_decimals < 0) {
+    auto multiplier = powf(10.0f, accuracy_decimals);
+    value = roundf(value * multiplier) / multiplier;
+    accuracy_decimals = 0;
+  }
+  uint8_t decimals = std::min<int8_t>(accuracy_decimals, 6);
+  double scaled = static_cast<double>(value) * POW10[decimals];
+  if (std::fabs(scaled) >= 1e15) {
+    int len = snprintf(buf, VALUE_BUFFER_SIZE, "%.*f", decimals, value);
+    if (len >= 0 && static_cast<size_t>(len) < VALUE_BUFFER_SIZE)
+      return len;
+    // a float can have up to 39 digits in fixed notation, this takes at most 15 characters
+    len = snprintf(buf, VALUE_BUFFER_SIZE, "%.9g", value);
+    return std::max(len, 0);
+  }
+
+  int64_t rounded = std::llround(scaled);
+  char *pos = buf;
+  if (rounded < 0) {
+    *pos++ = '-';
+    rounded = -rounded;
+  }
+  // the digits are generated backwards, the fraction first
+  char digits[24];
+  uint8_t count = 0;
+  do {
+    if (count == decimals && decimals != 0)
+      digits[count++] = '.';
+    digits[count++] = '0' + rounded % 10;
+    rounded /= 10;
+  } while (rounded != 0 || count <= decimals);
+  while (count != 0)
+    *pos++ = digits[--count];
+  *pos = '\0';
+  return pos - buf;
+}
+
 void StatsdComponent::setup() {
+  // the keys are the same for every update, so they are formatted once
+  for (auto &s : this->sensors_) {
+    size_t offset = this->keys_.size();
+    if (this->prefix_ != nullptr && this->prefix_[0] != '\0') {
+      this->keys_ += this->prefix_;
+      this->keys_ += '.';
+    }
+    this->keys_ += s.name;
+    this->keys_ += ':';
+    s.key_offset = offset;
+    s.key_length = this->keys_.size() - offset;
+  }
+  this->keys_.shrink_to_fit();
+  this->packet_.reserve(this->max_packet_size_);
+  if (this->only_changes_)
+    this->last_values_.resize(this->sensors_.size() * VALUE_BUFFER_SIZE);
+
 #ifndef USE_ESP8266
   this->sock_ = esphome::socket::socket(AF_INET, SOCK_DGRAM, 0);
 
@@ -44,6 +106,8 @@ void StatsdComponent::dump_config() {
   if (this->prefix_) {
     ESP_LOGCONFIG(TAG, "  prefix: %s", this->prefix_);
   }
+  ESP_LOGCONFIG(TAG, "  max packet size: %u", this->max_packet_size_);
+  ESP_LOGCONFIG(TAG, "  only changes: %s", YESNO(this->only_changes_));
 
   ESP_LOGCONFIG(TAG, "  metrics:");
   for (sensors_t s : this->sensors_) {
@@ -58,6 +122,7 @@ float StatsdComponent::get_setup_priority() const { return esphome::setup_priori
 void StatsdComponent::register_sensor(const char *name, esphome::sensor::Sensor *sensor) {
   sensors_t s;
   s.name = name;
+  s.last_length = 0;
   s.sensor = sensor;
   s.type = TYPE_SENSOR;
   this->sensors_.push_back(s);
@@ -68,6 +133,7 @@ void StatsdComponent::register_sensor(const char *name, esphome::sensor::Sensor
 void StatsdComponent::register_binary_sensor(const char *name, esphome::binary_sensor::BinarySensor *binary_sensor) {
   sensors_t s;
   s.name = name;
+  s.last_length = 0;
   s.binary_sensor = binary_sensor;
   s.type = TYPE_BINARY_SENSOR;
   this->sensors_.push_back(s);
@@ -75,18 +141,20 @@ void StatsdComponent::register_binary_sensor(const char *name, esphome::binary_s
 #endif
 
 void StatsdComponent::update() {
-  std::string out;
-  out.reserve(SEND_THRESHOLD);
+  char value[VALUE_BUFFER_SIZE];
 
-  for (sensors_t s : this->sensors_) {
-    double val = 0;
+  for (size_t i = 0; i < this->sensors_.size(); i++) {
+    auto &s = this->sensors_[i];
+    size_t len;
+    bool negative = false;
     switch (s.type) {
 #ifdef USE_SENSOR
       case TYPE_SENSOR:
-        if (!s.sensor->has_state()) {
+        if (!s.sensor->has_state() || !std::isfinite(s.sensor->state)) {
           continue;
         }
-        val = s.sensor->state;
+        len = format_value(value, s.sensor->state, s.sensor->get_accuracy_decimals());
+        negative = value[0] == '-';
         break;
 #endif
 #ifdef USE_BINARY_SENSOR
@@ -94,10 +162,10 @@ void StatsdComponent::update() {
         if (!s.binary_sensor->has_state()) {
           continue;
         }
-        // map bool to double
-        if (s.binary_sensor->state) {
-          val = 1;
-        }
+        // map bool to a number
+        value[0] = s.binary_sensor->state ? '1' : '0';
+        value[1] = '\0';
+        len = 1;
         break;
 #endif
       default:
@@ -105,27 +173,41 @@ void StatsdComponent::update() {
         continue;
     }
 
-    // statsD gauge:
-    // https://github.com/statsd/statsd/blob/master/docs/metric_types.md
-    // This implies you can't explicitly set a gauge to a negative number without first setting it to zero.
-    if (val < 0) {
-      if (this->prefix_) {
-        out.append(str_sprintf("%s.", this->prefix_));
+    if (this->only_changes_) {
+      // compare the text that was sent, a hash could collide and hide a change
+      char *last_value = &this->last_values_[i * VALUE_BUFFER_SIZE];
+      if (s.last_length == len && memcmp(last_value, value, len) == 0) {
+        continue;
       }
-      out.append(str_sprintf("%s:0|g\n", s.name));
-    }
-    if (this->prefix_) {
-      out.append(str_sprintf("%s.", this->prefix_));
+      memcpy(last_value, value, len);
+      s.last_length = len;
     }
-    out.append(str_sprintf("%s:%f|g\n", s.name, val));
 
-    if (out.length() > SEND_THRESHOLD) {
-      this->send_(&out);
-      out.clear();
+    // statsD gauge:
+    // https://github.com/statsd/statsd/blob/master/docs/metric_types.md
+    // This implies you can't explicitly set a gauge to a negative number without first setting it to zero.
+    if (negative) {
+      this->add_line_(s, "0", 1);
     }
+    this->add_line_(s, value, len);
   }
 
-  this->send_(&out);
+  this->send_(&this->packet_);
+  this->packet_.clear();
+}
+
+void StatsdComponent::add_line_(const sensors_t &s, const char *value, size_t value_len) {
+  // <key>:<value>|g\n
+  size_t line_len = s.key_length + value_len + 3;
+  // statsD does not support fragmented UDP packets, so the lines are packed into datagrams of at most
+  // max_packet_size bytes
+  if (this->packet_.size() + line_len > this->max_packet_size_) {
+    this->send_(&this->packet_);
+    this->packet_.clear();
+  }
+  this->packet_.append(this->keys_, s.key_offset, s.key_length);
+  this->packet_.append(value, value_len);
+  this->packet_.append("|g\n", 3);
 }
 
 void StatsdComponent::send_(std::string *out) {
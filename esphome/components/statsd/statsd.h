@@ -33,6 +33,11 @@ using sensor_type_t = enum { TYPE_SENSOR, TYPE_BINARY_SENSOR };
 using sensors_t = struct {
   const char *name;
   sensor_type_t type;
+  /// Offset and length of "<prefix>.<name>:" in the key arena, built in setup()
+  uint16_t key_offset;
+  uint16_t key_length;
+  /// Length of the last sent value in last_values_, 0 if none was sent yet; only used with only_changes
+  uint8_t last_length;
   union {
 #ifdef USE_SENSOR
     esphome::sensor::Sensor *sensor;
@@ -57,6 +62,8 @@ class StatsdComponent : public PollingComponent {
     this->port_ = port;
     this->prefix_ = prefix;
   }
+  void set_max_packet_size(uint16_t max_packet_size) { this->max_packet_size_ = max_packet_size; }
+  void set_only_changes(bool only_changes) { this->only_changes_ = only_changes; }
 
 #ifdef USE_SENSOR
   void register_sensor(const char *name, esphome::sensor::Sensor *sensor);
@@ -70,8 +77,16 @@ class StatsdComponent : public PollingComponent {
   const char *host_;
   const char *prefix_;
   uint16_t port_;
+  uint16_t max_packet_size_{1432};
+  bool only_changes_{false};
 
   std::vector<sensors_t> sensors_;
+  /// The metric keys of all sensors
+  std::string keys_;
+  /// Datagram that is being packed, reused for every update
+  std::string packet_;
+  /// The last sent value of every sensor for only_changes, in slots of the size of a formatted value
+  std::vector<char> last_values_;
 
 #ifdef USE_ESP8266
   WiFiUDP sock_;
@@ -80,6 +95,8 @@ class StatsdComponent : public PollingComponent {
   struct sockaddr_in destination_;
 #endif
 
+  /// Add a line to the packet, sending the packet first if the line does not fit anymore.
+  void add_line_(const sensors_t &s, const char *value, size_t value_len);
   void send_(std::string *out);
 };
 
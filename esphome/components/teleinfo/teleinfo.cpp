@@ -1,27 +1,33 @@
 #include "teleinfo.h"
 #include "esphome/core/log.h"
 
+#include <algorithm>
+#include <cstring>
+
 namespace esphome {
 namespace teleinfo {
 
 static const char *const TAG = "teleinfo";
 
 /* Helpers */
-static int get_field(char *dest, char *buf_start, char *buf_end, int sep, int max_len) {
+/*
+ * Terminate the field starting at buf_start in place, and return its length.
+ * Returns 0 if the field isn't followed by a separator before buf_end.
+ */
+static int terminate_field(char *buf_start, char *buf_end, int sep) {
   char *field_end;
-  int len;
 
   field_end = static_cast<char *>(memchr(buf_start, sep, buf_end - buf_start));
   if (!field_end)
     return 0;
-  len = field_end - buf_start;
-  if (len >= max_len)
-    return len;
-  strncpy(dest, buf_start, len);
-  dest[len] = '\0';
+  *field_end = '\0';
 
-  return len;
+  return field_end - buf_start;
+}
+static bool compare_listener_tag(const TeleInfoListener *listener, const char *tag) {
+  return strcmp(listener->tag.c_str(), tag) < 0;
 }
+static bool compare_listeners(const TeleInfoListener *lhs, const TeleInfoListener *rhs) { return lhs->tag < rhs->tag; }
 /* TeleInfo methods */
 bool TeleInfo::check_crc_(const char *grp, const char *grp_end) {
   int grp_len = grp_end - grp;
@@ -66,11 +72,16 @@ bool TeleInfo::read_chars_until_(bool drop, uint8_t c) {
 
   return false;
 }
-void TeleInfo::setup() { state_ = OFF; }
+void TeleInfo::setup() {
+  state_ = OFF;
+  // the loop only runs from an update until the frame has been read
+  this->disable_loop();
+}
 void TeleInfo::update() {
   if (state_ == OFF) {
     buf_index_ = 0;
     state_ = ON;
+    this->enable_loop();
   }
 }
 void TeleInfo::loop() {
@@ -91,6 +102,9 @@ void TeleInfo::loop() {
       char *buf_finger;
       char *grp_end;
       char *buf_end;
+      const char *tag;
+      const char *timestamp;
+      const char *val;
       int field_len;
 
       buf_finger = buf_;
@@ -116,14 +130,11 @@ void TeleInfo::loop() {
        * The DATE tag is a special case. The group looks like this
        * 0xa | Tag | 0x9 | Timestamp | 0x9 | 0x9 | CRC | 0xd
        *
+       * Once the checksum of a group is verified, its fields are parsed in place by
+       * replacing their separators with null terminators.
        */
-      while ((buf_finger = static_cast<char *>(memchr(buf_finger, (int) 0xa, buf_index_ - 1))) &&
-             ((buf_finger - buf_) < buf_index_)) {  // NOLINT(clang-diagnostic-sign-compare)
-        /*
-         * Make sure timesamp is nullified between each tag as some tags don't
-         * have a timestamp
-         */
-        timestamp_[0] = '\0';
+      while (buf_finger < buf_end &&
+             (buf_finger = static_cast<char *>(memchr(buf_finger, (int) 0xa, buf_end - buf_finger)))) {
         /* Point to the first char of the group after 0xa */
         buf_finger += 1;
 
@@ -138,7 +149,8 @@ void TeleInfo::loop() {
           continue;
 
         /* Get tag */
-        field_len = get_field(tag_, buf_finger, grp_end, separator_, MAX_TAG_SIZE);
+        tag = buf_finger;
+        field_len = terminate_field(buf_finger, grp_end, separator_);
         if (!field_len || field_len >= MAX_TAG_SIZE) {
           ESP_LOGE(TAG, "Invalid tag.");
           continue;
@@ -152,10 +164,11 @@ void TeleInfo::loop() {
          * historical mode is not in use (separator_ != 0x20), it means there is a
          * timestamp to read first.
          */
-        if (std::count(buf_finger, grp_end, separator_) == 2 && strcmp(tag_, "DATE") != 0 && separator_ != 0x20) {
-          field_len = get_field(timestamp_, buf_finger, grp_end, separator_, MAX_TIMESTAMP_SIZE);
+        if (std::count(buf_finger, grp_end, separator_) == 2 && strcmp(tag, "DATE") != 0 && separator_ != 0x20) {
+          timestamp = buf_finger;
+          field_len = terminate_field(buf_finger, grp_end, separator_);
           if (!field_len || field_len >= MAX_TIMESTAMP_SIZE) {
-            ESP_LOGE(TAG, "Invalid timestamp for tag %s", timestamp_);
+            ESP_LOGE(TAG, "Invalid timestamp %s for tag %s", timestamp, tag);
             continue;
           }
 
@@ -163,27 +176,33 @@ void TeleInfo::loop() {
           buf_finger += field_len + 1;
         }
 
-        field_len = get_field(val_, buf_finger, grp_end, separator_, MAX_VAL_SIZE);
+        val = buf_finger;
+        field_len = terminate_field(buf_finger, grp_end, separator_);
         if (!field_len || field_len >= MAX_VAL_SIZE) {
-          ESP_LOGE(TAG, "Invalid value for tag %s", tag_);
+          ESP_LOGE(TAG, "Invalid value for tag %s", tag);
           continue;
         }
 
         /* Advance buf_finger to end of group */
         buf_finger += field_len + 1 + 1 + 1;
 
-        publish_value_(std::string(tag_), std::string(val_));
+        publish_value_(tag, val);
       }
       state_ = OFF;
       break;
   }
+  if (state_ == OFF)
+    this->disable_loop();
 }
-void TeleInfo::publish_value_(const std::string &tag, const std::string &val) {
-  for (auto *element : teleinfo_listeners_) {
-    if (tag != element->tag)
-      continue;
-    element->publish_val(val);
-  }
+void TeleInfo::publish_value_(const char *tag, const char *val) {
+  /* Listeners are sorted by tag, so all listeners of this tag are found with a binary search. */
+  auto it = std::lower_bound(teleinfo_listeners_.begin(), teleinfo_listeners_.end(), tag, compare_listener_tag);
+  if (it == teleinfo_listeners_.end() || (*it)->tag != tag)
+    return;
+
+  const std::string value(val);
+  for (; it != teleinfo_listeners_.end() && (*it)->tag == tag; ++it)
+    (*it)->publish_val(value);
 }
 void TeleInfo::dump_config() {
   ESP_LOGCONFIG(TAG, "TeleInfo:");
@@ -203,7 +222,10 @@ TeleInfo::TeleInfo(bool historical_mode) {
     baud_rate_ = 9600;
   }
 }
-void TeleInfo::register_teleinfo_listener(TeleInfoListener *listener) { teleinfo_listeners_.push_back(listener); }
+void TeleInfo::register_teleinfo_listener(TeleInfoListener *listener) {
+  auto pos = std::upper_bound(teleinfo_listeners_.begin(), teleinfo_listeners_.end(), listener, compare_listeners);
+  teleinfo_listeners_.insert(pos, listener);
+}
 
 }  // namespace teleinfo
 }  // namespace esphome
@@ -29,6 +29,7 @@ class TeleInfo : public PollingComponent, public uart::UARTDevice {
   void setup() override;
   void update() override;
   void dump_config() override;
+  /// Registered listeners, kept sorted by tag.
   std::vector<TeleInfoListener *> teleinfo_listeners_{};
 
  protected:
@@ -37,9 +38,6 @@ class TeleInfo : public PollingComponent, public uart::UARTDevice {
   int separator_;
   char buf_[MAX_BUF_SIZE];
   uint32_t buf_index_{0};
-  char tag_[MAX_TAG_SIZE];
-  char val_[MAX_VAL_SIZE];
-  char timestamp_[MAX_TIMESTAMP_SIZE];
   enum State {
     OFF,
     ON,
@@ -48,7 +46,7 @@ class TeleInfo : public PollingComponent, public uart::UARTDevice {
   } state_{OFF};
   bool read_chars_until_(bool drop, uint8_t c);
   bool check_crc_(const char *grp, const char *grp_end);
-  void publish_value_(const std::string &tag, const std::string &val);
+  void publish_value_(const char *tag, const char *val);
 };
 }  // namespace teleinfo
 }  // namespace esphome
@@ -3,6 +3,7 @@
 #include "esphome/core/log.h"
 
 #include <cinttypes>
+#include <sys/time.h>
 
 namespace esphome {
 namespace time {
@@ -10,6 +11,17 @@ namespace time {
 static const char *const TAG = "automation";
 static const int MAX_TIMESTAMP_DRIFT = 900;  // how far can the clock drift before we consider
                                              // there has been a drastic time synchronization
+static const time_t MAX_LOOKAHEAD = 86400;   // how far ahead a single search for the next match looks
+static const uint32_t INVALID_TIME_RETRY = 1000;  // how often to check for a valid time before the first sync
+
+/// Return the first set bit in [start, end), or -1 if there is none.
+template<size_t N> static int next_set_bit(const std::bitset<N> &bits, int start, int end) {
+  for (int i = start; i < end; i++) {
+    if (bits[i])
+      return i;
+  }
+  return -1;
+}
 
 void CronTrigger::add_second(uint8_t second) { this->seconds_[second] = true; }
 void CronTrigger::add_minute(uint8_t minute) { this->minutes_[minute] = true; }
@@ -21,36 +33,49 @@ bool CronTrigger::matches(const ESPTime &time) {
   return time.is_valid() && this->seconds_[time.second] && this->minutes_[time.minute] && this->hours_[time.hour] &&
          this->days_of_month_[time.day_of_month] && this->months_[time.month] && this->days_of_week_[time.day_of_week];
 }
-void CronTrigger::loop() {
-  ESPTime time = this->rtc_->now();
-  if (!time.is_valid())
-    return;
-
-  if (this->last_check_.has_value()) {
-    if (*this->last_check_ > time && this->last_check_->timestamp - time.timestamp > MAX_TIMESTAMP_DRIFT) {
-      // We went back in time (a lot), probably caused by time synchronization
-      ESP_LOGW(TAG, "Time has jumped back!");
-    } else if (*this->last_check_ >= time) {
-      // already handled this one
-      return;
-    } else if (time > *this->last_check_ && time.timestamp - this->last_check_->timestamp > MAX_TIMESTAMP_DRIFT) {
-      // We went ahead in time (a lot), probably caused by time synchronization
-      ESP_LOGW(TAG, "Time has jumped ahead!");
-      this->last_check_ = time;
-      return;
+void CronTrigger::setup() {
+  this->rtc_->add_on_time_sync_callback([this]() { this->process_(); });
+  this->process_();
+}
+optional<time_t> CronTrigger::next_match_(time_t from) {
+  time_t t = from + 1;
+  while (t - from <= MAX_LOOKAHEAD) {
+    ESPTime c = ESPTime::from_epoch_local(t);
+    int32_t into_hour = c.minute * 60 + c.second;
+    int32_t into_day = c.hour * 3600 + into_hour;
+    if (!this->months_[c.month] || !this->days_of_month_[c.day_of_month] || !this->days_of_week_[c.day_of_week]) {
+      // Skip to the next local midnight. Stop an hour short when possible so that days shortened
+      // by a DST change don't make us overshoot past midnight.
+      int32_t step = 86400 - into_day;
+      t += step > 3600 ? step - 3600 : step;
+      continue;
     }
-
-    while (true) {
-      this->last_check_->increment_second();
-      if (*this->last_check_ >= time)
-        break;
-
-      if (this->matches(*this->last_check_))
-        this->trigger();
+    if (!this->hours_[c.hour]) {
+      t += 3600 - into_hour;
+      continue;
+    }
+    if (!this->minutes_[c.minute]) {
+      int next = next_set_bit(this->minutes_, c.minute + 1, 60);
+      t += next < 0 ? 3600 - into_hour : (next - c.minute) * 60 - c.second;
+      continue;
+    }
+    if (!this->seconds_[c.second]) {
+      int next = next_set_bit(this->seconds_, c.second + 1, 60);
+      t += next < 0 ? 60 - c.second : next - c.second;
+      continue;
     }
+    return t;
   }
-
-  this->last_check_ = time;
+  return {};
+}
+void CronTrigger::process_() {
+  ESPTime time = this->rtc_->now();
+  if (!time.is_valid()) {
+    // Also re-checked on every time sync, this only covers time sources that never report one.
+    this->set_timeout("cron", INVALID_TIME_RETRY, [this]() { this->process_(); });
+    return;
+  }
+  time_t now = time.timestamp;
   if (!time.fields_in_range()) {
     ESP_LOGW(TAG, "Time is out of range!");
     ESP_LOGD(TAG, "Second=%02u Minute=%02u Hour=%02u DayOfWeek=%u DayOfMonth=%u DayOfYear=%u Month=%u time=%" PRId64,
@@ -58,8 +83,40 @@ void CronTrigger::loop() {
              (int64_t) time.timestamp);
   }
 
-  if (this->matches(time))
-    this->trigger();
+  if (!this->last_check_.has_value()) {
+    if (this->matches(time))
+      this->trigger();
+  } else if (*this->last_check_ > now && *this->last_check_ - now > MAX_TIMESTAMP_DRIFT) {
+    // We went back in time (a lot), probably caused by time synchronization
+    ESP_LOGW(TAG, "Time has jumped back!");
+    if (this->matches(time))
+      this->trigger();
+  } else if (*this->last_check_ >= now) {
+    // already handled this one, we were woken early or the clock was adjusted back slightly
+    now = *this->last_check_;
+  } else if (now - *this->last_check_ > MAX_TIMESTAMP_DRIFT) {
+    // We went ahead in time (a lot), probably caused by time synchronization
+    ESP_LOGW(TAG, "Time has jumped ahead!");
+  } else {
+    for (auto next = this->next_match_(*this->last_check_); next.has_value() && *next <= now;
+         next = this->next_match_(*next)) {
+      this->trigger();
+    }
+  }
+
+  this->schedule_(now);
+}
+void CronTrigger::schedule_(time_t now) {
+  auto next = this->next_match_(now);
+  time_t target = next.has_value() ? *next : now + MAX_LOOKAHEAD;
+  // Nothing matches before the target, so the next check can start right there.
+  this->last_check_ = target - 1;
+
+  struct timeval tv;
+  gettimeofday(&tv, nullptr);
+  int64_t delay = (int64_t) (target - tv.tv_sec) * 1000 - tv.tv_usec / 1000;
+  ESP_LOGVV(TAG, "Next check in %" PRId64 "ms", delay);
+  this->set_timeout("cron", delay > 0 ? delay : 0, [this]() { this->process_(); });
 }
 CronTrigger::CronTrigger(RealTimeClock *rtc) : rtc_(rtc) {}
 void CronTrigger::add_seconds(const std::vector<uint8_t> &seconds) {
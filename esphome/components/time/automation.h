@@ -27,10 +27,17 @@ class CronTrigger : public Trigger<>, public Component {
   void add_day_of_week(uint8_t day_of_week);
   void add_days_of_week(const std::vector<uint8_t> &days_of_week);
   bool matches(const ESPTime &time);
-  void loop() override;
+  void setup() override;
   float get_setup_priority() const override;
 
  protected:
+  /// Return the first timestamp strictly after `from` that matches, searching at most MAX_LOOKAHEAD seconds ahead.
+  optional<time_t> next_match_(time_t from);
+  /// Fire every match since the last check and arm a timeout for the next one.
+  void process_();
+  /// Arm a timeout for the next match after `now`.
+  void schedule_(time_t now);
+
   std::bitset<61> seconds_;
   std::bitset<60> minutes_;
   std::bitset<24> hours_;
@@ -38,7 +45,7 @@ class CronTrigger : public Trigger<>, public Component {
   std::bitset<13> months_;
   std::bitset<8> days_of_week_;
   RealTimeClock *rtc_;
-  optional<ESPTime> last_check_;
+  optional<time_t> last_check_;
 };
 
 class SyncTrigger : public Trigger<>, public Component {
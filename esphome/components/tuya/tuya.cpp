@@ -5,6 +5,8 @@
 #include "esphome/core/log.h"
 #include "esphome/core/util.h"
 
+#include <algorithm>
+
 #ifdef USE_WIFI
 #include "esphome/components/wifi/wifi_component.h"
 #endif
@@ -20,6 +22,7 @@ static const char *const TAG = "tuya";
 static const int COMMAND_DELAY = 10;
 static const int RECEIVE_TIMEOUT = 300;
 static const int MAX_RETRIES = 5;
+static const size_t PAYLOAD_POOL_SIZE = 4;
 
 void Tuya::setup() {
   this->set_interval("heartbeat", 15000, [this] { this->send_empty_command_(TuyaCommandType::HEARTBEAT); });
@@ -72,6 +75,12 @@ void Tuya::dump_config() {
   }
   LOG_PIN("  Status Pin: ", this->status_pin_);
   ESP_LOGCONFIG(TAG, "  Product: '%s'", this->product_.c_str());
+  const auto &stats = this->queue_stats_;
+  ESP_LOGCONFIG(TAG,
+                "  Command queue: %" PRIu32 " sent, %" PRIu32 " coalesced, max depth %" PRIu32 ", latency avg %" PRIu32
+                "ms, max %" PRIu32 "ms",
+                stats.sent, stats.coalesced, stats.max_depth, stats.sent == 0 ? 0 : stats.total_latency_ms / stats.sent,
+                stats.max_latency_ms);
 }
 
 bool Tuya::validate_message_() {
@@ -144,7 +153,7 @@ void Tuya::handle_command_(uint8_t command, uint8_t version, const uint8_t *buff
 
   if (this->expected_response_.has_value() && this->expected_response_ == command_type) {
     this->expected_response_.reset();
-    this->command_queue_.erase(command_queue_.begin());
+    this->pop_command_();
     this->init_retries_ = 0;
   }
 
@@ -411,7 +420,7 @@ void Tuya::handle_datapoints_(const uint8_t *buffer, size_t len) {
   }
 }
 
-void Tuya::send_raw_command_(TuyaCommand command) {
+void Tuya::send_raw_command_(const TuyaCommand &command) {
   uint8_t len_hi = (uint8_t) (command.payload.size() >> 8);
   uint8_t len_lo = (uint8_t) (command.payload.size() & 0xFF);
   uint8_t version = 0;
@@ -462,25 +471,47 @@ void Tuya::process_command_queue_() {
       if (++this->init_retries_ >= MAX_RETRIES) {
         this->init_failed_ = true;
         ESP_LOGE(TAG, "Initialization failed at init_state %u", static_cast<uint8_t>(this->init_state_));
-        this->command_queue_.erase(command_queue_.begin());
+        this->pop_command_();
         this->init_retries_ = 0;
       }
     } else {
-      this->command_queue_.erase(command_queue_.begin());
+      this->pop_command_();
     }
   }
 
   // Left check of delay since last command in case there's ever a command sent by calling send_raw_command_ directly
   if (delay > COMMAND_DELAY && !this->command_queue_.empty() && this->rx_message_.empty() &&
       !this->expected_response_.has_value()) {
+    uint32_t latency = now - this->command_queue_.front().queued_at;
+    this->queue_stats_.sent++;
+    this->queue_stats_.total_latency_ms += latency;
+    this->queue_stats_.max_latency_ms = std::max(this->queue_stats_.max_latency_ms, latency);
     this->send_raw_command_(command_queue_.front());
     if (!this->expected_response_.has_value())
-      this->command_queue_.erase(command_queue_.begin());
+      this->pop_command_();
   }
 }
 
-void Tuya::send_command_(const TuyaCommand &command) {
-  command_queue_.push_back(command);
+void Tuya::pop_command_() {
+  auto &payload = this->command_queue_.front().payload;
+  if (payload.capacity() > 0 && this->payload_pool_.size() < PAYLOAD_POOL_SIZE)
+    this->payload_pool_.push_back(std::move(payload));
+  this->command_queue_.erase(this->command_queue_.begin());
+}
+
+std::vector<uint8_t> Tuya::acquire_payload_() {
+  if (this->payload_pool_.empty())
+    return {};
+  std::vector<uint8_t> payload = std::move(this->payload_pool_.back());
+  this->payload_pool_.pop_back();
+  payload.clear();
+  return payload;
+}
+
+void Tuya::send_command_(TuyaCommand command) {
+  command_queue_.push_back(std::move(command));
+  command_queue_.back().queued_at = millis();
+  this->queue_stats_.max_depth = std::max<uint32_t>(this->queue_stats_.max_depth, this->command_queue_.size());
   process_command_queue_();
 }
 
@@ -684,14 +715,31 @@ void Tuya::set_string_datapoint_value_(uint8_t datapoint_id, const std::string &
 }
 
 void Tuya::send_datapoint_command_(uint8_t datapoint_id, TuyaDatapointType datapoint_type, std::vector<uint8_t> data) {
-  std::vector<uint8_t> buffer;
+  std::vector<uint8_t> buffer = this->acquire_payload_();
   buffer.push_back(datapoint_id);
   buffer.push_back(static_cast<uint8_t>(datapoint_type));
   buffer.push_back(data.size() >> 8);
   buffer.push_back(data.size() >> 0);
   buffer.insert(buffer.end(), data.begin(), data.end());
 
-  this->send_command_(TuyaCommand{.cmd = TuyaCommandType::DATAPOINT_DELIVER, .payload = buffer});
+  // Only the latest value matters, so a write to the same datapoint that is still waiting in the queue takes the new
+  // value in place. The first command has been sent already while its response is awaited.
+  size_t first = this->expected_response_.has_value() ? 1 : 0;
+  for (size_t i = first; i < this->command_queue_.size(); i++) {
+    auto &queued = this->command_queue_[i];
+    if (queued.cmd == TuyaCommandType::DATAPOINT_DELIVER && !queued.payload.empty() &&
+        queued.payload[0] == datapoint_id) {
+      ESP_LOGV(TAG, "Replacing queued value of datapoint %u", datapoint_id);
+      // the replaced payload goes back to the pool
+      std::swap(queued.payload, buffer);
+      if (this->payload_pool_.size() < PAYLOAD_POOL_SIZE)
+        this->payload_pool_.push_back(std::move(buffer));
+      this->queue_stats_.coalesced++;
+      return;
+    }
+  }
+
+  this->send_command_(TuyaCommand{.cmd = TuyaCommandType::DATAPOINT_DELIVER, .payload = std::move(buffer)});
 }
 
 void Tuya::register_listener(uint8_t datapoint_id, const std::function<void(TuyaDatapoint)> &func) {
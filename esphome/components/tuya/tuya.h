@@ -83,6 +83,16 @@ enum class TuyaInitState : uint8_t {
 struct TuyaCommand {
   TuyaCommandType cmd;
   std::vector<uint8_t> payload;
+  uint32_t queued_at{0};  ///< millis() when the command was added to the queue
+};
+
+/// Statistics of the command queue, to judge whether the UART link keeps up with the writes.
+struct TuyaQueueStats {
+  uint32_t sent{0};              ///< number of commands sent from the queue
+  uint32_t coalesced{0};         ///< number of datapoint writes that replaced a queued write to the same datapoint
+  uint32_t max_depth{0};         ///< largest number of commands that were queued at once
+  uint32_t max_latency_ms{0};    ///< longest time a command waited in the queue before being sent
+  uint32_t total_latency_ms{0};  ///< sum of the times all sent commands waited in the queue
 };
 
 class Tuya : public Component, public uart::UARTDevice {
@@ -106,6 +116,7 @@ class Tuya : public Component, public uart::UARTDevice {
   void force_set_enum_datapoint_value(uint8_t datapoint_id, uint8_t value);
   void force_set_bitmask_datapoint_value(uint8_t datapoint_id, uint32_t value, uint8_t length);
   TuyaInitState get_init_state();
+  const TuyaQueueStats &get_queue_stats() const { return this->queue_stats_; }
 #ifdef USE_TIME
   void set_time_id(time::RealTimeClock *time_id) { this->time_id_ = time_id; }
 #endif
@@ -123,9 +134,13 @@ class Tuya : public Component, public uart::UARTDevice {
   bool validate_message_();
 
   void handle_command_(uint8_t command, uint8_t version, const uint8_t *buffer, size_t len);
-  void send_raw_command_(TuyaCommand command);
+  void send_raw_command_(const TuyaCommand &command);
   void process_command_queue_();
-  void send_command_(const TuyaCommand &command);
+  void send_command_(TuyaCommand command);
+  /// Remove the first command from the queue, keeping its payload buffer for the next datapoint write.
+  void pop_command_();
+  /// An empty payload buffer, from the pool if there is one.
+  std::vector<uint8_t> acquire_payload_();
   void send_empty_command_(TuyaCommandType command);
   void set_numeric_datapoint_value_(uint8_t datapoint_id, TuyaDatapointType datapoint_type, uint32_t value,
                                     uint8_t length, bool forced);
@@ -157,6 +172,9 @@ class Tuya : public Component, public uart::UARTDevice {
   std::vector<uint8_t> rx_message_;
   std::vector<uint8_t> ignore_mcu_update_on_datapoints_{};
   std::vector<TuyaCommand> command_queue_;
+  /// Payload buffers of commands that left the queue, so that a burst of datapoint writes does not allocate for each.
+  std::vector<std::vector<uint8_t>> payload_pool_;
+  TuyaQueueStats queue_stats_{};
   optional<TuyaCommandType> expected_response_{};
   uint8_t wifi_status_ = -1;
   CallbackManager<void()> initialized_callback_{};
@@ -38,6 +38,8 @@ class UARTDevice {
     return res;
   }
 
+  size_t read_available(uint8_t *data, size_t len) { return this->parent_->read_available(data, len); }
+
   int available() { return this->parent_->available(); }
 
   void flush() { this->parent_->flush(); }
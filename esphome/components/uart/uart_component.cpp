@@ -1,10 +1,22 @@
 #include "uart_component.h"
 
+#include <algorithm>
+
 namespace esphome {
 namespace uart {
 
 static const char *const TAG = "uart";
 
+size_t UARTComponent::read_available(uint8_t *data, size_t len) {
+  int available = this->available();
+  if (available <= 0 || len == 0)
+    return 0;
+  size_t count = std::min(size_t(available), len);
+  if (!this->read_array(data, count))
+    return 0;
+  return count;
+}
+
 bool UARTComponent::check_read_timeout_(size_t len) {
   if (this->available() >= int(len))
     return true;
@@ -67,6 +67,13 @@ class UARTComponent {
   // @return True if the specified number of bytes were successfully read, false otherwise.
   virtual bool read_array(uint8_t *data, size_t len) = 0;
 
+  // Reads the bytes that are already available, up to len, without waiting for more to arrive.
+  // The default implementation uses available() and read_array(), backends override it to read in bulk.
+  // @param data Pointer to the array where the read data will be stored.
+  // @param len Maximum number of bytes to read.
+  // @return Number of bytes read.
+  virtual size_t read_available(uint8_t *data, size_t len);
+
   // Pure virtual method to return the number of bytes available for reading.
   // @return Number of available bytes.
   virtual int available() = 0;
@@ -74,6 +81,13 @@ class UARTComponent {
   // Pure virtual method to block until all bytes have been written to the UART bus.
   virtual void flush() = 0;
 
+  // Enables the loop of a component that reads from this bus whenever data is received, through
+  // Component::enable_loop_soon_any_context(), so it can disable its loop while it waits for data.
+  // Only one component per bus can be woken.
+  // @param component The component to wake.
+  // @return False if this platform can't tell when data arrives, then the component has to keep its loop enabled.
+  virtual bool wake_loop_on_rx(Component *component) { return false; }
+
   // Sets the TX (transmit) pin for the UART bus.
   // @param tx_pin Pointer to the internal GPIO pin used for transmission.
   void set_tx_pin(InternalGPIOPin *tx_pin) { this->tx_pin_ = tx_pin; }
@@ -189,7 +189,29 @@ bool ESP32ArduinoUARTComponent::read_array(uint8_t *data, size_t len) {
   return true;
 }
 
+size_t ESP32ArduinoUARTComponent::read_available(uint8_t *data, size_t len) {
+  size_t count = std::min(size_t(this->hw_serial_->available()), len);
+  if (count == 0)
+    return 0;
+  // all requested bytes are buffered already, so this does not wait
+  this->hw_serial_->readBytes(data, count);
+#ifdef USE_UART_DEBUGGER
+  for (size_t i = 0; i < count; i++) {
+    this->debug_callback_.call(UART_DIRECTION_RX, data[i]);
+  }
+#endif
+  return count;
+}
+
 int ESP32ArduinoUARTComponent::available() { return this->hw_serial_->available(); }
+bool ESP32ArduinoUARTComponent::wake_loop_on_rx(Component *component) {
+  if (this->hw_serial_ == nullptr || this->rx_wake_component_ != nullptr)
+    return false;
+  this->rx_wake_component_ = component;
+  // called from the event task of HardwareSerial
+  this->hw_serial_->onReceive([component]() { component->enable_loop_soon_any_context(); });
+  return true;
+}
 void ESP32ArduinoUARTComponent::flush() {
   ESP_LOGVV(TAG, "    Flushing...");
   this->hw_serial_->flush();
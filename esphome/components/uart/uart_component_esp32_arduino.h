@@ -23,12 +23,15 @@ class ESP32ArduinoUARTComponent : public UARTComponent, public Component {
 
   bool peek_byte(uint8_t *data) override;
   bool read_array(uint8_t *data, size_t len) override;
+  size_t read_available(uint8_t *data, size_t len) override;
 
   int available() override;
   void flush() override;
 
   uint32_t get_config();
 
+  bool wake_loop_on_rx(Component *component) override;
+
   HardwareSerial *get_hw_serial() { return this->hw_serial_; }
   uint8_t get_hw_serial_number() { return this->number_; }
 
@@ -51,6 +54,7 @@ class ESP32ArduinoUARTComponent : public UARTComponent, public Component {
   void check_logger_conflict() override;
 
   HardwareSerial *hw_serial_{nullptr};
+  Component *rx_wake_component_{nullptr};
   uint8_t number_{0};
 };
 
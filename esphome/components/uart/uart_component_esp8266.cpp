@@ -185,6 +185,24 @@ bool ESP8266UartComponent::read_array(uint8_t *data, size_t len) {
 #endif
   return true;
 }
+size_t ESP8266UartComponent::read_available(uint8_t *data, size_t len) {
+  size_t count = std::min(size_t(this->available()), len);
+  if (count == 0)
+    return 0;
+  if (this->hw_serial_ != nullptr) {
+    // all requested bytes are buffered already, so this does not wait
+    this->hw_serial_->readBytes(data, count);
+  } else {
+    for (size_t i = 0; i < count; i++)
+      data[i] = this->sw_serial_->read_byte();
+  }
+#ifdef USE_UART_DEBUGGER
+  for (size_t i = 0; i < count; i++) {
+    this->debug_callback_.call(UART_DIRECTION_RX, data[i]);
+  }
+#endif
+  return count;
+}
 int ESP8266UartComponent::available() {
   if (this->hw_serial_ != nullptr) {
     return this->hw_serial_->available();
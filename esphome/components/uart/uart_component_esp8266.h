@@ -57,6 +57,7 @@ class ESP8266UartComponent : public UARTComponent, public Component {
 
   bool peek_byte(uint8_t *data) override;
   bool read_array(uint8_t *data, size_t len) override;
+  size_t read_available(uint8_t *data, size_t len) override;
 
   int available() override;
   void flush() override;
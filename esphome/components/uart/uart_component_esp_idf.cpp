@@ -221,6 +221,54 @@ bool IDFUARTComponent::read_array(uint8_t *data, size_t len) {
   return true;
 }
 
+size_t IDFUARTComponent::read_available(uint8_t *data, size_t len) {
+  if (len == 0)
+    return 0;
+  size_t count = 0;
+  xSemaphoreTake(this->lock_, portMAX_DELAY);
+  if (this->has_peek_) {
+    data[count++] = this->peek_byte_;
+    this->has_peek_ = false;
+  }
+  size_t buffered;
+  uart_get_buffered_data_len(this->uart_num_, &buffered);
+  size_t to_read = std::min(buffered, len - count);
+  if (to_read > 0) {
+    int res = uart_read_bytes(this->uart_num_, data + count, to_read, 0);
+    if (res > 0)
+      count += res;
+  }
+  xSemaphoreGive(this->lock_);
+#ifdef USE_UART_DEBUGGER
+  for (size_t i = 0; i < count; i++) {
+    this->debug_callback_.call(UART_DIRECTION_RX, data[i]);
+  }
+#endif
+  return count;
+}
+
+bool IDFUARTComponent::wake_loop_on_rx(Component *component) {
+  if (this->uart_event_queue_ == nullptr || this->rx_wake_component_ != nullptr)
+    return false;
+  this->rx_wake_component_ = component;
+  if (xTaskCreate(IDFUARTComponent::rx_event_task, "uart_rx", 2048, this, 1, nullptr) != pdPASS) {
+    ESP_LOGW(TAG, "Could not create the receive event task");
+    this->rx_wake_component_ = nullptr;
+    return false;
+  }
+  return true;
+}
+
+void IDFUARTComponent::rx_event_task(void *param) {
+  auto *uart = static_cast<IDFUARTComponent *>(param);
+  uart_event_t event;
+  while (true) {
+    // Received data, but also overflows and errors, which the reader has to notice and drain
+    if (xQueueReceive(uart->uart_event_queue_, &event, portMAX_DELAY) == pdTRUE)
+      uart->rx_wake_component_->enable_loop_soon_any_context();
+  }
+}
+
 int IDFUARTComponent::available() {
   size_t available;
 
@@ -19,9 +19,11 @@ class IDFUARTComponent : public UARTComponent, public Component {
 
   bool peek_byte(uint8_t *data) override;
   bool read_array(uint8_t *data, size_t len) override;
+  size_t read_available(uint8_t *data, size_t len) override;
 
   int available() override;
   void flush() override;
+  bool wake_loop_on_rx(Component *component) override;
 
   uint8_t get_hw_serial_number() { return this->uart_num_; }
   QueueHandle_t *get_uart_event_queue() { return &this->uart_event_queue_; }
@@ -43,8 +45,12 @@ class IDFUARTComponent : public UARTComponent, public Component {
 
  protected:
   void check_logger_conflict() override;
+  /// Waits for events of the driver and wakes rx_wake_component_, see wake_loop_on_rx().
+  static void rx_event_task(void *param);
+
   uart_port_t uart_num_;
-  QueueHandle_t uart_event_queue_;
+  QueueHandle_t uart_event_queue_{nullptr};
+  Component *rx_wake_component_{nullptr};
   uart_config_t get_config_();
   SemaphoreHandle_t lock_;
 
@@ -263,6 +263,32 @@ bool HostUartComponent::read_array(uint8_t *data, size_t len) {
   return true;
 }
 
+size_t HostUartComponent::read_available(uint8_t *data, size_t len) {
+  if ((this->file_descriptor_ == -1) || (len == 0)) {
+    return 0;
+  }
+  size_t count = 0;
+  if (this->has_peek_) {
+    data[count++] = this->peek_byte_;
+    this->has_peek_ = false;
+  }
+  if (count < len) {
+    // The port is opened non-blocking, so a single read returns whatever is buffered
+    ssize_t sz = ::read(this->file_descriptor_, data + count, len - count);
+    if (sz > 0) {
+      count += sz;
+    } else if (sz == -1 && errno != EAGAIN && errno != EWOULDBLOCK) {
+      this->update_error_(strerror(errno));
+    }
+  }
+#ifdef USE_UART_DEBUGGER
+  for (size_t i = 0; i < count; i++) {
+    this->debug_callback_.call(UART_DIRECTION_RX, data[i]);
+  }
+#endif
+  return count;
+}
+
 int HostUartComponent::available() {
   if (this->file_descriptor_ == -1) {
     return 0;
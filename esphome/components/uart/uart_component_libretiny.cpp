@@ -143,6 +143,20 @@ bool LibreTinyUARTComponent::read_array(uint8_t *data, size_t len) {
   return true;
 }
 
+size_t LibreTinyUARTComponent::read_available(uint8_t *data, size_t len) {
+  size_t count = std::min(size_t(this->serial_->available()), len);
+  if (count == 0)
+    return 0;
+  // all requested bytes are buffered already, so this does not wait
+  this->serial_->readBytes(data, count);
+#ifdef USE_UART_DEBUGGER
+  for (size_t i = 0; i < count; i++) {
+    this->debug_callback_.call(UART_DIRECTION_RX, data[i]);
+  }
+#endif
+  return count;
+}
+
 int LibreTinyUARTComponent::available() { return this->serial_->available(); }
 void LibreTinyUARTComponent::flush() {
   ESP_LOGVV(TAG, "    Flushing...");
@@ -172,6 +172,20 @@ bool RP2040UartComponent::read_array(uint8_t *data, size_t len) {
 #endif
   return true;
 }
+size_t RP2040UartComponent::read_available(uint8_t *data, size_t len) {
+  size_t count = std::min(size_t(this->serial_->available()), len);
+  if (count == 0)
+    return 0;
+  // all requested bytes are buffered already, so this does not wait
+  this->serial_->readBytes(data, count);
+#ifdef USE_UART_DEBUGGER
+  for (size_t i = 0; i < count; i++) {
+    this->debug_callback_.call(UART_DIRECTION_RX, data[i]);
+  }
+#endif
+  return count;
+}
+
 int RP2040UartComponent::available() { return this->serial_->available(); }
 void RP2040UartComponent::flush() {
   ESP_LOGVV(TAG, "    Flushing...");
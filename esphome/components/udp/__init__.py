@@ -34,6 +34,15 @@ CONF_UDP_ID = "udp_id"
 CONF_PING_PONG_ENABLE = "ping_pong_enable"
 CONF_PING_PONG_RECYCLE_TIME = "ping_pong_recycle_time"
 CONF_ROLLING_CODE_ENABLE = "rolling_code_enable"
+CONF_PROTOCOL_VERSION = "protocol_version"
+
+
+def fnv1_hash(string: str) -> int:
+    """The 32 bit hash of a sensor id, as calculated by udp::hash_name() on the device."""
+    hash_ = 2166136261
+    for char in string.encode():
+        hash_ = ((hash_ * 16777619) & 0xFFFFFFFF) ^ char
+    return hash_
 
 
 def sensor_validation(cls: MockObjClass):
@@ -72,6 +81,16 @@ def validate_(config):
             raise cv.Invalid("No sensors or binary sensors to encrypt")
     elif config[CONF_ROLLING_CODE_ENABLE]:
         raise cv.Invalid("Rolling code requires an encryption key")
+    # version 2 identifies sensors by the hash of their id
+    for key in (CONF_SENSORS, CONF_BINARY_SENSORS):
+        hashes = {}
+        for sens_conf in config.get(key, ()):
+            bcst_id = sens_conf.get(CONF_BROADCAST_ID, sens_conf[CONF_ID].id)
+            other = hashes.setdefault(fnv1_hash(bcst_id), bcst_id)
+            if other != bcst_id:
+                raise cv.Invalid(
+                    f"Broadcast ids {other} and {bcst_id} have the same hash, please rename one of them"
+                )
     if config[CONF_PING_PONG_ENABLE]:
         if not any(CONF_ENCRYPTION in p for p in config.get(CONF_PROVIDERS) or ()):
             raise cv.Invalid("Ping-pong requires at least one encrypted provider")
@@ -87,6 +106,8 @@ CONFIG_SCHEMA = cv.All(
             cv.Optional(CONF_ADDRESSES, default=["255.255.255.255"]): cv.ensure_list(
                 cv.ipv4
             ),
+            # version 2 packets can only be decoded by receivers running this or a later release
+            cv.Optional(CONF_PROTOCOL_VERSION, default=1): cv.int_range(min=1, max=2),
             cv.Optional(CONF_ROLLING_CODE_ENABLE, default=False): cv.boolean,
             cv.Optional(CONF_PING_PONG_ENABLE, default=False): cv.boolean,
             cv.Optional(
@@ -128,6 +149,7 @@ async def to_code(config):
     var = cg.new_Pvariable(config[CONF_ID])
     await cg.register_component(var, config)
     cg.add(var.set_port(config[CONF_PORT]))
+    cg.add(var.set_protocol_version(config[CONF_PROTOCOL_VERSION]))
     cg.add(var.set_rolling_code_enable(config[CONF_ROLLING_CODE_ENABLE]))
     cg.add(var.set_ping_pong_enable(config[CONF_PING_PONG_ENABLE]))
     cg.add(
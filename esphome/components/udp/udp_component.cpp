@@ -35,6 +35,16 @@ namespace udp {
  *      name length: 1 byte
  *      name
  *
+ * With protocol version 2, sensors are identified by the FNV-1 hash of their name instead:
+ * repeat:
+ *      SENSOR_ID_KEY: 1 byte
+ *      float value: 4 bytes
+ *      name hash: 4 bytes
+ * repeat:
+ *      BINARY_SENSOR_ID_KEY: 1 byte
+ *      bool value: 1 bytes
+ *      name hash: 4 bytes
+ *
  * Padded to a 4 byte boundary with nulls
  *
  * Structure of a ping request packet:
@@ -112,6 +122,8 @@ enum DataKey {
   BINARY_SENSOR_KEY,
   PING_KEY,
   ROLLING_CODE_KEY,
+  SENSOR_ID_KEY,
+  BINARY_SENSOR_ID_KEY,
 };
 
 static const size_t MAX_PING_KEYS = 4;
@@ -143,6 +155,30 @@ static inline void add(std::vector<uint8_t> &vec, uint16_t data) {
   vec.push_back((uint8_t) (data >> 8));
 }
 static inline void add(std::vector<uint8_t> &vec, DataKey data) { vec.push_back(data); }
+template<typename T> static bool key_less(const RemoteEntity<T> &entity, uint64_t key) { return entity.key < key; }
+
+/// Find a remote sensor by key. Protocol version 1 also sends the id, which then has to match exactly: ids with the
+/// same hash are only reported in setup(), and a sensor that is not configured may have the hash of one that is.
+template<typename T>
+static T *find_remote(std::vector<RemoteEntity<T>> &entities, uint64_t key, const uint8_t *id, size_t id_len) {
+  auto it = std::lower_bound(entities.begin(), entities.end(), key, key_less<T>);
+  for (; it != entities.end() && it->key == key; it++) {
+    if (id == nullptr || (strlen(it->id) == id_len && memcmp(it->id, id, id_len) == 0))
+      return it->sensor;
+  }
+  return nullptr;
+}
+
+template<typename T> static void sort_remote(std::vector<RemoteEntity<T>> &entities) {
+  std::sort(entities.begin(), entities.end(),
+            [](const RemoteEntity<T> &a, const RemoteEntity<T> &b) { return a.key < b.key; });
+  for (size_t i = 1; i < entities.size(); i++) {
+    if (entities[i].key == entities[i - 1].key)
+      ESP_LOGE(TAG, "Sensor ids %s and %s of %s have the same hash", entities[i - 1].id, entities[i].id,
+               entities[i].provider);
+  }
+}
+
 static void add(std::vector<uint8_t> &vec, const char *str) {
   auto len = strlen(str);
   vec.push_back(len);
@@ -166,6 +202,14 @@ void UDPComponent::setup() {
   this->pref_.save(&this->rolling_code_[1]);
   this->ping_key_ = random_uint32();
   ESP_LOGV(TAG, "Rolling code incremented, upper part now %u", (unsigned) this->rolling_code_[1]);
+  std::sort(this->providers_.begin(), this->providers_.end(),
+            [](const Provider &a, const Provider &b) { return a.name_hash < b.name_hash; });
+#ifdef USE_SENSOR
+  sort_remote(this->remote_sensors_);
+#endif
+#ifdef USE_BINARY_SENSOR
+  sort_remote(this->remote_binary_sensors_);
+#endif
 #ifdef USE_SENSOR
   for (auto &sensor : this->sensors_) {
     sensor.sensor->add_on_state_callback([this, &sensor](float x) {
@@ -311,11 +355,21 @@ void UDPComponent::add_binary_data_(uint8_t key, const char *id, bool data) {
   auto len = 1 + 1 + 1 + strlen(id);
   if (len + this->header_.size() + this->data_.size() > MAX_PACKET_SIZE) {
     this->flush_();
+    this->init_data_();
   }
   add(this->data_, key);
   add(this->data_, (uint8_t) data);
   add(this->data_, id);
 }
+void UDPComponent::add_binary_data_(uint8_t key, uint32_t id_hash, bool data) {
+  if (1 + 1 + 4 + this->header_.size() + this->data_.size() > MAX_PACKET_SIZE) {
+    this->flush_();
+    this->init_data_();
+  }
+  add(this->data_, key);
+  add(this->data_, (uint8_t) data);
+  add(this->data_, id_hash);
+}
 void UDPComponent::add_data_(uint8_t key, const char *id, float data) {
   FuData udata{.f32 = data};
   this->add_data_(key, id, udata.u32);
@@ -325,27 +379,55 @@ void UDPComponent::add_data_(uint8_t key, const char *id, uint32_t data) {
   auto len = 4 + 1 + 1 + strlen(id);
   if (len + this->header_.size() + this->data_.size() > MAX_PACKET_SIZE) {
     this->flush_();
+    this->init_data_();
   }
   add(this->data_, key);
   add(this->data_, data);
   add(this->data_, id);
 }
+
+void UDPComponent::add_data_(uint8_t key, uint32_t id_hash, float data) {
+  if (1 + 4 + 4 + this->header_.size() + this->data_.size() > MAX_PACKET_SIZE) {
+    this->flush_();
+    this->init_data_();
+  }
+  FuData udata{.f32 = data};
+  add(this->data_, key);
+  add(this->data_, udata.u32);
+  add(this->data_, id_hash);
+}
 void UDPComponent::send_data_(bool all) {
   if (!this->should_send_ || !network::is_connected())
     return;
   this->init_data_();
 #ifdef USE_SENSOR
   for (auto &sensor : this->sensors_) {
-    if (all || sensor.updated) {
-      sensor.updated = false;
-      this->add_data_(SENSOR_KEY, sensor.id, sensor.sensor->get_state());
+    if (!all && !sensor.updated)
+      continue;
+    sensor.updated = false;
+    // between the periodic full updates only values that changed are sent
+    FuData udata{.f32 = sensor.sensor->get_state()};
+    if (!all && udata.u32 == sensor.last_value)
+      continue;
+    sensor.last_value = udata.u32;
+    if (this->protocol_version_ >= 2) {
+      this->add_data_(SENSOR_ID_KEY, sensor.id_hash, udata.f32);
+    } else {
+      this->add_data_(SENSOR_KEY, sensor.id, udata.f32);
     }
   }
 #endif
 #ifdef USE_BINARY_SENSOR
   for (auto &sensor : this->binary_sensors_) {
-    if (all || sensor.updated) {
-      sensor.updated = false;
+    if (!all && !sensor.updated)
+      continue;
+    sensor.updated = false;
+    if (!all && sensor.sensor->state == sensor.last_value)
+      continue;
+    sensor.last_value = sensor.sensor->state;
+    if (this->protocol_version_ >= 2) {
+      this->add_binary_data_(BINARY_SENSOR_ID_KEY, sensor.id_hash, sensor.sensor->state);
+    } else {
       this->add_binary_data_(BINARY_SENSOR_KEY, sensor.id, sensor.sensor->state);
     }
   }
@@ -474,22 +556,18 @@ void UDPComponent::process_(uint8_t *buf, const size_t len) {
     return;
   }
 
-  if (this->providers_.count(namebuf) == 0) {
+  auto *provider_ptr = this->find_provider_(hash_name(namebuf), namebuf);
+  if (provider_ptr == nullptr) {
     ESP_LOGVV(TAG, "Unknown hostname %s", namebuf);
     return;
   }
-  auto &provider = this->providers_[namebuf];
+  auto &provider = *provider_ptr;
+  uint64_t provider_key = uint64_t(provider.name_hash) << 32;
   // if encryption not used with this host, ping check is pointless since it would be easily spoofed.
   if (provider.encryption_key.empty())
     ping_key_seen = true;
 
   ESP_LOGV(TAG, "Found hostname %s", namebuf);
-#ifdef USE_SENSOR
-  auto &sensors = this->remote_sensors_[namebuf];
-#endif
-#ifdef USE_BINARY_SENSOR
-  auto &binary_sensors = this->remote_binary_sensors_[namebuf];
-#endif
 
   if (!provider.encryption_key.empty()) {
     xxtea_decrypt((uint32_t *) buf, (end - buf) / 4, (uint32_t *) provider.encryption_key.data());
@@ -525,46 +603,75 @@ void UDPComponent::process_(uint8_t *buf, const size_t len) {
       this->resend_ping_key_ = true;
       break;
     }
-    if (byte == BINARY_SENSOR_KEY) {
-      if (end - buf < 3) {
-        ESP_LOGV(TAG, "Binary sensor key requires at least 3 more bytes");
+    uint32_t id_hash;
+    const uint8_t *id = nullptr;
+    if (byte == BINARY_SENSOR_KEY || byte == SENSOR_KEY) {
+      if (end - buf < (byte == SENSOR_KEY ? 6 : 3)) {
+        ESP_LOGV(TAG, "Sensor key %d requires more bytes", byte);
+        return;
+      }
+      rdata.u32 = byte == SENSOR_KEY ? get_uint32(buf) : *buf++;
+      hlen = *buf++;
+      if (end - buf < hlen) {
+        ESP_LOGV(TAG, "Name length of %u not available", hlen);
         return;
       }
-      rdata.u32 = *buf++;
-    } else if (byte == SENSOR_KEY) {
-      if (end - buf < 6) {
-        ESP_LOGV(TAG, "Sensor key requires at least 6 more bytes");
+      id = buf;
+      id_hash = hash_name(buf, hlen);
+      ESP_LOGV(TAG, "Found sensor key %d, id %.*s, data %lX", byte, hlen, buf, (unsigned long) rdata.u32);
+      buf += hlen;
+    } else if (byte == BINARY_SENSOR_ID_KEY || byte == SENSOR_ID_KEY) {
+      if (end - buf < (byte == SENSOR_ID_KEY ? 8 : 5)) {
+        ESP_LOGV(TAG, "Sensor key %d requires more bytes", byte);
         return;
       }
-      rdata.u32 = get_uint32(buf);
+      rdata.u32 = byte == SENSOR_ID_KEY ? get_uint32(buf) : *buf++;
+      id_hash = get_uint32(buf);
+      ESP_LOGV(TAG, "Found sensor key %d, id hash %08X, data %lX", byte, (unsigned) id_hash, (unsigned long) rdata.u32);
     } else {
       ESP_LOGW(TAG, "Unknown key byte %X", byte);
       return;
     }
 
-    hlen = *buf++;
-    if (end - buf < hlen) {
-      ESP_LOGV(TAG, "Name length of %u not available", hlen);
-      return;
-    }
-    memset(namebuf, 0, sizeof namebuf);
-    memcpy(namebuf, buf, hlen);
-    ESP_LOGV(TAG, "Found sensor key %d, id %s, data %lX", byte, namebuf, (unsigned long) rdata.u32);
-    buf += hlen;
 #ifdef USE_SENSOR
-    if (byte == SENSOR_KEY && sensors.count(namebuf) != 0)
-      sensors[namebuf]->publish_state(rdata.f32);
+    if (byte == SENSOR_KEY || byte == SENSOR_ID_KEY) {
+      auto *sensor = find_remote(this->remote_sensors_, provider_key | id_hash, id, hlen);
+      if (sensor != nullptr)
+        sensor->publish_state(rdata.f32);
+    }
 #endif
 #ifdef USE_BINARY_SENSOR
-    if (byte == BINARY_SENSOR_KEY && binary_sensors.count(namebuf) != 0)
-      binary_sensors[namebuf]->publish_state(rdata.u32 != 0);
+    if (byte == BINARY_SENSOR_KEY || byte == BINARY_SENSOR_ID_KEY) {
+      auto *sensor = find_remote(this->remote_binary_sensors_, provider_key | id_hash, id, hlen);
+      if (sensor != nullptr)
+        sensor->publish_state(rdata.u32 != 0);
+    }
 #endif
   }
 }
 
+Provider *UDPComponent::find_provider_(const char *name) {
+  for (auto &provider : this->providers_) {
+    if (strcmp(provider.name, name) == 0)
+      return &provider;
+  }
+  return nullptr;
+}
+
+Provider *UDPComponent::find_provider_(uint32_t name_hash, const char *name) {
+  auto it = std::lower_bound(this->providers_.begin(), this->providers_.end(), name_hash,
+                             [](const Provider &provider, uint32_t hash) { return provider.name_hash < hash; });
+  for (; it != this->providers_.end() && it->name_hash == name_hash; it++) {
+    if (strcmp(it->name, name) == 0)
+      return &*it;
+  }
+  return nullptr;
+}
+
 void UDPComponent::dump_config() {
   ESP_LOGCONFIG(TAG, "UDP:");
   ESP_LOGCONFIG(TAG, "  Port: %u", this->port_);
+  ESP_LOGCONFIG(TAG, "  Protocol version: %u", this->protocol_version_);
   ESP_LOGCONFIG(TAG, "  Encrypted: %s", YESNO(this->is_encrypted_()));
   ESP_LOGCONFIG(TAG, "  Ping-pong: %s", YESNO(this->ping_pong_enable_));
   for (const auto &address : this->addresses_)
@@ -578,15 +685,19 @@ void UDPComponent::dump_config() {
     ESP_LOGCONFIG(TAG, "  Binary Sensor: %s", sensor.id);
 #endif
   for (const auto &host : this->providers_) {
-    ESP_LOGCONFIG(TAG, "  Remote host: %s", host.first.c_str());
-    ESP_LOGCONFIG(TAG, "    Encrypted: %s", YESNO(!host.second.encryption_key.empty()));
+    ESP_LOGCONFIG(TAG, "  Remote host: %s", host.name);
+    ESP_LOGCONFIG(TAG, "    Encrypted: %s", YESNO(!host.encryption_key.empty()));
 #ifdef USE_SENSOR
-    for (const auto &sensor : this->remote_sensors_[host.first.c_str()])
-      ESP_LOGCONFIG(TAG, "    Sensor: %s", sensor.first.c_str());
+    for (const auto &sensor : this->remote_sensors_) {
+      if (strcmp(sensor.provider, host.name) == 0)
+        ESP_LOGCONFIG(TAG, "    Sensor: %s", sensor.id);
+    }
 #endif
 #ifdef USE_BINARY_SENSOR
-    for (const auto &sensor : this->remote_binary_sensors_[host.first.c_str()])
-      ESP_LOGCONFIG(TAG, "    Binary Sensor: %s", sensor.first.c_str());
+    for (const auto &sensor : this->remote_binary_sensors_) {
+      if (strcmp(sensor.provider, host.name) == 0)
+        ESP_LOGCONFIG(TAG, "    Binary Sensor: %s", sensor.id);
+    }
 #endif
   }
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "esphome/core/component.h"
+#include "esphome/core/helpers.h"
 #ifdef USE_SENSOR
 #include "esphome/components/sensor/sensor.h"
 #endif
@@ -13,15 +14,33 @@
 #ifdef USE_SOCKET_IMPL_LWIP_TCP
 #include <WiFiUdp.h>
 #endif
-#include <vector>
+#include <algorithm>
+#include <cstring>
 #include <map>
+#include <string>
+#include <vector>
 
 namespace esphome {
 namespace udp {
 
+/// FNV-1 hash of a device name or sensor id. The bytes are hashed as unsigned values, so the hash is the same on
+/// every platform and matches the one used for config validation, whatever the signedness of char.
+inline uint32_t hash_name(const uint8_t *name, size_t len) {
+  uint32_t hash = 2166136261UL;
+  for (size_t i = 0; i != len; i++) {
+    hash *= 16777619UL;
+    hash ^= name[i];
+  }
+  return hash;
+}
+inline uint32_t hash_name(const char *name) {
+  return hash_name(reinterpret_cast<const uint8_t *>(name), strlen(name));
+}
+
 struct Provider {
   std::vector<uint8_t> encryption_key;
   const char *name;
+  uint32_t name_hash;
   uint32_t last_code[2];
 };
 
@@ -30,6 +49,9 @@ struct Sensor {
   sensor::Sensor *sensor;
   const char *id;
   bool updated;
+  uint32_t id_hash;
+  /// Raw bits of the last value that was sent
+  uint32_t last_value;
 };
 #endif
 #ifdef USE_BINARY_SENSOR
@@ -37,9 +59,19 @@ struct BinarySensor {
   binary_sensor::BinarySensor *sensor;
   const char *id;
   bool updated;
+  uint32_t id_hash;
+  bool last_value;
 };
 #endif
 
+/// A sensor of a provider, looked up by the hashes of the provider's name and the sensor id.
+template<typename T> struct RemoteEntity {
+  uint64_t key;
+  const char *provider;
+  const char *id;
+  T *sensor;
+};
+
 class UDPComponent : public PollingComponent {
  public:
   void setup() override;
@@ -49,43 +81,40 @@ class UDPComponent : public PollingComponent {
 
 #ifdef USE_SENSOR
   void add_sensor(const char *id, sensor::Sensor *sensor) {
-    Sensor st{sensor, id, true};
+    Sensor st{sensor, id, true, hash_name(id), 0};
     this->sensors_.push_back(st);
   }
   void add_remote_sensor(const char *hostname, const char *remote_id, sensor::Sensor *sensor) {
     this->add_provider(hostname);
-    this->remote_sensors_[hostname][remote_id] = sensor;
+    this->remote_sensors_.push_back({remote_key(hostname, remote_id), hostname, remote_id, sensor});
   }
 #endif
 #ifdef USE_BINARY_SENSOR
   void add_binary_sensor(const char *id, binary_sensor::BinarySensor *sensor) {
-    BinarySensor st{sensor, id, true};
+    BinarySensor st{sensor, id, true, hash_name(id), false};
     this->binary_sensors_.push_back(st);
   }
 
   void add_remote_binary_sensor(const char *hostname, const char *remote_id, binary_sensor::BinarySensor *sensor) {
     this->add_provider(hostname);
-    this->remote_binary_sensors_[hostname][remote_id] = sensor;
+    this->remote_binary_sensors_.push_back({remote_key(hostname, remote_id), hostname, remote_id, sensor});
   }
 #endif
   void add_address(const char *addr) { this->addresses_.emplace_back(addr); }
   void set_port(uint16_t port) { this->port_ = port; }
+  /// Version 2 sends the hashes of the sensor ids instead of the ids, and is understood by all receivers.
+  void set_protocol_version(uint8_t version) { this->protocol_version_ = version; }
   float get_setup_priority() const override { return setup_priority::AFTER_WIFI; }
 
   void add_provider(const char *hostname) {
-    if (this->providers_.count(hostname) == 0) {
+    if (this->find_provider_(hostname) == nullptr) {
       Provider provider;
       provider.encryption_key = std::vector<uint8_t>{};
       provider.last_code[0] = 0;
       provider.last_code[1] = 0;
       provider.name = hostname;
-      this->providers_[hostname] = provider;
-#ifdef USE_SENSOR
-      this->remote_sensors_[hostname] = std::map<std::string, sensor::Sensor *>();
-#endif
-#ifdef USE_BINARY_SENSOR
-      this->remote_binary_sensors_[hostname] = std::map<std::string, binary_sensor::BinarySensor *>();
-#endif
+      provider.name_hash = hash_name(hostname);
+      this->providers_.push_back(provider);
     }
   }
 
@@ -94,7 +123,12 @@ class UDPComponent : public PollingComponent {
   void set_ping_pong_enable(bool enable) { this->ping_pong_enable_ = enable; }
   void set_ping_pong_recycle_time(uint32_t recycle_time) { this->ping_pong_recyle_time_ = recycle_time; }
   void set_provider_encryption(const char *name, std::vector<uint8_t> key) {
-    this->providers_[name].encryption_key = std::move(key);
+    this->add_provider(name);
+    this->find_provider_(name)->encryption_key = std::move(key);
+  }
+
+  static uint64_t remote_key(const char *provider, const char *id) {
+    return (uint64_t(hash_name(provider)) << 32) | hash_name(id);
   }
 
  protected:
@@ -103,12 +137,17 @@ class UDPComponent : public PollingComponent {
   void flush_();
   void add_data_(uint8_t key, const char *id, float data);
   void add_data_(uint8_t key, const char *id, uint32_t data);
+  void add_data_(uint8_t key, uint32_t id_hash, float data);
   void increment_code_();
   void add_binary_data_(uint8_t key, const char *id, bool data);
+  void add_binary_data_(uint8_t key, uint32_t id_hash, bool data);
   void init_data_();
+  Provider *find_provider_(const char *name);
+  Provider *find_provider_(uint32_t name_hash, const char *name);
 
   bool updated_{};
   uint16_t port_{18511};
+  uint8_t protocol_version_{1};
   uint32_t ping_key_{};
   uint32_t rolling_code_[2]{};
   bool rolling_code_enable_{};
@@ -134,16 +173,18 @@ class UDPComponent : public PollingComponent {
   std::vector<uint8_t> encryption_key_{};
   std::vector<std::string> addresses_{};
 
+  // The remote sensors are sorted by key in setup(), for a binary search on receive.
 #ifdef USE_SENSOR
   std::vector<Sensor> sensors_{};
-  std::map<std::string, std::map<std::string, sensor::Sensor *>> remote_sensors_{};
+  std::vector<RemoteEntity<sensor::Sensor>> remote_sensors_{};
 #endif
 #ifdef USE_BINARY_SENSOR
   std::vector<BinarySensor> binary_sensors_{};
-  std::map<std::string, std::map<std::string, binary_sensor::BinarySensor *>> remote_binary_sensors_{};
+  std::vector<RemoteEntity<binary_sensor::BinarySensor>> remote_binary_sensors_{};
 #endif
 
-  std::map<std::string, Provider> providers_{};
+  /// Sorted by name hash in setup()
+  std::vector<Provider> providers_{};
   std::vector<uint8_t> ping_header_{};
   std::vector<uint8_t> header_{};
   std::vector<uint8_t> data_{};
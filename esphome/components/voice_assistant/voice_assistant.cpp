@@ -71,7 +71,7 @@ bool VoiceAssistant::start_udp_socket_() {
 }
 
 bool VoiceAssistant::allocate_buffers_() {
-  if (this->send_buffer_ != nullptr) {
+  if (this->stream_reader_.is_attached()) {
     return true;  // Already allocated
   }
 
@@ -86,27 +86,20 @@ bool VoiceAssistant::allocate_buffers_() {
   }
 #endif
 
-  ExternalRAMAllocator<int16_t> allocator(ExternalRAMAllocator<int16_t>::ALLOW_FAILURE);
-  this->input_buffer_ = allocator.allocate(INPUT_BUFFER_SIZE);
-  if (this->input_buffer_ == nullptr) {
-    ESP_LOGW(TAG, "Could not allocate input buffer");
-    return false;
-  }
-
 #ifdef USE_ESP_ADF
   this->vad_instance_ = vad_create(VAD_MODE_4);
-#endif
 
-  this->ring_buffer_ = RingBuffer::create(BUFFER_SIZE * sizeof(int16_t));
-  if (this->ring_buffer_ == nullptr) {
+  if (!this->mic_->get_audio_ring().add_reader(&this->vad_reader_, BUFFER_SIZE * sizeof(int16_t),
+                                               INPUT_BUFFER_SIZE * sizeof(int16_t))) {
     ESP_LOGW(TAG, "Could not allocate ring buffer");
     return false;
   }
+#endif
 
-  ExternalRAMAllocator<uint8_t> send_allocator(ExternalRAMAllocator<uint8_t>::ALLOW_FAILURE);
-  this->send_buffer_ = send_allocator.allocate(SEND_BUFFER_SIZE);
-  if (send_buffer_ == nullptr) {
-    ESP_LOGW(TAG, "Could not allocate send buffer");
+  // audio is sent straight from the ring, in chunks of SEND_BUFFER_SIZE
+  if (!this->mic_->get_audio_ring().add_reader(&this->stream_reader_, BUFFER_SIZE * sizeof(int16_t),
+                                               SEND_BUFFER_SIZE)) {
+    ESP_LOGW(TAG, "Could not allocate ring buffer");
     return false;
   }
 
@@ -114,17 +107,10 @@ bool VoiceAssistant::allocate_buffers_() {
 }
 
 void VoiceAssistant::clear_buffers_() {
-  if (this->send_buffer_ != nullptr) {
-    memset(this->send_buffer_, 0, SEND_BUFFER_SIZE);
-  }
-
-  if (this->input_buffer_ != nullptr) {
-    memset(this->input_buffer_, 0, INPUT_BUFFER_SIZE * sizeof(int16_t));
-  }
-
-  if (this->ring_buffer_ != nullptr) {
-    this->ring_buffer_->reset();
-  }
+  this->stream_reader_.consume_all();
+#ifdef USE_ESP_ADF
+  this->vad_reader_.consume_all();
+#endif
 
 #ifdef USE_SPEAKER
   if (this->speaker_buffer_ != nullptr) {
@@ -138,26 +124,16 @@ void VoiceAssistant::clear_buffers_() {
 }
 
 void VoiceAssistant::deallocate_buffers_() {
-  ExternalRAMAllocator<uint8_t> send_deallocator(ExternalRAMAllocator<uint8_t>::ALLOW_FAILURE);
-  send_deallocator.deallocate(this->send_buffer_, SEND_BUFFER_SIZE);
-  this->send_buffer_ = nullptr;
-
-  if (this->ring_buffer_ != nullptr) {
-    this->ring_buffer_.reset();
-    this->ring_buffer_ = nullptr;
-  }
+  this->mic_->get_audio_ring().remove_reader(&this->stream_reader_);
 
 #ifdef USE_ESP_ADF
+  this->mic_->get_audio_ring().remove_reader(&this->vad_reader_);
   if (this->vad_instance_ != nullptr) {
     vad_destroy(this->vad_instance_);
     this->vad_instance_ = nullptr;
   }
 #endif
 
-  ExternalRAMAllocator<int16_t> input_deallocator(ExternalRAMAllocator<int16_t>::ALLOW_FAILURE);
-  input_deallocator.deallocate(this->input_buffer_, INPUT_BUFFER_SIZE);
-  this->input_buffer_ = nullptr;
-
 #ifdef USE_SPEAKER
   if (this->speaker_buffer_ != nullptr) {
     ExternalRAMAllocator<uint8_t> speaker_deallocator(ExternalRAMAllocator<uint8_t>::ALLOW_FAILURE);
@@ -174,14 +150,8 @@ void VoiceAssistant::reset_conversation_id() {
 
 int VoiceAssistant::read_microphone_() {
   size_t bytes_read = 0;
-  if (this->mic_->is_running()) {  // Read audio into input buffer
-    bytes_read = this->mic_->read(this->input_buffer_, INPUT_BUFFER_SIZE * sizeof(int16_t));
-    if (bytes_read == 0) {
-      memset(this->input_buffer_, 0, INPUT_BUFFER_SIZE * sizeof(int16_t));
-      return 0;
-    }
-    // Write audio into ring buffer
-    this->ring_buffer_->write((void *) this->input_buffer_, bytes_read);
+  if (this->mic_->is_running()) {  // Read audio into the ring shared with other users of the microphone
+    bytes_read = this->mic_->read_to_audio_ring(INPUT_BUFFER_SIZE * sizeof(int16_t));
   } else {
     ESP_LOGD(TAG, "microphone not running");
   }
@@ -242,16 +212,22 @@ void VoiceAssistant::loop() {
     }
 #ifdef USE_ESP_ADF
     case State::WAIT_FOR_VAD: {
+      // only look at audio that arrives from now on
+      this->vad_reader_.consume_all();
       this->read_microphone_();
       ESP_LOGD(TAG, "Waiting for speech...");
       this->set_state_(State::WAITING_FOR_VAD);
       break;
     }
     case State::WAITING_FOR_VAD: {
-      size_t bytes_read = this->read_microphone_();
-      if (bytes_read > 0) {
+      this->read_microphone_();
+      const uint8_t *frame;
+      while ((frame = this->vad_reader_.peek(INPUT_BUFFER_SIZE * sizeof(int16_t))) != nullptr) {
+        // the frame is only read, the VAD API takes a non-const pointer
         vad_state_t vad_state =
-            vad_process(this->vad_instance_, this->input_buffer_, SAMPLE_RATE_HZ, VAD_FRAME_LENGTH_MS);
+            vad_process(this->vad_instance_, reinterpret_cast<int16_t *>(const_cast<uint8_t *>(frame)),
+                        SAMPLE_RATE_HZ, VAD_FRAME_LENGTH_MS);
+        this->vad_reader_.consume(INPUT_BUFFER_SIZE * sizeof(int16_t));
         if (vad_state == VAD_SPEECH) {
           if (this->vad_counter_ < this->vad_threshold_) {
             this->vad_counter_++;
@@ -261,6 +237,7 @@ void VoiceAssistant::loop() {
 
             // Reset for next time
             this->vad_counter_ = 0;
+            break;
           }
         } else {
           if (this->vad_counter_ > 0) {
@@ -310,13 +287,11 @@ void VoiceAssistant::loop() {
     }
     case State::STREAMING_MICROPHONE: {
       this->read_microphone_();
-      size_t available = this->ring_buffer_->available();
-      while (available >= SEND_BUFFER_SIZE) {
-        size_t read_bytes = this->ring_buffer_->read((void *) this->send_buffer_, SEND_BUFFER_SIZE, 0);
+      const uint8_t *data;
+      // send straight from the audio ring, without copying into a message first
+      while ((data = this->stream_reader_.peek(SEND_BUFFER_SIZE)) != nullptr) {
         if (this->audio_mode_ == AUDIO_MODE_API) {
-          api::VoiceAssistantAudio msg;
-          msg.data.assign((char *) this->send_buffer_, read_bytes);
-          this->api_client_->send_voice_assistant_audio(msg);
+          this->api_client_->send_voice_assistant_audio(data, SEND_BUFFER_SIZE);
         } else {
           if (!this->udp_socket_running_) {
             if (!this->start_udp_socket_()) {
@@ -324,10 +299,10 @@ void VoiceAssistant::loop() {
               break;
             }
           }
-          this->socket_->sendto(this->send_buffer_, read_bytes, 0, (struct sockaddr *) &this->dest_addr_,
+          this->socket_->sendto(data, SEND_BUFFER_SIZE, 0, (struct sockaddr *) &this->dest_addr_,
                                 sizeof(this->dest_addr_));
         }
-        available = this->ring_buffer_->available();
+        this->stream_reader_.consume(SEND_BUFFER_SIZE);
       }
 
       break;
@@ -726,7 +701,7 @@ void VoiceAssistant::on_event(const api::VoiceAssistantEventResponse &msg) {
     case api::enums::VOICE_ASSISTANT_RUN_END: {
       ESP_LOGD(TAG, "Assist Pipeline ended");
       if (this->state_ == State::STREAMING_MICROPHONE) {
-        this->ring_buffer_->reset();
+        this->stream_reader_.consume_all();
 #ifdef USE_ESP_ADF
         if (this->use_wake_word_) {
           // No need to stop the microphone since we didn't use the speaker
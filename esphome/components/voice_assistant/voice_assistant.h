@@ -7,7 +7,6 @@
 #include "esphome/core/automation.h"
 #include "esphome/core/component.h"
 #include "esphome/core/helpers.h"
-#include "esphome/core/ring_buffer.h"
 
 #include "esphome/components/api/api_connection.h"
 #include "esphome/components/api/api_pb2.h"
@@ -273,8 +272,11 @@ class VoiceAssistant : public Component {
   vad_handle_t vad_instance_;
   uint8_t vad_threshold_{5};
   uint8_t vad_counter_{0};
+  // Reads frames for the VAD from the audio ring of the microphone, next to stream_reader_
+  microphone::AudioRingReader vad_reader_;
 #endif
-  std::unique_ptr<RingBuffer> ring_buffer_;
+  // Reads the audio to stream from the audio ring of the microphone
+  microphone::AudioRingReader stream_reader_;
 
   bool use_wake_word_;
   uint8_t noise_suppression_level_;
@@ -282,9 +284,6 @@ class VoiceAssistant : public Component {
   float volume_multiplier_;
   uint32_t conversation_timeout_;
 
-  uint8_t *send_buffer_{nullptr};
-  int16_t *input_buffer_{nullptr};
-
   bool continuous_{false};
   bool silence_detection_;
 
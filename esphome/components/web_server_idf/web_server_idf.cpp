@@ -1,6 +1,7 @@
 #ifdef USE_ESP_IDF
 
 #include <cstdarg>
+#include <memory>
 
 #include "esphome/core/log.h"
 #include "esphome/core/helpers.h"
@@ -22,6 +23,9 @@ namespace web_server_idf {
 
 static const char *const TAG = "web_server_idf";
 
+// Size of the parts of a chunked response, a little less than the payload of a full TCP segment.
+static const size_t CHUNK_SIZE = 1400;
+
 void AsyncWebServer::end() {
   if (this->server_) {
     httpd_stop(this->server_);
@@ -147,9 +151,7 @@ std::string AsyncWebServerRequest::url() const {
 
 std::string AsyncWebServerRequest::host() const { return this->get_header("Host").value(); }
 
-void AsyncWebServerRequest::send(AsyncWebServerResponse *response) {
-  httpd_resp_send(*this, response->get_content_data(), response->get_content_size());
-}
+void AsyncWebServerRequest::send(AsyncWebServerResponse *response) { response->send_body(*this); }
 
 void AsyncWebServerRequest::send(int code, const char *content_type, const char *content) {
   this->init_response_(nullptr, code, content_type);
@@ -250,6 +252,26 @@ void AsyncWebServerResponse::addHeader(const char *name, const char *value) {
   httpd_resp_set_hdr(*this->req_, name, value);
 }
 
+void AsyncWebServerResponse::send_body(httpd_req_t *req) {
+  httpd_resp_send(req, this->get_content_data(), this->get_content_size());
+}
+
+void AsyncWebServerResponseChunked::send_body(httpd_req_t *req) {
+  std::unique_ptr<uint8_t[]> buffer(new uint8_t[CHUNK_SIZE]);
+  size_t index = 0;
+  while (true) {
+    size_t len = this->filler_(buffer.get(), CHUNK_SIZE, index);
+    if (len == 0)
+      break;
+    if (httpd_resp_send_chunk(req, reinterpret_cast<const char *>(buffer.get()), len) != ESP_OK) {
+      ESP_LOGW(TAG, "Sending chunk failed");
+      return;
+    }
+    index += len;
+  }
+  httpd_resp_send_chunk(req, nullptr, 0);
+}
+
 void AsyncResponseStream::print(float value) { this->print(to_string(value)); }
 
 void AsyncResponseStream::printf(const char *fmt, ...) {
@@ -40,6 +40,9 @@ class AsyncWebServerResponse {
   virtual const char *get_content_data() const = 0;
   virtual size_t get_content_size() const = 0;
 
+  /// Send the body of the response, after the status and the headers.
+  virtual void send_body(httpd_req_t *req);
+
  protected:
   const AsyncWebServerRequest *req_;
 };
@@ -93,6 +96,23 @@ class AsyncWebServerResponseProgmem : public AsyncWebServerResponse {
   size_t size_;
 };
 
+/// Returns the next part of a chunked response, at most `max_len` bytes at `index` of the body. 0 ends the body.
+using AwsResponseFiller = std::function<size_t(uint8_t *buffer, size_t max_len, size_t index)>;
+
+/// A response that is generated while it is sent, with chunked transfer encoding.
+class AsyncWebServerResponseChunked : public AsyncWebServerResponse {
+ public:
+  AsyncWebServerResponseChunked(const AsyncWebServerRequest *req, AwsResponseFiller filler)
+      : AsyncWebServerResponse(req), filler_(std::move(filler)) {}
+
+  const char *get_content_data() const override { return nullptr; };
+  size_t get_content_size() const override { return 0; };
+  void send_body(httpd_req_t *req) override;
+
+ protected:
+  AwsResponseFiller filler_;
+};
+
 class AsyncWebServerRequest {
   friend class AsyncWebServer;
 
@@ -133,6 +153,13 @@ class AsyncWebServerRequest {
     return res;
   }
   // NOLINTNEXTLINE(readability-identifier-naming)
+  AsyncWebServerResponse *beginChunkedResponse(const char *content_type, AwsResponseFiller filler) {
+    // NOLINTNEXTLINE(cppcoreguidelines-owning-memory)
+    auto *res = new AsyncWebServerResponseChunked(this, std::move(filler));
+    this->init_response_(res, 200, content_type);
+    return res;
+  }
+  // NOLINTNEXTLINE(readability-identifier-naming)
   AsyncResponseStream *beginResponseStream(const char *content_type) {
     auto *res = new AsyncResponseStream(this);  // NOLINT(cppcoreguidelines-owning-memory)
     this->init_response_(res, 200, content_type);
@@ -3,6 +3,8 @@
 #include "esphome/core/version.h"
 #include "esphome/core/hal.h"
 
+#include <algorithm>
+
 #ifdef USE_STATUS_LED
 #include "esphome/components/status_led/status_led.h"
 #endif
@@ -31,6 +33,10 @@ void Application::setup() {
   std::stable_sort(this->components_.begin(), this->components_.end(), [](const Component *a, const Component *b) {
     return a->get_actual_setup_priority() > b->get_actual_setup_priority();
   });
+#ifdef USE_RUNTIME_STATS
+  // Most components are timed for at most two of loop, update and scheduler callbacks
+  this->runtime_stats.init(this->components_.size() * 2);
+#endif
 
   for (uint32_t i = 0; i < this->components_.size(); i++) {
     Component *component = this->components_[i];
@@ -62,13 +68,18 @@ void Application::setup() {
   ESP_LOGI(TAG, "setup() finished successfully!");
   this->schedule_dump_config();
   this->calculate_looping_components_();
+  this->setup_complete_ = true;
 }
 void Application::loop() {
   uint32_t new_app_state = 0;
 
   this->scheduler.call();
   this->feed_wdt();
-  for (Component *component : this->looping_components_) {
+  if (this->has_pending_enable_loop_requests_)
+    this->enable_pending_loops_();
+  auto &active = this->active_looping_components_;
+  for (size_t i = 0; i < active.size();) {
+    Component *component = active[i];
     {
       WarnIfComponentBlockingGuard guard{component};
       component->call();
@@ -76,6 +87,21 @@ void Application::loop() {
     new_app_state |= component->get_component_state();
     this->app_state_ |= new_app_state;
     this->feed_wdt();
+    if (i < active.size() && active[i] == component) {
+      i++;
+    } else {
+      // Loops were enabled or disabled, continue with the first component after this one in loop order
+      i = std::upper_bound(active.begin(), active.end(), component->loop_index_,
+                           [](uint16_t index, Component *other) { return index < other->loop_index_; }) -
+          active.begin();
+    }
+  }
+  // components with a disabled loop still report their status
+  if (this->active_looping_components_.size() != this->looping_components_.size()) {
+    for (auto *component : this->looping_components_) {
+      if (component->loop_disabled_)
+        new_app_state |= component->get_component_state();
+    }
   }
   this->app_state_ = new_app_state;
 
@@ -145,8 +171,49 @@ void Application::run_safe_shutdown_hooks() {
 
 void Application::calculate_looping_components_() {
   for (auto *obj : this->components_) {
-    if (obj->has_overridden_loop())
-      this->looping_components_.push_back(obj);
+    if (!obj->has_overridden_loop())
+      continue;
+    if (std::find(this->main_loop_excluded_.begin(), this->main_loop_excluded_.end(), obj) !=
+        this->main_loop_excluded_.end())
+      continue;
+    obj->loop_index_ = this->looping_components_.size();
+    this->looping_components_.push_back(obj);
+    if (!obj->loop_disabled_)
+      this->active_looping_components_.push_back(obj);
+  }
+}
+
+std::vector<Component *>::iterator Application::find_active_loop_position_(uint16_t loop_index) {
+  auto &active = this->active_looping_components_;
+  return std::lower_bound(active.begin(), active.end(), loop_index,
+                          [](Component *component, uint16_t index) { return component->loop_index_ < index; });
+}
+
+void Application::disable_component_loop_(Component *component) {
+  // not part of the main loop, or the looping components have not been calculated yet
+  if (component->loop_index_ == UINT16_MAX)
+    return;
+  auto it = this->find_active_loop_position_(component->loop_index_);
+  if (it != this->active_looping_components_.end() && *it == component)
+    this->active_looping_components_.erase(it);
+}
+
+void Application::enable_component_loop_(Component *component) {
+  if (component->loop_index_ == UINT16_MAX)
+    return;
+  auto it = this->find_active_loop_position_(component->loop_index_);
+  if (it == this->active_looping_components_.end() || *it != component)
+    this->active_looping_components_.insert(it, component);
+}
+
+void Application::enable_pending_loops_() {
+  // cleared first, so a request made while the components are checked is picked up in the next iteration
+  this->has_pending_enable_loop_requests_ = false;
+  for (auto *component : this->looping_components_) {
+    if (!component->pending_enable_loop_)
+      continue;
+    component->pending_enable_loop_ = false;
+    component->enable_loop();
   }
 }
 
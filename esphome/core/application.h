@@ -7,6 +7,7 @@
 #include "esphome/core/hal.h"
 #include "esphome/core/helpers.h"
 #include "esphome/core/preferences.h"
+#include "esphome/core/runtime_stats.h"
 #include "esphome/core/scheduler.h"
 
 #ifdef USE_BINARY_SENSOR
@@ -243,6 +244,26 @@ class Application {
 
   uint32_t get_app_state() const { return this->app_state_; }
 
+  /// Whether setup() has finished for all components and the main loop is running.
+  bool is_setup_complete() const { return this->setup_complete_; }
+
+  /** Stop calling loop() of this component from the main loop, after setup has finished.
+   *
+   * Used by components that run the loop of other components themselves. Must be called before setup() finishes.
+   */
+  void exclude_from_main_loop(Component *component) { this->main_loop_excluded_.push_back(component); }
+
+  /** Run loop() and the timers of this component on another task instead of the main loop.
+   *
+   * Used by components that call other components from their own task, e.g. priority_loop. That task must call the
+   * component and `scheduler` itself. All moved components share one scheduler. Must be called before setup().
+   */
+  void move_to_task(Component *component, Scheduler *scheduler) {
+    component->runs_on_task_ = true;
+    this->task_scheduler_ = scheduler;
+    this->exclude_from_main_loop(component);
+  }
+
 #ifdef USE_BINARY_SENSOR
   const std::vector<binary_sensor::BinarySensor *> &get_binary_sensors() { return this->binary_sensors_; }
   binary_sensor::BinarySensor *get_binary_sensor_by_key(uint32_t key, bool include_internal = false) {
@@ -460,6 +481,10 @@ class Application {
 #endif
 
   Scheduler scheduler;
+#ifdef USE_RUNTIME_STATS
+  /// Timing of all loop(), update() and scheduler calls into components.
+  RuntimeStats runtime_stats;
+#endif
 
  protected:
   friend Component;
@@ -467,11 +492,25 @@ class Application {
   void register_component_(Component *comp);
 
   void calculate_looping_components_();
+  void disable_component_loop_(Component *component);
+  void enable_component_loop_(Component *component);
+  /// Where the component with this loop index is, or belongs, in the active looping components.
+  std::vector<Component *>::iterator find_active_loop_position_(uint16_t loop_index);
+  /// Enable the loops requested with Component::enable_loop_soon_any_context().
+  void enable_pending_loops_();
 
   void feed_wdt_arch_();
 
   std::vector<Component *> components_{};
+  /// All components with a loop, in the order they are called. Component::loop_index_ is the position in here.
   std::vector<Component *> looping_components_{};
+  /// The looping components with an enabled loop, in the same order.
+  std::vector<Component *> active_looping_components_{};
+  /// Set from any context by Component::enable_loop_soon_any_context(), handled at the start of loop().
+  volatile bool has_pending_enable_loop_requests_{false};
+  std::vector<Component *> main_loop_excluded_{};
+  /// Scheduler of the components moved to another task, see move_to_task().
+  Scheduler *task_scheduler_{nullptr};
 
 #ifdef USE_BINARY_SENSOR
   std::vector<binary_sensor::BinarySensor *> binary_sensors_{};
@@ -547,6 +586,7 @@ class Application {
   uint32_t loop_interval_{16};
   size_t dump_config_at_{SIZE_MAX};
   uint32_t app_state_{0};
+  bool setup_complete_{false};
 };
 
 /// Global storage of Application pointer - only one Application can exist.
@@ -81,6 +81,14 @@ template<typename... Ts> class Condition {
     return this->check_tuple_(tuple, typename gens<sizeof...(Ts)>::type());
   }
 
+  /** Register a callback that is called whenever a state this condition depends on may have changed.
+   *
+   * Lets waiting actions re-check the condition only when its result could be different, instead of on every loop.
+   *
+   * @return false if this condition can't track what it depends on (e.g. lambdas), in which case it must be polled.
+   */
+  virtual bool add_on_dependency_change_callback(const std::function<void()> &callback) { return false; }
+
  protected:
   template<int... S> bool check_tuple_(const std::tuple<Ts...> &tuple, seq<S...> /*unused*/) {
     return this->check(std::get<S>(tuple)...);
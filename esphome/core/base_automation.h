@@ -5,6 +5,7 @@
 #include "esphome/core/defines.h"
 #include "esphome/core/preferences.h"
 
+#include <atomic>
 #include <vector>
 
 namespace esphome {
@@ -21,6 +22,14 @@ template<typename... Ts> class AndCondition : public Condition<Ts...> {
     return true;
   }
 
+  bool add_on_dependency_change_callback(const std::function<void()> &callback) override {
+    for (auto *condition : this->conditions_) {
+      if (!condition->add_on_dependency_change_callback(callback))
+        return false;
+    }
+    return true;
+  }
+
  protected:
   std::vector<Condition<Ts...> *> conditions_;
 };
@@ -37,6 +46,14 @@ template<typename... Ts> class OrCondition : public Condition<Ts...> {
     return false;
   }
 
+  bool add_on_dependency_change_callback(const std::function<void()> &callback) override {
+    for (auto *condition : this->conditions_) {
+      if (!condition->add_on_dependency_change_callback(callback))
+        return false;
+    }
+    return true;
+  }
+
  protected:
   std::vector<Condition<Ts...> *> conditions_;
 };
@@ -45,6 +62,9 @@ template<typename... Ts> class NotCondition : public Condition<Ts...> {
  public:
   explicit NotCondition(Condition<Ts...> *condition) : condition_(condition) {}
   bool check(Ts... x) override { return !this->condition_->check(x...); }
+  bool add_on_dependency_change_callback(const std::function<void()> &callback) override {
+    return this->condition_->add_on_dependency_change_callback(callback);
+  }
 
  protected:
   Condition<Ts...> *condition_;
@@ -62,6 +82,14 @@ template<typename... Ts> class XorCondition : public Condition<Ts...> {
     return result == 1;
   }
 
+  bool add_on_dependency_change_callback(const std::function<void()> &callback) override {
+    for (auto *condition : this->conditions_) {
+      if (!condition->add_on_dependency_change_callback(callback))
+        return false;
+    }
+    return true;
+  }
+
  protected:
   std::vector<Condition<Ts...> *> conditions_;
 };
@@ -312,8 +340,19 @@ template<typename... Ts> class WaitUntilAction : public Action<Ts...>, public Co
 
   TEMPLATABLE_VALUE(uint32_t, timeout_value)
 
+  void setup() override {
+    // The callback runs on whatever task published the state, so the loop is only enabled from the main loop
+    this->track_changes_ = this->condition_->add_on_dependency_change_callback([this]() {
+      this->dependency_changed_ = true;
+      this->enable_loop_soon_any_context();
+    });
+    if (this->num_running_ == 0)
+      this->disable_loop();
+  }
+
   void play_complex(Ts... x) override {
     this->num_running_++;
+    this->dependency_changed_ = false;
     // Check if we can continue immediately.
     if (this->condition_->check(x...)) {
       if (this->num_running_ > 0) {
@@ -328,12 +367,22 @@ template<typename... Ts> class WaitUntilAction : public Action<Ts...>, public Co
       this->set_timeout("timeout", this->timeout_value_.value(x...), f);
     }
 
+    this->enable_loop();
     this->loop();
   }
 
   void loop() override {
-    if (this->num_running_ == 0)
+    if (this->num_running_ == 0) {
+      this->disable_loop();
       return;
+    }
+
+    // Nothing the condition depends on has changed since the last check, so it can't pass yet. The dependency change
+    // callback enables the loop again.
+    if (this->track_changes_ && !this->dependency_changed_.exchange(false)) {
+      this->disable_loop();
+      return;
+    }
 
     if (!this->condition_->check_tuple(this->var_)) {
       return;
@@ -354,6 +403,9 @@ template<typename... Ts> class WaitUntilAction : public Action<Ts...>, public Co
  protected:
   Condition<Ts...> *condition_;
   std::tuple<Ts...> var_{};
+  bool track_changes_{false};
+  /// Set by the dependency change callback, which runs on whatever task published the state.
+  std::atomic<bool> dependency_changed_{false};
 };
 
 template<typename... Ts> class UpdateComponentAction : public Action<Ts...> {
@@ -50,30 +50,32 @@ void Component::setup() {}
 void Component::loop() {}
 
 void Component::set_interval(const std::string &name, uint32_t interval, std::function<void()> &&f) {  // NOLINT
-  App.scheduler.set_interval(this, name, interval, std::move(f));
+  this->get_scheduler_().set_interval(this, name, interval, std::move(f));
 }
 
 bool Component::cancel_interval(const std::string &name) {  // NOLINT
-  return App.scheduler.cancel_interval(this, name);
+  return this->get_scheduler_().cancel_interval(this, name);
 }
 
 void Component::set_retry(const std::string &name, uint32_t initial_wait_time, uint8_t max_attempts,
                           std::function<RetryResult(uint8_t)> &&f, float backoff_increase_factor) {  // NOLINT
-  App.scheduler.set_retry(this, name, initial_wait_time, max_attempts, std::move(f), backoff_increase_factor);
+  this->get_scheduler_().set_retry(this, name, initial_wait_time, max_attempts, std::move(f), backoff_increase_factor);
 }
 
 bool Component::cancel_retry(const std::string &name) {  // NOLINT
-  return App.scheduler.cancel_retry(this, name);
+  return this->get_scheduler_().cancel_retry(this, name);
 }
 
 void Component::set_timeout(const std::string &name, uint32_t timeout, std::function<void()> &&f) {  // NOLINT
-  App.scheduler.set_timeout(this, name, timeout, std::move(f));
+  this->get_scheduler_().set_timeout(this, name, timeout, std::move(f));
 }
 
 bool Component::cancel_timeout(const std::string &name) {  // NOLINT
-  return App.scheduler.cancel_timeout(this, name);
+  return this->get_scheduler_().cancel_timeout(this, name);
 }
 
+Scheduler &Component::get_scheduler_() { return this->runs_on_task_ ? *App.task_scheduler_ : App.scheduler; }
+
 void Component::call_loop() { this->loop(); }
 void Component::call_setup() { this->setup(); }
 void Component::call_dump_config() {
@@ -122,23 +124,23 @@ void Component::mark_failed() {
   this->status_set_error();
 }
 void Component::defer(std::function<void()> &&f) {  // NOLINT
-  App.scheduler.set_timeout(this, "", 0, std::move(f));
+  this->get_scheduler_().set_timeout(this, "", 0, std::move(f));
 }
 bool Component::cancel_defer(const std::string &name) {  // NOLINT
-  return App.scheduler.cancel_timeout(this, name);
+  return this->get_scheduler_().cancel_timeout(this, name);
 }
 void Component::defer(const std::string &name, std::function<void()> &&f) {  // NOLINT
-  App.scheduler.set_timeout(this, name, 0, std::move(f));
+  this->get_scheduler_().set_timeout(this, name, 0, std::move(f));
 }
 void Component::set_timeout(uint32_t timeout, std::function<void()> &&f) {  // NOLINT
-  App.scheduler.set_timeout(this, "", timeout, std::move(f));
+  this->get_scheduler_().set_timeout(this, "", timeout, std::move(f));
 }
 void Component::set_interval(uint32_t interval, std::function<void()> &&f) {  // NOLINT
-  App.scheduler.set_interval(this, "", interval, std::move(f));
+  this->get_scheduler_().set_interval(this, "", interval, std::move(f));
 }
 void Component::set_retry(uint32_t initial_wait_time, uint8_t max_attempts, std::function<RetryResult(uint8_t)> &&f,
                           float backoff_increase_factor) {  // NOLINT
-  App.scheduler.set_retry(this, "", initial_wait_time, max_attempts, std::move(f), backoff_increase_factor);
+  this->get_scheduler_().set_retry(this, "", initial_wait_time, max_attempts, std::move(f), backoff_increase_factor);
 }
 bool Component::is_failed() const { return (this->component_state_ & COMPONENT_STATE_MASK) == COMPONENT_STATE_FAILED; }
 bool Component::is_ready() const {
@@ -191,6 +193,23 @@ float Component::get_actual_setup_priority() const {
 }
 void Component::set_setup_priority(float priority) { this->setup_priority_override_ = priority; }
 
+void Component::disable_loop() {
+  if (this->loop_disabled_)
+    return;
+  this->loop_disabled_ = true;
+  App.disable_component_loop_(this);
+}
+void Component::enable_loop() {
+  if (!this->loop_disabled_)
+    return;
+  this->loop_disabled_ = false;
+  App.enable_component_loop_(this);
+}
+void IRAM_ATTR Component::enable_loop_soon_any_context() {
+  // Only flags are written here, the main loop enables the loop at the start of its next iteration
+  this->pending_enable_loop_ = true;
+  App.has_pending_enable_loop_requests_ = true;
+}
 bool Component::has_overridden_loop() const {
 #if defined(USE_HOST) || defined(CLANG_TIDY)
   bool loop_overridden = true;
@@ -228,9 +247,17 @@ void PollingComponent::stop_poller() {
 uint32_t PollingComponent::get_update_interval() const { return this->update_interval_; }
 void PollingComponent::set_update_interval(uint32_t update_interval) { this->update_interval_ = update_interval; }
 
-WarnIfComponentBlockingGuard::WarnIfComponentBlockingGuard(Component *component)
-    : started_(millis()), component_(component) {}
+WarnIfComponentBlockingGuard::WarnIfComponentBlockingGuard(Component *component, RuntimeStatsKind kind)
+    : started_(millis()), component_(component) {
+#ifdef USE_RUNTIME_STATS
+  this->started_us_ = micros();
+  this->kind_ = kind;
+#endif
+}
 WarnIfComponentBlockingGuard::~WarnIfComponentBlockingGuard() {
+#ifdef USE_RUNTIME_STATS
+  App.runtime_stats.record(this->component_, this->kind_, micros() - this->started_us_);
+#endif
   uint32_t now = millis();
   if (now - started_ > 50) {
     const char *src = component_ == nullptr ? "<null>" : component_->get_component_source();
@@ -6,9 +6,12 @@
 #include <string>
 
 #include "esphome/core/optional.h"
+#include "esphome/core/runtime_stats.h"
 
 namespace esphome {
 
+class Scheduler;
+
 /** Default setup priorities for components of different types.
  *
  * Components should return one of these setup priorities in get_setup_priority.
@@ -142,6 +145,16 @@ class Component {
 
   bool has_overridden_loop() const;
 
+  /// Whether loop() is called from the main loop, see disable_loop().
+  bool is_loop_enabled() const { return !this->loop_disabled_; }
+
+  /** Like enable_loop(), but safe to call from other tasks and from interrupts.
+   *
+   * The loop is enabled at the start of the next main loop iteration, e.g. from callbacks of sensors that may publish
+   * from their own task, or of a UART that received data.
+   */
+  void enable_loop_soon_any_context();
+
   /** Set where this component was loaded from for some debug messages.
    *
    * This is set by the ESPHome core, and should not be called manually.
@@ -160,6 +173,19 @@ class Component {
   virtual void call_setup();
   virtual void call_dump_config();
 
+  /// The scheduler that runs the timers of this component, see Application::move_to_task().
+  Scheduler &get_scheduler_();
+
+  /** Stop calling loop() from the main loop until enable_loop() is called.
+   *
+   * For components that only have work to do occasionally, e.g. while waiting for something. The other components
+   * keep their order. Both calls must be made from the main loop task, and can be made at any time, also from within
+   * loop() or before setup has finished.
+   */
+  void disable_loop();
+  /// Call loop() from the main loop again after disable_loop(), does nothing if the loop is enabled.
+  void enable_loop();
+
   /** Set an interval function with a unique name. Empty name means no cancelling possible.
    *
    * This will call f every interval ms. Can be cancelled via CancelInterval().
@@ -270,6 +296,13 @@ class Component {
   bool cancel_defer(const std::string &name);  // NOLINT
 
   uint32_t component_state_{0x0000};  ///< State of this component.
+  /// Position of this component in the looping components of the application, see Application::loop().
+  uint16_t loop_index_{UINT16_MAX};
+  bool loop_disabled_{false};
+  /// Set by enable_loop_soon_any_context(), cleared by the main loop when it enabled the loop.
+  volatile bool pending_enable_loop_{false};
+  /// Set by Application::move_to_task(): loop() and the timers of this component run on another task.
+  bool runs_on_task_{false};
   float setup_priority_override_{NAN};
   const char *component_source_{nullptr};
 };
@@ -321,12 +354,16 @@ class PollingComponent : public Component {
 
 class WarnIfComponentBlockingGuard {
  public:
-  WarnIfComponentBlockingGuard(Component *component);
+  WarnIfComponentBlockingGuard(Component *component, RuntimeStatsKind kind = RuntimeStatsKind::LOOP);
   ~WarnIfComponentBlockingGuard();
 
  protected:
   uint32_t started_;
   Component *component_;
+#ifdef USE_RUNTIME_STATS
+  uint32_t started_us_;
+  RuntimeStatsKind kind_;
+#endif
 };
 
 }  // namespace esphome
@@ -17,6 +17,7 @@
 // Feature flags
 #define USE_ALARM_CONTROL_PANEL
 #define USE_API
+#define USE_API_ENTITY_CACHE
 #define USE_API_NOISE
 #define USE_API_PLAINTEXT
 #define USE_BINARY_SENSOR
@@ -67,6 +68,7 @@
 #define USE_OUTPUT
 #define USE_POWER_SUPPLY
 #define USE_QR_CODE
+#define USE_RUNTIME_STATS
 #define USE_SELECT
 #define USE_SENSOR
 #define USE_STATUS_LED
@@ -34,6 +34,20 @@ class ESPPreferenceObject {
   ESPPreferenceBackend *backend_{nullptr};
 };
 
+/// Counters that show how many preference saves actually end up in flash.
+struct ESPPreferencesStats {
+  /// Number of save() calls.
+  uint32_t saves{0};
+  /// Saves that were dropped because the value didn't change.
+  uint32_t unchanged{0};
+  /// Entries written to flash.
+  uint32_t writes{0};
+  /// Bytes written to flash, including per-entry overhead of the backend.
+  uint32_t bytes_written{0};
+  /// Calls to sync() that wrote at least one entry.
+  uint32_t commits{0};
+};
+
 class ESPPreferences {
  public:
   virtual ESPPreferenceObject make_preference(size_t length, uint32_t type, bool in_flash) = 0;
@@ -54,6 +68,9 @@ class ESPPreferences {
    */
   virtual bool reset() = 0;
 
+  /// Get the write statistics of this backend, all zero if the backend doesn't track them.
+  virtual ESPPreferencesStats get_stats() { return {}; }
+
   template<typename T, enable_if_t<is_trivially_copyable<T>::value, bool> = true>
   ESPPreferenceObject make_preference(uint32_t type, bool in_flash) {
     return this->make_preference(sizeof(T), type, in_flash);
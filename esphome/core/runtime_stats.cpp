@@ -0,0 +1,133 @@
+#include "esphome/core/runtime_stats.h"
+
+#ifdef USE_RUNTIME_STATS
+
+namespace esphome {
+
+void RuntimeStatsEntry::record(uint32_t duration_us) {
+  this->count++;
+  this->total_us += duration_us;
+  if (duration_us < this->min_us)
+    this->min_us = duration_us;
+  if (duration_us > this->max_us)
+    this->max_us = duration_us;
+
+  uint8_t bucket = 0;
+  for (uint32_t rest = duration_us >> 4; rest != 0 && bucket < BUCKETS - 1; rest >>= 1)
+    bucket++;
+  if (this->buckets[bucket] == UINT16_MAX) {
+    // Halve all buckets instead of saturating, this keeps the shape of the distribution
+    for (auto &b : this->buckets)
+      b >>= 1;
+  }
+  this->buckets[bucket]++;
+}
+
+uint32_t RuntimeStatsEntry::average_us() const {
+  if (this->count == 0)
+    return 0;
+  return this->total_us / this->count;
+}
+
+uint32_t RuntimeStatsEntry::percentile_us(uint8_t percentile) const {
+  uint32_t total = 0;
+  for (auto b : this->buckets)
+    total += b;
+  if (total == 0)
+    return 0;
+
+  uint32_t target = (total * percentile + 99) / 100;
+  uint32_t seen = 0;
+  for (uint8_t i = 0; i < BUCKETS - 1; i++) {
+    seen += this->buckets[i];
+    if (seen >= target) {
+      uint32_t upper = (1UL << (i + 4)) - 1;
+      return upper < this->max_us ? upper : this->max_us;
+    }
+  }
+  return this->max_us;
+}
+
+void RuntimeStats::init(size_t capacity) {
+  LockGuard guard(this->lock_);
+  // Keep the table at most half full so probe sequences stay short
+  size_t size = 1;
+  while (size < capacity * 2)
+    size <<= 1;
+  this->entries_.resize(size);
+}
+
+void RuntimeStats::record(const Component *component, RuntimeStatsKind kind, uint32_t duration_us) {
+  if (component == nullptr)
+    return;
+  LockGuard guard(this->lock_);
+  if (this->entries_.empty())
+    return;
+
+  const size_t mask = this->entries_.size() - 1;
+  size_t index = ((reinterpret_cast<uintptr_t>(component) >> 2) * 31 + static_cast<uint8_t>(kind)) & mask;
+  for (size_t probe = 0; probe <= mask; probe++) {
+    auto &entry = this->entries_[index];
+    if (entry.component == component && entry.kind == kind) {
+      entry.record(duration_us);
+      return;
+    }
+    if (entry.component == nullptr) {
+      if (this->used_ * 4 >= this->entries_.size() * 3)
+        break;
+      entry.component = component;
+      entry.kind = kind;
+      this->used_++;
+      entry.record(duration_us);
+      return;
+    }
+    index = (index + 1) & mask;
+  }
+  this->dropped_++;
+}
+
+void RuntimeStats::reset() {
+  LockGuard guard(this->lock_);
+  this->reset_();
+}
+
+RuntimeStatsSnapshot RuntimeStats::snapshot(bool reset) {
+  RuntimeStatsSnapshot snapshot;
+  LockGuard guard(this->lock_);
+  for (const auto &entry : this->entries_) {
+    if (entry.component != nullptr && entry.count != 0)
+      snapshot.entries.push_back(entry);
+  }
+  snapshot.dropped = this->dropped_;
+  if (reset)
+    this->reset_();
+  return snapshot;
+}
+
+void RuntimeStats::reset_() {
+  for (auto &entry : this->entries_) {
+    const Component *component = entry.component;
+    RuntimeStatsKind kind = entry.kind;
+    entry = RuntimeStatsEntry{};
+    entry.component = component;
+    entry.kind = kind;
+  }
+  this->dropped_ = 0;
+}
+
+const char *runtime_stats_kind_to_string(RuntimeStatsKind kind) {
+  switch (kind) {
+    case RuntimeStatsKind::LOOP:
+      return "loop";
+    case RuntimeStatsKind::UPDATE:
+      return "update";
+    case RuntimeStatsKind::SCHEDULER:
+      return "scheduler";
+    default:
+      return "unknown";
+  }
+}
+
+}  // namespace esphome
+
+#endif  // USE_RUNTIME_STATS
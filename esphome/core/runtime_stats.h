@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "esphome/core/defines.h"
+#include "esphome/core/helpers.h"
+
+namespace esphome {
+
+class Component;
+
+/// The kind of call into a component that is being timed.
+enum class RuntimeStatsKind : uint8_t {
+  LOOP = 0,
+  UPDATE = 1,
+  SCHEDULER = 2,
+};
+
+#ifdef USE_RUNTIME_STATS
+
+/// Timing histogram of one kind of call into one component.
+struct RuntimeStatsEntry {
+  static const uint8_t BUCKETS = 16;
+
+  const Component *component{nullptr};
+  RuntimeStatsKind kind{RuntimeStatsKind::LOOP};
+  uint32_t count{0};
+  uint32_t min_us{UINT32_MAX};
+  uint32_t max_us{0};
+  uint64_t total_us{0};
+  /// Bucket 0 counts calls that took less than 16us, bucket i counts calls that took [2^(i+3), 2^(i+4)) us.
+  /// The last bucket also counts everything longer.
+  uint16_t buckets[BUCKETS]{};
+
+  void record(uint32_t duration_us);
+  uint32_t average_us() const;
+  /// Estimate a percentile (0-100) of the call duration, as the upper bound of the bucket it falls into.
+  uint32_t percentile_us(uint8_t percentile) const;
+};
+
+/// A consistent copy of the recorded timings.
+struct RuntimeStatsSnapshot {
+  /// Only the entries that recorded at least one call.
+  std::vector<RuntimeStatsEntry> entries;
+  uint32_t dropped{0};
+};
+
+/** Fixed-size table of per-component timing histograms.
+ *
+ * The table is a hash table on the component and kind, allocated once during setup. Calls into components that
+ * don't fit in the table anymore are only counted as dropped.
+ *
+ * Calls are recorded from every task that runs components (e.g. priority_loop), so all access goes through a mutex.
+ */
+class RuntimeStats {
+ public:
+  /// Allocate room for at least `capacity` entries, must be called before anything can be recorded.
+  void init(size_t capacity);
+  void record(const Component *component, RuntimeStatsKind kind, uint32_t duration_us);
+  /// Clear all recorded timings, keeping the table layout.
+  void reset();
+  /// Copy the recorded timings, and optionally reset them in the same step so that no call is lost in between.
+  RuntimeStatsSnapshot snapshot(bool reset = false);
+
+ protected:
+  void reset_();
+
+  Mutex lock_;
+  std::vector<RuntimeStatsEntry> entries_;
+  size_t used_{0};
+  uint32_t dropped_{0};
+};
+
+const char *runtime_stats_kind_to_string(RuntimeStatsKind kind);
+
+#endif  // USE_RUNTIME_STATS
+
+}  // namespace esphome
@@ -230,7 +230,15 @@ void HOT Scheduler::call() {
       //  - timeouts/intervals get added, potentially invalidating vector pointers
       //  - timeouts/intervals get cancelled
       {
-        WarnIfComponentBlockingGuard guard{item->component};
+#ifdef USE_RUNTIME_STATS
+        // PollingComponent runs update() from the interval named "update"
+        RuntimeStatsKind kind = item->type == SchedulerItem::INTERVAL && item->name == "update"
+                                    ? RuntimeStatsKind::UPDATE
+                                    : RuntimeStatsKind::SCHEDULER;
+#else
+        RuntimeStatsKind kind = RuntimeStatsKind::SCHEDULER;
+#endif
+        WarnIfComponentBlockingGuard guard{item->component, kind};
         item->callback();
       }
     }
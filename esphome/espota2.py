@@ -4,6 +4,7 @@ import gzip
 import hashlib
 import io
 import logging
+from pathlib import Path
 import random
 import socket
 import sys
@@ -11,6 +12,7 @@ import time
 
 from esphome.core import EsphomeError
 from esphome.helpers import resolve_ip_address
+from esphome.ota_delta import apply_delta, make_delta
 
 RESPONSE_OK = 0x00
 RESPONSE_REQUEST_AUTH = 0x01
@@ -23,6 +25,7 @@ RESPONSE_RECEIVE_OK = 0x44
 RESPONSE_UPDATE_END_OK = 0x45
 RESPONSE_SUPPORTS_COMPRESSION = 0x46
 RESPONSE_CHUNK_OK = 0x47
+RESPONSE_SUPPORTS_DELTA = 0x48
 
 RESPONSE_ERROR_MAGIC = 0x80
 RESPONSE_ERROR_UPDATE_PREPARE = 0x81
@@ -36,6 +39,7 @@ RESPONSE_ERROR_ESP8266_NOT_ENOUGH_SPACE = 0x88
 RESPONSE_ERROR_ESP32_NOT_ENOUGH_SPACE = 0x89
 RESPONSE_ERROR_NO_UPDATE_PARTITION = 0x8A
 RESPONSE_ERROR_MD5_MISMATCH = 0x8B
+RESPONSE_ERROR_INVALID_DELTA = 0x8D
 RESPONSE_ERROR_UNKNOWN = 0xFF
 
 OTA_VERSION_1_0 = 1
@@ -44,6 +48,17 @@ OTA_VERSION_2_0 = 2
 MAGIC_BYTES = [0x6C, 0x26, 0xF7, 0x5C, 0x45]
 
 FEATURE_SUPPORTS_COMPRESSION = 0x01
+FEATURE_SUPPORTS_DELTA = 0x02
+
+DELTA_FLAG_SUPPORTS_COMPRESSION = 0x01
+UPLOAD_MODE_FULL = 0x00
+UPLOAD_MODE_DELTA = 0x01
+
+# Images that were uploaded are kept next to the firmware, as sources for delta updates
+OTA_HISTORY_DIR = "ota_history"
+OTA_HISTORY_SIZE = 4
+# A delta is only sent when it is smaller than this part of the image
+DELTA_MAX_RATIO = 0.8
 
 
 UPLOAD_BLOCK_SIZE = 8192
@@ -171,6 +186,11 @@ def check_error(data, expect):
             "Error: Application MD5 code mismatch. Please try again "
             "or flash over USB with a good quality cable."
         )
+    if dat == RESPONSE_ERROR_INVALID_DELTA:
+        raise OTAError(
+            "Error: The delta update does not match the running firmware. Please try "
+            "again, or delete the ota_history folder next to the firmware."
+        )
     if dat == RESPONSE_ERROR_UNKNOWN:
         raise OTAError("Unknown error from ESP")
     if not isinstance(expect, (list, tuple)):
@@ -193,6 +213,49 @@ def send_check(sock, data, msg):
         raise OTAError(f"Error sending {msg}: {err}") from err
 
 
+def _history_path(filename: str) -> Path:
+    return Path(filename).parent / OTA_HISTORY_DIR
+
+
+def load_history_image(filename: str, md5: str) -> bytes | None:
+    """Return an image that was uploaded before from ``filename``, by its MD5."""
+    path = _history_path(filename) / f"{md5}.bin"
+    if not path.is_file():
+        return None
+    return path.read_bytes()
+
+
+def store_history_image(filename: str, contents: bytes) -> None:
+    """Keep an uploaded image, so the next update can be sent as a delta against it."""
+    path = _history_path(filename)
+    try:
+        path.mkdir(exist_ok=True)
+        (path / f"{hashlib.md5(contents).hexdigest()}.bin").write_bytes(contents)
+        images = sorted(path.glob("*.bin"), key=lambda p: p.stat().st_mtime)
+        for image in images[:-OTA_HISTORY_SIZE]:
+            image.unlink()
+    except OSError as err:
+        _LOGGER.debug("Could not store image for delta updates: %s", err)
+
+
+def make_upload_delta(
+    filename: str, running_md5: str, file_contents: bytes
+) -> bytes | None:
+    """Create a delta of the image against the running one, if it is known and the delta is worth it."""
+    source = load_history_image(filename, running_md5)
+    if source is None:
+        _LOGGER.debug("Running image %s is not known, sending full image", running_md5)
+        return None
+    patch = make_delta(source, file_contents)
+    if apply_delta(source, patch) != file_contents:
+        _LOGGER.warning("Delta does not reproduce the image, sending full image")
+        return None
+    if len(patch) > len(file_contents) * DELTA_MAX_RATIO:
+        _LOGGER.debug("Delta of %s bytes is too large, sending full image", len(patch))
+        return None
+    return patch
+
+
 def perform_ota(
     sock: socket.socket, password: str, file_handle: io.IOBase, filename: str
 ) -> None:
@@ -213,17 +276,16 @@ def perform_ota(
         )
 
     # Features
-    send_check(sock, FEATURE_SUPPORTS_COMPRESSION, "features")
+    send_check(
+        sock, FEATURE_SUPPORTS_COMPRESSION | FEATURE_SUPPORTS_DELTA, "features"
+    )
     features = receive_exactly(
-        sock, 1, "features", [RESPONSE_HEADER_OK, RESPONSE_SUPPORTS_COMPRESSION]
+        sock,
+        1,
+        "features",
+        [RESPONSE_HEADER_OK, RESPONSE_SUPPORTS_COMPRESSION, RESPONSE_SUPPORTS_DELTA],
     )[0]
 
-    if features == RESPONSE_SUPPORTS_COMPRESSION:
-        upload_contents = gzip.compress(file_contents, compresslevel=9)
-        _LOGGER.info("Compressed to %s bytes", len(upload_contents))
-    else:
-        upload_contents = file_contents
-
     (auth,) = receive_exactly(
         sock, 1, "auth", [RESPONSE_REQUEST_AUTH, RESPONSE_AUTH_OK]
     )
@@ -249,17 +311,44 @@ def perform_ota(
         send_check(sock, result, "auth result")
         receive_exactly(sock, 1, "auth result", RESPONSE_AUTH_OK)
 
+    patch = None
+    if features == RESPONSE_SUPPORTS_DELTA:
+        # the device only describes its running image after authentication
+        delta_flags = receive_exactly(sock, 1, "delta flags", [], decode=False)[0]
+        running_md5 = receive_exactly(
+            sock, 32, "running image MD5", [], decode=False
+        ).decode()
+        _LOGGER.debug("MD5 of running image is %s", running_md5)
+        if delta_flags & DELTA_FLAG_SUPPORTS_COMPRESSION:
+            features = RESPONSE_SUPPORTS_COMPRESSION
+        patch = make_upload_delta(filename, running_md5, file_contents)
+        send_check(
+            sock,
+            UPLOAD_MODE_FULL if patch is None else UPLOAD_MODE_DELTA,
+            "upload mode",
+        )
+
+    if patch is not None:
+        upload_contents = patch
+        _LOGGER.info("Sending delta of %s bytes", len(upload_contents))
+    elif features == RESPONSE_SUPPORTS_COMPRESSION:
+        upload_contents = gzip.compress(file_contents, compresslevel=9)
+        _LOGGER.info("Compressed to %s bytes", len(upload_contents))
+    else:
+        upload_contents = file_contents
+
     upload_size = len(upload_contents)
-    upload_size_encoded = [
-        (upload_size >> 24) & 0xFF,
-        (upload_size >> 16) & 0xFF,
-        (upload_size >> 8) & 0xFF,
-        (upload_size >> 0) & 0xFF,
-    ]
+    upload_size_encoded = upload_size.to_bytes(4, "big")
+    if patch is not None:
+        # the device prepares for the size of the image that is reconstructed
+        upload_size_encoded += file_size.to_bytes(4, "big")
     send_check(sock, upload_size_encoded, "binary size")
     receive_exactly(sock, 1, "binary size", RESPONSE_UPDATE_PREPARE_OK)
 
-    upload_md5 = hashlib.md5(upload_contents).hexdigest()
+    # the image is checked after it was reconstructed from a delta
+    upload_md5 = hashlib.md5(
+        file_contents if patch is not None else upload_contents
+    ).hexdigest()
     _LOGGER.debug("MD5 of upload is %s", upload_md5)
 
     send_check(sock, upload_md5, "file checksum")
@@ -305,6 +394,7 @@ def perform_ota(
     send_check(sock, RESPONSE_OK, "end acknowledgement")
 
     _LOGGER.info("OTA successful")
+    store_history_image(filename, file_contents)
 
     # Do not connect logs until it is fully on
     time.sleep(1)
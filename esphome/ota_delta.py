@@ -0,0 +1,124 @@
+"""Delta patches for OTA updates, reconstructed on the device from the running image.
+
+A patch starts with the magic bytes ``ESPD`` and a version byte, followed by
+operations. All numbers are unsigned LEB128 varints:
+
+- ``0x01 offset length``: copy ``length`` bytes of the source, starting at ``offset``.
+- ``0x02 length data``: insert the ``length`` bytes of ``data`` that follow.
+"""
+
+from __future__ import annotations
+
+DELTA_MAGIC = b"ESPD\x01"
+DELTA_OP_COPY = 0x01
+DELTA_OP_DATA = 0x02
+
+# Matches are found through an index of blocks of this size in the source
+BLOCK_SIZE = 32
+# Distance of the indexed blocks, every match of BLOCK_SIZE + BLOCK_STEP - 1 bytes is found
+BLOCK_STEP = 16
+# Shorter matches are sent as data, a copy operation costs up to 9 bytes
+MIN_MATCH = 24
+
+
+class DeltaError(ValueError):
+    pass
+
+
+def _encode_varint(value: int) -> bytes:
+    out = bytearray()
+    while True:
+        byte = value & 0x7F
+        value >>= 7
+        if value:
+            out.append(byte | 0x80)
+        else:
+            out.append(byte)
+            return bytes(out)
+
+
+def _decode_varint(data: bytes, pos: int) -> tuple[int, int]:
+    value = 0
+    shift = 0
+    while True:
+        if pos >= len(data):
+            raise DeltaError("Invalid number in patch")
+        byte = data[pos]
+        # the 5th byte holds the top 4 bits of a 32 bit number and has to be the last
+        if shift == 28 and byte > 0x0F:
+            raise DeltaError("Invalid number in patch")
+        pos += 1
+        value |= (byte & 0x7F) << shift
+        shift += 7
+        if not byte & 0x80:
+            return value, pos
+
+
+def make_delta(source: bytes, target: bytes) -> bytes:
+    """Create a patch that reconstructs ``target`` from ``source``."""
+    index: dict[bytes, int] = {}
+    for offset in range(0, len(source) - BLOCK_SIZE + 1, BLOCK_STEP):
+        index.setdefault(source[offset : offset + BLOCK_SIZE], offset)
+
+    out = bytearray(DELTA_MAGIC)
+    literal_start = 0
+
+    def flush_literal(end: int) -> None:
+        if end > literal_start:
+            out.append(DELTA_OP_DATA)
+            out.extend(_encode_varint(end - literal_start))
+            out.extend(target[literal_start:end])
+
+    pos = 0
+    last = len(target) - BLOCK_SIZE
+    while pos <= last:
+        src = index.get(target[pos : pos + BLOCK_SIZE])
+        if src is None:
+            pos += 1
+            continue
+        # extend the match in both directions
+        start = pos
+        while start > literal_start and src > 0 and source[src - 1] == target[start - 1]:
+            start -= 1
+            src -= 1
+        end = pos + BLOCK_SIZE
+        src_end = src + (end - start)
+        while end < len(target) and src_end < len(source) and source[src_end] == target[end]:
+            end += 1
+            src_end += 1
+        if end - start < MIN_MATCH:
+            pos += 1
+            continue
+        flush_literal(start)
+        out.append(DELTA_OP_COPY)
+        out += _encode_varint(src)
+        out += _encode_varint(end - start)
+        literal_start = pos = end
+    flush_literal(len(target))
+    return bytes(out)
+
+
+def apply_delta(source: bytes, patch: bytes) -> bytes:
+    """Reconstruct the target from ``source`` and a patch created by :func:`make_delta`."""
+    if not patch.startswith(DELTA_MAGIC):
+        raise DeltaError("Invalid patch header")
+    out = bytearray()
+    pos = len(DELTA_MAGIC)
+    while pos < len(patch):
+        opcode = patch[pos]
+        pos += 1
+        if opcode == DELTA_OP_COPY:
+            offset, pos = _decode_varint(patch, pos)
+            length, pos = _decode_varint(patch, pos)
+            if offset + length > len(source):
+                raise DeltaError("Patch copies beyond the source")
+            out += source[offset : offset + length]
+        elif opcode == DELTA_OP_DATA:
+            length, pos = _decode_varint(patch, pos)
+            if pos + length > len(patch):
+                raise DeltaError("Patch data is truncated")
+            out += patch[pos : pos + length]
+            pos += length
+        else:
+            raise DeltaError(f"Invalid patch operation 0x{opcode:02X}")
+    return bytes(out)
@@ -0,0 +1,9 @@
+#pragma once
+
+#define ESPHOME_BOARD "host"
+#define USE_API
+#define USE_API_ENTITY_CACHE
+#define USE_API_PLAINTEXT
+#define USE_NETWORK
+#define USE_SENSOR
+#define USE_SOCKET_IMPL_BSD_SOCKETS
@@ -0,0 +1,246 @@
+// The entity list of the native API with the encoded messages cached: all entities are listed, later requests get
+// the same messages from the cache in batches, and invalidating the cache picks up changed metadata.
+#include "host_test.h"
+
+#include "esphome/components/api/api_server.h"
+#include "esphome/components/sensor/sensor.h"
+#include "esphome/core/application.h"
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace esphome;
+
+static const uint16_t PORT = 26053;
+static const size_t SENSOR_COUNT = 500;
+
+static const uint32_t HELLO_REQUEST = 1;
+static const uint32_t HELLO_RESPONSE = 2;
+static const uint32_t CONNECT_REQUEST = 3;
+static const uint32_t CONNECT_RESPONSE = 4;
+static const uint32_t LIST_ENTITIES_REQUEST = 11;
+static const uint32_t LIST_ENTITIES_SENSOR_RESPONSE = 16;
+static const uint32_t LIST_ENTITIES_DONE_RESPONSE = 19;
+
+static api::APIServer *server;
+static std::vector<sensor::Sensor *> sensors;
+
+struct Message {
+  uint32_t type;
+  std::vector<uint8_t> payload;
+};
+
+static bool operator==(const Message &a, const Message &b) { return a.type == b.type && a.payload == b.payload; }
+
+/// A plaintext API client on a non-blocking socket, driven from the same thread as the server.
+class TestClient {
+ public:
+  ~TestClient() {
+    if (this->fd_ >= 0)
+      ::close(this->fd_);
+  }
+
+  void connect() {
+    this->fd_ = ::socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(PORT);
+    addr.sin_addr.s_addr = inet_addr("127.0.0.1");
+    EXPECT(::connect(this->fd_, (sockaddr *) &addr, sizeof(addr)) == 0);
+    fcntl(this->fd_, F_SETFL, O_NONBLOCK);
+    this->send(HELLO_REQUEST);
+    EXPECT(this->receive_until(HELLO_RESPONSE));
+    this->send(CONNECT_REQUEST);
+    EXPECT(this->receive_until(CONNECT_RESPONSE));
+  }
+
+  void send(uint32_t type) {
+    uint8_t frame[] = {0x00, 0x00, (uint8_t) type};
+    EXPECT(::write(this->fd_, frame, sizeof(frame)) == (ssize_t) sizeof(frame));
+  }
+
+  /// Run server loop iterations until a message of `type` arrived. The messages are kept in `received`.
+  bool receive_until(uint32_t type) {
+    this->received.clear();
+    this->loops = 0;
+    this->server_us = 0;
+    for (int i = 0; i < 10000; i++) {
+      uint64_t start = thread_cpu_us();
+      server->loop();
+      this->server_us += thread_cpu_us() - start;
+      this->loops++;
+      uint8_t buf[4096];
+      ssize_t len;
+      while ((len = ::read(this->fd_, buf, sizeof(buf))) > 0)
+        this->rx_.insert(this->rx_.end(), buf, buf + len);
+      while (this->parse_message_()) {
+        if (this->received.back().type == type)
+          return true;
+      }
+    }
+    return false;
+  }
+
+  /// Request the entity list and receive it.
+  bool list_entities() {
+    this->send(LIST_ENTITIES_REQUEST);
+    return this->receive_until(LIST_ENTITIES_DONE_RESPONSE);
+  }
+
+  std::vector<Message> received;
+  uint32_t loops{0};
+  /// CPU time the server spent in its loop while receiving.
+  uint64_t server_us{0};
+
+ protected:
+  static uint64_t thread_cpu_us() {
+    timespec spec;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &spec);
+    return (uint64_t) spec.tv_sec * 1000000 + spec.tv_nsec / 1000;
+  }
+  static bool read_varint(const std::vector<uint8_t> &buf, size_t *pos, uint32_t *value) {
+    *value = 0;
+    for (int shift = 0; *pos < buf.size(); shift += 7) {
+      uint8_t c = buf[(*pos)++];
+      *value |= (uint32_t) (c & 0x7F) << shift;
+      if ((c & 0x80) == 0)
+        return true;
+    }
+    return false;
+  }
+  bool parse_message_() {
+    size_t pos = 1;
+    uint32_t len, type;
+    if (this->rx_.empty() || !read_varint(this->rx_, &pos, &len) || !read_varint(this->rx_, &pos, &type) ||
+        this->rx_.size() < pos + len)
+      return false;
+    auto payload = this->rx_.begin() + pos;
+    this->received.push_back(Message{type, std::vector<uint8_t>(payload, payload + len)});
+    this->rx_.erase(this->rx_.begin(), this->rx_.begin() + pos + len);
+    return true;
+  }
+
+  int fd_{-1};
+  std::vector<uint8_t> rx_;
+};
+
+/// A short string field of a ListEntitiesSensorResponse, such as the object id (0x0A) or the name (0x1A).
+static std::string string_field(const Message &message, uint8_t tag) {
+  size_t pos = 0;
+  while (pos + 2 <= message.payload.size()) {
+    uint8_t field = message.payload[pos];
+    if ((field & 0x07) == 5) {
+      pos += 5;
+      continue;
+    }
+    size_t len = message.payload[pos + 1];
+    if (field == tag)
+      return std::string(message.payload.begin() + pos + 2, message.payload.begin() + pos + 2 + len);
+    pos += 2 + len;
+  }
+  return "";
+}
+
+static void test_all_entities_listed() {
+  TestClient client;
+  client.connect();
+  EXPECT(client.list_entities());
+  EXPECT_EQ(client.received.size(), SENSOR_COUNT + 1);
+  for (size_t i = 0; i < SENSOR_COUNT && i < client.received.size(); i++) {
+    EXPECT_EQ(client.received[i].type, LIST_ENTITIES_SENSOR_RESPONSE);
+    EXPECT(string_field(client.received[i], 0x0A) == sensors[i]->get_object_id());
+    EXPECT(string_field(client.received[i], 0x1A) == sensors[i]->get_name());
+  }
+}
+
+static void test_cached_list_is_identical() {
+  TestClient first, second;
+  first.connect();
+  second.connect();
+  EXPECT(first.list_entities());
+  // the second client streams the messages the first request encoded
+  EXPECT(second.list_entities());
+  EXPECT(first.received == second.received);
+  // in batches of about one TCP segment, a dozen messages, instead of one message per loop iteration
+  EXPECT(second.loops < SENSOR_COUNT / 5);
+  EXPECT(second.list_entities());
+  EXPECT(first.received == second.received);
+}
+
+static void test_invalidate() {
+  TestClient client;
+  client.connect();
+  EXPECT(client.list_entities());
+  std::vector<Message> before = client.received;
+
+  sensors[42]->set_name("Renamed Sensor");
+  // metadata changed without invalidating is not picked up
+  EXPECT(client.list_entities());
+  EXPECT(client.received == before);
+
+  server->invalidate_entity_catalog();
+  EXPECT(client.list_entities());
+  EXPECT_EQ(client.received.size(), before.size());
+  EXPECT(string_field(client.received[42], 0x1A) == "Renamed Sensor");
+  for (size_t i = 0; i < before.size() && i < client.received.size(); i++) {
+    if (i != 42)
+      EXPECT(client.received[i] == before[i]);
+  }
+}
+
+static void bench_list_entities() {
+  const int rounds = 50;
+  TestClient client;
+  client.connect();
+  for (bool cached : {false, true}) {
+    uint64_t server_us = 0;
+    uint32_t loops = 0;
+    for (int round = 0; round < rounds; round++) {
+      // the first request after invalidating encodes all messages again, the work done per request without the cache
+      if (!cached)
+        server->invalidate_entity_catalog();
+      client.list_entities();
+      server_us += client.server_us;
+      loops += client.loops;
+    }
+    size_t bytes = 0;
+    for (const auto &message : client.received)
+      bytes += message.payload.size();
+    printf("list of %zu sensors, %s: server CPU time %.0f us, %.1f loop iterations, %zu payload bytes\n",
+           SENSOR_COUNT, cached ? "from the cache" : "catalog rebuilt each time", (double) server_us / rounds,
+           (double) loops / rounds, bytes);
+  }
+}
+
+int main(int argc, char **argv) {
+  bool bench = host_test::bench_mode(argc, argv);
+  App.pre_setup("entities", "", "", "", "", false);
+  for (size_t i = 0; i < SENSOR_COUNT; i++) {
+    auto *sensor = new sensor::Sensor();  // NOLINT
+    App.register_sensor(sensor);
+    sensor->set_name(strdup(("Living Room Temperature Sensor " + std::to_string(i)).c_str()));
+    sensor->set_object_id(strdup(("living_room_temperature_sensor_" + std::to_string(i)).c_str()));
+    sensor->set_unit_of_measurement("°C");
+    sensor->set_device_class("temperature");
+    sensor->set_icon("mdi:thermometer");
+    sensor->set_accuracy_decimals(1);
+    sensors.push_back(sensor);
+  }
+  server = new api::APIServer();  // NOLINT
+  server->set_port(PORT);
+  server->setup();
+
+  test_all_entities_listed();
+  test_cached_list_is_identical();
+  test_invalidate();
+  if (bench)
+    bench_list_entities();
+  return host_test::result();
+}
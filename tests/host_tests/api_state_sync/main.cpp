@@ -0,0 +1,279 @@
+// The initial state sync of the native API over a loopback socket: batching, and resuming a subscription with
+// only the states the client did not confirm.
+#include "host_test.h"
+
+#include "esphome/components/api/api_server.h"
+#include "esphome/components/sensor/sensor.h"
+#include "esphome/core/application.h"
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <cstring>
+#include <set>
+#include <string>
+#include <vector>
+
+using namespace esphome;
+
+static const uint16_t PORT = 36053;
+static const size_t SENSOR_COUNT = 500;
+
+static const uint32_t HELLO_REQUEST = 1;
+static const uint32_t HELLO_RESPONSE = 2;
+static const uint32_t CONNECT_REQUEST = 3;
+static const uint32_t CONNECT_RESPONSE = 4;
+static const uint32_t PING_REQUEST = 7;
+static const uint32_t PING_RESPONSE = 8;
+static const uint32_t SUBSCRIBE_STATES_REQUEST = 20;
+static const uint32_t SENSOR_STATE_RESPONSE = 25;
+
+static api::APIServer *server;
+
+/// A plaintext API client on a non-blocking socket, driven from the same thread as the server.
+class TestClient {
+ public:
+  ~TestClient() { this->close(); }
+
+  void connect() {
+    this->fd_ = ::socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(PORT);
+    addr.sin_addr.s_addr = inet_addr("127.0.0.1");
+    EXPECT(::connect(this->fd_, (sockaddr *) &addr, sizeof(addr)) == 0);
+    fcntl(this->fd_, F_SETFL, O_NONBLOCK);
+    this->send(HELLO_REQUEST, {0x0A, 4, 't', 'e', 's', 't'});
+    EXPECT(this->pump_until(HELLO_RESPONSE));
+    this->send(CONNECT_REQUEST, {});
+    EXPECT(this->pump_until(CONNECT_RESPONSE));
+  }
+  void close() {
+    if (this->fd_ >= 0)
+      ::close(this->fd_);
+    this->fd_ = -1;
+  }
+
+  void send(uint32_t type, const std::vector<uint8_t> &payload) {
+    std::vector<uint8_t> frame{0x00, (uint8_t) payload.size(), (uint8_t) type};
+    frame.insert(frame.end(), payload.begin(), payload.end());
+    EXPECT(::write(this->fd_, frame.data(), frame.size()) == (ssize_t) frame.size());
+  }
+  void subscribe_states(bool resume) {
+    this->sensor_keys.clear();
+    this->send(SUBSCRIBE_STATES_REQUEST, resume ? std::vector<uint8_t>{0x08, 0x01} : std::vector<uint8_t>{});
+  }
+
+  /// Run one server loop iteration and handle everything the client received.
+  void pump() {
+    server->loop();
+    this->loops++;
+    uint8_t buf[1024];
+    ssize_t len;
+    while ((len = ::read(this->fd_, buf, sizeof(buf))) > 0) {
+      this->bytes += len;
+      this->rx_.insert(this->rx_.end(), buf, buf + len);
+    }
+    while (this->parse_frame_()) {
+    }
+  }
+  bool pump_until(uint32_t type, int max_loops = 10000) {
+    this->last_type_ = 0;
+    for (int i = 0; i < max_loops && this->last_type_ != type; i++)
+      this->pump();
+    return this->last_type_ == type;
+  }
+  void pump_loops(int count) {
+    for (int i = 0; i < count; i++)
+      this->pump();
+  }
+
+  bool answer_pings{true};
+  uint32_t pings{0};
+  uint32_t frames{0};
+  uint32_t loops{0};
+  size_t bytes{0};
+  std::multiset<uint32_t> sensor_keys;
+
+ protected:
+  static bool read_varint(const std::vector<uint8_t> &buf, size_t *pos, uint32_t *value) {
+    *value = 0;
+    for (int shift = 0; *pos < buf.size(); shift += 7) {
+      uint8_t c = buf[(*pos)++];
+      *value |= (uint32_t) (c & 0x7F) << shift;
+      if ((c & 0x80) == 0)
+        return true;
+    }
+    return false;
+  }
+  bool parse_frame_() {
+    size_t pos = 1;
+    uint32_t len, type;
+    if (this->rx_.empty() || !read_varint(this->rx_, &pos, &len) || !read_varint(this->rx_, &pos, &type) ||
+        this->rx_.size() < pos + len)
+      return false;
+    if (type == SENSOR_STATE_RESPONSE && len >= 5 && this->rx_[pos] == 0x0D) {
+      uint32_t key;
+      memcpy(&key, &this->rx_[pos + 1], 4);
+      this->sensor_keys.insert(key);
+    }
+    if (type == PING_REQUEST) {
+      this->pings++;
+      if (this->answer_pings)
+        this->send(PING_RESPONSE, {});
+    }
+    this->rx_.erase(this->rx_.begin(), this->rx_.begin() + pos + len);
+    this->last_type_ = type;
+    this->frames++;
+    return true;
+  }
+
+  int fd_{-1};
+  std::vector<uint8_t> rx_;
+  uint32_t last_type_{0};
+};
+
+static std::vector<sensor::Sensor *> sensors;
+
+static void disconnect(TestClient &client) {
+  client.close();
+  for (int i = 0; i < 1000 && server->is_connected(); i++)
+    server->loop();
+  EXPECT(!server->is_connected());
+}
+
+/// Let the server send the ping that confirms the states sent so far.
+static void acknowledge(TestClient &client) {
+  host_test::advance_time_ms(10000);
+  client.pump_loops(10);
+}
+
+static void sync_all_states(TestClient &client) {
+  client.subscribe_states(false);
+  for (int i = 0; i < 10000 && client.sensor_keys.size() < SENSOR_COUNT; i++)
+    client.pump();
+  EXPECT_EQ(client.sensor_keys.size(), SENSOR_COUNT);
+}
+
+/// All sensors that share a bitmap slot with the given ones, which a resume sends too.
+static std::set<uint32_t> resume_keys(const std::vector<size_t> &changed) {
+  std::set<uint32_t> keys;
+  for (auto *sensor : sensors) {
+    for (size_t index : changed) {
+      if (sensor->get_object_id_hash() % api::StateChangeBitmap::SIZE ==
+          sensors[index]->get_object_id_hash() % api::StateChangeBitmap::SIZE)
+        keys.insert(sensor->get_object_id_hash());
+    }
+  }
+  return keys;
+}
+
+static void test_full_sync_is_batched() {
+  TestClient client;
+  client.connect();
+  uint32_t loops = client.loops;
+  sync_all_states(client);
+  // One message per loop iteration used to take SENSOR_COUNT iterations
+  EXPECT(client.loops - loops < SENSOR_COUNT / 10);
+  disconnect(client);
+}
+
+static void test_resume_sends_unconfirmed_states() {
+  TestClient client;
+  client.connect();
+  sync_all_states(client);
+  acknowledge(client);
+  EXPECT(client.pings > 0);
+
+  // Written to the socket but never confirmed by the client, so it may be lost with the connection
+  client.answer_pings = false;
+  sensors[3]->publish_state(1.0f);
+  client.pump_loops(5);
+  EXPECT_EQ(client.sensor_keys.count(sensors[3]->get_object_id_hash()), 2u);
+  disconnect(client);
+
+  sensors[5]->publish_state(2.0f);
+  sensors[7]->publish_state(3.0f);
+
+  uint32_t pings = client.pings;
+  client.connect();
+  client.answer_pings = true;
+  client.subscribe_states(true);
+  client.pump_loops(20);
+  std::set<uint32_t> expected = resume_keys({3, 5, 7});
+  EXPECT(std::set<uint32_t>(client.sensor_keys.begin(), client.sensor_keys.end()) == expected);
+  EXPECT_EQ(client.sensor_keys.size(), expected.size());
+
+  // Once confirmed, nothing is sent again
+  acknowledge(client);
+  EXPECT(client.pings > pings);
+  disconnect(client);
+  client.connect();
+  client.subscribe_states(true);
+  client.pump_loops(20);
+  EXPECT_EQ(client.sensor_keys.size(), 0u);
+  disconnect(client);
+}
+
+static void test_resume_without_confirmation_sends_all() {
+  TestClient client;
+  client.connect();
+  client.answer_pings = false;
+  sync_all_states(client);
+  disconnect(client);
+
+  client.connect();
+  client.answer_pings = true;
+  client.subscribe_states(true);
+  client.pump_loops(100);
+  EXPECT_EQ(client.sensor_keys.size(), SENSOR_COUNT);
+  disconnect(client);
+}
+
+static void bench_full_sync() {
+  const int rounds = 20;
+  uint64_t total_us = 0;
+  uint32_t loops = 0, frames = 0;
+  size_t bytes = 0;
+  for (int i = 0; i < rounds; i++) {
+    TestClient client;
+    client.connect();
+    client.answer_pings = false;
+    uint32_t start_loops = client.loops, start_frames = client.frames;
+    size_t start_bytes = client.bytes;
+    uint64_t start = host_test::now_us();
+    sync_all_states(client);
+    total_us += host_test::now_us() - start;
+    loops += client.loops - start_loops;
+    frames += client.frames - start_frames;
+    bytes += client.bytes - start_bytes;
+    disconnect(client);
+  }
+  printf("full sync of %zu sensors: %.0f us, %.1f loop iterations, %u frames, %zu bytes\n", SENSOR_COUNT,
+         (double) total_us / rounds, (double) loops / rounds, frames / rounds, bytes / rounds);
+}
+
+int main(int argc, char **argv) {
+  bool bench = host_test::bench_mode(argc, argv);
+  App.pre_setup("sync", "", "", "", "", false);
+  for (size_t i = 0; i < SENSOR_COUNT; i++) {
+    auto *sensor = new sensor::Sensor();  // NOLINT
+    App.register_sensor(sensor);
+    sensor->set_name(strdup(("Sensor " + std::to_string(i)).c_str()));
+    sensor->set_object_id(strdup(("sensor_" + std::to_string(i)).c_str()));
+    sensor->publish_state(i);
+    sensors.push_back(sensor);
+  }
+  server = new api::APIServer();  // NOLINT
+  server->set_port(PORT);
+  server->setup();
+
+  test_full_sync_is_batched();
+  test_resume_sends_unconfirmed_states();
+  test_resume_without_confirmation_sends_all();
+  if (bench)
+    bench_full_sync();
+  return host_test::result();
+}
@@ -0,0 +1,172 @@
+// The PCM block kernels of the audio component against a plain 64 bit reference: saturation at both ends, negative
+// factors, conversion in place and from unaligned buffers, and their throughput.
+#include "host_test.h"
+
+#include "esphome/components/audio/audio.h"
+
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <random>
+#include <vector>
+
+using namespace esphome;
+
+static const size_t SAMPLES = 4096;
+
+static int16_t saturate16(int64_t value) { return std::min<int64_t>(std::max<int64_t>(value, INT16_MIN), INT16_MAX); }
+static int32_t saturate32(int64_t value) { return std::min<int64_t>(std::max<int64_t>(value, INT32_MIN), INT32_MAX); }
+
+/// Random samples, starting with the extremes.
+template<typename T> static std::vector<T> random_samples(uint32_t seed) {
+  std::mt19937 rng(seed);
+  std::vector<T> samples(SAMPLES);
+  for (auto &sample : samples)
+    sample = static_cast<T>(rng());
+  samples[0] = std::numeric_limits<T>::min();
+  samples[1] = std::numeric_limits<T>::max();
+  samples[2] = std::numeric_limits<T>::min();
+  samples[3] = -1;
+  return samples;
+}
+
+static const std::vector<int16_t> A = random_samples<int16_t>(1);
+static const std::vector<int16_t> B = random_samples<int16_t>(2);
+static const std::vector<int32_t> W = random_samples<int32_t>(3);
+
+static void test_gain() {
+  EXPECT_EQ(audio::gain_to_q15(1.0f), INT16_MAX);
+  EXPECT_EQ(audio::gain_to_q15(2.0f), INT16_MAX);
+  EXPECT_EQ(audio::gain_to_q15(-1.0f), 0);
+  EXPECT_EQ(audio::gain_to_q15(0.5f), 16384);
+  EXPECT_EQ(audio::gain_to_q31(1.0f), INT32_MAX);
+  EXPECT_EQ(audio::gain_to_q31(0.0f), 0);
+}
+
+static void test_scale() {
+  std::vector<int16_t> output(SAMPLES);
+  for (int16_t factor : {0, 1, 1234, 16384, INT16_MAX, -1, -16384, INT16_MIN}) {
+    audio::scale_q15(A.data(), output.data(), SAMPLES, factor);
+    int errors = 0;
+    for (size_t i = 0; i < SAMPLES; i++)
+      errors += output[i] != saturate16((int64_t(A[i]) * factor) >> 15);
+    EXPECT_EQ(errors, 0);
+  }
+  // in place
+  output = A;
+  audio::scale_q15(output.data(), output.data(), SAMPLES, 16384);
+  EXPECT_EQ(output[1], INT16_MAX >> 1);
+
+  std::vector<int32_t> output32(SAMPLES);
+  for (int32_t factor : {audio::gain_to_q31(0.5f), INT32_MAX, INT32_MIN, -1}) {
+    audio::scale_q31(W.data(), output32.data(), SAMPLES, factor);
+    int errors = 0;
+    for (size_t i = 0; i < SAMPLES; i++)
+      errors += output32[i] != saturate32((int64_t(W[i]) * factor) >> 31);
+    EXPECT_EQ(errors, 0);
+  }
+}
+
+static void test_mix() {
+  std::vector<int16_t> output(SAMPLES);
+  audio::mix_s16(A.data(), B.data(), output.data(), SAMPLES);
+  int errors = 0;
+  for (size_t i = 0; i < SAMPLES; i++)
+    errors += output[i] != saturate16(int64_t(A[i]) + B[i]);
+  EXPECT_EQ(errors, 0);
+
+  const std::pair<int16_t, int16_t> factors[] = {
+      {INT16_MAX, INT16_MAX}, {16384, 8192}, {0, INT16_MAX}, {-16384, 16384}, {-INT16_MAX, -INT16_MAX}};
+  for (auto [factor_a, factor_b] : factors) {
+    audio::mix_q15(A.data(), factor_a, B.data(), factor_b, output.data(), SAMPLES);
+    errors = 0;
+    for (size_t i = 0; i < SAMPLES; i++)
+      errors += output[i] != saturate16((int64_t(A[i]) * factor_a + int64_t(B[i]) * factor_b) >> 15);
+    EXPECT_EQ(errors, 0);
+  }
+  // INT16_MIN factors are raised to -INT16_MAX, both products at their extreme would not fit into 32 bits otherwise
+  audio::mix_q15(A.data(), INT16_MIN, B.data(), INT16_MIN, output.data(), SAMPLES);
+  EXPECT_EQ(output[0], INT16_MAX);
+  errors = 0;
+  for (size_t i = 0; i < SAMPLES; i++)
+    errors += output[i] != saturate16((int64_t(A[i]) * -INT16_MAX + int64_t(B[i]) * -INT16_MAX) >> 15);
+  EXPECT_EQ(errors, 0);
+}
+
+static void test_interleave() {
+  std::vector<int16_t> left(SAMPLES / 2), right(SAMPLES / 2), output(SAMPLES);
+  audio::deinterleave_s16(A.data(), left.data(), right.data(), SAMPLES / 2);
+  EXPECT_EQ(left[1], A[2]);
+  EXPECT_EQ(right[1], A[3]);
+  audio::interleave_s16(left.data(), right.data(), output.data(), SAMPLES / 2);
+  EXPECT(output == A);
+}
+
+static void test_convert() {
+  std::vector<int32_t> wide(SAMPLES);
+  audio::convert_s16_to_s32(A.data(), wide.data(), SAMPLES);
+  int errors = 0;
+  for (size_t i = 0; i < SAMPLES; i++)
+    errors += wide[i] != int32_t(A[i]) * 65536;
+  EXPECT_EQ(errors, 0);
+  std::vector<int16_t> narrow(SAMPLES);
+  audio::convert_s32_to_s16(wide.data(), narrow.data(), SAMPLES);
+  EXPECT(narrow == A);
+
+  // in place from a buffer that is not aligned for 32 bit access, amplified, as the microphone does it
+  std::vector<uint8_t> raw(SAMPLES * 4 + 2);
+  memcpy(raw.data() + 2, W.data(), SAMPLES * 4);
+  auto *samples = reinterpret_cast<int16_t *>(raw.data() + 2);
+  audio::convert_s32_to_s16(raw.data() + 2, samples, SAMPLES, 14);
+  errors = 0;
+  for (size_t i = 0; i < SAMPLES; i++) {
+    int16_t value;
+    memcpy(&value, raw.data() + 2 + 2 * i, 2);
+    errors += value != saturate16(W[i] >> 14);
+  }
+  EXPECT_EQ(errors, 0);
+}
+
+static void bench(const char *name, size_t bytes, const std::function<void()> &kernel) {
+  const int rounds = 20000;
+  uint64_t start = host_test::now_us();
+  for (int round = 0; round < rounds; round++)
+    kernel();
+  double us = double(host_test::now_us() - start) / rounds;
+  printf("%-19s %4zu samples: %6.2f us, %6.0f MB/s\n", name, SAMPLES, us, bytes / us);
+}
+
+static void bench_kernels() {
+  std::vector<int16_t> output(SAMPLES), left(SAMPLES / 2), right(SAMPLES / 2);
+  std::vector<int32_t> output32(SAMPLES);
+  // the loop the speaker used before, for comparison
+  bench("scalar q15 loop", SAMPLES * 2, [&]() {
+    for (size_t i = 0; i < SAMPLES; i++)
+      output[i] = static_cast<int16_t>((static_cast<int32_t>(A[i]) * 1234) >> 15);
+  });
+  bench("scale_q15", SAMPLES * 2, [&]() { audio::scale_q15(A.data(), output.data(), SAMPLES, 1234); });
+  bench("scale_q31", SAMPLES * 4, [&]() { audio::scale_q31(W.data(), output32.data(), SAMPLES, 1234567); });
+  bench("mix_s16", SAMPLES * 2, [&]() { audio::mix_s16(A.data(), B.data(), output.data(), SAMPLES); });
+  bench("mix_q15", SAMPLES * 2,
+        [&]() { audio::mix_q15(A.data(), 1000, B.data(), -2000, output.data(), SAMPLES); });
+  bench("interleave_s16", SAMPLES * 2,
+        [&]() { audio::interleave_s16(left.data(), right.data(), output.data(), SAMPLES / 2); });
+  bench("deinterleave_s16", SAMPLES * 2,
+        [&]() { audio::deinterleave_s16(A.data(), left.data(), right.data(), SAMPLES / 2); });
+  bench("convert_s16_to_s32", SAMPLES * 2, [&]() { audio::convert_s16_to_s32(A.data(), output32.data(), SAMPLES); });
+  bench("convert_s32_to_s16", SAMPLES * 4, [&]() { audio::convert_s32_to_s16(W.data(), output.data(), SAMPLES, 14); });
+  // keep the results alive
+  static volatile int32_t sink;
+  sink = output[0] + output32[0] + left[0];
+}
+
+int main(int argc, char **argv) {
+  test_gain();
+  test_scale();
+  test_mix();
+  test_interleave();
+  test_convert();
+  if (host_test::bench_mode(argc, argv))
+    bench_kernels();
+  return host_test::result();
+}
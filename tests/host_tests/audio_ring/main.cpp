@@ -0,0 +1,161 @@
+// A microphone shared by the voice assistant and wake word detection through one AudioRing: both readers get every
+// sample in order, a slow reader loses its oldest data only, and readers that need more space reallocate the ring.
+#include "host_test.h"
+
+#include "esphome/components/microphone/microphone.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+using namespace esphome;
+
+static int16_t sample_at(uint32_t i) { return static_cast<int16_t>((i * 2654435761u) >> 16); }
+
+/// A microphone that produces a known sample stream, copying it like a DMA driver does, optionally with short reads.
+class TestMicrophone : public microphone::Microphone {
+ public:
+  void start() override { this->state_ = microphone::STATE_RUNNING; }
+  void stop() override { this->state_ = microphone::STATE_STOPPED; }
+  size_t read(int16_t *buf, size_t len) override {
+    size_t samples = len / 2;
+    if (this->short_reads && rand() % 4 == 0)  // NOLINT(cert-msc30-c, cert-msc50-cpp)
+      samples = rand() % (samples + 1);        // NOLINT(cert-msc30-c, cert-msc50-cpp)
+    int16_t dma[2048];
+    for (size_t i = 0; i < samples; i++)
+      dma[i] = sample_at(this->next_++);
+    memcpy(buf, dma, samples * 2);
+    return samples * 2;
+  }
+
+  bool short_reads{false};
+
+ protected:
+  uint32_t next_{0};
+};
+
+/// A reader that checks the samples it reads in place against the stream.
+struct Consumer {
+  bool read(size_t len) {
+    const uint8_t *data = this->reader.peek(len);
+    if (data == nullptr)
+      return false;
+    const auto *samples = reinterpret_cast<const int16_t *>(data);
+    for (size_t i = 0; i < len / 2; i++) {
+      if (samples[i] != sample_at(this->next++))
+        this->errors++;
+    }
+    this->reader.consume(len);
+    this->bytes += len;
+    return true;
+  }
+
+  microphone::AudioRingReader reader;
+  uint32_t next{0};
+  size_t bytes{0};
+  int errors{0};
+};
+
+/// The voice assistant reads 1024 byte chunks from a 16 kB ring, wake word detection 320 byte strides from 2 kB.
+static void stream(TestMicrophone &microphone, size_t iterations, size_t *produced, Consumer &va, Consumer &mww) {
+  for (size_t i = 0; i < iterations; i++) {
+    // both components fill the ring from their loop
+    *produced += microphone.read_to_audio_ring(1024);
+    *produced += microphone.read_to_audio_ring(512);
+    while (va.read(1024)) {
+    }
+    while (mww.read(320)) {
+    }
+  }
+}
+
+static void test_shared_readers() {
+  for (bool short_reads : {false, true}) {
+    srand(1);  // NOLINT(cert-msc51-cpp)
+    TestMicrophone microphone;
+    microphone.short_reads = short_reads;
+    microphone.start();
+    auto &ring = microphone.get_audio_ring();
+    Consumer va, mww;
+    EXPECT(ring.add_reader(&mww.reader, 2048, 512));
+    EXPECT(ring.add_reader(&va.reader, 16384, 1024));
+    EXPECT_EQ(ring.get_size(), 16384u);
+
+    size_t produced = 0;
+    stream(microphone, 2000, &produced, va, mww);
+    EXPECT_EQ(va.errors, 0);
+    EXPECT_EQ(mww.errors, 0);
+    EXPECT_EQ(va.reader.get_dropped(), 0u);
+    EXPECT_EQ(mww.reader.get_dropped(), 0u);
+    // both are behind by less than one read
+    EXPECT(va.bytes + 1024 > produced);
+    EXPECT(mww.bytes + 320 > produced);
+  }
+}
+
+static void test_overrun() {
+  TestMicrophone microphone;
+  microphone.start();
+  auto &ring = microphone.get_audio_ring();
+  Consumer fast, slow;
+  EXPECT(ring.add_reader(&fast.reader, 4096, 1024));
+  EXPECT(ring.add_reader(&slow.reader, 4096, 1024));
+  for (int i = 0; i < 20; i++) {
+    microphone.read_to_audio_ring(1000);
+    while (fast.read(600)) {
+    }
+  }
+  EXPECT_EQ(fast.errors, 0);
+  EXPECT_EQ(fast.reader.get_dropped(), 0u);
+
+  // the slow reader keeps the newest data, contiguous and in order
+  size_t available = slow.reader.available();
+  EXPECT(available <= ring.get_size() && available >= ring.get_size() - 1000);
+  EXPECT_EQ(slow.reader.get_dropped() + available, 20000u);
+  slow.next = slow.reader.get_dropped() / 2;
+  while (slow.read(1000)) {
+  }
+  EXPECT_EQ(slow.errors, 0);
+
+  // a reader that needs a bigger ring reallocates it, and all readers start over
+  Consumer big;
+  EXPECT(ring.add_reader(&big.reader, 8192, 2048));
+  EXPECT_EQ(ring.get_size(), 8192u);
+  EXPECT_EQ(fast.reader.available(), 0u);
+  // views are limited to the largest size a reader asked for
+  microphone.read_to_audio_ring(2048);
+  EXPECT(big.reader.peek(2049) == nullptr);
+  EXPECT(big.reader.peek(2048) != nullptr);
+
+  ring.remove_reader(&fast.reader);
+  ring.remove_reader(&slow.reader);
+  ring.remove_reader(&big.reader);
+  // the buffer is freed with the last reader
+  EXPECT(ring.prepare_write(16) == nullptr);
+}
+
+static void bench_stream() {
+  TestMicrophone microphone;
+  microphone.start();
+  auto &ring = microphone.get_audio_ring();
+  Consumer va, mww;
+  ring.add_reader(&mww.reader, 2048, 512);
+  ring.add_reader(&va.reader, 16384, 1024);
+  const size_t iterations = 200000;
+  size_t produced = 0;
+  uint64_t start = host_test::now_us();
+  stream(microphone, iterations, &produced, va, mww);
+  uint64_t elapsed = host_test::now_us() - start;
+  // 16 kHz mono 16 bit audio, 32 bytes per ms
+  printf("two readers: %.1f MB/s (%.0fx real time), ring %zu bytes + %zu mirror, %.3f mirror copies per byte\n",
+         (double) produced / elapsed, (double) produced / 32 / (elapsed / 1000.0), ring.get_size(),
+         ring.get_max_view(), (double) ring.get_mirrored() / produced);
+}
+
+int main(int argc, char **argv) {
+  test_shared_readers();
+  test_overrun();
+  if (host_test::bench_mode(argc, argv))
+    bench_stream();
+  return host_test::result();
+}
@@ -0,0 +1,4 @@
+#pragma once
+
+#define USE_BINARY_SENSOR
+#define USE_TIME
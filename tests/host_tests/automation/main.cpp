@@ -0,0 +1,140 @@
+// CronTrigger's next-match search and event-driven wait_until.
+#include "host_test.h"
+
+#include "esphome/components/binary_sensor/automation.h"
+#include "esphome/components/time/automation.h"
+#include "esphome/core/application.h"
+#include "esphome/core/base_automation.h"
+
+#include <cstdlib>
+#include <thread>
+
+using namespace esphome;
+
+class TestClock : public time::RealTimeClock {
+ public:
+  void update() override {}
+};
+
+class TestCronTrigger : public time::CronTrigger {
+ public:
+  using CronTrigger::CronTrigger;
+  using CronTrigger::next_match_;
+};
+
+static const time_t LOOKAHEAD = 86400;
+
+/// Check every second after `from` so the result can be compared with the stepping search.
+static optional<time_t> brute_force_next(TestCronTrigger &cron, time_t from) {
+  for (time_t t = from + 1; t - from <= LOOKAHEAD; t++) {
+    if (cron.matches(ESPTime::from_epoch_local(t)))
+      return t;
+  }
+  return {};
+}
+
+static void fill_dates(TestCronTrigger &cron) {
+  for (uint8_t i = 1; i <= 31; i++)
+    cron.add_day_of_month(i);
+  for (uint8_t i = 1; i <= 12; i++)
+    cron.add_month(i);
+  for (uint8_t i = 1; i <= 7; i++)
+    cron.add_day_of_week(i);
+}
+
+static void test_next_match() {
+  // A zone with DST, so that the search has to cope with days of 23 and 25 hours.
+  setenv("TZ", "CET-1CEST,M3.5.0,M10.5.0/3", 1);
+  tzset();
+
+  TestClock rtc;
+  TestCronTrigger every_day(&rtc);
+  fill_dates(every_day);
+  every_day.add_seconds({0, 30});
+  every_day.add_minute(15);
+  every_day.add_hours({2, 3});
+
+  TestCronTrigger sparse(&rtc);
+  sparse.add_second(59);
+  sparse.add_minute(59);
+  sparse.add_hour(23);
+  sparse.add_day_of_month(31);
+  for (uint8_t i = 1; i <= 12; i++)
+    sparse.add_month(i);
+  sparse.add_day_of_week(1);
+
+  // Midnight after the short day has to be found without stepping over it.
+  TestCronTrigger mondays(&rtc);
+  mondays.add_second(0);
+  mondays.add_minute(0);
+  mondays.add_hour(0);
+  for (uint8_t i = 1; i <= 31; i++)
+    mondays.add_day_of_month(i);
+  for (uint8_t i = 1; i <= 12; i++)
+    mondays.add_month(i);
+  mondays.add_day_of_week(2);
+  // 2024-03-31 00:30 CET, 2024-04-01 00:00 CEST
+  auto monday = mondays.next_match_(1711841400);
+  EXPECT(monday.has_value() && *monday == 1711922400);
+
+  // 2024-03-31 and 2024-10-27 are the DST changes in this zone.
+  const time_t starts[] = {1711839600, 1711846800, 1711850400, 1711854000, 1729987200,
+                           1729990800, 1729994400, 1729998000, 1704067199, 1719791999};
+  for (time_t start : starts) {
+    for (time_t offset : {0, 1, 899, 3599, 7200}) {
+      time_t from = start + offset;
+      auto expected = brute_force_next(every_day, from);
+      auto actual = every_day.next_match_(from);
+      EXPECT(expected.has_value() == actual.has_value());
+      if (expected.has_value() && actual.has_value())
+        EXPECT_EQ(*actual, *expected);
+    }
+    auto expected = brute_force_next(sparse, start);
+    auto actual = sparse.next_match_(start);
+    EXPECT(expected.has_value() == actual.has_value());
+    if (expected.has_value() && actual.has_value())
+      EXPECT_EQ(*actual, *expected);
+  }
+}
+
+static void run_loops(int count) {
+  for (int i = 0; i < count; i++)
+    App.loop();
+}
+
+static void test_wait_until_cross_task() {
+  binary_sensor::BinarySensor sensor;
+  sensor.publish_initial_state(false);
+  binary_sensor::BinarySensorCondition<> condition(&sensor, true);
+  auto *wait = new WaitUntilAction<>(&condition);
+  int done = 0;
+  auto *after = new LambdaAction<>([&done]() { done++; });
+  Trigger<> trigger;
+  Automation<> automation(&trigger);
+  automation.add_actions({wait, after});
+
+  App.register_component(wait);
+  App.setup();
+
+  trigger.trigger();
+  run_loops(3);
+  EXPECT_EQ(done, 0);
+
+  // States published from another task only set a flag, the condition is still checked on the main loop.
+  std::thread publisher([&sensor]() { sensor.publish_state(true); });
+  publisher.join();
+  EXPECT_EQ(done, 0);
+  run_loops(3);
+  EXPECT_EQ(done, 1);
+
+  // A condition that's already true continues right away.
+  trigger.trigger();
+  EXPECT_EQ(done, 2);
+}
+
+int main(int argc, char **argv) {
+  App.pre_setup("automation", "", "", "", "", false);
+  test_next_match();
+  test_wait_until_cross_task();
+  return host_test::result();
+}
@@ -0,0 +1,43 @@
+// The HAL of the host platform, without the main() from esphome/components/host/core.cpp.
+#include "esphome/core/hal.h"
+#include "host_test.h"
+
+#include <sched.h>
+#include <time.h>
+#include <atomic>
+#include <cerrno>
+#include <cstdlib>
+
+namespace esphome {
+
+static std::atomic<uint64_t> time_offset_ns{0};  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+static uint64_t monotonic_ns() {
+  struct timespec spec;
+  clock_gettime(CLOCK_MONOTONIC, &spec);
+  return (uint64_t) spec.tv_sec * 1000000000ULL + spec.tv_nsec + time_offset_ns;
+}
+
+namespace host_test {
+void advance_time_ms(uint32_t ms) { time_offset_ns += (uint64_t) ms * 1000000ULL; }
+}  // namespace host_test
+
+void yield() { ::sched_yield(); }
+uint32_t millis() { return monotonic_ns() / 1000000ULL; }
+uint32_t micros() { return monotonic_ns() / 1000ULL; }
+void delay(uint32_t ms) { delayMicroseconds(ms * 1000U); }
+void delayMicroseconds(uint32_t us) {
+  struct timespec ts;
+  ts.tv_sec = us / 1000000U;
+  ts.tv_nsec = (us % 1000000U) * 1000U;
+  while (nanosleep(&ts, &ts) != 0 && errno == EINTR) {
+  }
+}
+void arch_restart() { exit(0); }
+void arch_init() {}
+void arch_feed_wdt() {}
+uint8_t progmem_read_byte(const uint8_t *addr) { return *addr; }
+uint32_t arch_get_cpu_cycle_count() { return monotonic_ns(); }
+uint32_t arch_get_cpu_freq_hz() { return 1000000000U; }
+
+}  // namespace esphome
@@ -0,0 +1,92 @@
+#include "host_test.h"
+
+#include "esphome/core/defines.h"
+#include "esphome/core/log.h"
+#include "esphome/core/preferences.h"
+
+#include <chrono>
+#include <cstdarg>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+
+namespace esphome {
+
+namespace host_test {
+
+int failures = 0;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+std::string log_output;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+static std::mutex log_lock;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+void clear_log() {
+  std::lock_guard<std::mutex> guard(log_lock);
+  log_output.clear();
+}
+bool log_contains(const char *text) {
+  std::lock_guard<std::mutex> guard(log_lock);
+  return log_output.find(text) != std::string::npos;
+}
+
+bool bench_mode(int argc, char **argv) {
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--bench") == 0)
+      return true;
+  }
+  return false;
+}
+
+uint64_t now_us() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+int result() {
+  if (failures == 0) {
+    printf("OK\n");
+    return 0;
+  }
+  printf("%d expectation(s) failed\n", failures);
+  return 1;
+}
+
+/// Preferences that store nothing, for programs that don't link a preferences backend.
+class NullPreferences : public ESPPreferences {
+ public:
+  ESPPreferenceObject make_preference(size_t length, uint32_t type, bool in_flash) override { return {}; }
+  ESPPreferenceObject make_preference(size_t length, uint32_t type) override { return {}; }
+  bool sync() override { return true; }
+  bool reset() override { return true; }
+};
+
+static NullPreferences null_preferences;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+}  // namespace host_test
+
+// Replaced by the definition in the host preferences backend when a program links it.
+__attribute__((weak)) ESPPreferences *global_preferences =  // NOLINT
+    &host_test::null_preferences;
+
+void esp_log_printf_(int level, const char *tag, int line, const char *format, ...) {  // NOLINT
+  va_list arg;
+  va_start(arg, format);
+  esp_log_vprintf_(level, tag, line, format, arg);
+  va_end(arg);
+}
+
+void esp_log_vprintf_(int level, const char *tag, int line, const char *format, va_list args) {  // NOLINT
+  char buf[512];
+  vsnprintf(buf, sizeof(buf), format, args);
+  std::lock_guard<std::mutex> guard(host_test::log_lock);
+  // Benchmarks can log a lot, only the recent part is of interest
+  if (host_test::log_output.size() > 1000000)
+    host_test::log_output.erase(0, host_test::log_output.size() / 2);
+  host_test::log_output += "[";
+  host_test::log_output += tag;
+  host_test::log_output += "] ";
+  host_test::log_output += buf;
+  host_test::log_output += "\n";
+  if (getenv("HOST_TEST_VERBOSE") != nullptr)
+    fprintf(stderr, "[%s:%d] %s\n", tag, line, buf);
+}
+
+}  // namespace esphome
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cinttypes>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+namespace esphome {
+namespace host_test {
+
+/// Number of failed expectations so far.
+extern int failures;
+/// Everything logged since the last clear_log(), one "[tag] message" per line.
+extern std::string log_output;
+
+void clear_log();
+bool log_contains(const char *text);
+/// True if the program was started with --bench.
+bool bench_mode(int argc, char **argv);
+/// Monotonic time in microseconds as a 64-bit value, for benchmarks.
+uint64_t now_us();
+/// Move millis() and micros() forward, to reach timeouts without waiting for them.
+void advance_time_ms(uint32_t ms);
+/// Print a summary and return the exit code for main().
+int result();
+
+}  // namespace host_test
+}  // namespace esphome
+
+#define EXPECT(cond) \
+  do { \
+    if (!(cond)) { \
+      ::esphome::host_test::failures++; \
+      fprintf(stderr, "%s:%d: expected %s\n", __FILE__, __LINE__, #cond); \
+    } \
+  } while (0)
+
+#define EXPECT_EQ(a, b) \
+  do { \
+    auto a_value_ = (a); \
+    auto b_value_ = (b); \
+    if (!(a_value_ == b_value_)) { \
+      ::esphome::host_test::failures++; \
+      fprintf(stderr, "%s:%d: expected %s == %s (%s vs %s)\n", __FILE__, __LINE__, #a, #b, \
+              std::to_string(a_value_).c_str(), std::to_string(b_value_).c_str()); \
+    } \
+  } while (0)
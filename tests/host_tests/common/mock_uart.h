@@ -0,0 +1,79 @@
+#pragma once
+
+#include "esphome/components/uart/uart_component.h"
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace esphome {
+namespace host_test {
+
+/// A UART bus that hands out the bytes fed to it and records everything written.
+class MockUARTComponent : public uart::UARTComponent {
+ public:
+  void feed(const std::vector<uint8_t> &data) {
+    this->rx.insert(this->rx.end(), data.begin(), data.end());
+    this->wake_();
+  }
+  void feed(const std::string &data) {
+    this->rx.insert(this->rx.end(), data.begin(), data.end());
+    this->wake_();
+  }
+
+  void write_array(const uint8_t *data, size_t len) override {
+    this->tx.insert(this->tx.end(), data, data + len);
+    this->writes++;
+  }
+  bool peek_byte(uint8_t *data) override {
+    if (this->rx_pos_ >= this->rx.size())
+      return false;
+    *data = this->rx[this->rx_pos_];
+    return true;
+  }
+  bool read_array(uint8_t *data, size_t len) override {
+    if (this->rx.size() - this->rx_pos_ < len)
+      return false;
+    memcpy(data, this->rx.data() + this->rx_pos_, len);
+    this->consume_(len);
+    return true;
+  }
+  size_t read_available(uint8_t *data, size_t len) override {
+    len = std::min(len, this->rx.size() - this->rx_pos_);
+    memcpy(data, this->rx.data() + this->rx_pos_, len);
+    this->consume_(len);
+    return len;
+  }
+  int available() override { return this->rx.size() - this->rx_pos_; }
+  void flush() override {}
+  bool wake_loop_on_rx(Component *component) override {
+    this->wake_component_ = component;
+    return true;
+  }
+
+  std::vector<uint8_t> rx;
+  std::vector<uint8_t> tx;
+  /// Number of write_array() calls.
+  size_t writes{0};
+
+ protected:
+  void check_logger_conflict() override {}
+  void wake_() {
+    if (this->wake_component_ != nullptr)
+      this->wake_component_->enable_loop_soon_any_context();
+  }
+  void consume_(size_t len) {
+    this->rx_pos_ += len;
+    if (this->rx_pos_ == this->rx.size()) {
+      this->rx.clear();
+      this->rx_pos_ = 0;
+    }
+  }
+
+  size_t rx_pos_{0};
+  Component *wake_component_{nullptr};
+};
+
+}  // namespace host_test
+}  // namespace esphome
@@ -0,0 +1,254 @@
+// Components that disable and enable their own loop: the main loop calls every enabled component once per iteration
+// in registration order, also when loops are switched from within loop(), and enable_loop_soon_any_context() from
+// another thread only takes effect on the main loop.
+#include "host_test.h"
+
+#include "esphome/core/application.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <functional>
+#include <thread>
+#include <vector>
+
+using namespace esphome;
+
+static const int COMPONENT_COUNT = 200;
+
+class TestComponent;
+static std::vector<TestComponent *> components;
+/// The index of every component called in the current iteration, in call order.
+static std::vector<int> calls;
+
+class TestComponent : public Component {
+ public:
+  explicit TestComponent(int index) : index_(index) {}
+
+  void loop() override {
+    calls.push_back(this->index_);
+    if (this->on_loop)
+      this->on_loop();
+  }
+
+  using Component::disable_loop;
+  using Component::enable_loop;
+  using Component::status_clear_warning;
+  using Component::status_set_warning;
+
+  std::function<void()> on_loop;
+
+ protected:
+  int index_;
+};
+
+/// One main loop iteration. Returns the components called, in call order.
+static std::vector<int> iteration() {
+  calls.clear();
+  App.loop();
+  return calls;
+}
+
+static void reset() {
+  for (auto *component : components) {
+    component->on_loop = nullptr;
+    component->enable_loop();
+  }
+}
+
+static std::vector<int> all_except(const std::vector<int> &disabled) {
+  std::vector<int> indices;
+  for (int i = 0; i < COMPONENT_COUNT; i++) {
+    if (std::find(disabled.begin(), disabled.end(), i) == disabled.end())
+      indices.push_back(i);
+  }
+  return indices;
+}
+
+static void test_order_is_kept() {
+  reset();
+  EXPECT(iteration() == all_except({}));
+  // disabled and enabled again in a different order, the loops still run in registration order
+  for (int i : {5, 100, 3, 199, 0, 42})
+    components[i]->disable_loop();
+  EXPECT(iteration() == all_except({0, 3, 5, 42, 100, 199}));
+  for (int i : {199, 3, 42})
+    components[i]->enable_loop();
+  EXPECT(iteration() == all_except({0, 5, 100}));
+  for (int i : {100, 0, 5})
+    components[i]->enable_loop();
+  EXPECT(iteration() == all_except({}));
+}
+
+static void test_switch_from_loop() {
+  reset();
+  // disabling itself doesn't skip the next component
+  components[10]->on_loop = []() { components[10]->disable_loop(); };
+  EXPECT(iteration() == all_except({}));
+  EXPECT(iteration() == all_except({10}));
+
+  // disabling a component that was already called, or one that comes later
+  reset();
+  components[50]->on_loop = []() {
+    components[20]->disable_loop();
+    components[80]->disable_loop();
+  };
+  EXPECT(iteration() == all_except({80}));
+  EXPECT(iteration() == all_except({20, 80}));
+
+  // a component enabled before the one that is running is called from the next iteration on, one after it right away
+  reset();
+  components[20]->disable_loop();
+  components[80]->disable_loop();
+  components[50]->on_loop = []() {
+    components[20]->enable_loop();
+    components[80]->enable_loop();
+    components[50]->on_loop = nullptr;
+  };
+  EXPECT(iteration() == all_except({20}));
+  EXPECT(iteration() == all_except({}));
+
+  // disabled and enabled again within its own loop, it is not called twice
+  reset();
+  components[30]->on_loop = []() {
+    components[30]->disable_loop();
+    components[30]->enable_loop();
+  };
+  EXPECT(iteration() == all_except({}));
+
+  // the last component disables itself and the first one
+  reset();
+  components[COMPONENT_COUNT - 1]->on_loop = []() {
+    components[COMPONENT_COUNT - 1]->disable_loop();
+    components[0]->disable_loop();
+  };
+  EXPECT(iteration() == all_except({}));
+  EXPECT(iteration() == all_except({0, COMPONENT_COUNT - 1}));
+}
+
+static void test_random_switches() {
+  reset();
+  srand(1);  // NOLINT(cert-msc51-cpp)
+  // every component that is enabled for the whole iteration is called exactly once, and calls are in order
+  std::vector<bool> touched(COMPONENT_COUNT);
+  components[COMPONENT_COUNT / 2]->on_loop = [&touched]() {
+    for (int k = 0; k < 5; k++) {
+      int index = rand() % COMPONENT_COUNT;  // NOLINT(cert-msc30-c, cert-msc50-cpp)
+      if (index == COMPONENT_COUNT / 2)
+        continue;
+      touched[index] = true;
+      if (components[index]->is_loop_enabled()) {
+        components[index]->disable_loop();
+      } else {
+        components[index]->enable_loop();
+      }
+    }
+  };
+  int failures = 0;
+  for (int round = 0; round < 2000; round++) {
+    std::vector<bool> enabled(COMPONENT_COUNT);
+    for (int i = 0; i < COMPONENT_COUNT; i++)
+      enabled[i] = components[i]->is_loop_enabled();
+    std::fill(touched.begin(), touched.end(), false);
+    std::vector<int> called = iteration();
+    std::vector<int> count(COMPONENT_COUNT);
+    for (size_t i = 0; i < called.size(); i++) {
+      count[called[i]]++;
+      if (i > 0 && called[i] <= called[i - 1])
+        failures++;
+    }
+    for (int i = 0; i < COMPONENT_COUNT; i++) {
+      if (count[i] > 1 || (!touched[i] && count[i] != (enabled[i] ? 1 : 0)))
+        failures++;
+    }
+  }
+  EXPECT_EQ(failures, 0);
+}
+
+static void test_enable_from_other_thread() {
+  reset();
+  components[7]->disable_loop();
+  EXPECT(iteration() == all_except({7}));
+
+  std::thread other([]() { components[7]->enable_loop_soon_any_context(); });
+  other.join();
+  // only the main loop changes the looping components
+  EXPECT(!components[7]->is_loop_enabled());
+  EXPECT(iteration() == all_except({}));
+  EXPECT(components[7]->is_loop_enabled());
+
+  // requests from many threads for many components while the main loop runs
+  for (auto *component : components)
+    component->disable_loop();
+  std::atomic<bool> started{false};
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; t++) {
+    threads.emplace_back([t, &started]() {
+      while (!started) {
+      }
+      for (int i = t; i < COMPONENT_COUNT; i += 4)
+        components[i]->enable_loop_soon_any_context();
+    });
+  }
+  started = true;
+  for (int i = 0; i < 20; i++)
+    iteration();
+  for (auto &thread : threads)
+    thread.join();
+  iteration();
+  EXPECT(iteration() == all_except({}));
+}
+
+static void test_disabled_components_report_status() {
+  reset();
+  components[3]->disable_loop();
+  components[3]->status_set_warning();
+  iteration();
+  EXPECT((App.get_app_state() & STATUS_LED_WARNING) != 0);
+  components[3]->status_clear_warning();
+  iteration();
+  EXPECT((App.get_app_state() & STATUS_LED_WARNING) == 0);
+}
+
+static void bench_loop() {
+  const int rounds = 20000;
+  for (bool dynamic : {false, true}) {
+    reset();
+    // 20 busy components, the others only have work to do occasionally
+    if (dynamic) {
+      for (int i = 0; i < COMPONENT_COUNT; i++) {
+        if (i % 10 != 0)
+          components[i]->disable_loop();
+      }
+    }
+    size_t loop_calls = 0;
+    uint64_t start = host_test::now_us();
+    for (int round = 0; round < rounds; round++)
+      loop_calls += iteration().size();
+    double us = (double) (host_test::now_us() - start) / rounds;
+    printf("%d components, %s: %.0f loop calls, %.2f us per iteration\n", COMPONENT_COUNT,
+           dynamic ? "idle ones disabled" : "all looping", (double) loop_calls / rounds, us);
+  }
+}
+
+int main(int argc, char **argv) {
+  App.pre_setup("component_loop", "", "", "", "", false);
+  App.set_loop_interval(0);
+  for (int i = 0; i < COMPONENT_COUNT; i++) {
+    auto *component = new TestComponent(i);  // NOLINT
+    component->set_component_source("test");
+    App.register_component(component);
+    components.push_back(component);
+  }
+  App.setup();
+  calls.reserve(2 * COMPONENT_COUNT);
+
+  test_order_is_kept();
+  test_switch_from_loop();
+  test_random_switches();
+  test_enable_from_other_thread();
+  test_disabled_components_report_status();
+  if (host_test::bench_mode(argc, argv))
+    bench_loop();
+  return host_test::result();
+}
@@ -0,0 +1,141 @@
+// LEDBitEncoder: the symbols of every chunk size match expanding the whole strip at once, and the reset symbol
+// follows the last byte whenever a chunk has room for it.
+#include "host_test.h"
+
+#include "esphome/components/esp32_rmt_led_strip/led_bit_encoder.h"
+
+#include <random>
+#include <vector>
+
+using namespace esphome;
+using esp32_rmt_led_strip::LEDBitEncoder;
+
+// WS2812 timings at 10 MHz, in the layout of rmt_item32_t
+static const uint32_t BIT0 = 0x00188010;
+static const uint32_t BIT1 = 0x000C8020;
+static const uint32_t RESET = 0x7FFF0001;
+
+/// The strip expanded at once, one symbol per bit and the reset symbol, as the driver did before.
+static std::vector<uint32_t> expand(const std::vector<uint8_t> &data, uint32_t reset) {
+  std::vector<uint32_t> symbols;
+  for (uint8_t b : data) {
+    for (int bit = 7; bit >= 0; bit--)
+      symbols.push_back(b & (1 << bit) ? BIT1 : BIT0);
+  }
+  if (reset != 0)
+    symbols.push_back(reset);
+  return symbols;
+}
+
+/// Encode the strip in chunks of at most `max_symbols`. Like the RMT driver, stop once all bytes are consumed.
+static std::vector<uint32_t> encode(const LEDBitEncoder &encoder, const std::vector<uint8_t> &data, size_t max_symbols,
+                                    size_t *chunks = nullptr) {
+  std::vector<uint32_t> symbols;
+  std::vector<uint32_t> chunk(max_symbols);
+  size_t pos = 0;
+  size_t count = 0;
+  while (pos < data.size()) {
+    size_t num_symbols;
+    pos += encoder.encode(data.data() + pos, data.size() - pos, chunk.data(), max_symbols, &num_symbols);
+    symbols.insert(symbols.end(), chunk.begin(), chunk.begin() + num_symbols);
+    count++;
+  }
+  if (chunks != nullptr)
+    *chunks = count;
+  return symbols;
+}
+
+static std::vector<uint8_t> random_data(size_t len) {
+  std::mt19937 rng(1);  // NOLINT(cert-msc51-cpp)
+  std::vector<uint8_t> data(len);
+  for (auto &b : data)
+    b = rng();
+  return data;
+}
+
+static void test_bits() {
+  LEDBitEncoder encoder;
+  encoder.set_symbols(BIT0, BIT1, 0);
+  uint8_t data[] = {0xA5};
+  uint32_t symbols[8];
+  size_t num_symbols;
+  EXPECT_EQ(encoder.encode(data, 1, symbols, 8, &num_symbols), 1u);
+  EXPECT_EQ(num_symbols, 8u);
+  // most significant bit first
+  const uint32_t expected[] = {BIT1, BIT0, BIT1, BIT0, BIT0, BIT1, BIT0, BIT1};
+  for (int i = 0; i < 8; i++)
+    EXPECT_EQ(symbols[i], expected[i]);
+}
+
+static void test_chunks() {
+  std::vector<uint8_t> data = random_data(3 * 60);
+  LEDBitEncoder encoder;
+  for (uint32_t reset : {RESET, 0u}) {
+    encoder.set_symbols(BIT0, BIT1, reset);
+    for (size_t max_symbols = 9; max_symbols <= 100; max_symbols++) {
+      if (encode(encoder, data, max_symbols) != expand(data, reset)) {
+        printf("max_symbols=%zu reset=%u: symbols differ\n", max_symbols, reset != 0);
+        EXPECT(false);
+      }
+    }
+  }
+}
+
+static void test_reset() {
+  LEDBitEncoder encoder;
+  encoder.set_symbols(BIT0, BIT1, RESET);
+  std::vector<uint8_t> data = random_data(4);
+  uint32_t symbols[32];
+  size_t num_symbols;
+  // four bytes fill the chunk, so the last one goes with the reset symbol into the next
+  EXPECT_EQ(encoder.encode(data.data(), 4, symbols, 32, &num_symbols), 3u);
+  EXPECT_EQ(num_symbols, 24u);
+  EXPECT_EQ(encoder.encode(data.data() + 3, 1, symbols, 32, &num_symbols), 1u);
+  EXPECT_EQ(num_symbols, 9u);
+  EXPECT_EQ(symbols[8], RESET);
+
+  // two bytes per chunk: the last chunk has one byte and the reset symbol
+  size_t chunks;
+  EXPECT(encode(encoder, data, 16, &chunks) == expand(data, RESET));
+  EXPECT_EQ(chunks, 3u);
+
+  // with room for a single byte there is never room for the reset symbol
+  EXPECT(encode(encoder, data, 8, &chunks) == expand(data, 0));
+  EXPECT_EQ(chunks, 4u);
+}
+
+static void bench_encode() {
+  const size_t leds = 2000;
+  const int rounds = 200;
+  std::vector<uint8_t> data = random_data(leds * 3);
+  uint64_t start = host_test::now_us();
+  size_t symbols = 0;
+  for (int round = 0; round < rounds; round++)
+    symbols += expand(data, RESET).size();
+  double full_us = double(host_test::now_us() - start) / rounds;
+  printf("%zu LEDs expanded at once: %.1f us, %zu byte buffer\n", leds, full_us, symbols / rounds * 4);
+
+  LEDBitEncoder encoder;
+  encoder.set_symbols(BIT0, BIT1, RESET);
+  for (size_t max_symbols : {32, 64, 256}) {
+    std::vector<uint32_t> chunk(max_symbols);
+    start = host_test::now_us();
+    for (int round = 0; round < rounds; round++) {
+      size_t pos = 0, num_symbols;
+      while (pos < data.size())
+        pos += encoder.encode(data.data() + pos, data.size() - pos, chunk.data(), max_symbols, &num_symbols);
+    }
+    double chunked_us = double(host_test::now_us() - start) / rounds;
+    printf("%zu LEDs in %zu symbol chunks: %.1f us (%.1f Msymbols/s), %zu byte buffer\n", leds, max_symbols,
+           chunked_us, symbols / rounds / chunked_us, max_symbols * 4);
+  }
+}
+
+int main(int argc, char **argv) {
+  test_bits();
+  test_chunks();
+  test_reset();
+  if (host_test::bench_mode(argc, argv))
+    bench_encode();
+  return host_test::result();
+}
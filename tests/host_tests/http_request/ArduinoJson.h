@@ -0,0 +1,14 @@
+#pragma once
+// The firmware gets ArduinoJson from PlatformIO. The http_request headers only name these types, the JSON body of the
+// send action is not tested here.
+#include <string>
+
+struct JsonVariant {
+  template<typename T> bool set(T) { return true; }
+  template<typename T> T as() const { return T(); }
+};
+struct JsonObject {
+  JsonVariant operator[](const char *) { return {}; }
+  JsonVariant operator[](const std::string &) { return {}; }
+};
+struct JsonArray {};
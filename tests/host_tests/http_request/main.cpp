@@ -0,0 +1,424 @@
+// Downloads from a local HTTP server: the body through stream() and HttpStream with a slow consumer, reuse of kept
+// connections, redirects, and requests on a kept connection that the server closed in the meantime. The benchmark
+// reports throughput and the heap in use while a 4 MB file is downloaded.
+#include "host_test.h"
+
+#include "esphome/components/http_request/http_request_host.h"
+
+#include <arpa/inet.h>
+#include <malloc.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace esphome;
+using http_request::HttpStream;
+
+static const uint16_t PORT = 28731;
+static const size_t FIRMWARE_SIZE = 4 << 20;
+static const size_t SMALL_SIZE = 1024;
+static const size_t CLOSE_SIZE = 5000;
+
+static std::vector<uint8_t> make_firmware() {
+  std::vector<uint8_t> data(FIRMWARE_SIZE);
+  uint32_t state = 1;
+  for (auto &b : data) {
+    state = state * 1664525u + 1013904223u;
+    b = state >> 24;
+  }
+  return data;
+}
+// never destroyed, the server threads may still be sending when the program exits
+static const std::vector<uint8_t> &FIRMWARE = *new std::vector<uint8_t>(make_firmware());  // NOLINT
+
+/// A keep-alive HTTP/1.1 server on the loopback interface, one thread per connection.
+class Server {
+ public:
+  Server() {
+    this->fd_ = ::socket(AF_INET, SOCK_STREAM, 0);
+    int one = 1;
+    setsockopt(this->fd_, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(PORT);
+    addr.sin_addr.s_addr = inet_addr("127.0.0.1");
+    EXPECT(bind(this->fd_, (sockaddr *) &addr, sizeof(addr)) == 0);
+    EXPECT(listen(this->fd_, 16) == 0);
+    std::thread([this]() { this->accept_(); }).detach();
+  }
+
+  /// Close the connections that wait for a request, as a server does after its keep-alive timeout.
+  void close_idle() {
+    // give the connection threads time to get back to waiting for the next request
+    usleep(10000);
+    std::lock_guard<std::mutex> lock(this->mutex_);
+    for (int fd : this->idle_)
+      ::shutdown(fd, SHUT_RDWR);
+    this->idle_.clear();
+  }
+
+  int connections() const { return this->connections_; }
+  /// The request lines received so far, e.g. "POST /post".
+  std::vector<std::string> requests() {
+    std::lock_guard<std::mutex> lock(this->mutex_);
+    return this->requests_;
+  }
+
+ protected:
+  void accept_() {
+    while (true) {
+      int fd = ::accept(this->fd_, nullptr, nullptr);
+      if (fd < 0)
+        continue;
+      int one = 1;
+      setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+      this->connections_++;
+      std::thread([this, fd]() { this->serve_(fd); }).detach();
+    }
+  }
+
+  void serve_(int fd) {
+    std::string buffer;
+    while (true) {
+      this->set_idle_(fd, true);
+      size_t head_end;
+      while ((head_end = buffer.find("\r\n\r\n")) == std::string::npos) {
+        char buf[1024];
+        ssize_t len = ::recv(fd, buf, sizeof(buf), 0);
+        if (len <= 0) {
+          this->set_idle_(fd, false);
+          ::close(fd);
+          return;
+        }
+        buffer.append(buf, len);
+      }
+      this->set_idle_(fd, false);
+      std::string head = buffer.substr(0, head_end);
+      buffer.erase(0, head_end + 4);
+      size_t length_pos = head.find("Content-Length: ");
+      size_t body_length = length_pos == std::string::npos ? 0 : atoi(head.c_str() + length_pos + 16);
+      while (buffer.size() < body_length) {
+        char buf[1024];
+        ssize_t len = ::recv(fd, buf, sizeof(buf), 0);
+        if (len <= 0)
+          break;
+        buffer.append(buf, len);
+      }
+      buffer.erase(0, std::min(body_length, buffer.size()));
+
+      std::string line = head.substr(0, head.find(" HTTP/"));
+      {
+        std::lock_guard<std::mutex> lock(this->mutex_);
+        this->requests_.push_back(line);
+      }
+      std::string path = line.substr(line.find(' ') + 1);
+      if (!this->respond_(fd, path) || head.find("Connection: close") != std::string::npos)
+        break;
+    }
+    ::close(fd);
+  }
+
+  /// Send the response. Returns false if the connection has to be closed after it.
+  bool respond_(int fd, const std::string &path) {
+    if (path == "/firmware.bin")
+      return this->send_(fd, "200 OK", FIRMWARE.data(), FIRMWARE.size());
+    if (path == "/small.bin" || path == "/post")
+      return this->send_(fd, "200 OK", FIRMWARE.data(), SMALL_SIZE);
+    if (path == "/redirect")
+      return this->send_(fd, "302 Found\r\nLocation: /small.bin", nullptr, 0);
+    if (path == "/close") {
+      // no length, the body ends when the connection is closed
+      std::string head = "HTTP/1.1 200 OK\r\nConnection: close\r\n\r\n";
+      send_all(fd, head.data(), head.size());
+      send_all(fd, FIRMWARE.data(), CLOSE_SIZE);
+      return false;
+    }
+    return this->send_(fd, "404 Not Found", nullptr, 0);
+  }
+
+  bool send_(int fd, const char *status, const uint8_t *body, size_t len) {
+    std::string head =
+        std::string("HTTP/1.1 ") + status + "\r\nContent-Length: " + std::to_string(len) + "\r\n\r\n";
+    return send_all(fd, head.data(), head.size()) && send_all(fd, body, len);
+  }
+
+  static bool send_all(int fd, const void *data, size_t len) {
+    const auto *bytes = static_cast<const uint8_t *>(data);
+    while (len > 0) {
+      ssize_t sent = ::send(fd, bytes, len, MSG_NOSIGNAL);
+      if (sent <= 0)
+        return false;
+      bytes += sent;
+      len -= sent;
+    }
+    return true;
+  }
+
+  void set_idle_(int fd, bool idle) {
+    std::lock_guard<std::mutex> lock(this->mutex_);
+    if (idle) {
+      this->idle_.insert(fd);
+    } else {
+      this->idle_.erase(fd);
+    }
+  }
+
+  int fd_;
+  std::atomic<int> connections_{0};
+  std::mutex mutex_;
+  std::set<int> idle_;
+  std::vector<std::string> requests_;
+};
+
+static Server *server;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+static std::string url(const char *path) { return "http://127.0.0.1:" + std::to_string(PORT) + path; }
+
+class TestHttpRequest : public http_request::HttpRequestHost {
+ public:
+  TestHttpRequest() {
+    this->set_timeout(2000);
+    this->set_follow_redirects(true);
+    this->set_redirect_limit(3);
+    this->set_useragent("esphome-test");
+    this->set_keep_alive(true);
+  }
+  size_t idle_connections() const { return this->idle_connections_.size(); }
+};
+
+/// Download the body of `path` with stream(). Returns the body, or an empty string if the download failed.
+static std::string download(TestHttpRequest &request, const char *path, size_t chunk_size = 1024) {
+  auto container = request.get(url(path));
+  if (container == nullptr)
+    return "";
+  std::string body;
+  auto result = container->stream(
+      [&body](uint8_t *data, size_t len) {
+        body.append(reinterpret_cast<char *>(data), len);
+        return (int) len;
+      },
+      chunk_size);
+  container->end();
+  return result == http_request::HTTP_STREAM_DONE ? body : "";
+}
+
+static std::string expected(size_t len) { return std::string(FIRMWARE.begin(), FIRMWARE.begin() + len); }
+
+static void test_stream() {
+  TestHttpRequest request;
+  for (size_t chunk_size : {256, 4096, 16384})
+    EXPECT(download(request, "/firmware.bin", chunk_size) == expected(FIRMWARE_SIZE));
+
+  // the consumer stops the transfer
+  auto container = request.get(url("/firmware.bin"));
+  size_t received = 0;
+  auto result = container->stream(
+      [&received](uint8_t *data, size_t len) {
+        if (received >= 100000)
+          return -1;
+        received += len;
+        return (int) len;
+      },
+      512);
+  container->end();
+  EXPECT_EQ(result, http_request::HTTP_STREAM_STOPPED);
+  // a connection with unread data is not kept
+  EXPECT_EQ(request.idle_connections(), 0u);
+}
+
+static void test_backpressure() {
+  TestHttpRequest request;
+  auto container = request.get(url("/firmware.bin"));
+  HttpStream stream(4096);
+  std::string body;
+  size_t max_ahead = 0;
+  http_request::HttpStreamResult result;
+  // a decoder that needs 300 bytes to make progress, and uses at most 100 bytes at a time
+  auto consumer = [&](uint8_t *data, size_t len) {
+    if (len < 300 && !container->is_read_complete())
+      return 0;
+    size_t used = std::min<size_t>(len, 100);
+    body.append(reinterpret_cast<char *>(data), used);
+    return (int) used;
+  };
+  while ((result = stream.poll(container.get(), consumer)) == http_request::HTTP_STREAM_PENDING)
+    max_ahead = std::max(max_ahead, container->get_bytes_read() - body.size());
+  container->end();
+  EXPECT_EQ(result, http_request::HTTP_STREAM_DONE);
+  EXPECT(body == expected(FIRMWARE_SIZE));
+  // nothing more than the buffer is read ahead of the consumer
+  EXPECT(max_ahead <= 4096);
+}
+
+static void test_keep_alive() {
+  for (bool keep_alive : {false, true}) {
+    TestHttpRequest request;
+    request.set_keep_alive(keep_alive);
+    int connections = server->connections();
+    for (int i = 0; i < 20; i++)
+      EXPECT(download(request, "/small.bin") == expected(SMALL_SIZE));
+    EXPECT_EQ(server->connections() - connections, keep_alive ? 1 : 20);
+    EXPECT_EQ(request.idle_connections(), keep_alive ? 1u : 0u);
+  }
+}
+
+static void test_redirect_and_close() {
+  TestHttpRequest request;
+  EXPECT(download(request, "/redirect") == expected(SMALL_SIZE));
+  EXPECT(download(request, "/close") == expected(CLOSE_SIZE));
+  // the next request to the same origin does not use the closed connection
+  EXPECT(download(request, "/small.bin") == expected(SMALL_SIZE));
+  EXPECT_EQ(request.idle_connections(), 1u);
+
+  auto missing = request.get(url("/missing"));
+  EXPECT(missing != nullptr && missing->status_code == 404);
+  if (missing != nullptr)
+    missing->end();
+}
+
+static void test_closed_kept_connection() {
+  TestHttpRequest request;
+  EXPECT(download(request, "/small.bin") == expected(SMALL_SIZE));
+  EXPECT_EQ(request.idle_connections(), 1u);
+
+  // a GET is sent again on a new connection
+  server->close_idle();
+  usleep(10000);
+  int connections = server->connections();
+  EXPECT(download(request, "/small.bin") == expected(SMALL_SIZE));
+  EXPECT_EQ(server->connections() - connections, 1);
+
+  // a POST is never sent on a kept connection, it would be sent twice if the server acted on it before closing
+  auto posts = []() {
+    auto requests = server->requests();
+    return std::count(requests.begin(), requests.end(), "POST /post");
+  };
+  connections = server->connections();
+  auto container = request.post(url("/post"), "value=1");
+  EXPECT(container != nullptr && container->status_code == 200);
+  if (container != nullptr)
+    container->end();
+  EXPECT_EQ(server->connections() - connections, 1);
+  EXPECT_EQ(posts(), 1);
+
+  // and the server closing the kept connection doesn't matter to it
+  server->close_idle();
+  usleep(10000);
+  container = request.post(url("/post"), "value=2");
+  EXPECT(container != nullptr && container->status_code == 200);
+  if (container != nullptr)
+    container->end();
+  EXPECT_EQ(posts(), 2);
+}
+
+// Heap in use by the main thread. glibc keeps freed blocks in per-thread caches, so its own statistics don't show a
+// buffer that is freed and allocated again. The allocator is replaced in the optimized build only, ASan has its own.
+static size_t heap_in_use = 0;                  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+static size_t heap_peak = 0;                    // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+static thread_local bool heap_counted = false;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+#ifndef __SANITIZE_ADDRESS__
+extern "C" {
+// NOLINTBEGIN
+void *__libc_malloc(size_t size);
+void *__libc_calloc(size_t n, size_t size);
+void *__libc_realloc(void *ptr, size_t size);
+void __libc_free(void *ptr);
+
+static void *count_alloc(void *ptr) {
+  if (ptr != nullptr && heap_counted) {
+    heap_in_use += malloc_usable_size(ptr);
+    heap_peak = std::max(heap_peak, heap_in_use);
+  }
+  return ptr;
+}
+static void count_free(void *ptr) {
+  if (ptr != nullptr && heap_counted)
+    heap_in_use -= std::min(heap_in_use, malloc_usable_size(ptr));
+}
+void *malloc(size_t size) { return count_alloc(__libc_malloc(size)); }
+void *calloc(size_t n, size_t size) { return count_alloc(__libc_calloc(n, size)); }
+void *realloc(void *ptr, size_t size) {
+  count_free(ptr);
+  return count_alloc(__libc_realloc(ptr, size));
+}
+void free(void *ptr) {
+  count_free(ptr);
+  __libc_free(ptr);
+}
+// NOLINTEND
+}
+#endif
+
+/// Start counting the peak heap in use from now on.
+static size_t heap_mark() {
+  heap_peak = heap_in_use;
+  return heap_in_use;
+}
+
+static void bench_download() {
+  heap_counted = true;
+  TestHttpRequest request;
+  download(request, "/small.bin");
+  // the old way of the OTA and update components: read() into a fixed buffer
+  {
+    size_t base = heap_mark();
+    uint64_t start = host_test::now_us();
+    auto container = request.get(url("/firmware.bin"));
+    uint8_t buf[256];
+    while (container->get_bytes_read() < container->content_length) {
+      if (container->read(buf, sizeof(buf)) < 0)
+        break;
+    }
+    container->end();
+    double us = host_test::now_us() - start;
+    printf("4 MB with read() of 256 bytes: %6.1f MB/s, peak heap %zu bytes\n", FIRMWARE_SIZE / us,
+           heap_peak - base);
+  }
+  for (size_t chunk_size : {256, 1024, 4096, 16384}) {
+    size_t base = heap_mark(), received = 0;
+    uint64_t start = host_test::now_us();
+    auto container = request.get(url("/firmware.bin"));
+    container->stream(
+        [&](uint8_t *, size_t len) {
+          received += len;
+          return (int) len;
+        },
+        chunk_size);
+    container->end();
+    double us = host_test::now_us() - start;
+    printf("4 MB with stream() in %5zu byte chunks: %6.1f MB/s, peak heap %zu bytes\n", chunk_size, received / us,
+           heap_peak - base);
+  }
+  for (bool keep_alive : {false, true}) {
+    request.set_keep_alive(keep_alive);
+    const int rounds = 300;
+    uint64_t start = host_test::now_us();
+    for (int i = 0; i < rounds; i++)
+      download(request, "/small.bin");
+    double us = host_test::now_us() - start;
+    printf("%d requests of 1 kB, keep_alive %s: %.0f requests/s\n", rounds, keep_alive ? "on" : "off",
+           rounds / us * 1e6);
+  }
+}
+
+int main(int argc, char **argv) {
+  server = new Server();  // NOLINT
+  test_stream();
+  test_backpressure();
+  test_keep_alive();
+  test_redirect_and_close();
+  test_closed_kept_connection();
+  if (host_test::bench_mode(argc, argv))
+    bench_download();
+  return host_test::result();
+}
@@ -0,0 +1,476 @@
+// The I2C transaction scheduler on a mock bus: conversions of many devices share their wait time, and the devices
+// ported to it (bme280_i2c, ads1115, ina2xx_i2c) report the same values as through their direct register access.
+#include "host_test.h"
+
+#include "esphome/components/ads1115/sensor/ads1115_sensor.h"
+#include "esphome/components/bme280_i2c/bme280_i2c.h"
+#include "esphome/components/i2c/i2c_scheduler.h"
+#include "esphome/components/ina2xx_i2c/ina2xx_i2c.h"
+#include "esphome/core/application.h"
+#include "esphome/core/hal.h"
+
+#include <cmath>
+#include <map>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+using namespace esphome;
+using i2c::ErrorCode;
+
+/// A device on the mock bus, it sees the bytes of each transfer.
+class MockDevice {
+ public:
+  virtual ~MockDevice() = default;
+  virtual void write(const std::vector<uint8_t> &data) = 0;
+  virtual void read(uint8_t *data, size_t len) = 0;
+};
+
+/// An I2C bus that passes transfers to the mock devices and counts them. Missing devices don't acknowledge.
+class MockBus : public i2c::I2CBus {
+ public:
+  ErrorCode readv(uint8_t address, i2c::ReadBuffer *buffers, size_t count) override {
+    this->transfers++;
+    auto it = this->devices.find(address);
+    if (it == this->devices.end())
+      return i2c::ERROR_NOT_ACKNOWLEDGED;
+    for (size_t i = 0; i < count; i++)
+      it->second->read(buffers[i].data, buffers[i].len);
+    return i2c::ERROR_OK;
+  }
+  ErrorCode writev(uint8_t address, i2c::WriteBuffer *buffers, size_t count, bool stop) override {
+    this->transfers++;
+    auto it = this->devices.find(address);
+    if (it == this->devices.end())
+      return i2c::ERROR_NOT_ACKNOWLEDGED;
+    std::vector<uint8_t> data;
+    for (size_t i = 0; i < count; i++)
+      data.insert(data.end(), buffers[i].data, buffers[i].data + buffers[i].len);
+    it->second->write(data);
+    return i2c::ERROR_OK;
+  }
+
+  std::map<uint8_t, MockDevice *> devices;
+  uint32_t transfers{0};
+};
+
+/// Byte wide registers with an auto-incrementing register pointer, like the BME280.
+class ByteRegisterDevice : public MockDevice {
+ public:
+  void write(const std::vector<uint8_t> &data) override {
+    if (data.empty())
+      return;
+    this->pointer = data[0];
+    for (size_t i = 1; i < data.size(); i++)
+      this->registers[this->pointer++] = data[i];
+  }
+  void read(uint8_t *data, size_t len) override {
+    for (size_t i = 0; i < len; i++)
+      data[i] = this->registers[this->pointer++];
+  }
+  void set_u16_le(uint8_t reg, uint16_t value) {
+    this->registers[reg] = value & 0xFF;
+    this->registers[reg + 1] = value >> 8;
+  }
+
+  uint8_t registers[256]{};
+  uint8_t pointer{0};
+};
+
+/// Registers of different sizes that are read as a whole, like those of the ADS1115 and the INA2xx.
+class WordRegisterDevice : public MockDevice {
+ public:
+  void write(const std::vector<uint8_t> &data) override {
+    if (data.empty())
+      return;
+    this->pointer = data[0];
+    if (data.size() > 1) {
+      this->registers[this->pointer] = std::vector<uint8_t>(data.begin() + 1, data.end());
+      this->on_register_write(this->pointer);
+    }
+  }
+  void read(uint8_t *data, size_t len) override {
+    const auto &value = this->registers[this->pointer];
+    for (size_t i = 0; i < len; i++)
+      data[i] = i < value.size() ? value[i] : 0;
+  }
+  virtual void on_register_write(uint8_t reg) {}
+
+  std::map<uint8_t, std::vector<uint8_t>> registers;
+  uint8_t pointer{0};
+};
+
+/// Run the main loop for the given simulated time, counting the passes that used the bus.
+static uint32_t run_loop(MockBus &bus, uint32_t ms) {
+  uint32_t passes = 0;
+  for (uint32_t i = 0; i < ms; i++) {
+    uint32_t transfers = bus.transfers;
+    App.scheduler.call();
+    if (bus.transfers != transfers)
+      passes++;
+    host_test::advance_time_ms(1);
+  }
+  return passes;
+}
+
+static_assert(std::is_same<decltype(i2c::I2CTransactionStats::bus_time_us), uint64_t>::value,
+              "the total bus time must not overflow after about an hour");
+
+/// Answers every read with its address followed by an incrementing count.
+class EchoDevice : public MockDevice {
+ public:
+  explicit EchoDevice(uint8_t address) : address_(address) {}
+  void write(const std::vector<uint8_t> &data) override {}
+  void read(uint8_t *data, size_t len) override {
+    for (size_t i = 0; i < len; i++)
+      data[i] = this->address_ + i;
+  }
+
+ protected:
+  uint8_t address_;
+};
+
+static const uint8_t MEASURE_COMMAND = 0xFD;
+
+class MeasuringDevice : public i2c::I2CDevice {
+ public:
+  MeasuringDevice(MockBus *bus, uint8_t address, uint32_t conversion_ms) {
+    this->set_i2c_bus(bus);
+    this->set_i2c_address(address);
+    this->transaction.write(&MEASURE_COMMAND, 1).delay(conversion_ms).read(this->data, 6);
+    this->transaction.set_callback([this](ErrorCode err) {
+      if (err == i2c::ERROR_OK && this->data[0] == this->get_i2c_address() && this->data[5] == this->data[0] + 5) {
+        this->ok++;
+      } else {
+        this->failed++;
+      }
+    });
+  }
+
+  i2c::I2CTransaction transaction{this};
+  uint8_t data[6];
+  uint32_t ok{0};
+  uint32_t failed{0};
+};
+
+static void test_shared_conversions() {
+  MockBus bus;
+  i2c::I2CScheduler scheduler;
+  std::vector<std::unique_ptr<EchoDevice>> echos;
+  std::vector<std::unique_ptr<MeasuringDevice>> devices;
+  for (uint8_t i = 0; i < 12; i++) {
+    uint8_t address = 0x40 + i;
+    echos.push_back(std::make_unique<EchoDevice>(address));
+    bus.devices[address] = echos.back().get();
+    // conversions of 8 to 11 ms
+    devices.push_back(std::make_unique<MeasuringDevice>(&bus, address, 8 + i % 4));
+  }
+  // not connected
+  devices.push_back(std::make_unique<MeasuringDevice>(&bus, 0x7F, 10));
+
+  const uint32_t cycles = 20;
+  uint32_t passes = 0;
+  for (uint32_t cycle = 0; cycle < cycles; cycle++) {
+    for (auto &device : devices)
+      EXPECT(scheduler.submit(&device->transaction));
+    // a transaction can't be submitted again while it is pending
+    EXPECT(!scheduler.submit(&devices[0]->transaction));
+    passes += run_loop(bus, 100);
+  }
+
+  for (uint8_t i = 0; i < 12; i++) {
+    EXPECT_EQ(devices[i]->ok, cycles);
+    EXPECT_EQ(devices[i]->failed, 0u);
+    EXPECT_EQ(devices[i]->transaction.get_stats().transactions, cycles);
+  }
+  EXPECT_EQ(devices[12]->failed, cycles);
+  EXPECT_EQ(devices[12]->transaction.get_stats().errors, cycles);
+  // the commands go out in one pass and the reads of all devices in another, instead of one wake up per device and step
+  EXPECT_EQ(passes, 2 * cycles);
+  EXPECT_EQ(scheduler.get_transactions().size(), devices.size());
+}
+
+static void test_read_register_step() {
+  MockBus bus;
+  i2c::I2CScheduler scheduler;
+  ByteRegisterDevice mock;
+  for (int i = 0; i < 256; i++)
+    mock.registers[i] = i;
+  bus.devices[0x10] = &mock;
+  i2c::I2CDevice device;
+  device.set_i2c_bus(&bus);
+  device.set_i2c_address(0x10);
+
+  uint8_t data[3]{};
+  ErrorCode result = i2c::ERROR_UNKNOWN;
+  i2c::I2CTransaction transaction(&device);
+  transaction.read_register(0x20, data, 3);
+  transaction.set_callback([&result](ErrorCode err) { result = err; });
+  EXPECT(scheduler.submit(&transaction));
+  run_loop(bus, 2);
+  EXPECT_EQ(result, i2c::ERROR_OK);
+  EXPECT_EQ(data[0], 0x20);
+  EXPECT_EQ(data[2], 0x22);
+  // the register address and the read
+  EXPECT_EQ(bus.transfers, 2u);
+}
+
+/// A BME280 with the calibration and readings of the example in the datasheet.
+class MockBME280 : public ByteRegisterDevice {
+ public:
+  MockBME280() {
+    this->registers[0xD0] = 0x60;
+    const uint16_t calibration[] = {27504, 26435, (uint16_t) -1000, 36477, (uint16_t) -10685, 3024,
+                                    2855,  140,   (uint16_t) -7,    15500, (uint16_t) -14600, 6000};
+    for (size_t i = 0; i < 12; i++)
+      this->set_u16_le(0x88 + 2 * i, calibration[i]);
+    this->registers[0xA1] = 75;
+    this->set_u16_le(0xE1, 362);
+    this->registers[0xE3] = 0;
+    // h4 = 313, h5 = 50
+    this->registers[0xE4] = 313 >> 4;
+    this->registers[0xE5] = (313 & 0x0F) | ((50 & 0x0F) << 4);
+    this->registers[0xE6] = 50 >> 4;
+    this->registers[0xE7] = 30;
+    // pressure 415148, temperature 519888, humidity 0x6000
+    const uint8_t measurement[] = {0x65, 0x5A, 0xC0, 0x7E, 0xED, 0x00, 0x60, 0x00};
+    for (size_t i = 0; i < sizeof(measurement); i++)
+      this->registers[0xF7 + i] = measurement[i];
+  }
+};
+
+struct BME280Sensors {
+  sensor::Sensor temperature;
+  sensor::Sensor pressure;
+  sensor::Sensor humidity;
+};
+
+static void setup_bme280(bme280_i2c::BME280I2CComponent &bme, BME280Sensors &sensors, MockBus *bus, uint8_t address,
+                         i2c::I2CScheduler *scheduler) {
+  bme.set_i2c_bus(bus);
+  bme.set_i2c_address(address);
+  bme.set_i2c_scheduler(scheduler);
+  bme.set_temperature_sensor(&sensors.temperature);
+  bme.set_pressure_sensor(&sensors.pressure);
+  bme.set_humidity_sensor(&sensors.humidity);
+  bme.set_update_interval(3600000);
+  bme.call();
+  EXPECT(!bme.is_failed());
+}
+
+static void test_bme280() {
+  MockBus bus;
+  i2c::I2CScheduler scheduler;
+  MockBME280 direct_mock, scheduled_mock;
+  bus.devices[0x76] = &direct_mock;
+  bus.devices[0x77] = &scheduled_mock;
+  bme280_i2c::BME280I2CComponent direct, scheduled;
+  BME280Sensors direct_sensors, scheduled_sensors;
+  setup_bme280(direct, direct_sensors, &bus, 0x76, nullptr);
+  setup_bme280(scheduled, scheduled_sensors, &bus, 0x77, &scheduler);
+
+  direct.update();
+  scheduled.update();
+  run_loop(bus, 200);
+  // the forced measurement was started with the configured oversampling
+  EXPECT_EQ(scheduled_mock.registers[0xF4], direct_mock.registers[0xF4]);
+  EXPECT_EQ(scheduled_mock.registers[0xF4], (0b101 << 5) | (0b101 << 2) | 0b01);
+
+  EXPECT(std::fabs(scheduled_sensors.temperature.state - 25.08f) < 0.01f);
+  EXPECT(std::fabs(scheduled_sensors.pressure.state - 1006.53f) < 0.01f);
+  EXPECT(scheduled_sensors.humidity.state > 0.0f && scheduled_sensors.humidity.state <= 100.0f);
+  EXPECT_EQ(scheduled_sensors.temperature.state, direct_sensors.temperature.state);
+  EXPECT_EQ(scheduled_sensors.pressure.state, direct_sensors.pressure.state);
+  EXPECT_EQ(scheduled_sensors.humidity.state, direct_sensors.humidity.state);
+  EXPECT_EQ(scheduler.get_transactions()[0]->get_stats().transactions, 1u);
+  EXPECT_EQ(scheduler.get_transactions()[0]->get_stats().errors, 0u);
+
+  // A missing device is reported through the callback
+  bus.devices.erase(0x77);
+  scheduled.update();
+  run_loop(bus, 200);
+  EXPECT(scheduled.status_has_warning());
+  EXPECT_EQ(scheduler.get_transactions()[0]->get_stats().errors, 1u);
+}
+
+/// An ADS1115 in single shot mode, each channel converts to its own value.
+class MockADS1115 : public WordRegisterDevice {
+ public:
+  MockADS1115() {
+    this->registers[0x00] = {0, 0};
+    this->registers[0x01] = {0x85, 0x83};
+  }
+  void write(const std::vector<uint8_t> &data) override {
+    if (data.size() > 1 && data[0] == 0x01 && this->converting_())
+      this->overlapping++;
+    WordRegisterDevice::write(data);
+  }
+  void read(uint8_t *data, size_t len) override {
+    if (this->pointer == 0x01) {
+      auto &config = this->registers[0x01];
+      config[0] = (config[0] & 0x7F) | (this->converting_() ? 0 : 0x80);
+    }
+    WordRegisterDevice::read(data, len);
+  }
+  void on_register_write(uint8_t reg) override {
+    if (reg != 0x01 || (this->registers[0x01][0] & 0x80) == 0)
+      return;
+    uint8_t multiplexer = (this->registers[0x01][0] >> 4) & 0b111;
+    uint16_t value = 1000 * (multiplexer + 1);
+    this->registers[0x00] = {(uint8_t) (value >> 8), (uint8_t) (value & 0xFF)};
+    this->done_at_ = millis() + 2;
+  }
+
+  uint32_t overlapping{0};
+
+ protected:
+  bool converting_() const { return (int32_t) (millis() - this->done_at_) < 0; }
+
+  uint32_t done_at_{0};
+};
+
+static void test_ads1115() {
+  const ads1115::ADS1115Multiplexer channels[] = {
+      ads1115::ADS1115_MULTIPLEXER_P0_NG, ads1115::ADS1115_MULTIPLEXER_P1_NG, ads1115::ADS1115_MULTIPLEXER_P2_NG,
+      ads1115::ADS1115_MULTIPLEXER_P3_NG};
+  MockBus bus;
+  i2c::I2CScheduler scheduler;
+  std::vector<float> values[2];
+  for (int scheduled = 0; scheduled < 2; scheduled++) {
+    MockADS1115 mock;
+    bus.devices[0x48] = &mock;
+    ads1115::ADS1115Component ads;
+    ads.set_i2c_bus(&bus);
+    ads.set_i2c_address(0x48);
+    ads.set_continuous_mode(false);
+    ads.set_i2c_scheduler(scheduled ? &scheduler : nullptr);
+    ads.call();
+    EXPECT(!ads.is_failed());
+
+    std::vector<std::unique_ptr<ads1115::ADS1115Sensor>> sensors;
+    for (auto channel : channels) {
+      sensors.push_back(std::make_unique<ads1115::ADS1115Sensor>());
+      sensors.back()->set_parent(&ads);
+      sensors.back()->set_multiplexer(channel);
+      sensors.back()->set_gain(ads1115::ADS1115_GAIN_4P096);
+      sensors.back()->set_resolution(ads1115::ADS1115_16_BITS);
+    }
+    // all channels are due at once, they must still be converted one after the other
+    for (auto &sensor : sensors)
+      sensor->update();
+    run_loop(bus, 50);
+    for (auto &sensor : sensors)
+      values[scheduled].push_back(sensor->state);
+    EXPECT_EQ(mock.overlapping, 0u);
+    EXPECT(!ads.status_has_warning());
+  }
+  for (size_t i = 0; i < 4; i++) {
+    EXPECT_EQ(values[1][i], (1000 * (4 + i + 1) * 4096) / 32768.0f / 1e3f);
+    EXPECT_EQ(values[1][i], values[0][i]);
+  }
+}
+
+/// An INA228 with a reading in every data register.
+class MockINA228 : public WordRegisterDevice {
+ public:
+  MockINA228() {
+    this->registers[0x3E] = {0x54, 0x49};
+    this->registers[0x3F] = {0x22, 0x81};
+    this->registers[0x04] = {0x01, 0x23, 0x40};
+    this->registers[0x05] = {0x32, 0x00, 0x00};
+    this->registers[0x06] = {0x0C, 0x80};
+    this->registers[0x07] = {0x04, 0x56, 0x70};
+    this->registers[0x08] = {0x00, 0x45, 0x67};
+    this->registers[0x09] = {0x00, 0x00, 0x12, 0x34, 0x56};
+    this->registers[0x0A] = {0x00, 0x00, 0x00, 0x65, 0x43};
+    this->registers[0x0B] = {0x00, 0x01};
+  }
+};
+
+struct INASensors {
+  sensor::Sensor shunt_voltage, bus_voltage, die_temperature, current, power, energy, charge;
+};
+
+static void test_ina2xx() {
+  MockBus bus;
+  i2c::I2CScheduler scheduler;
+  MockINA228 direct_mock, scheduled_mock;
+  bus.devices[0x40] = &direct_mock;
+  bus.devices[0x41] = &scheduled_mock;
+  ina2xx_i2c::INA2XXI2C inas[2];
+  INASensors sensors[2];
+  for (int scheduled = 0; scheduled < 2; scheduled++) {
+    auto &ina = inas[scheduled];
+    auto &s = sensors[scheduled];
+    ina.set_i2c_bus(&bus);
+    ina.set_i2c_address(0x40 + scheduled);
+    ina.set_i2c_scheduler(scheduled ? &scheduler : nullptr);
+    ina.set_model(ina2xx_base::INA_228);
+    ina.set_shunt_resistance_ohm(0.01f);
+    ina.set_max_current_a(10.0f);
+    ina.set_shunt_voltage_sensor(&s.shunt_voltage);
+    ina.set_bus_voltage_sensor(&s.bus_voltage);
+    ina.set_die_temperature_sensor(&s.die_temperature);
+    ina.set_current_sensor(&s.current);
+    ina.set_power_sensor(&s.power);
+    ina.set_energy_sensor_j(&s.energy);
+    ina.set_charge_sensor_c(&s.charge);
+    ina.set_update_interval(3600000);
+    ina.call();
+    EXPECT(!ina.is_failed());
+  }
+
+  inas[0].update();
+  inas[1].update();
+  uint32_t passes = run_loop(bus, 5);
+  EXPECT_EQ(passes, 1u);
+  // the data collection steps of the scheduled one use the registers read in that pass
+  uint32_t transfers = bus.transfers;
+  for (int i = 0; i < 10; i++)
+    inas[1].call();
+  EXPECT_EQ(bus.transfers, transfers);
+  for (int i = 0; i < 10; i++)
+    inas[0].call();
+  EXPECT(bus.transfers > transfers);
+
+  for (auto member : {&INASensors::shunt_voltage, &INASensors::bus_voltage, &INASensors::die_temperature,
+                      &INASensors::current, &INASensors::power, &INASensors::energy, &INASensors::charge}) {
+    EXPECT((sensors[1].*member).has_state());
+    EXPECT_EQ((sensors[1].*member).state, (sensors[0].*member).state);
+  }
+  EXPECT(!inas[1].status_has_warning());
+}
+
+static void bench_shared_conversions() {
+  MockBus bus;
+  i2c::I2CScheduler scheduler;
+  std::vector<std::unique_ptr<EchoDevice>> echos;
+  std::vector<std::unique_ptr<MeasuringDevice>> devices;
+  for (uint8_t i = 0; i < 12; i++) {
+    echos.push_back(std::make_unique<EchoDevice>(0x40 + i));
+    bus.devices[0x40 + i] = echos.back().get();
+    devices.push_back(std::make_unique<MeasuringDevice>(&bus, 0x40 + i, 8 + i % 4));
+  }
+  const uint32_t cycles = 1000;
+  uint32_t passes = 0;
+  uint64_t start = host_test::now_us();
+  for (uint32_t cycle = 0; cycle < cycles; cycle++) {
+    for (auto &device : devices)
+      scheduler.submit(&device->transaction);
+    passes += run_loop(bus, 20);
+  }
+  uint64_t elapsed = host_test::now_us() - start;
+  printf("12 devices: %.2f bus passes per cycle (%zu without the scheduler), %.1f us per cycle\n",
+         (double) passes / cycles, devices.size() * 2, (double) elapsed / cycles);
+}
+
+int main(int argc, char **argv) {
+  test_shared_conversions();
+  test_read_register_step();
+  test_bme280();
+  test_ads1115();
+  test_ina2xx();
+  if (host_test::bench_mode(argc, argv))
+    bench_shared_conversions();
+  return host_test::result();
+}
@@ -0,0 +1,193 @@
+// Light transitions run by the shared transition engine: lights are only looped while busy, transitions end on
+// time and follow the smoothed progress, the frame rate limit, skipped frames of slow transitions, and flashes.
+#include "host_test.h"
+
+#include "esphome/components/light/light_output.h"
+#include "esphome/components/light/light_state.h"
+#include "esphome/components/light/light_transition_engine.h"
+#include "esphome/core/application.h"
+
+#include <cmath>
+#include <vector>
+
+using namespace esphome;
+using namespace esphome::light;
+
+static const uint32_t LOOP_INTERVAL = 16;
+
+struct Write {
+  uint32_t at;
+  float brightness;
+};
+
+class TestOutput : public LightOutput {
+ public:
+  LightTraits get_traits() override {
+    LightTraits traits;
+    traits.set_supported_color_modes({ColorMode::BRIGHTNESS});
+    return traits;
+  }
+  void write_state(LightState *state) override {
+    float brightness;
+    state->current_values_as_brightness(&brightness);
+    this->writes.push_back(Write{millis(), brightness});
+  }
+
+  std::vector<Write> writes;
+};
+
+static LightTransitionEngine *engine;
+static std::vector<LightState *> lights;
+static std::vector<TestOutput *> outputs;
+
+/// One main loop iteration, LOOP_INTERVAL after the previous one.
+static void step() {
+  host_test::advance_time_ms(LOOP_INTERVAL);
+  App.loop();
+}
+
+/// Start a transition of the light and run the main loop until it reached the target. Returns the start time and
+/// sets `duration` to the time it took.
+static uint32_t transition(size_t index, float brightness, uint32_t length, uint32_t *duration) {
+  uint32_t reached = 0;
+  lights[index]->add_new_target_state_reached_callback([&reached]() {
+    if (reached == 0)
+      reached = millis();
+  });
+  outputs[index]->writes.clear();
+  uint32_t start = millis();
+  lights[index]->make_call().set_state(true).set_brightness(brightness).set_transition_length(length).perform();
+  while (reached == 0 && millis() - start < length + 1000)
+    step();
+  *duration = reached - start;
+  return start;
+}
+
+static void test_idle_lights_leave_the_engine() {
+  // the initial states are applied with the default transition length
+  for (int i = 0; i < 200 && !engine->get_active_lights().empty(); i++)
+    step();
+  EXPECT(engine->get_active_lights().empty());
+  for (auto *output : outputs)
+    EXPECT(output->writes.size() <= 3);
+
+  // idle lights are not called from the main loop
+  size_t writes = 0;
+  for (auto *output : outputs)
+    writes += output->writes.size();
+  for (int i = 0; i < 100; i++)
+    step();
+  size_t writes_after = 0;
+  for (auto *output : outputs)
+    writes_after += output->writes.size();
+  EXPECT_EQ(writes_after, writes);
+}
+
+static void test_transition() {
+  uint32_t duration;
+  uint32_t start = transition(0, 1.0f, 1000, &duration);
+  // the transition ends within one loop iteration of its length
+  EXPECT(duration >= 1000 && duration <= 1000 + LOOP_INTERVAL);
+  EXPECT(!outputs[0]->writes.empty() && outputs[0]->writes.back().brightness == 1.0f);
+  // the values in between follow the smoothed progress
+  for (const auto &write : outputs[0]->writes) {
+    float progress = std::min(1.0f, (write.at - start) / 1000.0f);
+    float smoothed = progress * progress * progress * (progress * (progress * 6 - 15) + 10);
+    if (std::abs(write.brightness - smoothed) >= 0.002f) {
+      printf("at %u ms: %f, expected %f\n", write.at - start, write.brightness, smoothed);
+      EXPECT(false);
+    }
+  }
+  for (int i = 0; i < 3; i++)
+    step();
+  EXPECT(engine->get_active_lights().empty());
+}
+
+static void test_frame_rate() {
+  // light 1 runs at 25 fps
+  uint32_t duration;
+  transition(1, 1.0f, 1000, &duration);
+  EXPECT(duration >= 1000 && duration <= 1000 + LOOP_INTERVAL);
+  const auto &writes = outputs[1]->writes;
+  EXPECT(writes.size() > 10 && writes.size() <= 27);
+  // the last frame is written when the transition ends, however soon after the previous one
+  for (size_t i = 1; i + 1 < writes.size(); i++)
+    EXPECT(writes[i].at - writes[i - 1].at >= 40);
+  EXPECT(!writes.empty() && writes.back().brightness == 1.0f);
+}
+
+static void test_slow_transition_skips_frames() {
+  lights[2]->make_call().set_state(true).set_brightness(0.5f).set_transition_length(0).perform();
+  step();
+  uint32_t duration;
+  transition(2, 0.51f, 600000, &duration);
+  EXPECT(duration >= 600000 && duration <= 600000 + LOOP_INTERVAL);
+  // 37500 frames, but most of them round to the same 16 bit output as the frame before
+  EXPECT(outputs[2]->writes.size() < 700);
+  EXPECT(!outputs[2]->writes.empty() && outputs[2]->writes.back().brightness == 0.51f);
+}
+
+static void test_flash() {
+  outputs[3]->writes.clear();
+  uint32_t start = millis();
+  lights[3]->make_call().set_state(true).set_flash_length(500).perform();
+  while (millis() - start < 2000)
+    step();
+  uint32_t off_at = 0;
+  for (const auto &write : outputs[3]->writes) {
+    if (write.brightness == 0.0f && write.at > start) {
+      off_at = write.at;
+      break;
+    }
+  }
+  EXPECT(off_at - start >= 500 && off_at - start <= 500 + LOOP_INTERVAL);
+}
+
+static void bench_idle_loop() {
+  // the cost of 20 idle lights per main loop iteration, without and with the engine
+  const int rounds = 200000;
+  uint64_t start = host_test::now_us();
+  for (int i = 0; i < rounds; i++) {
+    for (auto *light : lights)
+      light->loop();
+  }
+  double looped_ns = (double) (host_test::now_us() - start) * 1000 / rounds;
+  // the engine disables its loop while no light is busy, this is the cost if it was called anyway
+  start = host_test::now_us();
+  for (int i = 0; i < rounds; i++)
+    engine->loop();
+  double engine_ns = (double) (host_test::now_us() - start) * 1000 / rounds;
+  printf("20 idle lights: %.0f ns per loop iteration when looped, %.1f ns through the engine\n", looped_ns,
+         engine_ns);
+}
+
+int main(int argc, char **argv) {
+  App.pre_setup("light", "", "", "", "", false);
+  App.set_loop_interval(LOOP_INTERVAL);
+  engine = new LightTransitionEngine();  // NOLINT
+  for (int i = 0; i < 20; i++) {
+    auto *output = new TestOutput();            // NOLINT
+    auto *light = new LightState(output);       // NOLINT
+    light->set_component_source("light");
+    light->set_restore_mode(LIGHT_ALWAYS_OFF);
+    light->set_gamma_correct(1.0f);
+    light->set_default_transition_length(1000);
+    if (i == 1)
+      light->set_transition_frame_interval(40);
+    App.register_component(light);
+    light->set_transition_engine(engine);
+    outputs.push_back(output);
+    lights.push_back(light);
+  }
+  App.register_component(engine);
+  App.setup();
+
+  test_idle_lights_leave_the_engine();
+  test_transition();
+  test_frame_rate();
+  test_slow_transition_skips_frames();
+  test_flash();
+  if (host_test::bench_mode(argc, argv))
+    bench_idle_loop();
+  return host_test::result();
+}
@@ -0,0 +1,166 @@
+// The set commands of the Nextion queue: while a set of a variable waits for its acknowledgement only the latest
+// newer value is kept, sets that were never acknowledged stop holding back newer values, and the queue entries of
+// acknowledged sets are reused.
+#include "host_test.h"
+#include "mock_uart.h"
+
+#include "esphome/components/nextion/nextion.h"
+
+#include <string>
+
+using namespace esphome;
+
+class TestNextion : public nextion::Nextion {
+ public:
+  /// Skip the connection handshake.
+  void set_connected() {
+    this->is_setup_ = true;
+    this->is_connected_ = true;
+    this->sent_setup_commands_ = true;
+    this->nextion_reports_is_setup_ = true;
+  }
+  /// Handle what the display sent and age out the queue, as loop() does once connected.
+  void process() {
+    this->process_serial_();
+    this->process_nextion_commands_();
+  }
+  size_t pool_size() const { return this->queue_pool_.size(); }
+  nextion::NextionQueue *last_entry() const { return this->nextion_queue_.back(); }
+};
+
+/// The commands written to the display since the last call, separated by '|'.
+static std::string sent(host_test::MockUARTComponent &uart) {
+  std::string commands;
+  for (uint8_t c : uart.tx) {
+    if (c == 0xFF) {
+      if (commands.empty() || commands.back() != '|')
+        commands += '|';
+    } else {
+      commands += (char) c;
+    }
+  }
+  uart.tx.clear();
+  return commands;
+}
+
+/// The display acknowledges `count` commands.
+static void acknowledge(TestNextion &nextion, host_test::MockUARTComponent &uart, int count) {
+  for (int i = 0; i < count; i++)
+    uart.feed(std::vector<uint8_t>{0x01, 0xFF, 0xFF, 0xFF});
+  host_test::advance_time_ms(20);
+  nextion.process();
+}
+
+static void test_coalescing() {
+  host_test::MockUARTComponent uart;
+  TestNextion nextion;
+  nextion.set_uart_parent(&uart);
+  nextion.set_connected();
+
+  for (int value = 0; value < 50; value++) {
+    nextion.add_no_result_to_queue_with_set("n0", "n0.val", value);
+    nextion.add_no_result_to_queue_with_set("t0", "t0.txt", std::to_string(value));
+  }
+  // the first set of each variable is sent, the latest of the others waits for its acknowledgement
+  EXPECT(sent(uart) == "n0.val=0|t0.txt=\"0\"|");
+  EXPECT_EQ(nextion.queue_size(), 2u);
+
+  acknowledge(nextion, uart, 2);
+  EXPECT(sent(uart) == "n0.val=49|t0.txt=\"49\"|");
+  EXPECT_EQ(nextion.queue_size(), 2u);
+
+  acknowledge(nextion, uart, 2);
+  EXPECT(sent(uart).empty());
+  EXPECT_EQ(nextion.queue_size(), 0u);
+
+  const auto &stats = nextion.get_queue_stats();
+  EXPECT_EQ(stats.acknowledged, 4u);
+  EXPECT_EQ(stats.coalesced, 96u);
+  EXPECT_EQ(stats.max_depth, 2u);
+  EXPECT(stats.max_latency_ms >= 20);
+}
+
+static void test_lost_acknowledgement() {
+  host_test::MockUARTComponent uart;
+  TestNextion nextion;
+  nextion.set_uart_parent(&uart);
+  nextion.set_connected();
+
+  // the set that waits is sent once the unacknowledged one ages out of the queue
+  nextion.add_no_result_to_queue_with_set("n0", "n0.val", 100);
+  nextion.add_no_result_to_queue_with_set("n0", "n0.val", 101);
+  nextion.add_no_result_to_queue_with_set("n0", "n0.val", 102);
+  EXPECT(sent(uart) == "n0.val=100|");
+  host_test::advance_time_ms(9000);
+  // the queue is checked for old entries whenever the display sends something
+  uart.feed(std::vector<uint8_t>{0x88, 0xFF, 0xFF, 0xFF});
+  nextion.process();
+  EXPECT(sent(uart) == "n0.val=102|");
+  EXPECT_EQ(nextion.queue_size(), 1u);
+
+  // a new value doesn't wait for a set that is older than the queue age limit
+  host_test::advance_time_ms(9000);
+  nextion.add_no_result_to_queue_with_set("n0", "n0.val", 103);
+  EXPECT(sent(uart) == "n0.val=103|");
+}
+
+static void test_pool() {
+  host_test::MockUARTComponent uart;
+  TestNextion nextion;
+  nextion.set_uart_parent(&uart);
+  nextion.set_connected();
+
+  for (int i = 0; i < 12; i++)
+    nextion.add_no_result_to_queue_with_set("n" + std::to_string(i), "n" + std::to_string(i) + ".val", i);
+  EXPECT_EQ(nextion.queue_size(), 12u);
+  acknowledge(nextion, uart, 12);
+  EXPECT_EQ(nextion.queue_size(), 0u);
+  // the pool is bounded
+  EXPECT_EQ(nextion.pool_size(), 8u);
+
+  // the next set takes its entry from the pool and names it after the new variable
+  nextion.add_no_result_to_queue_with_set("t0", "t0.txt", "text");
+  EXPECT_EQ(nextion.pool_size(), 7u);
+  EXPECT(nextion.last_entry()->component->get_variable_name() == "t0");
+  acknowledge(nextion, uart, 1);
+  EXPECT_EQ(nextion.pool_size(), 8u);
+}
+
+static void bench_burst() {
+  host_test::MockUARTComponent uart;
+  TestNextion nextion;
+  nextion.set_uart_parent(&uart);
+  nextion.set_connected();
+  const int rounds = 2000;
+  const int variables = 8;
+  std::string names[variables], names_to_send[variables];
+  for (int i = 0; i < variables; i++) {
+    names[i] = "n" + std::to_string(i);
+    names_to_send[i] = names[i] + ".val";
+  }
+  uint64_t elapsed = 0;
+  size_t bytes = 0;
+  for (int round = 0; round < rounds; round++) {
+    uint64_t start = host_test::now_us();
+    // sensors that update faster than the display acknowledges
+    for (int value = 0; value < 20; value++) {
+      for (int i = 0; i < variables; i++)
+        nextion.add_no_result_to_queue_with_set(names[i], names_to_send[i], round * 100 + value);
+    }
+    elapsed += host_test::now_us() - start;
+    while (nextion.queue_size() > 0)
+      acknowledge(nextion, uart, nextion.queue_size());
+    bytes += sent(uart).size();
+  }
+  printf("%d sets of %d variables: %.2f us per set, %.0f bytes sent\n", 20 * variables, variables,
+         (double) elapsed / rounds / (20 * variables), (double) bytes / rounds);
+}
+
+int main(int argc, char **argv) {
+  test_coalescing();
+  test_lost_acknowledgement();
+  test_pool();
+  if (host_test::bench_mode(argc, argv))
+    bench_burst();
+  return host_test::result();
+}
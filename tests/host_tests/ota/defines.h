@@ -0,0 +1,9 @@
+#pragma once
+
+#define ESPHOME_BOARD "host"
+#define USE_MD5
+#define USE_NETWORK
+#define USE_OTA
+#define USE_OTA_PASSWORD
+#define USE_OTA_VERSION 2
+#define USE_SOCKET_IMPL_BSD_SOCKETS
@@ -0,0 +1,577 @@
+// The write pipeline of OTA updates against a slow backend, and complete updates with the native OTA protocol over
+// a loopback socket: the image arrives unchanged, and failed writes, a wrong password and a lost connection abort
+// the update. Delta updates are only offered after authentication, and invalid patches are rejected.
+#include "host_test.h"
+
+#include "esphome/components/esphome/ota/ota_esphome.h"
+#include "esphome/components/md5/md5.h"
+#include "esphome/components/ota/ota_delta.h"
+#include "esphome/components/ota/ota_write_pipeline.h"
+#include "esphome/core/application.h"
+#include "esphome/core/hal.h"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <signal.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace esphome;
+using ota::OTAResponseTypes;
+
+static const uint16_t PORT = 36286;
+static const char *const PASSWORD = "secret";
+
+static const uint8_t FEATURE_SUPPORTS_DELTA = 0x02;
+static const uint8_t UPLOAD_MODE_FULL = 0x00;
+static const uint8_t UPLOAD_MODE_DELTA = 0x01;
+static const uint8_t DELTA_HEADER[] = {'E', 'S', 'P', 'D', 0x01};
+static const uint8_t DELTA_OP_COPY = 0x01;
+static const uint8_t DELTA_OP_DATA = 0x02;
+
+/// A backend that keeps the image in memory, with a simulated flash write speed.
+class TestBackend : public ota::OTABackend {
+ public:
+  OTAResponseTypes begin(size_t image_size) override {
+    this->image_size = image_size;
+    this->begun = true;
+    return ota::OTA_RESPONSE_OK;
+  }
+  void set_update_md5(const char *md5) override { this->expected_md5.assign(md5, 32); }
+  OTAResponseTypes write(uint8_t *data, size_t len) override {
+    if (this->write_delay_us != 0)
+      delayMicroseconds(this->write_delay_us);
+    if (this->fail_after != 0 && this->data.size() + len > this->fail_after)
+      return ota::OTA_RESPONSE_ERROR_WRITING_FLASH;
+    this->data.insert(this->data.end(), data, data + len);
+    this->writes++;
+    return ota::OTA_RESPONSE_OK;
+  }
+  OTAResponseTypes end() override {
+    md5::MD5Digest md5{};
+    md5.init();
+    md5.add(this->data.data(), this->data.size());
+    md5.calculate();
+    if (this->data.size() != this->image_size || !md5.equals_hex(this->expected_md5.c_str()))
+      return ota::OTA_RESPONSE_ERROR_MD5_MISMATCH;
+    this->ended = true;
+    return ota::OTA_RESPONSE_OK;
+  }
+  void abort() override { this->aborted = true; }
+  bool supports_compression() override { return false; }
+  size_t get_running_image_size() override { return this->running_image.size(); }
+  bool read_running_image(size_t offset, uint8_t *data, size_t len) override {
+    memcpy(data, this->running_image.data() + offset, len);
+    return true;
+  }
+
+  uint32_t write_delay_us{0};
+  /// number of bytes after which writes fail, 0 for never
+  size_t fail_after{0};
+  /// delta updates are offered when this is not empty
+  std::vector<uint8_t> running_image;
+
+  size_t image_size{0};
+  std::string expected_md5;
+  std::vector<uint8_t> data;
+  size_t writes{0};
+  bool begun{false};
+  bool ended{false};
+  bool aborted{false};
+};
+
+static std::vector<uint8_t> random_bytes(size_t len, uint32_t seed) {
+  std::mt19937 rng(seed);
+  std::vector<uint8_t> data(len);
+  for (auto &byte : data)
+    byte = rng();
+  return data;
+}
+
+static std::string md5_hex(const std::vector<uint8_t> &data) {
+  md5::MD5Digest md5{};
+  md5.init();
+  md5.add(data.data(), data.size());
+  md5.calculate();
+  char hex[33] = {};
+  md5.get_hex(hex);
+  return hex;
+}
+
+static void append_varint(std::vector<uint8_t> &patch, uint32_t value) {
+  while (value >= 0x80) {
+    patch.push_back(0x80 | (value & 0x7F));
+    value >>= 7;
+  }
+  patch.push_back(value);
+}
+
+// The update server runs in a child process, which exits when an update completed and the device would restart.
+// Its backend reports back through a pipe: a status byte, followed by the MD5 of the image if the update completed.
+
+/// How the backend of the server behaves, set before the server process is started.
+static uint32_t server_write_delay_us = 0;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+static size_t server_fail_after = 0;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+static std::vector<uint8_t> server_running_image;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+static int report_fd = -1;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+static const uint8_t REPORT_COMPLETED = 'C';
+static const uint8_t REPORT_ABORTED = 'A';
+
+class ServerBackend : public TestBackend {
+ public:
+  OTAResponseTypes end() override {
+    OTAResponseTypes error = TestBackend::end();
+    if (error == ota::OTA_RESPONSE_OK) {
+      std::string report = (char) REPORT_COMPLETED + md5_hex(this->data);
+      EXPECT(::write(report_fd, report.data(), report.size()) == (ssize_t) report.size());
+    }
+    return error;
+  }
+  void abort() override {
+    uint8_t status = REPORT_ABORTED;
+    EXPECT(::write(report_fd, &status, 1) == 1);
+  }
+};
+
+namespace esphome {
+namespace ota {
+std::unique_ptr<OTABackend> make_ota_backend() {
+  auto backend = make_unique<ServerBackend>();
+  backend->write_delay_us = server_write_delay_us;
+  backend->fail_after = server_fail_after;
+  backend->running_image = server_running_image;
+  return backend;
+}
+}  // namespace ota
+}  // namespace esphome
+
+class Server {
+ public:
+  explicit Server(size_t buffer_size) {
+    int fds[2];
+    EXPECT(pipe(fds) == 0);
+    fflush(stdout);
+    this->pid_ = fork();
+    if (this->pid_ == 0) {
+      ::close(fds[0]);
+      report_fd = fds[1];
+      // run by the application like on a device, so clients are accepted by the interval while the loop is disabled
+      auto *component = new ESPHomeOTAComponent();  // NOLINT
+      component->set_port(PORT);
+      component->set_buffer_size(buffer_size);
+      component->set_auth_password(PASSWORD);
+      App.register_component(component);
+      App.set_loop_interval(1);
+      App.setup();
+      while (true)
+        App.loop();
+    }
+    ::close(fds[1]);
+    this->report_fd_ = fds[0];
+  }
+  ~Server() {
+    if (this->pid_ > 0)
+      this->stop();
+    ::close(this->report_fd_);
+  }
+
+  /// Wait for the report of the backend, for at most one second.
+  std::vector<uint8_t> read_report() {
+    std::vector<uint8_t> report;
+    uint8_t buf[4096];
+    uint32_t start = millis();
+    while (millis() - start < 1000) {
+      timeval timeout{0, 10000};
+      fd_set fds;
+      FD_ZERO(&fds);
+      FD_SET(this->report_fd_, &fds);
+      if (select(this->report_fd_ + 1, &fds, nullptr, nullptr, &timeout) <= 0)
+        continue;
+      ssize_t len = ::read(this->report_fd_, buf, sizeof(buf));
+      if (len <= 0)
+        break;
+      report.insert(report.end(), buf, buf + len);
+    }
+    return report;
+  }
+  /// Wait for the server process to exit, which it does after a completed update.
+  bool exited() {
+    int status;
+    for (int i = 0; i < 2000; i++) {
+      if (waitpid(this->pid_, &status, WNOHANG) == this->pid_) {
+        this->pid_ = 0;
+        return WIFEXITED(status) && WEXITSTATUS(status) == 0;
+      }
+      delay(1);
+    }
+    return false;
+  }
+  void stop() {
+    kill(this->pid_, SIGKILL);
+    waitpid(this->pid_, nullptr, 0);
+    this->pid_ = 0;
+  }
+
+ protected:
+  pid_t pid_;
+  int report_fd_;
+};
+
+/// A client of the native OTA protocol, version 2, like esphome/espota2.py.
+class Client {
+ public:
+  ~Client() { this->close(); }
+
+  bool connect() {
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(PORT);
+    addr.sin_addr.s_addr = inet_addr("127.0.0.1");
+    // the server may still be starting
+    for (int i = 0; i < 200; i++) {
+      this->fd_ = ::socket(AF_INET, SOCK_STREAM, 0);
+      if (::connect(this->fd_, (sockaddr *) &addr, sizeof(addr)) == 0)
+        break;
+      this->close();
+      delay(10);
+    }
+    if (this->fd_ < 0)
+      return false;
+    timeval timeout{3, 0};
+    setsockopt(this->fd_, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    return true;
+  }
+  void close() {
+    if (this->fd_ >= 0)
+      ::close(this->fd_);
+    this->fd_ = -1;
+  }
+
+  /// Upload an image and return the last response of the server, OTA_RESPONSE_UPDATE_END_OK on success.
+  /// @param send_len Number of bytes of the image to send before the connection is closed.
+  uint8_t upload(const std::vector<uint8_t> &image, const char *password, size_t send_len = SIZE_MAX) {
+    return this->upload(image, password, md5_hex(image), send_len);
+  }
+  uint8_t upload(const std::vector<uint8_t> &image, const char *password, const std::string &md5,
+                 size_t send_len = SIZE_MAX) {
+    this->send({0x6C, 0x26, 0xF7, 0x5C, 0x45});
+    if (this->receive() != ota::OTA_RESPONSE_OK || this->receive() != 2)
+      return this->responses.back();
+    // no compression, delta updates if asked for
+    this->send({this->delta ? FEATURE_SUPPORTS_DELTA : (uint8_t) 0});
+    uint8_t response = this->receive();
+    if (response != ota::OTA_RESPONSE_HEADER_OK && response != ota::OTA_RESPONSE_SUPPORTS_DELTA)
+      return response;
+    bool delta_offered = response == ota::OTA_RESPONSE_SUPPORTS_DELTA;
+
+    response = this->receive();
+    if (response == ota::OTA_RESPONSE_REQUEST_AUTH) {
+      std::string nonce = this->receive_string(32);
+      std::string cnonce = md5_hex({1, 2, 3});
+      std::string challenge = password + nonce + cnonce;
+      this->send(std::vector<uint8_t>(cnonce.begin(), cnonce.end()));
+      std::string result = md5_hex(std::vector<uint8_t>(challenge.begin(), challenge.end()));
+      this->send(std::vector<uint8_t>(result.begin(), result.end()));
+      response = this->receive();
+    }
+    if (response != ota::OTA_RESPONSE_AUTH_OK)
+      return response;
+
+    const std::vector<uint8_t> &upload = this->patch.empty() ? image : this->patch;
+    if (delta_offered) {
+      std::string description = this->receive_string(33);
+      this->running_image_md5 = description.substr(1);
+      this->send({this->patch.empty() ? UPLOAD_MODE_FULL : UPLOAD_MODE_DELTA});
+    }
+    size_t size = upload.size();
+    this->send({(uint8_t) (size >> 24), (uint8_t) (size >> 16), (uint8_t) (size >> 8), (uint8_t) size});
+    if (!this->patch.empty()) {
+      size_t image_size = image.size();
+      this->send({(uint8_t) (image_size >> 24), (uint8_t) (image_size >> 16), (uint8_t) (image_size >> 8),
+                  (uint8_t) image_size});
+    }
+    if (this->receive() != ota::OTA_RESPONSE_UPDATE_PREPARE_OK)
+      return this->responses.back();
+    this->send(std::vector<uint8_t>(md5.begin(), md5.end()));
+    if (this->receive() != ota::OTA_RESPONSE_BIN_MD5_OK)
+      return this->responses.back();
+
+    for (size_t offset = 0; offset < size; offset += 8192) {
+      size_t len = std::min<size_t>(8192, size - offset);
+      if (offset + len > send_len) {
+        this->send(std::vector<uint8_t>(upload.begin() + offset, upload.begin() + send_len));
+        this->close();
+        return ota::OTA_RESPONSE_ERROR_UNKNOWN;
+      }
+      this->send(std::vector<uint8_t>(upload.begin() + offset, upload.begin() + offset + len));
+      if (this->receive() != ota::OTA_RESPONSE_CHUNK_OK)
+        return this->responses.back();
+    }
+    if (this->receive() != ota::OTA_RESPONSE_RECEIVE_OK || this->receive() != ota::OTA_RESPONSE_UPDATE_END_OK)
+      return this->responses.back();
+    this->send({ota::OTA_RESPONSE_OK});
+    return ota::OTA_RESPONSE_UPDATE_END_OK;
+  }
+
+  /// Ask for a delta update, which is sent if a patch is set.
+  bool delta{false};
+  std::vector<uint8_t> patch;
+
+  /// Every byte the server responded with, except the nonce and the description of the running image.
+  std::vector<uint8_t> responses;
+  std::string running_image_md5;
+
+ protected:
+  void send(const std::vector<uint8_t> &data) {
+    EXPECT(::send(this->fd_, data.data(), data.size(), MSG_NOSIGNAL) == (ssize_t) data.size());
+  }
+  uint8_t receive() {
+    uint8_t byte = ota::OTA_RESPONSE_ERROR_UNKNOWN;
+    if (::recv(this->fd_, &byte, 1, MSG_WAITALL) != 1)
+      byte = ota::OTA_RESPONSE_ERROR_UNKNOWN;
+    this->responses.push_back(byte);
+    return byte;
+  }
+  std::string receive_string(size_t len) {
+    std::string data(len, '\0');
+    EXPECT(::recv(this->fd_, &data[0], len, MSG_WAITALL) == (ssize_t) len);
+    return data;
+  }
+
+  int fd_{-1};
+};
+
+static void test_pipeline_keeps_order() {
+  std::vector<uint8_t> image = random_bytes(100000, 1);
+  for (size_t buffer_size : {1000, 4096}) {
+    TestBackend backend;
+    backend.write_delay_us = 50;
+    ota::OTAWritePipeline pipeline(&backend, buffer_size);
+    EXPECT(pipeline.start());
+    std::mt19937 rng(2);
+    size_t offset = 0;
+    while (offset < image.size()) {
+      // partial buffers are committed too, like the last part of an image
+      size_t len = std::min<size_t>(image.size() - offset, 1 + rng() % buffer_size);
+      memcpy(pipeline.get_buffer(), image.data() + offset, len);
+      EXPECT_EQ(pipeline.commit(len), ota::OTA_RESPONSE_OK);
+      offset += len;
+    }
+    EXPECT_EQ(pipeline.flush(), ota::OTA_RESPONSE_OK);
+    EXPECT(backend.data == image);
+  }
+}
+
+static void test_pipeline_reports_errors() {
+  TestBackend backend;
+  backend.fail_after = 2500;
+  ota::OTAWritePipeline pipeline(&backend, 1000);
+  EXPECT(pipeline.start());
+  // the error of a write is only known when the next buffer is committed
+  EXPECT_EQ(pipeline.commit(1000), ota::OTA_RESPONSE_OK);
+  EXPECT_EQ(pipeline.commit(1000), ota::OTA_RESPONSE_OK);
+  EXPECT_EQ(pipeline.commit(1000), ota::OTA_RESPONSE_OK);
+  EXPECT_EQ(pipeline.commit(1000), ota::OTA_RESPONSE_ERROR_WRITING_FLASH);
+  EXPECT_EQ(pipeline.flush(), ota::OTA_RESPONSE_ERROR_WRITING_FLASH);
+  // nothing is written after the first failure
+  EXPECT_EQ(backend.writes, 2u);
+}
+
+static void test_update() {
+  std::vector<uint8_t> image = random_bytes(100000, 3);
+  for (size_t buffer_size : {1024, 16384}) {
+    Server server(buffer_size);
+    Client client;
+    EXPECT(client.connect());
+    EXPECT_EQ(client.upload(image, PASSWORD), ota::OTA_RESPONSE_UPDATE_END_OK);
+    std::vector<uint8_t> report = server.read_report();
+    EXPECT(std::string(report.begin(), report.end()) == (char) REPORT_COMPLETED + md5_hex(image));
+    EXPECT(server.exited());
+  }
+}
+
+static void test_wrong_password() {
+  Server server(1024);
+  Client client;
+  EXPECT(client.connect());
+  EXPECT_EQ(client.upload(random_bytes(1000, 4), "wrong"), ota::OTA_RESPONSE_ERROR_AUTH_INVALID);
+  // the update was never started
+  EXPECT(server.read_report().empty());
+}
+
+static void test_write_error() {
+  server_fail_after = 30000;
+  Server server(4096);
+  server_fail_after = 0;
+  Client client;
+  EXPECT(client.connect());
+  EXPECT_EQ(client.upload(random_bytes(100000, 5), PASSWORD), ota::OTA_RESPONSE_ERROR_WRITING_FLASH);
+  EXPECT(server.read_report() == std::vector<uint8_t>{REPORT_ABORTED});
+}
+
+static void test_md5_mismatch() {
+  Server server(4096);
+  Client client;
+  EXPECT(client.connect());
+  std::vector<uint8_t> image = random_bytes(50000, 6);
+  EXPECT_EQ(client.upload(image, PASSWORD, md5_hex({0})), ota::OTA_RESPONSE_ERROR_MD5_MISMATCH);
+  EXPECT(server.read_report() == std::vector<uint8_t>{REPORT_ABORTED});
+}
+
+static void test_connection_lost() {
+  Server server(4096);
+  Client client;
+  EXPECT(client.connect());
+  client.upload(random_bytes(100000, 7), PASSWORD, 50000);
+  EXPECT(server.read_report() == std::vector<uint8_t>{REPORT_ABORTED});
+}
+
+static void test_delta_update() {
+  std::vector<uint8_t> running = random_bytes(100000, 10);
+  std::vector<uint8_t> inserted = random_bytes(1000, 11);
+  std::vector<uint8_t> image(running.begin(), running.begin() + 40000);
+  image.insert(image.end(), inserted.begin(), inserted.end());
+  image.insert(image.end(), running.begin() + 41000, running.end());
+  std::vector<uint8_t> patch(std::begin(DELTA_HEADER), std::end(DELTA_HEADER));
+  patch.push_back(DELTA_OP_COPY);
+  append_varint(patch, 0);
+  append_varint(patch, 40000);
+  patch.push_back(DELTA_OP_DATA);
+  append_varint(patch, inserted.size());
+  patch.insert(patch.end(), inserted.begin(), inserted.end());
+  patch.push_back(DELTA_OP_COPY);
+  append_varint(patch, 41000);
+  append_varint(patch, running.size() - 41000);
+
+  server_running_image = running;
+  Server server(4096);
+  server_running_image.clear();
+
+  // nothing about the running image is sent before the uploader is authenticated
+  Client unauthenticated;
+  unauthenticated.delta = true;
+  EXPECT(unauthenticated.connect());
+  EXPECT_EQ(unauthenticated.upload(image, "wrong"), ota::OTA_RESPONSE_ERROR_AUTH_INVALID);
+  EXPECT(unauthenticated.responses ==
+         (std::vector<uint8_t>{ota::OTA_RESPONSE_OK, 2, ota::OTA_RESPONSE_SUPPORTS_DELTA,
+                               ota::OTA_RESPONSE_REQUEST_AUTH, ota::OTA_RESPONSE_ERROR_AUTH_INVALID}));
+  EXPECT(unauthenticated.running_image_md5.empty());
+
+  Client client;
+  client.delta = true;
+  client.patch = patch;
+  EXPECT(client.connect());
+  EXPECT_EQ(client.upload(image, PASSWORD), ota::OTA_RESPONSE_UPDATE_END_OK);
+  EXPECT(client.running_image_md5 == md5_hex(running));
+  std::vector<uint8_t> report = server.read_report();
+  EXPECT(std::string(report.begin(), report.end()) == (char) REPORT_COMPLETED + md5_hex(image));
+  EXPECT(server.exited());
+}
+
+static OTAResponseTypes decode(const std::vector<uint8_t> &patch, size_t image_size) {
+  TestBackend backend;
+  backend.running_image = random_bytes(1000, 12);
+  ota::OTAWritePipeline pipeline(&backend, 256);
+  EXPECT(pipeline.start());
+  ota::OTADeltaDecoder decoder(&backend, &pipeline, backend.running_image.size(), image_size);
+  OTAResponseTypes error = decoder.feed(patch.data(), patch.size());
+  if (error == ota::OTA_RESPONSE_OK)
+    error = decoder.finish();
+  if (error == ota::OTA_RESPONSE_OK)
+    error = pipeline.flush();
+  return error;
+}
+
+static void test_delta_rejects_large_numbers() {
+  std::vector<uint8_t> header(std::begin(DELTA_HEADER), std::end(DELTA_HEADER));
+  // an offset of 0 with the longest encoding
+  std::vector<uint8_t> patch = header;
+  patch.insert(patch.end(), {DELTA_OP_COPY, 0x80, 0x80, 0x80, 0x80, 0x00, 10});
+  EXPECT_EQ(decode(patch, 10), ota::OTA_RESPONSE_OK);
+  // an offset of 2^32, which must not wrap around to 0
+  patch = header;
+  patch.insert(patch.end(), {DELTA_OP_COPY, 0x80, 0x80, 0x80, 0x80, 0x10, 10});
+  EXPECT_EQ(decode(patch, 10), ota::OTA_RESPONSE_ERROR_INVALID_DELTA);
+  // a 6th byte
+  patch = header;
+  patch.insert(patch.end(), {DELTA_OP_DATA, 0x81, 0x80, 0x80, 0x80, 0x80, 0x00});
+  EXPECT_EQ(decode(patch, 10), ota::OTA_RESPONSE_ERROR_INVALID_DELTA);
+}
+
+static void bench_pipeline() {
+  // receiving and writing 4 KB both take about 1 ms, which is the order of magnitude of an ESP32
+  const size_t buffer_size = 4096;
+  const size_t image_size = 256 * 1024;
+  const uint32_t work_us = 1000;
+  std::vector<uint8_t> image = random_bytes(image_size, 8);
+
+  TestBackend direct;
+  direct.write_delay_us = work_us;
+  std::vector<uint8_t> buffer(buffer_size);
+  uint64_t start = host_test::now_us();
+  for (size_t offset = 0; offset < image_size; offset += buffer_size) {
+    delayMicroseconds(work_us);
+    memcpy(buffer.data(), image.data() + offset, buffer_size);
+    direct.write(buffer.data(), buffer_size);
+  }
+  uint64_t direct_us = host_test::now_us() - start;
+
+  TestBackend backend;
+  backend.write_delay_us = work_us;
+  ota::OTAWritePipeline pipeline(&backend, buffer_size);
+  pipeline.start();
+  start = host_test::now_us();
+  for (size_t offset = 0; offset < image_size; offset += buffer_size) {
+    delayMicroseconds(work_us);
+    memcpy(pipeline.get_buffer(), image.data() + offset, buffer_size);
+    pipeline.commit(buffer_size);
+  }
+  pipeline.flush();
+  uint64_t pipeline_us = host_test::now_us() - start;
+  EXPECT(backend.data == image);
+  printf("%zu KB image with %u us to receive and write 4 KB: %.1f ms direct, %.1f ms pipelined (waited %u ms)\n",
+         image_size / 1024, work_us, direct_us / 1000.0, pipeline_us / 1000.0, pipeline.get_wait_time());
+}
+
+static void bench_update() {
+  // a flash write speed of roughly 100 KB/s
+  std::vector<uint8_t> image = random_bytes(256 * 1024, 9);
+  for (size_t buffer_size : {1024, 4096, 16384}) {
+    server_write_delay_us = buffer_size * 10;
+    Server server(buffer_size);
+    server_write_delay_us = 0;
+    Client client;
+    EXPECT(client.connect());
+    uint64_t start = host_test::now_us();
+    EXPECT_EQ(client.upload(image, PASSWORD), ota::OTA_RESPONSE_UPDATE_END_OK);
+    uint64_t elapsed = host_test::now_us() - start;
+    EXPECT(server.exited());
+    printf("%zu KB update with %zu byte buffers and 10 us per byte written: %.1f ms\n", image.size() / 1024,
+           buffer_size, elapsed / 1000.0);
+  }
+}
+
+int main(int argc, char **argv) {
+  App.pre_setup("ota", "", "", "", "", false);
+  test_pipeline_keeps_order();
+  test_pipeline_reports_errors();
+  test_update();
+  test_wrong_password();
+  test_write_error();
+  test_md5_mismatch();
+  test_connection_lost();
+  test_delta_update();
+  test_delta_rejects_large_numbers();
+  if (host_test::bench_mode(argc, argv)) {
+    bench_pipeline();
+    bench_update();
+  }
+  return host_test::result();
+}
@@ -0,0 +1,4 @@
+// The host backend is referenced by ota_esphome.cpp once the compiler devirtualizes the backend calls. Its
+// make_ota_backend() is renamed, the test provides its own.
+#define make_ota_backend make_host_ota_backend
+#include "esphome/components/ota/ota_backend_host.cpp"
@@ -0,0 +1,12 @@
+// Builds the ESP32 preferences backend on the host, on top of the NVS mock.
+#include "esphome/core/helpers.h"
+#include "esphome/core/log.h"
+#include "esphome/core/preferences.h"
+
+// The host backend in the same program owns global_preferences.
+namespace esphome {
+extern ESPPreferences *esp32_global_preferences;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+}  // namespace esphome
+#define global_preferences esp32_global_preferences
+#define USE_ESP32
+#include "esphome/components/esp32/preferences.cpp"
@@ -0,0 +1,189 @@
+// Flash wear of the preference backends: how much a save/sync workload writes, and that nothing is lost doing so.
+#include "host_test.h"
+#include "nvs_mock.h"
+
+#include "esphome/components/host/preferences.h"
+#include "esphome/core/application.h"
+
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cstdlib>
+#include <array>
+#include <random>
+
+using namespace esphome;
+
+namespace esphome {
+extern ESPPreferences *esp32_global_preferences;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+namespace esp32 {
+void setup_preferences();
+}  // namespace esp32
+}  // namespace esphome
+
+static const size_t NUM_KEYS = 24;
+static const size_t VALUE_SIZE = 12;
+// Record header of the host log plus the value
+static const size_t LIVE_SIZE = NUM_KEYS * (5 + VALUE_SIZE);
+
+using Value = std::array<uint8_t, VALUE_SIZE>;
+
+struct Workload {
+  std::vector<Value> values{NUM_KEYS};
+  std::vector<bool> set = std::vector<bool>(NUM_KEYS);
+  uint32_t saves{0};
+  uint32_t unchanged{0};
+  uint32_t changed_per_sync_max{0};
+};
+
+/// Save a random subset of the keys, about a third of them with the value they already have.
+static uint32_t save_round(ESPPreferences *prefs, Workload &workload, std::mt19937 &rng) {
+  uint32_t changed = 0;
+  for (size_t key = 0; key < NUM_KEYS; key++) {
+    if (rng() % 4 != 0)
+      continue;
+    auto &value = workload.values[key];
+    bool change = !workload.set[key] || rng() % 3 != 0;
+    if (change) {
+      for (auto &b : value)
+        b = rng();
+      workload.set[key] = true;
+      changed++;
+    } else {
+      workload.unchanged++;
+    }
+    workload.saves++;
+    prefs->make_preference<Value>(1000 + key).save(&value);
+  }
+  return changed;
+}
+
+static void expect_values(ESPPreferences *prefs, const Workload &workload) {
+  for (size_t key = 0; key < NUM_KEYS; key++) {
+    if (!workload.set[key])
+      continue;
+    Value loaded{};
+    EXPECT(prefs->make_preference<Value>(1000 + key).load(&loaded));
+    EXPECT(loaded == workload.values[key]);
+  }
+}
+
+static off_t file_size(const std::string &path) {
+  struct stat st;
+  return stat(path.c_str(), &st) == 0 ? st.st_size : -1;
+}
+
+static void test_host(const std::string &home, bool bench) {
+  host::setup_preferences();
+  std::string path = home + "/.esphome/prefs/prefs_test.prefs";
+  Workload workload;
+  std::mt19937 rng(1);
+  const int rounds = bench ? 20000 : 2000;
+  off_t max_size = 0;
+  for (int i = 0; i < rounds; i++) {
+    save_round(global_preferences, workload, rng);
+    EXPECT(global_preferences->sync());
+    max_size = std::max(max_size, file_size(path));
+  }
+  auto stats = global_preferences->get_stats();
+  EXPECT_EQ(stats.saves, workload.saves);
+  // Saving the value a key already has is the only way a save is dropped
+  EXPECT_EQ(stats.unchanged, workload.unchanged);
+  // Compaction keeps the log within a few times the live data: 4x plus what one sync appends
+  EXPECT(max_size <= (off_t) (LIVE_SIZE * 5));
+
+  // Everything survives a restart
+  host::setup_preferences();
+  expect_values(global_preferences, workload);
+
+  // A write error doesn't lose anything: /dev/full accepts the open and fails on the flush
+  unlink(path.c_str());
+  EXPECT(symlink("/dev/full", path.c_str()) == 0);
+  workload.values[0][0]++;
+  workload.set[0] = true;
+  global_preferences->make_preference<Value>(1000).save(&workload.values[0]);
+  EXPECT(!global_preferences->sync());
+  // The next sync rewrites the whole log
+  EXPECT(global_preferences->sync());
+  host::setup_preferences();
+  expect_values(global_preferences, workload);
+
+  if (bench) {
+    printf("host: %d syncs, %u saves (%u unchanged), %u records and %u bytes written, log peaked at %ld bytes\n",
+           rounds, stats.saves, stats.unchanged, stats.writes, stats.bytes_written, (long) max_size);
+  }
+}
+
+static void test_esp32(bool bench) {
+  esp32::setup_preferences();
+  auto *prefs = esp32_global_preferences;
+
+  // Repeated saves before a sync reach flash once
+  uint32_t value = 42;
+  auto pref = prefs->make_preference<uint32_t>(1);
+  pref.save(&value);
+  pref.save(&value);
+  value = 43;
+  pref.save(&value);
+  EXPECT(prefs->sync());
+  EXPECT_EQ(nvs_mock::counters.writes, 1u);
+  auto stats = prefs->get_stats();
+  EXPECT_EQ(stats.saves, 3u);
+  EXPECT_EQ(stats.unchanged, 1u);
+
+  // Saving what flash already holds doesn't write, and isn't counted as unchanged a second time
+  pref.save(&value);
+  EXPECT(prefs->sync());
+  EXPECT_EQ(nvs_mock::counters.writes, 1u);
+  stats = prefs->get_stats();
+  EXPECT_EQ(stats.saves, 4u);
+  EXPECT_EQ(stats.unchanged, 1u);
+  EXPECT_EQ(stats.writes, 1u);
+
+  // A changed value is written without reading the old one back first
+  uint32_t reads = nvs_mock::counters.reads;
+  value = 44;
+  pref.save(&value);
+  EXPECT(prefs->sync());
+  EXPECT_EQ(nvs_mock::counters.writes, 2u);
+  EXPECT_EQ(nvs_mock::counters.reads, reads);
+
+  Workload workload;
+  std::mt19937 rng(2);
+  const int rounds = bench ? 20000 : 2000;
+  uint32_t expected_writes = nvs_mock::counters.writes;
+  for (int i = 0; i < rounds; i++) {
+    std::vector<Value> before = workload.values;
+    save_round(prefs, workload, rng);
+    EXPECT(prefs->sync());
+    for (size_t key = 0; key < NUM_KEYS; key++) {
+      if (workload.values[key] != before[key])
+        expected_writes++;
+    }
+  }
+  // Only keys whose value differs from flash are written
+  EXPECT_EQ(nvs_mock::counters.writes, expected_writes);
+  expect_values(prefs, workload);
+
+  if (bench) {
+    stats = prefs->get_stats();
+    printf("esp32: %d syncs, %u saves (%u unchanged), %u blobs and %u bytes written\n", rounds, stats.saves,
+           stats.unchanged, nvs_mock::counters.writes, nvs_mock::counters.bytes_written);
+  }
+}
+
+int main(int argc, char **argv) {
+  bool bench = host_test::bench_mode(argc, argv);
+  char home[] = "/tmp/prefs_test_XXXXXX";
+  if (mkdtemp(home) == nullptr)
+    return 1;
+  setenv("HOME", home, 1);
+  App.pre_setup("prefs_test", "", "", "", "", false);
+
+  test_host(home, bench);
+  test_esp32(bench);
+
+  std::string cleanup = std::string("rm -rf ") + home;
+  if (system(cleanup.c_str()) != 0)
+    return 1;
+  return host_test::result();
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+// The parts of the ESP-IDF NVS API used by the ESP32 preferences backend, implemented by nvs_mock.cpp.
+
+#include <cstddef>
+#include <cstdint>
+
+using esp_err_t = int;
+using nvs_handle_t = uint32_t;
+
+#define ESP_OK 0
+#define ESP_ERR_NVS_NOT_FOUND 0x1102
+
+enum nvs_open_mode_t { NVS_READONLY, NVS_READWRITE };
+
+esp_err_t nvs_flash_init();
+esp_err_t nvs_flash_deinit();
+esp_err_t nvs_flash_erase();
+esp_err_t nvs_open(const char *name, nvs_open_mode_t open_mode, nvs_handle_t *out_handle);
+esp_err_t nvs_get_blob(nvs_handle_t handle, const char *key, void *out_value, size_t *length);
+esp_err_t nvs_set_blob(nvs_handle_t handle, const char *key, const void *value, size_t length);
+esp_err_t nvs_commit(nvs_handle_t handle);
+const char *esp_err_to_name(esp_err_t code);
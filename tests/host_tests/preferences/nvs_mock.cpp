@@ -0,0 +1,46 @@
+#include "nvs_mock.h"
+
+#include <cstring>
+
+namespace nvs_mock {
+
+std::map<std::string, std::vector<uint8_t>> blobs;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+Counters counters;                                // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+}  // namespace nvs_mock
+
+using namespace nvs_mock;
+
+esp_err_t nvs_flash_init() { return ESP_OK; }
+esp_err_t nvs_flash_deinit() { return ESP_OK; }
+esp_err_t nvs_flash_erase() {
+  blobs.clear();
+  counters.erases++;
+  return ESP_OK;
+}
+esp_err_t nvs_open(const char *name, nvs_open_mode_t open_mode, nvs_handle_t *out_handle) {
+  *out_handle = 1;
+  return ESP_OK;
+}
+esp_err_t nvs_get_blob(nvs_handle_t handle, const char *key, void *out_value, size_t *length) {
+  auto it = blobs.find(key);
+  if (it == blobs.end())
+    return ESP_ERR_NVS_NOT_FOUND;
+  counters.reads++;
+  if (out_value != nullptr)
+    memcpy(out_value, it->second.data(), std::min(*length, it->second.size()));
+  *length = it->second.size();
+  return ESP_OK;
+}
+esp_err_t nvs_set_blob(nvs_handle_t handle, const char *key, const void *value, size_t length) {
+  auto *bytes = static_cast<const uint8_t *>(value);
+  blobs[key].assign(bytes, bytes + length);
+  counters.writes++;
+  counters.bytes_written += length;
+  return ESP_OK;
+}
+esp_err_t nvs_commit(nvs_handle_t handle) {
+  counters.commits++;
+  return ESP_OK;
+}
+const char *esp_err_to_name(esp_err_t code) { return code == ESP_OK ? "ESP_OK" : "ESP_ERR_NVS_NOT_FOUND"; }
@@ -0,0 +1,22 @@
+#pragma once
+
+#include "nvs_flash.h"
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace nvs_mock {
+
+struct Counters {
+  uint32_t reads{0};
+  uint32_t writes{0};
+  uint32_t bytes_written{0};
+  uint32_t commits{0};
+  uint32_t erases{0};
+};
+
+extern std::map<std::string, std::vector<uint8_t>> blobs;
+extern Counters counters;
+
+}  // namespace nvs_mock
@@ -0,0 +1,119 @@
+// priority_loop on a std::thread: loop latency while the main loop is blocked, timers on the priority task,
+// states handed to the main loop, and shutdown.
+#include "host_test.h"
+
+#include "esphome/components/priority_loop/priority_loop.h"
+#include "esphome/core/application.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace esphome;
+
+static std::thread::id main_thread;
+
+/// Records when its loop runs and publishes a counter through the priority loop.
+class PinnedComponent : public Component {
+ public:
+  PinnedComponent(priority_loop::PriorityLoop *parent, sensor::Sensor *sensor) : parent_(parent), sensor_(sensor) {}
+
+  void setup() override {
+    this->set_interval(5, [this]() {
+      this->timer_calls++;
+      if (std::this_thread::get_id() == main_thread)
+        this->timer_on_main++;
+    });
+  }
+  void loop() override {
+    uint64_t now = host_test::now_us();
+    if (this->last_us_ != 0)
+      this->gaps_us.push_back(now - this->last_us_);
+    this->last_us_ = now;
+    this->loop_calls++;
+    if (std::this_thread::get_id() == main_thread)
+      this->loop_on_main++;
+    this->parent_->publish_state(this->sensor_, this->loop_calls);
+  }
+
+  std::vector<uint64_t> gaps_us;
+  std::atomic<uint32_t> loop_calls{0};
+  std::atomic<uint32_t> loop_on_main{0};
+  std::atomic<uint32_t> timer_calls{0};
+  std::atomic<uint32_t> timer_on_main{0};
+
+ protected:
+  priority_loop::PriorityLoop *parent_;
+  sensor::Sensor *sensor_;
+  uint64_t last_us_{0};
+};
+
+/// A main loop component that hogs the loop, like a slow display redraw.
+class BlockingComponent : public Component {
+ public:
+  void loop() override { std::this_thread::sleep_for(std::chrono::milliseconds(50)); }
+};
+
+int main(int argc, char **argv) {
+  bool bench = host_test::bench_mode(argc, argv);
+  main_thread = std::this_thread::get_id();
+  App.pre_setup("priority_loop", "", "", "", "", false);
+
+  auto *loop = new priority_loop::PriorityLoop();
+  loop->set_loop_interval(1);
+  auto *sensor = new sensor::Sensor();
+  uint32_t published = 0;
+  float last_state = 0;
+  bool in_order = true;
+  bool on_main = true;
+  sensor->add_on_state_callback([&](float state) {
+    published++;
+    in_order &= state > last_state;
+    last_state = state;
+    on_main &= std::this_thread::get_id() == main_thread;
+  });
+  auto *pinned = new PinnedComponent(loop, sensor);
+  loop->add_component(pinned);
+  App.register_component(pinned);
+  App.register_component(new BlockingComponent());
+  App.register_component(loop);
+  App.setup();
+
+  const int iterations = bench ? 100 : 20;
+  for (int i = 0; i < iterations; i++)
+    App.loop();
+
+  // The pinned loop kept running at its own interval while every main loop iteration blocked for 50ms
+  EXPECT(pinned->loop_calls > (uint32_t) iterations * 10);
+  EXPECT_EQ(pinned->loop_on_main.load(), 0u);
+  auto gaps = pinned->gaps_us;
+  std::sort(gaps.begin(), gaps.end());
+  uint64_t max_gap = gaps.empty() ? 0 : gaps.back();
+  uint64_t p99_gap = gaps.empty() ? 0 : gaps[gaps.size() * 99 / 100];
+  EXPECT(p99_gap < 5000);
+  EXPECT(max_gap < 50000);
+
+  // Its timers ran from the priority task too
+  EXPECT(pinned->timer_calls > 0);
+  EXPECT_EQ(pinned->timer_on_main.load(), 0u);
+
+  // States were published from the main loop, in order; the queue holds 32 so some of them were dropped
+  EXPECT(published > 0);
+  EXPECT(in_order);
+  EXPECT(on_main);
+  EXPECT(host_test::log_contains("State queue full"));
+
+  // Shutdown stops the task before it returns
+  App.run_safe_shutdown_hooks();
+  uint32_t calls = pinned->loop_calls;
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  EXPECT_EQ(pinned->loop_calls.load(), calls);
+
+  if (bench && !gaps.empty()) {
+    printf("priority loop period with a blocked main loop: p50=%" PRIu64 "us p99=%" PRIu64 "us max=%" PRIu64
+           "us over %zu calls\n",
+           gaps[gaps.size() / 2], p99_gap, max_gap, gaps.size() + 1);
+  }
+  return host_test::result();
+}
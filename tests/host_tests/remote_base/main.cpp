@@ -0,0 +1,330 @@
+// Dispatch of received frames to the binary sensors, triggers and dumpers of a receiver: every protocol decodes a
+// frame once, frames of other protocols are rejected by the header check, and binary sensors are looked up by key.
+#include "host_test.h"
+
+#include "esphome/components/remote_base/coolix_protocol.h"
+#include "esphome/components/remote_base/dish_protocol.h"
+#include "esphome/components/remote_base/jvc_protocol.h"
+#include "esphome/components/remote_base/lg_protocol.h"
+#include "esphome/components/remote_base/nec_protocol.h"
+#include "esphome/components/remote_base/panasonic_protocol.h"
+#include "esphome/components/remote_base/pioneer_protocol.h"
+#include "esphome/components/remote_base/rc5_protocol.h"
+#include "esphome/components/remote_base/samsung_protocol.h"
+#include "esphome/components/remote_base/sony_protocol.h"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace esphome;
+using namespace esphome::remote_base;
+
+class TestReceiver : public RemoteReceiverBase {
+ public:
+  TestReceiver() : RemoteReceiverBase(nullptr) {}
+  void receive(const RawTimings &timings) {
+    this->temp_ = timings;
+    this->call_listeners_dumpers_();
+  }
+};
+
+class TestTransmitter : public RemoteTransmitterBase {
+ public:
+  TestTransmitter() : RemoteTransmitterBase(nullptr) {}
+  RawTimings sent;
+
+ protected:
+  void send_internal(uint32_t send_times, uint32_t send_wait) override { this->sent = this->temp_.get_data(); }
+};
+
+/// The timings of a frame as a receiver captures them: consecutive marks or spaces merged, ending with the idle time,
+/// and every item off by up to 10%.
+template<typename Protocol> RawTimings capture(const typename Protocol::ProtocolData &data) {
+  static std::mt19937 rng(1);  // NOLINT(cert-msc51-cpp)
+  TestTransmitter transmitter;
+  transmitter.transmit<Protocol>(data);
+  RawTimings timings;
+  for (int32_t timing : transmitter.sent) {
+    if (!timings.empty() && (timings.back() < 0) == (timing < 0)) {
+      timings.back() += timing;
+    } else {
+      timings.push_back(timing);
+    }
+  }
+  // the receiver ends the frame after an idle time
+  if (timings.back() > 0)
+    timings.push_back(0);
+  timings.back() = std::min(timings.back(), int32_t(-10000));
+  for (auto &timing : timings)
+    timing = timing * int32_t(90 + rng() % 21) / 100;
+  return timings;
+}
+
+/// NEC, counting the calls of decode().
+class CountingNECProtocol : public NECProtocol {
+ public:
+  optional<NECData> decode(RemoteReceiveData src) override {
+    decodes++;
+    return NECProtocol::decode(src);
+  }
+  static int decodes;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+};
+int CountingNECProtocol::decodes = 0;
+
+/// Counts the presses of a binary sensor.
+template<typename Protocol>
+RemoteReceiverBinarySensor<Protocol> *add_binary_sensor(TestReceiver &receiver, typename Protocol::ProtocolData data,
+                                                        int *presses) {
+  auto *sensor = new RemoteReceiverBinarySensor<Protocol>();  // NOLINT
+  // in the order of the generated code: the data is set after registration
+  receiver.register_listener(sensor);
+  sensor->set_data(data);
+  sensor->add_on_state_callback([presses](bool state) { *presses += state; });
+  return sensor;
+}
+
+template<typename T> class RecordAction : public Action<T> {
+ public:
+  explicit RecordAction(std::vector<T> *values) : values_(values) {}
+  void play(T value) override { this->values_->push_back(value); }
+
+ protected:
+  std::vector<T> *values_;
+};
+
+template<typename Protocol>
+void add_trigger(TestReceiver &receiver, std::vector<typename Protocol::ProtocolData> *values) {
+  auto *trigger = new RemoteReceiverTrigger<Protocol>();  // NOLINT
+  receiver.register_listener(trigger);
+  auto *automation = new Automation<typename Protocol::ProtocolData>(trigger);  // NOLINT
+  automation->add_action(new RecordAction<typename Protocol::ProtocolData>(values));  // NOLINT
+}
+
+static void test_decode_once() {
+  TestReceiver receiver;
+  std::vector<int> presses(10);
+  for (int i = 0; i < 10; i++)
+    add_binary_sensor<CountingNECProtocol>(receiver, {0x1234, uint16_t(i), 1}, &presses[i]);
+  std::vector<NECData> triggered;
+  add_trigger<CountingNECProtocol>(receiver, &triggered);
+  receiver.register_dumper(new RemoteReceiverDumper<CountingNECProtocol>());  // NOLINT
+
+  CountingNECProtocol::decodes = 0;
+  receiver.receive(capture<NECProtocol>({0x1234, 7, 1}));
+  EXPECT_EQ(CountingNECProtocol::decodes, 1);
+  EXPECT_EQ(presses[7], 1);
+  EXPECT_EQ(presses[6], 0);
+  EXPECT_EQ(triggered.size(), 1u);
+  EXPECT(host_test::log_contains("Received NEC: address=0x1234, command=0x0007"));
+
+  // the next frame is decoded again
+  receiver.receive(capture<NECProtocol>({0x1234, 3, 1}));
+  EXPECT_EQ(CountingNECProtocol::decodes, 2);
+  EXPECT_EQ(presses[3], 1);
+  EXPECT_EQ(presses[7], 1);
+
+  // a frame without the NEC header never reaches the decoder
+  receiver.receive(capture<SonyProtocol>({0x10, 12}));
+  EXPECT_EQ(CountingNECProtocol::decodes, 2);
+  EXPECT_EQ(triggered.size(), 2u);
+
+  // one with the header but broken bits does
+  RawTimings broken = capture<NECProtocol>({0x1234, 5, 1});
+  broken[10] = 3000;
+  receiver.receive(broken);
+  EXPECT_EQ(CountingNECProtocol::decodes, 3);
+  EXPECT_EQ(presses[5], 0);
+  EXPECT_EQ(triggered.size(), 2u);
+}
+
+static void test_binary_sensors() {
+  TestReceiver receiver;
+  int nec = 0, nec_same = 0, nec_other_address = 0, samsung = 0, sony = 0, sony_15 = 0, jvc = 0, coolix = 0;
+  add_binary_sensor<NECProtocol>(receiver, {0x00FF, 0x10, 1}, &nec);
+  // the same value twice, and a value that only differs in a field that operator== ignores
+  add_binary_sensor<NECProtocol>(receiver, {0x00FF, 0x10, 5}, &nec_same);
+  add_binary_sensor<NECProtocol>(receiver, {0x00FE, 0x10, 1}, &nec_other_address);
+  add_binary_sensor<SamsungProtocol>(receiver, {0xE0E040BF, 32}, &samsung);
+  add_binary_sensor<SonyProtocol>(receiver, {0x290, 12}, &sony);
+  add_binary_sensor<SonyProtocol>(receiver, {0x290, 15}, &sony_15);
+  add_binary_sensor<JVCProtocol>(receiver, {0xC5E8}, &jvc);
+  // Coolix has no dispatch key, its operator== also matches a single code against both of a pair
+  add_binary_sensor<CoolixProtocol>(receiver, CoolixData(0, 0xB2BFD0), &coolix);
+
+  receiver.receive(capture<NECProtocol>({0x00FF, 0x10, 1}));
+  EXPECT_EQ(nec, 1);
+  EXPECT_EQ(nec_same, 1);
+  EXPECT_EQ(nec_other_address, 0);
+  receiver.receive(capture<SamsungProtocol>({0xE0E040BF, 32}));
+  EXPECT_EQ(samsung, 1);
+  receiver.receive(capture<SonyProtocol>({0x290, 12}));
+  EXPECT_EQ(sony, 1);
+  EXPECT_EQ(sony_15, 0);
+  receiver.receive(capture<JVCProtocol>({0xC5E8}));
+  EXPECT_EQ(jvc, 1);
+  receiver.receive(capture<CoolixProtocol>(CoolixData(0xB2BFD0, 0xB2BF50)));
+  EXPECT_EQ(coolix, 1);
+  EXPECT_EQ(nec + nec_same + samsung + sony + jvc, 5);
+}
+
+/// The values a trigger of Protocol fired with for a frame, compared with what the decoder returns for it directly.
+class DecodeCheck {
+ public:
+  virtual bool matches_decoder(const RawTimings &frame) = 0;
+};
+template<typename Protocol> class ProtocolDecodeCheck : public DecodeCheck {
+ public:
+  explicit ProtocolDecodeCheck(TestReceiver &receiver) { add_trigger<Protocol>(receiver, &this->values); }
+  bool matches_decoder(const RawTimings &frame) override {
+    auto expected = Protocol().decode(RemoteReceiveData(frame, 25, TOLERANCE_MODE_PERCENTAGE));
+    bool matches = expected.has_value() ? this->received(*expected) : this->values.empty();
+    this->values.clear();
+    return matches;
+  }
+  bool received(const typename Protocol::ProtocolData &data) const {
+    return this->values.size() == 1 && this->values[0] == data;
+  }
+  std::vector<typename Protocol::ProtocolData> values;
+};
+
+static void test_all_protocols() {
+  // the header check and the shared decode give the same results as every decoder on its own
+  TestReceiver receiver;
+  ProtocolDecodeCheck<NECProtocol> nec(receiver);
+  ProtocolDecodeCheck<SamsungProtocol> samsung(receiver);
+  ProtocolDecodeCheck<SonyProtocol> sony(receiver);
+  ProtocolDecodeCheck<LGProtocol> lg(receiver);
+  ProtocolDecodeCheck<JVCProtocol> jvc(receiver);
+  ProtocolDecodeCheck<RC5Protocol> rc5(receiver);
+  ProtocolDecodeCheck<PanasonicProtocol> panasonic(receiver);
+  ProtocolDecodeCheck<PioneerProtocol> pioneer(receiver);
+  ProtocolDecodeCheck<DishProtocol> dish(receiver);
+  ProtocolDecodeCheck<CoolixProtocol> coolix(receiver);
+  std::vector<DecodeCheck *> checks = {&nec, &samsung, &sony, &lg, &jvc, &rc5, &panasonic, &pioneer, &dish, &coolix};
+
+  auto check = [&](const RawTimings &frame, bool decoded) {
+    EXPECT(decoded);
+    for (auto *check : checks)
+      EXPECT(check->matches_decoder(frame));
+  };
+  RawTimings frame = capture<NECProtocol>({0x1234, 0x0059, 1});
+  receiver.receive(frame);
+  check(frame, nec.received({0x1234, 0x0059, 1}));
+  frame = capture<SamsungProtocol>({0xE0E040BF, 32});
+  receiver.receive(frame);
+  check(frame, samsung.received({0xE0E040BF, 32}));
+  frame = capture<SonyProtocol>({0x290, 12});
+  receiver.receive(frame);
+  check(frame, sony.received({0x290, 12}));
+  frame = capture<LGProtocol>({0x20DF10EF, 32});
+  receiver.receive(frame);
+  check(frame, lg.received({0x20DF10EF, 32}));
+  frame = capture<JVCProtocol>({0xC5E8});
+  receiver.receive(frame);
+  check(frame, jvc.received({0xC5E8}));
+  frame = capture<PanasonicProtocol>({0x4004, 0x100BCBD});
+  receiver.receive(frame);
+  check(frame, panasonic.received({0x4004, 0x100BCBD}));
+  // Pioneer frames are NEC frames with a different checksum
+  frame = capture<PioneerProtocol>({0xA55A, 0});
+  receiver.receive(frame);
+  check(frame, pioneer.received({0xA55A, 0}));
+  frame = capture<CoolixProtocol>(CoolixData(0xB2BFD0));
+  receiver.receive(frame);
+  check(frame, coolix.received(CoolixData(0xB2BFD0)));
+  // the RC5 and Dish decoders do not read back what their encoders send, only compare with them
+  for (const auto &frame : {capture<RC5Protocol>({0x05, 0x21}), capture<DishProtocol>({0x01, 0x02})}) {
+    receiver.receive(frame);
+    check(frame, true);
+  }
+}
+
+/// A binary sensor that decodes every frame itself, as all of them did before the dispatch.
+template<typename Protocol> class PlainBinarySensor : public RemoteReceiverBinarySensor<Protocol> {
+ public:
+  bool join_shared_listener(RemoteReceiverBase *receiver) override { return false; }
+
+ protected:
+  bool matches(RemoteReceiveData src) override {
+    auto res = Protocol().decode(src);
+    return res.has_value() && *res == this->data_;
+  }
+};
+
+template<typename Protocol> class PlainDumper : public RemoteReceiverDumperBase {
+ public:
+  bool dump(RemoteReceiveData src) override {
+    auto decoded = Protocol().decode(src);
+    if (!decoded.has_value())
+      return false;
+    Protocol().dump(*decoded);
+    return true;
+  }
+};
+
+template<template<typename> class Sensor, template<typename> class Dumper>
+static void bench_receiver(const char *name, const std::vector<RawTimings> &frames) {
+  TestReceiver receiver;
+  int presses = 0;
+  auto add = [&](RemoteReceiverListener *listener) { receiver.register_listener(listener); };
+  for (int i = 0; i < 60; i++) {
+    auto *sensor = new Sensor<NECProtocol>();  // NOLINT
+    add(sensor);
+    sensor->set_data({0x1234, uint16_t(i), 1});
+    sensor->add_on_state_callback([&presses](bool state) { presses += state; });
+  }
+  for (int i = 0; i < 10; i++) {
+    auto *samsung = new Sensor<SamsungProtocol>();  // NOLINT
+    add(samsung);
+    samsung->set_data({uint64_t(i), 32});
+    auto *sony = new Sensor<SonyProtocol>();  // NOLINT
+    add(sony);
+    sony->set_data({uint32_t(i), 12});
+  }
+  add(new NECTrigger());  // NOLINT
+  add(new SonyTrigger());  // NOLINT
+  add(new LGTrigger());  // NOLINT
+  receiver.register_dumper(new Dumper<NECProtocol>());  // NOLINT
+  receiver.register_dumper(new Dumper<SamsungProtocol>());  // NOLINT
+  receiver.register_dumper(new Dumper<SonyProtocol>());  // NOLINT
+  receiver.register_dumper(new Dumper<LGProtocol>());  // NOLINT
+  receiver.register_dumper(new Dumper<JVCProtocol>());  // NOLINT
+  receiver.register_dumper(new Dumper<RC5Protocol>());  // NOLINT
+  receiver.register_dumper(new Dumper<PanasonicProtocol>());  // NOLINT
+  receiver.register_dumper(new Dumper<PioneerProtocol>());  // NOLINT
+  receiver.register_dumper(new Dumper<DishProtocol>());  // NOLINT
+  receiver.register_dumper(new Dumper<CoolixProtocol>());  // NOLINT
+
+  const int rounds = 2000;
+  uint64_t start = host_test::now_us();
+  for (int round = 0; round < rounds; round++) {
+    for (const auto &frame : frames)
+      receiver.receive(frame);
+  }
+  uint64_t elapsed = host_test::now_us() - start;
+  EXPECT_EQ(presses, 2 * rounds);
+  printf("%s: %.2f us per frame\n", name, (double) elapsed / (rounds * frames.size()));
+}
+
+static void bench_dispatch() {
+  std::vector<RawTimings> frames = {
+      capture<NECProtocol>({0x1234, 7, 1}),       capture<NECProtocol>({0x1234, 59, 1}),
+      capture<SamsungProtocol>({0xE0E040BF, 32}), capture<SonyProtocol>({0x290, 12}),
+      capture<LGProtocol>({0x20DF10EF, 32}),      capture<JVCProtocol>({0xC5E8}),
+      capture<RC5Protocol>({0x05, 0x21}),         capture<PanasonicProtocol>({0x4004, 0x100BCBD}),
+      capture<PioneerProtocol>({0xA55A, 0}),      capture<DishProtocol>({0x01, 0x02}),
+      capture<CoolixProtocol>(CoolixData(0xB2BFD0)),
+  };
+  bench_receiver<PlainBinarySensor, PlainDumper>("decode per listener", frames);
+  bench_receiver<RemoteReceiverBinarySensor, RemoteReceiverDumper>("shared decode and dispatch", frames);
+}
+
+int main(int argc, char **argv) {
+  test_decode_once();
+  test_binary_sensors();
+  test_all_protocols();
+  if (host_test::bench_mode(argc, argv))
+    bench_dispatch();
+  return host_test::result();
+}
@@ -0,0 +1,111 @@
+// RuntimeStats histograms, table limits and recording from several threads at once.
+#include "host_test.h"
+
+#include "esphome/core/component.h"
+#include "esphome/core/runtime_stats.h"
+
+#include <thread>
+#include <vector>
+
+using namespace esphome;
+
+static void test_entry() {
+  RuntimeStatsEntry entry;
+  EXPECT_EQ(entry.average_us(), 0u);
+  EXPECT_EQ(entry.percentile_us(99), 0u);
+  for (uint32_t i = 0; i < 99; i++)
+    entry.record(10);
+  entry.record(5000);
+  EXPECT_EQ(entry.count, 100u);
+  EXPECT_EQ(entry.min_us, 10u);
+  EXPECT_EQ(entry.max_us, 5000u);
+  EXPECT_EQ(entry.average_us(), (99u * 10 + 5000) / 100);
+  // 10us falls in the first bucket, [0, 16)
+  EXPECT_EQ(entry.percentile_us(50), 15u);
+  EXPECT_EQ(entry.percentile_us(99), 15u);
+  // 5000us falls in [4096, 8192), capped at the maximum seen
+  EXPECT_EQ(entry.percentile_us(100), 5000u);
+
+  // Buckets halve instead of saturating, which keeps the percentiles
+  RuntimeStatsEntry busy;
+  for (uint32_t i = 0; i < 200000; i++)
+    busy.record(i % 10 == 0 ? 100 : 1);
+  EXPECT_EQ(busy.count, 200000u);
+  EXPECT_EQ(busy.percentile_us(50), 15u);
+  EXPECT_EQ(busy.percentile_us(95), 100u);
+}
+
+static void test_table() {
+  std::vector<Component> components(8);
+  RuntimeStats stats;
+  // Recording before init() is ignored
+  stats.record(&components[0], RuntimeStatsKind::LOOP, 1);
+  EXPECT_EQ(stats.snapshot().entries.size(), 0u);
+
+  // Room for 2 entries gives a table of 4 that takes 3 before dropping
+  stats.init(2);
+  for (auto &component : components) {
+    stats.record(&component, RuntimeStatsKind::LOOP, 1);
+    stats.record(&component, RuntimeStatsKind::LOOP, 3);
+  }
+  auto snapshot = stats.snapshot();
+  EXPECT_EQ(snapshot.entries.size(), 3u);
+  EXPECT_EQ(snapshot.dropped, 10u);
+  for (auto &entry : snapshot.entries) {
+    EXPECT_EQ(entry.count, 2u);
+    EXPECT_EQ(entry.average_us(), 2u);
+  }
+
+  // A snapshot with reset returns the old values and keeps the table layout
+  snapshot = stats.snapshot(true);
+  EXPECT_EQ(snapshot.entries.size(), 3u);
+  const Component *kept = snapshot.entries[0].component;
+  snapshot = stats.snapshot();
+  EXPECT_EQ(snapshot.entries.size(), 0u);
+  EXPECT_EQ(snapshot.dropped, 0u);
+  stats.record(kept, RuntimeStatsKind::LOOP, 7);
+  snapshot = stats.snapshot();
+  EXPECT_EQ(snapshot.entries.size(), 1u);
+  EXPECT_EQ(snapshot.dropped, 0u);
+}
+
+static void test_threads() {
+  static const int THREADS = 4;
+  static const uint32_t CALLS = 50000;
+  std::vector<Component> components(16);
+  RuntimeStats stats;
+  stats.init(components.size());
+
+  // Every thread records into the same entries, like the main loop and a priority_loop task timing scheduler
+  // callbacks of the same component. Reading and resetting runs concurrently.
+  std::vector<std::thread> threads;
+  for (int t = 0; t < THREADS; t++) {
+    threads.emplace_back([&stats, &components, t]() {
+      for (uint32_t i = 0; i < CALLS; i++)
+        stats.record(&components[(i + t) % 2], RuntimeStatsKind::SCHEDULER, 1 + i % 64);
+    });
+  }
+  uint64_t counted = 0;
+  std::thread reader([&stats, &counted]() {
+    for (int i = 0; i < 200; i++) {
+      for (auto &entry : stats.snapshot(true).entries)
+        counted += entry.count;
+      std::this_thread::yield();
+    }
+  });
+  for (auto &thread : threads)
+    thread.join();
+  reader.join();
+  auto snapshot = stats.snapshot();
+  for (auto &entry : snapshot.entries)
+    counted += entry.count;
+  EXPECT_EQ(snapshot.dropped, 0u);
+  EXPECT_EQ(counted, (uint64_t) THREADS * CALLS);
+}
+
+int main(int argc, char **argv) {
+  test_entry();
+  test_table();
+  test_threads();
+  return host_test::result();
+}
@@ -0,0 +1,229 @@
+// SML decoding of a generated meter file, dispatch of the values to listeners by OBIS code, and decoding of
+// truncated and corrupted files.
+#include "host_test.h"
+#include "mock_uart.h"
+
+#include "esphome/components/sml/sensor/sml_sensor.h"
+#include "esphome/components/sml/sml.h"
+#include "esphome/components/sml/sml_parser.h"
+#include "esphome/core/helpers.h"
+
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace esphome;
+using sml::bytes;
+
+// Encoding of SML nodes, see the SML specification 6.3.1
+static bytes tl(uint8_t type, size_t length) {
+  if (length + 1 < 16)
+    return {(uint8_t) ((type << 4) | (length + 1))};
+  length += 2;
+  return {(uint8_t) (0x80 | (type << 4) | (length >> 4)), (uint8_t) (length & 0x0f)};
+}
+static bytes value(uint8_t type, const bytes &data) {
+  bytes node = tl(type, data.size());
+  node.insert(node.end(), data.begin(), data.end());
+  return node;
+}
+static bytes list(const std::vector<bytes> &items) {
+  bytes node;
+  if (items.size() < 16) {
+    node = {(uint8_t) (0x70 | items.size())};
+  } else {
+    node = {(uint8_t) (0xF0 | (items.size() >> 4)), (uint8_t) (items.size() & 0x0f)};
+  }
+  for (const auto &item : items)
+    node.insert(node.end(), item.begin(), item.end());
+  return node;
+}
+static bytes uint_value(uint64_t v, size_t size) {
+  bytes data(size);
+  for (size_t i = 0; i < size; i++)
+    data[i] = v >> (8 * (size - 1 - i));
+  return value(sml::SML_UINT, data);
+}
+static bytes int_value(int64_t v, size_t size) {
+  bytes node = uint_value((uint64_t) v, size);
+  node[0] = (sml::SML_INT << 4) | (node[0] & 0x0f);
+  return node;
+}
+static bytes octet(const bytes &data) { return value(sml::SML_OCTET, data); }
+static const bytes EMPTY = {0x01};
+
+static bytes entry(const bytes &code, uint8_t unit, int8_t scaler, const bytes &val) {
+  return list({octet(code), EMPTY, EMPTY, uint_value(unit, 1), int_value(scaler, 1), val, EMPTY});
+}
+static bytes message(uint16_t type, const bytes &body) {
+  return list({octet({0x00, 0x01}), uint_value(0, 1), uint_value(0, 1), list({uint_value(type, 2), body}),
+               uint_value(0x1234, 2), {0x00}});
+}
+
+static const bytes SERVER_A = {0x0a, 0x01, 0x45, 0x53, 0x59, 0x11, 0x03, 0x0d, 0x9b, 0x2c};
+static const bytes SERVER_B = {0x0a, 0x01, 0x45, 0x53, 0x59, 0x11, 0x03, 0x0d, 0x9b, 0x2d};
+static const bytes METER_SERIAL = {'1', 'E', 'S', 'Y', '1', '1', '6', '0', '1', '2', '3',
+                                   '4', '5', '6', '7', '8', '9', '0', '1', '2'};
+
+static bytes make_file() {
+  std::vector<bytes> entries = {
+      entry({1, 0, 1, 8, 0, 255}, 30, -1, uint_value(123456, 4)),
+      entry({1, 0, 16, 7, 0, 255}, 27, 0, int_value(-1234, 2)),
+      entry({1, 0, 96, 1, 0, 255}, 255, 0, octet(METER_SERIAL)),
+      entry({1, 0, 0, 0, 9, 255}, 255, 0, value(sml::SML_BOOL, {1})),
+  };
+  // Enough entries for a list with a two byte TL field
+  for (uint8_t i = 0; i < 16; i++)
+    entries.push_back(entry({1, 0, 2, 8, i, 255}, 30, 0, uint_value(i, 1)));
+
+  bytes file = message(sml::SML_PUBLIC_OPEN_RES, list({EMPTY, octet({5, 6}), octet({11, 10, 1}), EMPTY, EMPTY, EMPTY}));
+  bytes response =
+      message(sml::SML_GET_LIST_RES, list({EMPTY, octet(SERVER_A), EMPTY, EMPTY, list(entries), EMPTY, EMPTY}));
+  file.insert(file.end(), response.begin(), response.end());
+  response = message(sml::SML_GET_LIST_RES, list({EMPTY, octet(SERVER_B), EMPTY, EMPTY,
+                                                  list({entry({1, 0, 1, 8, 0, 255}, 30, -1, uint_value(999, 2))}),
+                                                  EMPTY, EMPTY}));
+  file.insert(file.end(), response.begin(), response.end());
+  file.push_back(0x00);
+  return file;
+}
+
+/// Frame a file the way a meter sends it, with escape sequences and the checksum.
+static bytes make_frame(const bytes &file) {
+  bytes frame = sml::START_SEQ;
+  frame.insert(frame.end(), file.begin(), file.end());
+  uint8_t padding = (4 - frame.size() % 4) % 4;
+  frame.insert(frame.end(), padding, 0x00);
+  frame.insert(frame.end(), {0x1b, 0x1b, 0x1b, 0x1b, 0x1a, padding});
+  uint16_t crc = crc16(frame.data() + 8, frame.size() - 8, 0x6e23, 0x8408, true, true);
+  frame.push_back(crc & 0xff);
+  frame.push_back(crc >> 8);
+  return frame;
+}
+
+static void test_decode() {
+  bytes file = make_file();
+  sml::SmlFile sml_file{sml::BytesView(file)};
+  std::vector<std::string> codes;
+  std::vector<std::string> servers;
+  bool ok = sml_file.for_each_obis_info([&](const sml::ObisInfo &info) {
+    codes.push_back(info.code_repr());
+    servers.push_back(sml::bytes_repr(info.server_id));
+    if (codes.size() == 1) {
+      EXPECT_EQ(info.value_type, sml::SML_UINT);
+      EXPECT_EQ(sml::bytes_to_uint(info.value), 123456u);
+      EXPECT_EQ((int) info.unit, 30);
+      EXPECT_EQ((int) info.scaler, -1);
+    } else if (codes.size() == 2) {
+      EXPECT_EQ(info.value_type, sml::SML_INT);
+      EXPECT_EQ(sml::bytes_to_int(info.value), -1234);
+    } else if (codes.size() == 3) {
+      EXPECT_EQ(info.value_type, sml::SML_OCTET);
+      EXPECT(sml::bytes_to_string(info.value) == std::string(METER_SERIAL.begin(), METER_SERIAL.end()));
+    } else if (codes.size() == 4) {
+      EXPECT_EQ(info.value_type, sml::SML_BOOL);
+      EXPECT_EQ(sml::bytes_to_uint(info.value), 1u);
+    } else if (codes.size() == 20) {
+      EXPECT_EQ(sml::bytes_to_uint(info.value), 15u);
+    }
+  });
+  EXPECT(ok);
+  EXPECT_EQ(codes.size(), 21u);
+  if (codes.size() != 21)
+    return;
+  EXPECT(codes[0] == "1-0:1.8.0");
+  EXPECT(codes[1] == "1-0:16.7.0");
+  EXPECT(codes[19] == "1-0:2.8.15");
+  EXPECT(codes[20] == "1-0:1.8.0");
+  EXPECT(servers[0] == sml::bytes_repr(sml::BytesView(SERVER_A)));
+  EXPECT(servers[20] == sml::bytes_repr(sml::BytesView(SERVER_B)));
+}
+
+static void test_corrupted_files() {
+  // Every reported value must point into the buffer, whatever the buffer contains
+  bytes file = make_file();
+  std::mt19937 rng(1);
+  size_t values = 0;
+  for (size_t length = 0; length <= file.size(); length++) {
+    for (int k = 0; k < 20; k++) {
+      bytes data(file.begin(), file.begin() + length);
+      if (k != 0 && !data.empty())
+        data[rng() % data.size()] = rng();
+      sml::SmlFile sml_file{sml::BytesView(data.data(), data.size())};
+      sml_file.for_each_obis_info([&](const sml::ObisInfo &info) {
+        for (const auto *view : {&info.server_id, &info.code, &info.status, &info.value}) {
+          EXPECT(view->empty() || (view->begin() >= data.data() && view->end() <= data.data() + data.size()));
+        }
+        values++;
+      });
+    }
+  }
+  EXPECT(values > 0);
+}
+
+class TestSensor : public sml::SmlSensor {
+ public:
+  TestSensor(const char *server_id, const char *obis_code) : SmlSensor(server_id, obis_code) {
+    this->add_on_state_callback([this](float state) { this->publishes++; });
+  }
+  int publishes{0};
+};
+
+static void test_dispatch() {
+  host_test::MockUARTComponent uart;
+  sml::Sml sml;
+  sml.set_uart_parent(&uart);
+  TestSensor any_meter("", "1-0:1.8.0");
+  TestSensor meter_b(sml::bytes_repr(sml::BytesView(SERVER_B)).c_str(), "1-0:1.8.0");
+  TestSensor power("", "1-0:16.7.0");
+  TestSensor invalid("", "not an obis code");
+  TestSensor unknown("", "1-0:99.99.0");
+  for (auto *sensor : {&any_meter, &meter_b, &power, &invalid, &unknown})
+    sml.register_sml_listener(sensor);
+  sml.setup();
+
+  bytes frame = make_frame(make_file());
+  // A partial frame first, as if the meter was already sending when the device started
+  uart.feed(bytes(frame.begin() + frame.size() / 2, frame.end()));
+  uart.feed(frame);
+  sml.loop();
+  // the UART wakes the loop again when more data arrives
+  EXPECT(!sml.is_loop_enabled());
+
+  EXPECT_EQ(any_meter.publishes, 2);
+  EXPECT_EQ(any_meter.state, 999.0f);
+  EXPECT_EQ(meter_b.publishes, 1);
+  EXPECT_EQ(meter_b.state, 999.0f);
+  EXPECT_EQ(power.publishes, 1);
+  EXPECT_EQ(power.state, -1234.0f);
+  EXPECT_EQ(invalid.publishes, 0);
+  EXPECT_EQ(unknown.publishes, 0);
+
+  // A corrupted checksum drops the whole file
+  frame.back() ^= 1;
+  uart.feed(frame);
+  sml.loop();
+  EXPECT_EQ(any_meter.publishes, 2);
+}
+
+static void bench_decode() {
+  bytes file = make_file();
+  const int rounds = 20000;
+  size_t count = 0;
+  uint64_t start = host_test::now_us();
+  for (int i = 0; i < rounds; i++) {
+    sml::SmlFile sml_file{sml::BytesView(file)};
+    sml_file.for_each_obis_info([&](const sml::ObisInfo &) { count++; });
+  }
+  uint64_t elapsed = host_test::now_us() - start;
+  printf("decode: %.2f us per %zu byte file (%zu values)\n", (double) elapsed / rounds, file.size(), count / rounds);
+}
+
+int main(int argc, char **argv) {
+  test_decode();
+  test_corrupted_files();
+  test_dispatch();
+  if (host_test::bench_mode(argc, argv))
+    bench_decode();
+  return host_test::result();
+}
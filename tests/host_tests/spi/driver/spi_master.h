@@ -0,0 +1,80 @@
+// Mock of the ESP-IDF SPI master driver, see spi_master_mock.cpp.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+typedef int esp_err_t;  // NOLINT
+#define ESP_OK 0
+#define ESP_FAIL (-1)
+#define portMAX_DELAY 0xffffffffu
+typedef int spi_host_device_t;  // NOLINT
+#define SPI_DMA_CH_AUTO 3
+#define SPI_DEVICE_BIT_LSBFIRST 1
+#define SPI_DEVICE_HALFDUPLEX 2
+#define SPI_DEVICE_NO_DUMMY 4
+#define SPICOMMON_BUSFLAG_MASTER 1
+#define SPICOMMON_BUSFLAG_SCLK 2
+#define SPICOMMON_BUSFLAG_QUAD 4
+#define SPI_TRANS_VARIABLE_CMD 1
+#define SPI_TRANS_VARIABLE_ADDR 2
+#define SPI_TRANS_VARIABLE_DUMMY 4
+#define SPI_TRANS_MODE_QIO 8
+#define SPI_TRANS_MODE_OCT 16
+#define SPI_SWAP_DATA_TX(data, len) (data)
+
+struct spi_device_interface_config_t {
+  uint8_t mode;
+  int clock_speed_hz;
+  int spics_io_num;
+  uint32_t flags;
+  int queue_size;
+  void *pre_cb;
+  void *post_cb;
+};
+struct spi_bus_config_t {
+  int sclk_io_num, mosi_io_num, miso_io_num, quadwp_io_num, quadhd_io_num;
+  int data0_io_num, data1_io_num, data2_io_num, data3_io_num, data4_io_num, data5_io_num, data6_io_num,
+      data7_io_num;
+  int max_transfer_sz;
+  uint32_t flags;
+};
+struct spi_transaction_t {
+  uint32_t flags;
+  uint16_t cmd;
+  uint64_t addr;
+  size_t length;
+  size_t rxlength;
+  void *user;
+  const void *tx_buffer;
+  void *rx_buffer;
+};
+struct spi_transaction_ext_t {
+  spi_transaction_t base;
+  uint8_t command_bits;
+  uint8_t address_bits;
+  uint8_t dummy_bits;
+};
+struct spi_device_t;
+typedef spi_device_t *spi_device_handle_t;  // NOLINT
+
+esp_err_t spi_bus_add_device(spi_host_device_t host, const spi_device_interface_config_t *config,
+                             spi_device_handle_t *handle);
+esp_err_t spi_bus_remove_device(spi_device_handle_t handle);
+esp_err_t spi_bus_initialize(spi_host_device_t host, const spi_bus_config_t *config, int dma_chan);
+esp_err_t spi_device_acquire_bus(spi_device_handle_t device, uint32_t wait);
+void spi_device_release_bus(spi_device_handle_t device);
+esp_err_t spi_device_polling_start(spi_device_handle_t handle, spi_transaction_t *trans, uint32_t ticks_to_wait);
+esp_err_t spi_device_polling_end(spi_device_handle_t handle, uint32_t ticks_to_wait);
+esp_err_t spi_device_queue_trans(spi_device_handle_t handle, spi_transaction_t *trans, uint32_t ticks_to_wait);
+esp_err_t spi_device_get_trans_result(spi_device_handle_t handle, spi_transaction_t **trans, uint32_t ticks_to_wait);
+
+namespace spi_mock {
+/// Data bytes in the order they went out on the bus. Queued data is sampled when the transfer completes.
+extern std::vector<uint8_t> sent;
+/// Calls the real driver rejects, like polling while queued transfers are pending.
+extern int misuse;
+/// Queued transfers that have not completed yet.
+size_t pending();
+}  // namespace spi_mock
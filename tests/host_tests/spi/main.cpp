@@ -0,0 +1,132 @@
+// Queued double-buffered SPI writes of the ESP-IDF implementation against a mock driver that simulates the bus
+// time: the data arrives unchanged and in order, also when mixed with polling transfers.
+#include "host_test.h"
+
+#include "esphome/core/application.h"
+#include "esphome/core/component.h"
+#include "esphome/core/hal.h"
+#include "esphome/core/helpers.h"
+#include "esphome/core/log.h"
+#define USE_ESP_IDF
+#include "esphome/components/spi/spi.h"
+
+#include "driver/spi_master.h"
+
+#include <vector>
+
+using namespace esphome;
+using namespace esphome::spi;
+
+static const size_t CHUNK = 128;
+
+class TestDevice : public SPIDevice<BIT_ORDER_MSB_FIRST, CLOCK_POLARITY_LOW, CLOCK_PHASE_LEADING, DATA_RATE_40MHZ> {
+ public:
+  void set_delegate(SPIDelegate *delegate) { this->delegate_ = delegate; }
+};
+
+class TestComponent : public SPIComponent {
+ public:
+  static SPIBus *bus() { return get_bus(0, nullptr, nullptr, nullptr, {}); }
+};
+
+static volatile uint32_t sink;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+/// Stand-in for the pixel color conversion the display does while the previous chunk is sent.
+static uint8_t convert(size_t i, int work) {
+  uint32_t x = i;
+  for (int k = 0; k < work; k++)
+    x = x * 1103515245u + 12345u;
+  sink = x;
+  return (uint8_t) (x >> 13) ^ (uint8_t) i;
+}
+
+/// Write `size` bytes in chunks, queued from two alternating buffers or synchronously, followed by a polling write.
+static std::vector<uint8_t> flush(TestDevice &device, size_t size, bool queued, int work) {
+  std::vector<uint8_t> expected;
+  spi_mock::sent.clear();
+  device.enable();
+  uint8_t buffers[2][CHUNK];
+  uint8_t *buffer = buffers[0];
+  size_t idx = 0;
+  for (size_t i = 0; i != size; i++) {
+    buffer[idx++] = convert(i, work);
+    expected.push_back(buffer[idx - 1]);
+    if (idx == CHUNK || i == size - 1) {
+      if (queued) {
+        device.queue_write_array(buffer, idx);
+        buffer = buffer == buffers[0] ? buffers[1] : buffers[0];
+      } else {
+        device.write_array(buffer, idx);
+      }
+      idx = 0;
+    }
+  }
+  device.write_byte(0x2C);
+  expected.push_back(0x2C);
+  device.disable();
+  return expected;
+}
+
+static void test_queued_writes(TestDevice &device) {
+  for (bool queued : {false, true}) {
+    int misuse = spi_mock::misuse;
+    std::vector<uint8_t> expected = flush(device, 20 * CHUNK + 17, queued, 0);
+    EXPECT(spi_mock::sent == expected);
+    EXPECT_EQ(spi_mock::misuse, misuse);
+    EXPECT_EQ(spi_mock::pending(), 0u);
+  }
+}
+
+static void test_wait_queued_writes(TestDevice &device) {
+  uint8_t data[CHUNK] = {1, 2, 3};
+  spi_mock::sent.clear();
+  device.enable();
+  device.queue_write_array(data, sizeof(data));
+  EXPECT_EQ(spi_mock::pending(), 1u);
+  device.wait_queued_writes();
+  EXPECT_EQ(spi_mock::pending(), 0u);
+  // The buffer may be reused once the wait returned
+  data[0] = 0xFF;
+  EXPECT_EQ(spi_mock::sent.size(), CHUNK);
+  EXPECT_EQ(spi_mock::sent[0], 1);
+
+  // Disabling the device waits as well
+  device.queue_write_array(data, sizeof(data));
+  device.queue_write_array(data, sizeof(data));
+  device.disable();
+  EXPECT_EQ(spi_mock::pending(), 0u);
+  EXPECT_EQ(spi_mock::sent.size(), 3 * CHUNK);
+  EXPECT_EQ(spi_mock::misuse, 0);
+}
+
+static void bench_flush(TestDevice &device) {
+  // One full 240x320 RGB565 frame
+  const size_t size = 240 * 320 * 2;
+  const int work = 400;
+  uint64_t start = host_test::now_us();
+  for (size_t i = 0; i != size; i++)
+    convert(i, work);
+  uint64_t convert_us = host_test::now_us() - start;
+  double bus_us = size * 8 / 40.0 + (double) size / CHUNK * 5;
+  uint64_t times[2];
+  for (bool queued : {false, true}) {
+    start = host_test::now_us();
+    std::vector<uint8_t> expected = flush(device, size, queued, work);
+    times[queued] = host_test::now_us() - start;
+    EXPECT(spi_mock::sent == expected);
+  }
+  printf("frame flush: conversion %.1f ms, bus %.1f ms, synchronous %.1f ms, queued %.1f ms\n", convert_us / 1e3,
+         bus_us / 1e3, times[0] / 1e3, times[1] / 1e3);
+}
+
+int main(int argc, char **argv) {
+  SPIDelegate *delegate = TestComponent::bus()->get_delegate(40000000, BIT_ORDER_MSB_FIRST, MODE0, nullptr);
+  TestDevice device;
+  device.set_delegate(delegate);
+
+  test_queued_writes(device);
+  test_wait_queued_writes(device);
+  if (host_test::bench_mode(argc, argv))
+    bench_flush(device);
+  return host_test::result();
+}
@@ -0,0 +1,8 @@
+// Builds the ESP-IDF implementation against the mock driver.
+#include "esphome/core/application.h"
+#include "esphome/core/component.h"
+#include "esphome/core/hal.h"
+#include "esphome/core/helpers.h"
+#include "esphome/core/log.h"
+#define USE_ESP_IDF
+#include "esphome/components/spi/spi_esp_idf.cpp"
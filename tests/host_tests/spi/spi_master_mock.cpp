@@ -0,0 +1,94 @@
+// Mock of the ESP-IDF SPI master driver that simulates the transfer time of each transaction on the bus.
+#include "driver/spi_master.h"
+
+#include <chrono>
+#include <cstdio>
+#include <deque>
+#include <thread>
+#include <utility>
+
+using Clock = std::chrono::steady_clock;
+
+struct spi_device_t {
+  int clock_speed_hz;
+  int queue_size;
+  Clock::time_point bus_free{};
+  std::deque<std::pair<spi_transaction_t *, Clock::time_point>> queue;
+};
+
+namespace spi_mock {
+std::vector<uint8_t> sent;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+int misuse = 0;             // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+static spi_device_t *last_device = nullptr;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+size_t pending() { return last_device == nullptr ? 0 : last_device->queue.size(); }
+
+static void record(const spi_transaction_t *trans) {
+  if (trans->tx_buffer != nullptr) {
+    const auto *data = static_cast<const uint8_t *>(trans->tx_buffer);
+    sent.insert(sent.end(), data, data + trans->length / 8);
+  }
+}
+static esp_err_t fail(const char *reason) {
+  fprintf(stderr, "spi mock: %s\n", reason);
+  misuse++;
+  return ESP_FAIL;
+}
+}  // namespace spi_mock
+
+/// Occupy the bus for the transaction after the previous ones, 5us setup plus the bit time.
+static Clock::time_point schedule(spi_device_t *device, const spi_transaction_t *trans) {
+  auto now = Clock::now();
+  auto start = device->bus_free > now ? device->bus_free : now;
+  device->bus_free = start + std::chrono::nanoseconds(5000 + (uint64_t) trans->length * 1000000000ULL /
+                                                                  device->clock_speed_hz);
+  return device->bus_free;
+}
+
+esp_err_t spi_bus_add_device(spi_host_device_t host, const spi_device_interface_config_t *config,
+                             spi_device_handle_t *handle) {
+  *handle = new spi_device_t{config->clock_speed_hz, config->queue_size};  // NOLINT
+  spi_mock::last_device = *handle;
+  return ESP_OK;
+}
+esp_err_t spi_bus_remove_device(spi_device_handle_t handle) {
+  if (!handle->queue.empty())
+    spi_mock::fail("device removed with queued transfers");
+  if (spi_mock::last_device == handle)
+    spi_mock::last_device = nullptr;
+  delete handle;  // NOLINT
+  return ESP_OK;
+}
+esp_err_t spi_bus_initialize(spi_host_device_t host, const spi_bus_config_t *config, int dma_chan) { return ESP_OK; }
+esp_err_t spi_device_acquire_bus(spi_device_handle_t device, uint32_t wait) { return ESP_OK; }
+void spi_device_release_bus(spi_device_handle_t device) {
+  if (!device->queue.empty())
+    spi_mock::fail("bus released with queued transfers");
+}
+esp_err_t spi_device_polling_start(spi_device_handle_t handle, spi_transaction_t *trans, uint32_t ticks_to_wait) {
+  if (!handle->queue.empty())
+    return spi_mock::fail("polling transfer while queued transfers are pending");
+  schedule(handle, trans);
+  spi_mock::record(trans);
+  return ESP_OK;
+}
+esp_err_t spi_device_polling_end(spi_device_handle_t handle, uint32_t ticks_to_wait) {
+  std::this_thread::sleep_until(handle->bus_free);
+  return ESP_OK;
+}
+esp_err_t spi_device_queue_trans(spi_device_handle_t handle, spi_transaction_t *trans, uint32_t ticks_to_wait) {
+  if ((int) handle->queue.size() >= handle->queue_size)
+    return spi_mock::fail("queue overflow");
+  handle->queue.emplace_back(trans, schedule(handle, trans));
+  return ESP_OK;
+}
+esp_err_t spi_device_get_trans_result(spi_device_handle_t handle, spi_transaction_t **trans, uint32_t ticks_to_wait) {
+  if (handle->queue.empty())
+    return spi_mock::fail("no queued transfer");
+  auto entry = handle->queue.front();
+  handle->queue.pop_front();
+  std::this_thread::sleep_until(entry.second);
+  // Sampled at completion, so a buffer changed while it is on the bus shows up in the data
+  spi_mock::record(entry.first);
+  *trans = entry.first;
+  return ESP_OK;
+}
@@ -0,0 +1,6 @@
+#pragma once
+
+#define USE_BINARY_SENSOR
+#define USE_NETWORK
+#define USE_SENSOR
+#define USE_SOCKET_IMPL_BSD_SOCKETS
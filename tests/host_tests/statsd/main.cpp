@@ -0,0 +1,175 @@
+// The statsD datagrams as captured from a local UDP socket: value formatting, packing of the lines into datagrams
+// of at most max_packet_size bytes, and only_changes.
+#include "host_test.h"
+
+#include "esphome/components/statsd/statsd.h"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <cmath>
+#include <string>
+#include <vector>
+
+using namespace esphome;
+
+static const uint16_t PORT = 38125;
+
+static int receiver = -1;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+/// All datagrams that arrived since the last call.
+static std::vector<std::string> receive() {
+  std::vector<std::string> datagrams;
+  char buf[65536];
+  // loopback delivers immediately, but give the stack a moment anyway
+  usleep(1000);
+  ssize_t len;
+  while ((len = recv(receiver, buf, sizeof(buf), MSG_DONTWAIT)) >= 0)
+    datagrams.emplace_back(buf, len);
+  return datagrams;
+}
+
+static std::string join(const std::vector<std::string> &datagrams) {
+  std::string all;
+  for (const auto &datagram : datagrams)
+    all += datagram;
+  return all;
+}
+
+static sensor::Sensor *make_sensor(int8_t accuracy_decimals, float state) {
+  auto *sensor = new sensor::Sensor();  // NOLINT
+  sensor->set_accuracy_decimals(accuracy_decimals);
+  sensor->publish_state(state);
+  return sensor;
+}
+
+static void test_values() {
+  statsd::StatsdComponent statsd;
+  statsd.configure("127.0.0.1", PORT, "home");
+  statsd.register_sensor("temperature", make_sensor(1, 21.345f));
+  statsd.register_sensor("offset", make_sensor(2, -3.5f));
+  statsd.register_sensor("small", make_sensor(2, 0.004f));
+  statsd.register_sensor("rounded", make_sensor(-2, 123456.0f));
+  statsd.register_sensor("huge", make_sensor(0, 1e20f));
+  // does not fit into the value buffer in fixed notation
+  statsd.register_sensor("max", make_sensor(6, -3.4e38f));
+  statsd.register_sensor("unknown", make_sensor(1, NAN));
+  auto *door = new binary_sensor::BinarySensor();  // NOLINT
+  door->publish_initial_state(true);
+  statsd.register_binary_sensor("door", door);
+  statsd.register_binary_sensor("window", new binary_sensor::BinarySensor());  // NOLINT
+  statsd.setup();
+  statsd.update();
+
+  std::string all = join(receive());
+  EXPECT(all == std::string("home.temperature:21.3|g\n"
+                             // a negative gauge is set to 0 first
+                             "home.offset:0|g\n"
+                             "home.offset:-3.50|g\n"
+                             "home.small:0.00|g\n"
+                             "home.rounded:123500|g\n"
+                             "home.huge:100000002004087734272|g\n"
+                             "home.max:0|g\n"
+                             "home.max:-3.39999995e+38|g\n"
+                             "home.door:1|g\n"));
+}
+
+static void test_packing() {
+  statsd::StatsdComponent statsd;
+  statsd.configure("127.0.0.1", PORT, nullptr);
+  statsd.set_max_packet_size(100);
+  std::string expected;
+  for (int i = 0; i < 40; i++) {
+    const char *name = strdup(("sensor_" + std::to_string(i)).c_str());
+    statsd.register_sensor(name, make_sensor(1, i * 1.5f));
+    expected += std::string(name) + ":" + value_accuracy_to_string(i * 1.5f, 1) + "|g\n";
+  }
+  statsd.setup();
+  statsd.update();
+
+  std::vector<std::string> datagrams = receive();
+  EXPECT(datagrams.size() > 1);
+  for (size_t i = 0; i < datagrams.size(); i++) {
+    // only whole lines, and as many as fit
+    EXPECT(datagrams[i].size() <= 100);
+    EXPECT(datagrams[i].back() == '\n');
+    EXPECT(i == datagrams.size() - 1 || datagrams[i].size() > 100 - 20);
+  }
+  EXPECT(join(datagrams) == expected);
+}
+
+static void test_only_changes() {
+  statsd::StatsdComponent statsd;
+  statsd.configure("127.0.0.1", PORT, "home");
+  statsd.set_only_changes(true);
+  auto *temperature = make_sensor(1, 21.34f);
+  auto *humidity = make_sensor(0, 50.0f);
+  auto *door = new binary_sensor::BinarySensor();  // NOLINT
+  door->publish_initial_state(false);
+  statsd.register_sensor("temperature", temperature);
+  statsd.register_sensor("humidity", humidity);
+  statsd.register_binary_sensor("door", door);
+  statsd.setup();
+
+  statsd.update();
+  EXPECT(join(receive()) == "home.temperature:21.3|g\nhome.humidity:50|g\nhome.door:0|g\n");
+
+  // the same value at the accuracy of the sensor
+  temperature->publish_state(21.25f);
+  statsd.update();
+  EXPECT(receive().empty());
+
+  temperature->publish_state(21.5f);
+  door->publish_state(true);
+  statsd.update();
+  EXPECT(join(receive()) == "home.temperature:21.5|g\nhome.door:1|g\n");
+
+  // every distinct value is sent, also the ones that are only a few characters apart
+  for (int i = 0; i < 1000; i++) {
+    humidity->publish_state(i);
+    statsd.update();
+    EXPECT(join(receive()) == "home.humidity:" + std::to_string(i) + "|g\n");
+  }
+}
+
+static void bench_update() {
+  const int sensor_count = 100;
+  const int rounds = 2000;
+  statsd::StatsdComponent statsd;
+  statsd.configure("127.0.0.1", PORT, "home");
+  std::vector<sensor::Sensor *> sensors;
+  for (int i = 0; i < sensor_count; i++) {
+    sensors.push_back(make_sensor(2, i * 1.25f));
+    statsd.register_sensor(strdup(("sensor_" + std::to_string(i)).c_str()), sensors.back());
+  }
+  statsd.setup();
+  uint64_t elapsed = 0;
+  size_t bytes = 0;
+  for (int round = 0; round < rounds; round++) {
+    uint64_t start = host_test::now_us();
+    statsd.update();
+    elapsed += host_test::now_us() - start;
+    bytes += join(receive()).size();
+  }
+  printf("update of %d sensors: %.1f us, %zu bytes\n", sensor_count, (double) elapsed / rounds, bytes / rounds);
+}
+
+int main(int argc, char **argv) {
+  receiver = ::socket(AF_INET, SOCK_DGRAM, 0);
+  sockaddr_in addr{};
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons(PORT);
+  addr.sin_addr.s_addr = inet_addr("127.0.0.1");
+  EXPECT(bind(receiver, (sockaddr *) &addr, sizeof(addr)) == 0);
+  int size = 1 << 20;
+  setsockopt(receiver, SOL_SOCKET, SO_RCVBUF, &size, sizeof(size));
+
+  test_values();
+  test_packing();
+  test_only_changes();
+  if (host_test::bench_mode(argc, argv))
+    bench_update();
+  ::close(receiver);
+  return host_test::result();
+}
@@ -0,0 +1,162 @@
+// TeleInfo frames in historical and standard mode, fed through a mock UART: checksums, timestamps and the
+// lookup of listeners by tag.
+#include "host_test.h"
+#include "mock_uart.h"
+
+#include "esphome/components/teleinfo/teleinfo.h"
+
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace esphome;
+
+class TestListener : public teleinfo::TeleInfoListener {
+ public:
+  TestListener(const std::string &tag) { this->tag = tag; }
+  void publish_val(const std::string &val) override { this->values.push_back(val); }
+  std::vector<std::string> values;
+};
+
+/// Encode a group with its checksum, see Enedis-NOI-CPT_54E 5.3.
+static std::string group(bool historical, const std::string &tag, const std::string &timestamp,
+                         const std::string &value) {
+  char sep = historical ? ' ' : '\t';
+  std::string data = tag + sep;
+  if (!timestamp.empty())
+    data += timestamp + sep;
+  data += value;
+  // The checksum covers the separator before it in standard mode only
+  if (!historical)
+    data += sep;
+  uint8_t crc = 0;
+  for (char c : data)
+    crc += c;
+  crc = (crc & 0x3f) + 0x20;
+  return "\n" + data + (historical ? std::string(1, sep) : "") + (char) crc + "\r";
+}
+
+static std::string frame(const std::string &groups) { return "\x02" + groups + "\x03"; }
+
+/// Run the component until it handled a whole frame.
+static void receive(teleinfo::TeleInfo &teleinfo) {
+  teleinfo.update();
+  for (int i = 0; i < 100; i++)
+    teleinfo.loop();
+}
+
+static void test_historical() {
+  host_test::MockUARTComponent uart;
+  teleinfo::TeleInfo teleinfo(true);
+  teleinfo.set_uart_parent(&uart);
+  TestListener adco("ADCO"), base("BASE"), papp("PAPP"), papp2("PAPP"), iinst("IINST");
+  for (auto *listener : {&papp, &adco, &iinst, &base, &papp2})
+    teleinfo.register_teleinfo_listener(listener);
+  teleinfo.setup();
+
+  std::string bad = group(true, "IINST", "", "005");
+  bad[bad.size() - 2] ^= 1;
+  // Noise before the frame start is dropped
+  uart.feed("garbage");
+  uart.feed(frame(group(true, "ADCO", "", "021728123456") + group(true, "OPTARIF", "", "BASE") +
+                  group(true, "BASE", "", "004264213") + bad + group(true, "PAPP", "", "00390")));
+  host_test::clear_log();
+  receive(teleinfo);
+
+  EXPECT(adco.values == std::vector<std::string>{"021728123456"});
+  EXPECT(base.values == std::vector<std::string>{"004264213"});
+  EXPECT(papp.values == std::vector<std::string>{"00390"});
+  EXPECT(papp2.values == std::vector<std::string>{"00390"});
+  EXPECT(iinst.values.empty());
+  EXPECT(host_test::log_contains("bad crc"));
+}
+
+static void test_standard() {
+  host_test::MockUARTComponent uart;
+  teleinfo::TeleInfo teleinfo(false);
+  teleinfo.set_uart_parent(&uart);
+  TestListener date("DATE"), east("EAST"), smaxsn("SMAXSN"), ngtf("NGTF");
+  for (auto *listener : {&smaxsn, &ngtf, &east, &date})
+    teleinfo.register_teleinfo_listener(listener);
+  teleinfo.setup();
+  // the loop only runs from an update until the frame has been read
+  EXPECT(!teleinfo.is_loop_enabled());
+
+  uart.feed(frame(group(false, "ADSC", "", "041876097424") + group(false, "DATE", "E210101120000", "") +
+                  group(false, "NGTF", "", "      BASE      ") + group(false, "EAST", "", "012345678") +
+                  group(false, "SMAXSN", "E210101083010", "03290")));
+  receive(teleinfo);
+  EXPECT(!teleinfo.is_loop_enabled());
+
+  EXPECT(date.values == std::vector<std::string>{"E210101120000"});
+  EXPECT(ngtf.values == std::vector<std::string>{"      BASE      "});
+  EXPECT(east.values == std::vector<std::string>{"012345678"});
+  // The timestamp is skipped
+  EXPECT(smaxsn.values == std::vector<std::string>{"03290"});
+
+  // Nothing is read until the next update
+  uart.feed(frame(group(false, "EAST", "", "012345679")));
+  for (int i = 0; i < 10; i++)
+    teleinfo.loop();
+  EXPECT_EQ(east.values.size(), 1u);
+  teleinfo.update();
+  EXPECT(teleinfo.is_loop_enabled());
+  receive(teleinfo);
+  EXPECT_EQ(east.values.size(), 2u);
+}
+
+static void test_overflow() {
+  host_test::MockUARTComponent uart;
+  teleinfo::TeleInfo teleinfo(false);
+  teleinfo.set_uart_parent(&uart);
+  TestListener east("EAST");
+  teleinfo.register_teleinfo_listener(&east);
+  teleinfo.setup();
+
+  uart.feed("\x02");
+  uart.feed(std::string(teleinfo::MAX_BUF_SIZE, 'x'));
+  host_test::clear_log();
+  receive(teleinfo);
+  EXPECT(host_test::log_contains("Internal buffer full"));
+
+  // The next update starts over with the next frame
+  uart.rx.clear();
+  uart.feed(frame(group(false, "EAST", "", "1")));
+  receive(teleinfo);
+  EXPECT(east.values == std::vector<std::string>{"1"});
+}
+
+static void bench_frames() {
+  host_test::MockUARTComponent uart;
+  teleinfo::TeleInfo teleinfo(false);
+  teleinfo.set_uart_parent(&uart);
+  std::vector<TestListener *> listeners;
+  std::string groups;
+  for (int i = 0; i < 64; i++) {
+    std::string tag = "TAG" + std::to_string(i);
+    groups += group(false, tag, i % 5 == 0 ? "E210101120000" : "", std::to_string(i * 123));
+    if (i % 2 == 0) {
+      listeners.push_back(new TestListener(tag));  // NOLINT
+      teleinfo.register_teleinfo_listener(listeners.back());
+    }
+  }
+  const std::string data = frame(groups);
+  const int rounds = 2000;
+  uint64_t start = host_test::now_us();
+  for (int i = 0; i < rounds; i++) {
+    uart.feed(data);
+    receive(teleinfo);
+  }
+  uint64_t elapsed = host_test::now_us() - start;
+  printf("standard frame with 64 groups, 32 listeners: %.2f us per frame (%zu values)\n", (double) elapsed / rounds,
+         listeners[0]->values.size());
+}
+
+int main(int argc, char **argv) {
+  test_historical();
+  test_standard();
+  test_overflow();
+  if (host_test::bench_mode(argc, argv))
+    bench_frames();
+  return host_test::result();
+}
@@ -0,0 +1,190 @@
+// The command queue of the Tuya MCU link: datapoint writes that are still queued take the latest value in place,
+// and the payload buffers of sent commands are reused for the next writes.
+#include "host_test.h"
+#include "mock_uart.h"
+
+#include "esphome/components/tuya/tuya.h"
+
+#include <vector>
+
+using namespace esphome;
+
+class TestTuya : public tuya::Tuya {
+ public:
+  size_t queue_depth() const { return this->command_queue_.size(); }
+  size_t pool_size() const { return this->payload_pool_.size(); }
+  const uint8_t *pooled_buffer() const { return this->payload_pool_.back().data(); }
+  const uint8_t *last_payload() const { return this->command_queue_.back().payload.data(); }
+  /// Before the MCU finished its initialization, commands without a response are sent again.
+  void set_initialized() { this->init_state_ = tuya::TuyaInitState::INIT_DONE; }
+};
+
+struct Frame {
+  uint8_t cmd;
+  std::vector<uint8_t> payload;
+};
+
+/// The frames written to the MCU since the last call.
+static std::vector<Frame> sent_frames(host_test::MockUARTComponent &uart) {
+  std::vector<Frame> frames;
+  size_t pos = 0;
+  while (pos + 7 <= uart.tx.size()) {
+    size_t len = (uart.tx[pos + 4] << 8) | uart.tx[pos + 5];
+    if (pos + 7 + len > uart.tx.size())
+      break;
+    frames.push_back(Frame{uart.tx[pos + 3], std::vector<uint8_t>(uart.tx.begin() + pos + 6,
+                                                                  uart.tx.begin() + pos + 6 + len)});
+    pos += 7 + len;
+  }
+  EXPECT_EQ(pos, uart.tx.size());
+  uart.tx.clear();
+  return frames;
+}
+
+/// The report of the MCU after a datapoint write, which is the response the queue waits for.
+static void report(host_test::MockUARTComponent &uart, const std::vector<uint8_t> &datapoint) {
+  std::vector<uint8_t> frame{0x55, 0xAA, 0x03, 0x07, 0x00, (uint8_t) datapoint.size()};
+  frame.insert(frame.end(), datapoint.begin(), datapoint.end());
+  uint8_t checksum = 0;
+  for (uint8_t b : frame)
+    checksum += b;
+  frame.push_back(checksum);
+  uart.feed(frame);
+}
+
+static std::vector<uint8_t> integer_datapoint(uint8_t id, uint32_t value) {
+  return {id, 0x02, 0x00, 0x04, (uint8_t) (value >> 24), (uint8_t) (value >> 16), (uint8_t) (value >> 8),
+          (uint8_t) value};
+}
+
+static std::vector<uint8_t> boolean_datapoint(uint8_t id, bool value) { return {id, 0x01, 0x00, 0x01, value}; }
+
+/// Let the MCU answer the command in flight, and send the next one.
+static void respond(TestTuya &tuya, host_test::MockUARTComponent &uart, const std::vector<uint8_t> &datapoint) {
+  report(uart, datapoint);
+  host_test::advance_time_ms(20);
+  tuya.loop();
+}
+
+static void test_coalescing() {
+  host_test::MockUARTComponent uart;
+  TestTuya tuya;
+  tuya.set_uart_parent(&uart);
+
+  // the first write goes out at once and waits for its response, the others are queued
+  tuya.set_integer_datapoint_value(1, 10);
+  for (uint32_t value = 0; value < 50; value++) {
+    tuya.set_integer_datapoint_value(2, value);
+    tuya.set_boolean_datapoint_value(3, value & 1);
+  }
+  std::vector<Frame> frames = sent_frames(uart);
+  EXPECT_EQ(frames.size(), 1u);
+  if (frames.size() != 1)
+    return;
+  EXPECT(frames[0].payload == integer_datapoint(1, 10));
+  EXPECT_EQ(tuya.queue_depth(), 3u);
+
+  // a write to the datapoint in flight is queued behind it, not merged into the frame that was sent
+  tuya.set_integer_datapoint_value(1, 11);
+  EXPECT_EQ(tuya.queue_depth(), 4u);
+
+  respond(tuya, uart, integer_datapoint(1, 10));
+  respond(tuya, uart, integer_datapoint(2, 49));
+  respond(tuya, uart, boolean_datapoint(3, true));
+  respond(tuya, uart, integer_datapoint(1, 11));
+  frames = sent_frames(uart);
+  EXPECT_EQ(frames.size(), 3u);
+  if (frames.size() != 3)
+    return;
+  for (const auto &frame : frames)
+    EXPECT_EQ(frame.cmd, (uint8_t) tuya::TuyaCommandType::DATAPOINT_DELIVER);
+  // only the latest value of each datapoint
+  EXPECT(frames[0].payload == integer_datapoint(2, 49));
+  EXPECT(frames[1].payload == boolean_datapoint(3, true));
+  EXPECT(frames[2].payload == integer_datapoint(1, 11));
+  EXPECT_EQ(tuya.queue_depth(), 0u);
+
+  const auto &stats = tuya.get_queue_stats();
+  EXPECT_EQ(stats.sent, 4u);
+  EXPECT_EQ(stats.coalesced, 98u);
+  EXPECT_EQ(stats.max_depth, 4u);
+  EXPECT(stats.max_latency_ms >= 40);
+}
+
+static void test_timeout() {
+  host_test::MockUARTComponent uart;
+  TestTuya tuya;
+  tuya.set_uart_parent(&uart);
+  tuya.set_initialized();
+  tuya.set_integer_datapoint_value(1, 1);
+  tuya.set_integer_datapoint_value(2, 1);
+  tuya.set_integer_datapoint_value(2, 2);
+  // without a response the write is dropped after the receive timeout and the next one goes out
+  host_test::advance_time_ms(400);
+  tuya.loop();
+  std::vector<Frame> frames = sent_frames(uart);
+  EXPECT_EQ(frames.size(), 2u);
+  if (frames.size() != 2)
+    return;
+  EXPECT(frames[1].payload == integer_datapoint(2, 2));
+  EXPECT_EQ(tuya.queue_depth(), 1u);
+}
+
+static void test_pool() {
+  host_test::MockUARTComponent uart;
+  TestTuya tuya;
+  tuya.set_uart_parent(&uart);
+  for (uint8_t id = 1; id <= 8; id++)
+    tuya.set_integer_datapoint_value(id, 1);
+  for (uint8_t id = 1; id <= 8; id++)
+    respond(tuya, uart, integer_datapoint(id, 1));
+  EXPECT_EQ(tuya.queue_depth(), 0u);
+  // the pool is bounded
+  EXPECT_EQ(tuya.pool_size(), 4u);
+
+  // the next write takes a buffer from the pool
+  const uint8_t *pooled = tuya.pooled_buffer();
+  tuya.set_integer_datapoint_value(9, 1);
+  EXPECT(tuya.last_payload() == pooled);
+  EXPECT_EQ(tuya.pool_size(), 3u);
+
+  // and a write that replaces a queued value hands the old buffer back
+  tuya.set_integer_datapoint_value(10, 1);
+  EXPECT_EQ(tuya.pool_size(), 2u);
+  tuya.set_integer_datapoint_value(10, 2);
+  EXPECT_EQ(tuya.pool_size(), 2u);
+  EXPECT_EQ(tuya.get_queue_stats().coalesced, 1u);
+}
+
+static void bench_burst() {
+  host_test::MockUARTComponent uart;
+  TestTuya tuya;
+  tuya.set_uart_parent(&uart);
+  const int rounds = 2000;
+  const int datapoints = 8;
+  uint64_t elapsed = 0;
+  size_t frames = 0;
+  for (int round = 0; round < rounds; round++) {
+    uint64_t start = host_test::now_us();
+    // a dimmer being dragged: many writes to a few datapoints while the MCU answers one at a time
+    for (uint32_t value = 0; value < 20; value++) {
+      for (uint8_t id = 1; id <= datapoints; id++)
+        tuya.set_integer_datapoint_value(id, round * 100 + value);
+    }
+    elapsed += host_test::now_us() - start;
+    while (tuya.queue_depth() > 0)
+      respond(tuya, uart, integer_datapoint(1, 0));
+    frames += sent_frames(uart).size();
+  }
+  printf("%d writes to %d datapoints: %.2f us per write, %.1f frames sent\n", 20 * datapoints, datapoints,
+         (double) elapsed / rounds / (20 * datapoints), (double) frames / rounds);
+}
+
+int main(int argc, char **argv) {
+  test_coalescing();
+  test_timeout();
+  test_pool();
+  if (host_test::bench_mode(argc, argv))
+    bench_burst();
+  return host_test::result();
+}
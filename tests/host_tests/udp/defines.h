@@ -0,0 +1,7 @@
+#pragma once
+
+#define USE_BINARY_SENSOR
+#define USE_NETWORK
+#define USE_SENSOR
+#define USE_SOCKET_IMPL_BSD_SOCKETS
+#define USE_UDP
@@ -0,0 +1,204 @@
+// Sensor values sent from one UDP component to another over the loopback interface, with both protocol versions:
+// full and changes-only updates, ids with the same hash, and ids that are not ASCII.
+#include "host_test.h"
+
+#include "esphome/components/udp/udp_component.h"
+#include "esphome/core/application.h"
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace esphome;
+
+static const uint16_t PORT = 28511;
+
+class TestUDP : public udp::UDPComponent {
+ public:
+  /// Both ends run in one process, and data with the own device name is ignored.
+  void set_name(const char *name) { this->name_ = name; }
+};
+
+static sensor::Sensor *make_sensor(float state) {
+  auto *sensor = new sensor::Sensor();  // NOLINT
+  sensor->publish_state(state);
+  return sensor;
+}
+
+static const char *sensor_id(int i) { return strdup(("temperature_sensor_" + std::to_string(i)).c_str()); }
+
+/// A sender with 60 sensors and a binary sensor, and a receiver with all of them as remote sensors.
+struct Link {
+  explicit Link(uint8_t version) {
+    this->sender.set_port(PORT);
+    this->sender.add_address("127.0.0.1");
+    this->sender.set_protocol_version(version);
+    this->receiver.set_port(PORT);
+    for (int i = 0; i < 60; i++) {
+      this->local.push_back(make_sensor(i * 1.5f));
+      this->sender.add_sensor(sensor_id(i), this->local.back());
+      this->remote.push_back(new sensor::Sensor());  // NOLINT
+      this->receiver.add_remote_sensor("sender", sensor_id(i), this->remote.back());
+    }
+    this->local_door.publish_initial_state(true);
+    this->sender.add_binary_sensor("door", &this->local_door);
+    this->receiver.add_remote_binary_sensor("sender", "door", &this->remote_door);
+    this->sender.setup();
+    this->receiver.setup();
+    this->receiver.set_name("receiver");
+  }
+
+  /// Send what is due and receive it.
+  void transfer() {
+    this->sender.loop();
+    usleep(1000);
+    this->receiver.loop();
+  }
+
+  int received_values() {
+    int count = 0;
+    for (int i = 0; i < 60; i++)
+      count += this->remote[i]->has_state() && this->remote[i]->state == this->local[i]->state;
+    return count;
+  }
+
+  TestUDP sender;
+  TestUDP receiver;
+  std::vector<sensor::Sensor *> local;
+  std::vector<sensor::Sensor *> remote;
+  binary_sensor::BinarySensor local_door;
+  binary_sensor::BinarySensor remote_door;
+};
+
+static void test_updates(uint8_t version) {
+  Link link(version);
+  link.sender.update();
+  link.transfer();
+  EXPECT_EQ(link.received_values(), 60);
+  EXPECT(link.remote_door.has_state() && link.remote_door.state);
+
+  // between full updates only the values that changed are sent
+  int publishes = 0;
+  link.remote[3]->add_on_state_callback([&publishes](float) { publishes++; });
+  link.remote[7]->add_on_state_callback([&publishes](float) { publishes++; });
+  for (int i = 0; i < 60; i++)
+    link.local[i]->publish_state(i == 7 ? 99.0f : i * 1.5f);
+  link.transfer();
+  EXPECT_EQ(publishes, 1);
+  EXPECT_EQ(link.remote[7]->state, 99.0f);
+
+  link.sender.update();
+  link.transfer();
+  EXPECT_EQ(publishes, 3);
+  EXPECT_EQ(link.received_values(), 60);
+}
+
+static void test_same_hash() {
+  // "sensor_889" and "sensor_475416" have the same FNV-1 hash
+  EXPECT_EQ(udp::hash_name("sensor_889"), udp::hash_name("sensor_475416"));
+  TestUDP sender;
+  sender.set_port(PORT);
+  sender.add_address("127.0.0.1");
+  sender.set_protocol_version(1);
+  auto *local = make_sensor(1.0f);
+  sender.add_sensor("sensor_475416", local);
+  sender.setup();
+
+  // A sensor that is not configured must not update the one it collides with
+  TestUDP receiver;
+  receiver.set_port(PORT);
+  sensor::Sensor other;
+  receiver.add_remote_sensor("sender", "sensor_889", &other);
+  receiver.setup();
+  receiver.set_name("receiver");
+  sender.update();
+  sender.loop();
+  usleep(1000);
+  receiver.loop();
+  EXPECT(!other.has_state());
+}
+
+static void test_same_hash_both_configured() {
+  TestUDP sender;
+  sender.set_port(PORT);
+  sender.add_address("127.0.0.1");
+  sender.set_protocol_version(1);
+  auto *first = make_sensor(1.0f);
+  auto *second = make_sensor(2.0f);
+  sender.add_sensor("sensor_889", first);
+  sender.add_sensor("sensor_475416", second);
+  sender.setup();
+
+  TestUDP receiver;
+  receiver.set_port(PORT);
+  sensor::Sensor remote_first, remote_second;
+  receiver.add_remote_sensor("sender", "sensor_475416", &remote_second);
+  receiver.add_remote_sensor("sender", "sensor_889", &remote_first);
+  receiver.setup();
+  receiver.set_name("receiver");
+  EXPECT(host_test::log_contains("have the same hash"));
+  sender.update();
+  sender.loop();
+  usleep(1000);
+  receiver.loop();
+  EXPECT_EQ(remote_first.state, 1.0f);
+  EXPECT_EQ(remote_second.state, 2.0f);
+}
+
+static void test_non_ascii_id() {
+  // The value computed by fnv1_hash() in udp/__init__.py, which hashes the UTF-8 bytes as unsigned values
+  EXPECT_EQ(udp::hash_name("temp\xc3\xa9rature"), 0x8d07c00au);
+  for (uint8_t version : {1, 2}) {
+    TestUDP sender;
+    sender.set_port(PORT);
+    sender.add_address("127.0.0.1");
+    sender.set_protocol_version(version);
+    sender.add_sensor("temp\xc3\xa9rature", make_sensor(21.5f));
+    sender.setup();
+
+    TestUDP receiver;
+    receiver.set_port(PORT);
+    sensor::Sensor remote;
+    receiver.add_remote_sensor("sender", "temp\xc3\xa9rature", &remote);
+    receiver.setup();
+    receiver.set_name("receiver");
+    sender.update();
+    sender.loop();
+    usleep(1000);
+    receiver.loop();
+    EXPECT_EQ(remote.state, 21.5f);
+  }
+}
+
+static void bench_updates() {
+  for (uint8_t version : {1, 2}) {
+    Link link(version);
+    const int rounds = 500;
+    uint64_t send_us = 0, receive_us = 0;
+    for (int round = 0; round < rounds; round++) {
+      link.sender.update();
+      uint64_t start = host_test::now_us();
+      link.sender.loop();
+      send_us += host_test::now_us() - start;
+      usleep(1000);
+      start = host_test::now_us();
+      link.receiver.loop();
+      receive_us += host_test::now_us() - start;
+    }
+    EXPECT_EQ(link.received_values(), 60);
+    printf("protocol version %u, 60 sensors: send %.1f us, receive %.1f us\n", version, (double) send_us / rounds,
+           (double) receive_us / rounds);
+  }
+}
+
+int main(int argc, char **argv) {
+  App.pre_setup("sender", "", "", "", "", false);
+  test_updates(1);
+  test_updates(2);
+  test_same_hash();
+  test_same_hash_both_configured();
+  test_non_ascii_id();
+  if (host_test::bench_mode(argc, argv))
+    bench_updates();
+  return host_test::result();
+}
@@ -0,0 +1,62 @@
+import random
+
+import pytest
+
+from esphome import ota_delta
+
+
+def _image(size, seed):
+    rng = random.Random(seed)
+    return bytes(rng.getrandbits(8) for _ in range(size))
+
+
+def _modified(source):
+    # change a few bytes, insert a block and remove a block, so the offsets shift
+    target = bytearray(source)
+    target[100:104] = b"\x01\x02\x03\x04"
+    target[5000:5000] = b"new configuration value"
+    del target[20000:20100]
+    return bytes(target)
+
+
+@pytest.mark.parametrize(
+    "source, target",
+    (
+        (b"", b""),
+        (b"", b"only new data"),
+        (b"some old data", b""),
+        (_image(30000, 1), _image(30000, 1)),
+        (_image(30000, 1), _modified(_image(30000, 1))),
+        (_image(30000, 1), _image(30000, 2)),
+    ),
+)
+def test_apply_delta_reconstructs_target(source, target):
+    patch = ota_delta.make_delta(source, target)
+
+    assert ota_delta.apply_delta(source, patch) == target
+
+
+def test_make_delta_is_small_for_small_changes():
+    source = _image(30000, 1)
+    patch = ota_delta.make_delta(source, _modified(source))
+
+    assert len(patch) < 200
+
+
+@pytest.mark.parametrize(
+    "patch",
+    (
+        b"",
+        b"XXXX\x01",
+        ota_delta.DELTA_MAGIC + b"\x03",
+        ota_delta.DELTA_MAGIC + b"\x01\x00\x80",
+        ota_delta.DELTA_MAGIC + b"\x01\x00\x10",
+        ota_delta.DELTA_MAGIC + b"\x02\x05abc",
+        # numbers of more than 32 bits
+        ota_delta.DELTA_MAGIC + b"\x02\x80\x80\x80\x80\x10",
+        ota_delta.DELTA_MAGIC + b"\x02\x80\x80\x80\x80\x80\x00",
+    ),
+)
+def test_apply_delta_rejects_invalid_patches(patch):
+    with pytest.raises(ota_delta.DeltaError):
+        ota_delta.apply_delta(b"0123456789", patch)